@@ -0,0 +1,42 @@
+######################################################################
+#  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+#  All rights reserved.
+#  
+#  This library is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU Lesser General Public
+#  License as published by the Free Software Foundation; either
+#  version 2.1 of the License, or (at your option) any later version.
+#  
+#  This library is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#  Lesser General Public License for more details.
+#  
+#  You should have received a copy of the GNU Lesser General Public
+#  License along with this library; if not, write to the Free Software
+#  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+######################################################################
+
+# Client side of the RunManager ruby worker pool.
+#
+# usage: ruby ruby_worker_client.rb <socket path> <script> [script arguments]
+#
+# Hands the working directory, environment, arguments and standard streams of
+# this process to a warm worker, then exits with the exit code of the script.
+
+require 'socket'
+
+socket_path = ARGV.shift
+script = ARGV.shift
+
+conn = UNIXSocket.new(socket_path)
+conn.send_io(STDIN)
+conn.send_io(STDOUT)
+conn.send_io(STDERR)
+
+request = Marshal.dump([Dir.pwd, script, ARGV.to_a, ENV.to_hash])
+conn.write([request.size].pack('N'))
+conn.write(request)
+
+status = conn.read.to_s.strip
+exit(status.empty? ? 1 : status.to_i)
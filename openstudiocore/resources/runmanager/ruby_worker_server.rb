@@ -0,0 +1,117 @@
+######################################################################
+#  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+#  All rights reserved.
+#  
+#  This library is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU Lesser General Public
+#  License as published by the Free Software Foundation; either
+#  version 2.1 of the License, or (at your option) any later version.
+#  
+#  This library is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#  Lesser General Public License for more details.
+#  
+#  You should have received a copy of the GNU Lesser General Public
+#  License along with this library; if not, write to the Free Software
+#  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+######################################################################
+
+# Forking ruby server used by the RunManager ruby worker pool.
+#
+# usage: ruby ruby_worker_server.rb <socket path> <parent pid>
+#
+# The OpenStudio bindings are loaded once, then a child is forked for every job
+# so that each job starts from a clean but already warm interpreter. The server
+# exits when its socket file is removed or when the parent process goes away.
+
+require 'socket'
+
+begin
+  require 'openstudio'
+rescue LoadError
+  # jobs that need the bindings will require them themselves
+end
+
+socket_path = ARGV[0]
+parent_pid = ARGV[1].to_i
+
+def parent_alive?(pid)
+  return true if pid <= 0
+  Process.kill(0, pid)
+  true
+rescue Errno::ESRCH
+  false
+rescue Errno::EPERM
+  true
+end
+
+File.delete(socket_path) if File.exist?(socket_path)
+server = UNIXServer.new(socket_path)
+jobs = []
+
+loop do
+  break if !File.exist?(socket_path) || !parent_alive?(parent_pid)
+
+  jobs.delete_if { |t| !t.alive? }
+  next if IO.select([server], nil, nil, 1).nil?
+
+  conn = nil
+  ios = []
+  begin
+    conn = server.accept
+
+    # the client sends its standard streams first, then the marshalled request
+    3.times { ios << conn.recv_io }
+    len = conn.read(4).unpack('N')[0]
+    dir, script, args, env = Marshal.load(conn.read(len))
+  rescue StandardError, LoadError
+    ios.each { |io| io.close rescue nil }
+    conn.close rescue nil if conn
+    next
+  end
+
+  pid = fork do
+    server.close
+    conn.close
+    $stdin.reopen(ios[0])
+    $stdout.reopen(ios[1])
+    $stderr.reopen(ios[2])
+    ios.each { |io| io.close }
+    $stdout.sync = true
+    $stderr.sync = true
+
+    ENV.replace(env)
+    Dir.chdir(dir)
+    ARGV.replace(args)
+    $0 = script
+    load(script)
+  end
+
+  ios.each { |io| io.close }
+
+  jobs << Thread.new(conn, pid) do |c, child|
+    # a client that goes away (job stopped) takes its job with it
+    watcher = Thread.new do
+      begin
+        c.read
+      rescue StandardError
+      end
+      Process.kill('KILL', child) rescue nil
+    end
+
+    status = Process.wait2(child)[1]
+    watcher.kill
+    code = status.exitstatus || (128 + (status.termsig || 0))
+
+    begin
+      c.write("#{code}\n")
+    rescue StandardError
+    end
+    c.close rescue nil
+  end
+end
+
+server.close
+File.delete(socket_path) if File.exist?(socket_path)
+jobs.each { |t| t.join }
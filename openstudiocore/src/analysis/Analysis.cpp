@@ -39,6 +39,10 @@
 #include <utilities/core/PathHelpers.hpp>
 
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <sstream>
 
 namespace openstudio {
 namespace analysis {
@@ -199,6 +203,7 @@ namespace detail {
         }
       }
       connectChild(dataPoint,false);
+      indexDataPoint(dataPoint);
     }
   }
 
@@ -221,6 +226,7 @@ namespace detail {
       m_dataPoints.push_back(dataPoint.clone().cast<DataPoint>());
       m_dataPoints.back().setProblem(m_problem);
       connectChild(m_dataPoints.back(),false);
+      indexDataPoint(m_dataPoints.back());
     }
   }
 
@@ -317,6 +323,22 @@ namespace detail {
       const std::vector<QVariant>& variableValues) const
   {
     DataPointVector result;
+    // fully specified values can only match points with the same key, as long as no point has
+    // more values than were given (matches treats variableValues as a prefix)
+    boost::optional<DataPointKey> key = dataPointKey(variableValues);
+    if (key && (m_numDataPointsBySize.empty() ||
+                (m_numDataPointsBySize.rbegin()->first <= variableValues.size())))
+    {
+      DataPointKeyMap::const_iterator it = m_dataPointsByKey.find(*key);
+      if (it != m_dataPointsByKey.end()) {
+        BOOST_FOREACH(const DataPoint& dataPoint, it->second) {
+          if (dataPoint.matches(variableValues)) {
+            result.push_back(dataPoint);
+          }
+        }
+      }
+      return result;
+    }
     BOOST_FOREACH(const DataPoint& dataPoint, m_dataPoints) {
       if (dataPoint.matches(variableValues)) {
         result.push_back(dataPoint);
@@ -365,24 +387,15 @@ namespace detail {
 
   boost::optional<DataPoint> Analysis_Impl::getDataPointByUUID(const UUID& uuid) const {
     OptionalDataPoint result;
-    BOOST_FOREACH(const DataPoint& myDataPoint,dataPoints()) {
-      if (myDataPoint.uuid() == uuid) {
-        result = myDataPoint;
-        break;
-      }
+    DataPointUUIDMap::const_iterator it = m_dataPointsByUUID.find(uuid);
+    if (it != m_dataPointsByUUID.end()) {
+      result = it->second;
     }
     return result;
   }
 
   boost::optional<DataPoint> Analysis_Impl::getDataPointByUUID(const DataPoint& dataPoint) const {
-    OptionalDataPoint result;
-    BOOST_FOREACH(const DataPoint& myDataPoint,dataPoints()) {
-      if (dataPoint.uuidEqual(myDataPoint)) {
-        result = myDataPoint;
-        break;
-      }
-    }
-    return result;
+    return getDataPointByUUID(dataPoint.uuid());
   }
 
   bool Analysis_Impl::resultsAreInvalid() const {
@@ -506,6 +519,7 @@ namespace detail {
     }
     m_dataPoints.push_back(dataPoint);
     connectChild(m_dataPoints.back(),true);
+    indexDataPoint(m_dataPoints.back());
     onChange(AnalysisObject_Impl::Benign);
     return true;
   }
@@ -537,6 +551,7 @@ namespace detail {
       DataPointVector::iterator it = std::find(m_dataPoints.begin(),m_dataPoints.end(),*exactDataPoint);
       OS_ASSERT(it != m_dataPoints.end());
       disconnectChild(*it);
+      unindexDataPoint(*it);
       m_dataPoints.erase(it);
       // TODO: It may be that the algorithm should be reset, or at least marked not-complete.
       if (m_dataPoints.empty()) {
@@ -554,6 +569,7 @@ namespace detail {
       disconnectChild(dataPoint);
     }
     m_dataPoints.clear();
+    clearDataPointIndex();
     if (m_algorithm) {
       m_algorithm->reset();
     }
@@ -752,22 +768,63 @@ namespace detail {
   }
 
   bool Analysis_Impl::saveJSON(const openstudio::path& p,
-                               const AnalysisSerializationOptions& options,                               bool overwrite) const
+                               const AnalysisSerializationOptions& options,
+                               bool overwrite) const
   {
-    QVariant json = toVariant(options);
-    return openstudio::saveJSON(json,p,overwrite);
+    // Ensures file extension is .json. Warns if there is a mismatch.
+    openstudio::path jsonPath = setFileExtension(p,"json",true);
+    boost::filesystem::ofstream file(jsonPath,std::ios_base::binary);
+    if (!file) {
+      LOG(Error,"Could not open file " << toString(jsonPath) << " for writing.");
+      return false;
+    }
+    toJSON(file,options);
+    file.close();
+    return file.good();
   }
 
   std::ostream& Analysis_Impl::toJSON(std::ostream& os,
                                       const AnalysisSerializationOptions& options) const
   {
-    os << toJSON(options);
+    // Written member by member so that only one DataPoint is held as a QVariant at a time.
+    // The result is equivalent to serializing toVariant(options).
+    bool full = (options.scope == AnalysisSerializationScope::Full);
+    JsonWriter writer(os);
+    writer.startObject();
+
+    writer.startObject("metadata");
+    writer.writeMembers(jsonMetadata(options));
+    if (options.osServerView && full) {
+      writer.startArray("data_points");
+      Q_FOREACH(const DataPoint& dataPoint, m_dataPoints) {
+        if (dataPoint.hasProblem()) {
+          writer.write(dataPoint.toServerDataPointsVariant());
+        }
+      }
+      writer.end();
+    }
+    writer.end();
+
+    writer.startObject("analysis");
+    writer.writeMembers(toVariant().toMap());
+    if (full) {
+      writer.startArray("data_points");
+      Q_FOREACH(const DataPoint& dataPoint, m_dataPoints) {
+        writer.write(dataPoint.toVariant());
+      }
+      writer.end();
+    }
+    writer.end();
+
+    writer.end();
+    OS_ASSERT(writer.isComplete());
     return os;
   }
 
   std::string Analysis_Impl::toJSON(const AnalysisSerializationOptions& options) const {
-    QVariant json = this->toVariant(options);
-    return openstudio::toJSON(json);
+    std::stringstream ss;
+    toJSON(ss,options);
+    return ss.str();
   }
 
   QVariant Analysis_Impl::toVariant() const {
@@ -800,28 +857,17 @@ namespace detail {
       analysisData["data_points"] = QVariant(dataPointList);
     }
 
-    QVariantMap metadata = jsonMetadata().toMap();
-
-    if (!options.projectDir.empty()) {
-      metadata["project_dir"] = toQString(options.projectDir);
-    }
-
-    if (options.osServerView) {
+    QVariantMap metadata = jsonMetadata(options);
 
+    if (options.osServerView && (options.scope == AnalysisSerializationScope::Full)) {
       // this data is not read upon deserialization
-      QVariantMap serverView = problem().toServerFormulationVariant().toMap();
-
-      if (options.scope == AnalysisSerializationScope::Full) {
-        QVariantList dataPointList;
-        Q_FOREACH(const DataPoint& dataPoint, dataPoints()) {
-          if (dataPoint.hasProblem()) {
-            dataPointList.push_back(dataPoint.toServerDataPointsVariant());
-          }
+      QVariantList dataPointList;
+      Q_FOREACH(const DataPoint& dataPoint, dataPoints()) {
+        if (dataPoint.hasProblem()) {
+          dataPointList.push_back(dataPoint.toServerDataPointsVariant());
         }
-        serverView["data_points"] = QVariant(dataPointList);
       }
-
-      metadata.unite(serverView);
+      metadata.insert("data_points",QVariant(dataPointList));
     }
 
     // create top-level of final file
@@ -835,16 +881,25 @@ namespace detail {
   Analysis Analysis_Impl::fromVariant(const QVariant& variant,const VersionString& version) {
     QVariantMap map = variant.toMap();
     Problem problem = Problem_Impl::factoryFromVariant(map["problem"],version);
-    OptionalAlgorithm algorithm;
-    if (map.contains("algorithm")) {
-      algorithm =  Algorithm_Impl::factoryFromVariant(map["algorithm"],version);
-    }
     DataPointVector dataPoints;
     if (map.contains("data_points")) {
       dataPoints = deserializeUnorderedVector<DataPoint>(
             map["data_points"].toList(),
             boost::function<DataPoint (const QVariant&)>(boost::bind(openstudio::analysis::detail::DataPoint_Impl::factoryFromVariant,_1,version,problem)));
     }
+    return fromVariant(variant,version,problem,dataPoints);
+  }
+
+  Analysis Analysis_Impl::fromVariant(const QVariant& variant,
+                                      const VersionString& version,
+                                      const Problem& problem,
+                                      const std::vector<DataPoint>& dataPoints)
+  {
+    QVariantMap map = variant.toMap();
+    OptionalAlgorithm algorithm;
+    if (map.contains("algorithm")) {
+      algorithm =  Algorithm_Impl::factoryFromVariant(map["algorithm"],version);
+    }
     return Analysis(toUUID(map["uuid"].toString().toStdString()),
                     toUUID(map["version_uuid"].toString().toStdString()),
                     map.contains("name") ? map["name"].toString().toStdString() : std::string(),
@@ -874,6 +929,82 @@ namespace detail {
     }
   }
 
+  boost::optional<Analysis_Impl::DataPointKey> Analysis_Impl::dataPointKey(
+      const std::vector<QVariant>& variableValues)
+  {
+    DataPointKey result;
+    result.reserve(2u * variableValues.size());
+    BOOST_FOREACH(const QVariant& value, variableValues) {
+      if (value.isNull()) {
+        return boost::none;
+      }
+      if ((value.type() == QVariant::Int) || (value.type() == QVariant::UInt)) {
+        result.push_back(1);
+        result.push_back(value.toInt());
+      }
+      else if (value.type() == QVariant::Double) {
+        result.push_back(2);
+      }
+      else {
+        return boost::none;
+      }
+    }
+    return result;
+  }
+
+  void Analysis_Impl::indexDataPoint(const DataPoint& dataPoint) {
+    std::vector<QVariant> variableValues = dataPoint.variableValues();
+    m_dataPointsByUUID.insert(std::make_pair(dataPoint.uuid(),dataPoint));
+    ++m_numDataPointsBySize[variableValues.size()];
+    boost::optional<DataPointKey> key = dataPointKey(variableValues);
+    OS_ASSERT(key);
+    m_dataPointsByKey[*key].push_back(dataPoint);
+  }
+
+  void Analysis_Impl::unindexDataPoint(const DataPoint& dataPoint) {
+    std::vector<QVariant> variableValues = dataPoint.variableValues();
+    m_dataPointsByUUID.erase(dataPoint.uuid());
+    std::map<unsigned,unsigned>::iterator sizeIt = m_numDataPointsBySize.find(variableValues.size());
+    OS_ASSERT(sizeIt != m_numDataPointsBySize.end());
+    if (--(sizeIt->second) == 0u) {
+      m_numDataPointsBySize.erase(sizeIt);
+    }
+    boost::optional<DataPointKey> key = dataPointKey(variableValues);
+    OS_ASSERT(key);
+    DataPointKeyMap::iterator it = m_dataPointsByKey.find(*key);
+    OS_ASSERT(it != m_dataPointsByKey.end());
+    DataPointVector::iterator dpit = std::find_if(
+          it->second.begin(),
+          it->second.end(),
+          boost::bind(&DataPoint::uuidEqual,_1,dataPoint));
+    OS_ASSERT(dpit != it->second.end());
+    it->second.erase(dpit);
+    if (it->second.empty()) {
+      m_dataPointsByKey.erase(it);
+    }
+  }
+
+  QVariantMap Analysis_Impl::jsonMetadata(const AnalysisSerializationOptions& options) const {
+    QVariantMap metadata = openstudio::jsonMetadata().toMap();
+
+    if (!options.projectDir.empty()) {
+      metadata["project_dir"] = toQString(options.projectDir);
+    }
+
+    if (options.osServerView) {
+      // this data is not read upon deserialization
+      metadata.unite(problem().toServerFormulationVariant().toMap());
+    }
+
+    return metadata;
+  }
+
+  void Analysis_Impl::clearDataPointIndex() {
+    m_dataPointsByUUID.clear();
+    m_dataPointsByKey.clear();
+    m_numDataPointsBySize.clear();
+  }
+
 } // detail
 
 AnalysisSerializationOptions::AnalysisSerializationOptions(
@@ -0,0 +1,111 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <analysis/AnalysisJSONReader.hpp>
+
+#include <analysis/Analysis.hpp>
+#include <analysis/Analysis_Impl.hpp>
+#include <analysis/DataPoint.hpp>
+#include <analysis/DataPoint_Impl.hpp>
+#include <analysis/Problem_Impl.hpp>
+
+#include <utilities/core/Assert.hpp>
+#include <utilities/core/Json.hpp>
+
+#include <boost/foreach.hpp>
+
+namespace openstudio {
+namespace analysis {
+
+namespace {
+
+  boost::shared_ptr<JsonFileIndex> indexAnalysisFile(const openstudio::path& p) {
+    boost::shared_ptr<JsonFileIndex> result(new JsonFileIndex(p));
+    if (!result->contains("analysis") || !result->contains("metadata")) {
+      LOG_FREE_AND_THROW("openstudio.analysis.AnalysisJSONReader",
+                         "The file at " << toString(p) << " does not contain an analysis.");
+    }
+    return result;
+  }
+
+  VersionString extractVersion(const JsonFileIndex& index) {
+    QVariantMap topLevel;
+    topLevel["metadata"] = index.value("metadata");
+    return extractOpenStudioVersion(topLevel);
+  }
+
+}
+
+AnalysisJSONReader::AnalysisJSONReader(const openstudio::path& p)
+  : m_index(indexAnalysisFile(p)),
+    m_version(extractVersion(*m_index)),
+    m_problem(detail::Problem_Impl::factoryFromVariant(m_index->value("analysis/problem"),m_version))
+{
+  QVariantMap metadata = m_index->value("metadata").toMap();
+  if (metadata.contains("project_dir")) {
+    m_projectDir = toPath(metadata["project_dir"].toString());
+  }
+}
+
+VersionString AnalysisJSONReader::originalOSVersion() const {
+  return m_version;
+}
+
+openstudio::path AnalysisJSONReader::projectDir() const {
+  return m_projectDir;
+}
+
+Problem AnalysisJSONReader::problem() const {
+  return m_problem;
+}
+
+unsigned AnalysisJSONReader::numDataPoints() const {
+  return m_index->arraySize("analysis/data_points");
+}
+
+DataPoint AnalysisJSONReader::dataPoint(unsigned index) const {
+  if (index >= numDataPoints()) {
+    LOG_AND_THROW("Cannot load DataPoint " << index << ", because the analysis only contains "
+                  << numDataPoints() << " data points.");
+  }
+  return detail::DataPoint_Impl::factoryFromVariant(m_index->arrayElement("analysis/data_points",index),
+                                                    m_version,
+                                                    m_problem);
+}
+
+Analysis AnalysisJSONReader::analysis() const {
+  QVariantMap map;
+  BOOST_FOREACH(const std::string& key, m_index->keys("analysis")) {
+    if ((key != "problem") && (key != "data_points")) {
+      map[toQString(key)] = m_index->value("analysis/" + key);
+    }
+  }
+
+  std::vector<DataPoint> dataPoints;
+  unsigned n = numDataPoints();
+  dataPoints.reserve(n);
+  for (unsigned i = 0; i < n; ++i) {
+    dataPoints.push_back(dataPoint(i));
+  }
+
+  return detail::Analysis_Impl::fromVariant(map,m_version,m_problem,dataPoints);
+}
+
+} // analysis
+} // openstudio
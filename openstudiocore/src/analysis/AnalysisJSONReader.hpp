@@ -0,0 +1,80 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef ANALYSIS_ANALYSISJSONREADER_HPP
+#define ANALYSIS_ANALYSISJSONREADER_HPP
+
+#include <analysis/AnalysisAPI.hpp>
+#include <analysis/Problem.hpp>
+
+#include <utilities/core/Compare.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+namespace openstudio {
+
+class JsonFileIndex;
+
+namespace analysis {
+
+class Analysis;
+class DataPoint;
+
+/** AnalysisJSONReader opens an Analysis JSON file, as written by Analysis::saveJSON, without
+ *  parsing its data points. The Problem is parsed once on construction; \link DataPoint
+ *  DataPoints\endlink are then parsed one at a time, either by index or while assembling the
+ *  whole Analysis, so the file is never held as a single QVariant tree. Throws an
+ *  openstudio::Exception if p cannot be read or does not contain an analysis. */
+class ANALYSIS_API AnalysisJSONReader {
+ public:
+  explicit AnalysisJSONReader(const openstudio::path& p);
+
+  /** OpenStudio version that wrote the file. */
+  VersionString originalOSVersion() const;
+
+  /** Project directory recorded in the file's metadata, if any. */
+  openstudio::path projectDir() const;
+
+  /** The Analysis's Problem. All \link DataPoint DataPoints\endlink returned by this reader
+   *  point to this object. */
+  Problem problem() const;
+
+  unsigned numDataPoints() const;
+
+  /** Parses the DataPoint at index. Throws if index >= numDataPoints(). */
+  DataPoint dataPoint(unsigned index) const;
+
+  /** Parses the full Analysis, one DataPoint at a time. */
+  Analysis analysis() const;
+
+ private:
+  REGISTER_LOGGER("openstudio.analysis.AnalysisJSONReader");
+
+  boost::shared_ptr<JsonFileIndex> m_index;
+  VersionString m_version;
+  openstudio::path m_projectDir;
+  Problem m_problem;
+};
+
+} // analysis
+} // openstudio
+
+#endif // ANALYSIS_ANALYSISJSONREADER_HPP
@@ -29,6 +29,10 @@
 
 #include <utilities/core/FileReference.hpp>
 
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <map>
 #include <vector>
 
 namespace openstudio {
@@ -274,6 +278,13 @@ namespace detail {
 
     static Analysis fromVariant(const QVariant& variant,const VersionString& version);
 
+    /** Deserializes variant, ignoring any problem or data_points entries in favor of the
+     *  already deserialized problem and dataPoints. */
+    static Analysis fromVariant(const QVariant& variant,
+                                const VersionString& version,
+                                const Problem& problem,
+                                const std::vector<DataPoint>& dataPoints);
+
     //@}
    signals:
     void seedChanged();
@@ -291,6 +302,41 @@ namespace detail {
 
    private:
     REGISTER_LOGGER("openstudio.analysis.Analysis");
+
+    // Discrete values are kept as (1, value), continuous values as (2) and are left to
+    // DataPoint::matches since they are compared with a tolerance.
+    typedef std::vector<int> DataPointKey;
+    typedef boost::unordered_map<DataPointKey,std::vector<DataPoint>,boost::hash<DataPointKey> > DataPointKeyMap;
+
+    struct UUIDHash {
+      std::size_t operator()(const UUID& uuid) const {
+        std::size_t result = 0;
+        boost::hash_combine(result,uuid.data1);
+        boost::hash_combine(result,uuid.data2);
+        boost::hash_combine(result,uuid.data3);
+        boost::hash_range(result,uuid.data4,uuid.data4 + 8);
+        return result;
+      }
+    };
+    typedef boost::unordered_map<UUID,DataPoint,UUIDHash> DataPointUUIDMap;
+
+    // Indices over m_dataPoints, kept in sync by indexDataPoint and unindexDataPoint.
+    DataPointUUIDMap m_dataPointsByUUID;
+    DataPointKeyMap m_dataPointsByKey;
+    std::map<unsigned,unsigned> m_numDataPointsBySize;
+
+    /** Returns the hash key for variableValues, or boost::none if a value is null or of an
+     *  unexpected type. */
+    static boost::optional<DataPointKey> dataPointKey(const std::vector<QVariant>& variableValues);
+
+    void indexDataPoint(const DataPoint& dataPoint);
+
+    void unindexDataPoint(const DataPoint& dataPoint);
+
+    void clearDataPointIndex();
+
+    /** Top-level metadata for options, without the server view's data_points list. */
+    QVariantMap jsonMetadata(const AnalysisSerializationOptions& options) const;
   };
 
 } // detail
@@ -22,9 +22,12 @@
 
 #include <analysis/Analysis.hpp>
 #include <analysis/Analysis_Impl.hpp>
+#include <analysis/AnalysisJSONReader.hpp>
 #include <analysis/Problem.hpp>
 #include <analysis/Variable.hpp>
 #include <analysis/DataPoint.hpp>
+#include <analysis/DesignOfExperiments.hpp>
+#include <analysis/DesignOfExperimentsOptions.hpp>
 #include <analysis/Measure.hpp>
 #include <analysis/MeasureGroup.hpp>
 #include <analysis/MeasureGroup_Impl.hpp>
@@ -45,6 +48,10 @@
 #include <utilities/bcl/BCLMeasure.hpp>
 #include <utilities/data/Tag.hpp>
 
+#include <boost/timer.hpp>
+
+#include <sstream>
+
 #include <resources.hxx>
 #include <OpenStudio.hxx>
 
@@ -413,6 +420,38 @@ TEST_F(AnalysisFixture,Analysis_JSONSerialization_PreRun_Roundtrip) {
   EXPECT_FALSE(copy.dataPoints().empty());
 }
 
+TEST_F(AnalysisFixture,Analysis_JSONSerialization_LazyDataPoints) {
+  Analysis analysis = analysis1(PreRun);
+  AnalysisSerializationOptions options(openstudio::path(),AnalysisSerializationScope::Full);
+  std::string json = analysis.toJSON(options);
+  openstudio::path p = toPath("AnalysisFixtureData/analysis_lazy_data_points.json");
+  EXPECT_TRUE(analysis.saveJSON(p,options,true));
+
+  AnalysisJSONReader reader(p);
+  EXPECT_TRUE(reader.originalOSVersion() == VersionString(openStudioVersion()));
+  EXPECT_TRUE(reader.problem().uuid() == analysis.problem().uuid());
+  DataPointVector dataPoints = analysis.dataPoints();
+  ASSERT_EQ(dataPoints.size(),reader.numDataPoints());
+  ASSERT_FALSE(dataPoints.empty());
+
+  // data points can be loaded individually, in any order
+  DataPoint last = reader.dataPoint(reader.numDataPoints() - 1u);
+  EXPECT_TRUE(last.uuid() == dataPoints.back().uuid());
+  EXPECT_TRUE(last.problem().uuid() == reader.problem().uuid());
+  EXPECT_ANY_THROW(reader.dataPoint(reader.numDataPoints()));
+
+  // the assembled analysis serializes exactly as the original
+  Analysis copy = reader.analysis();
+  EXPECT_EQ(dataPoints.size(),copy.dataPoints().size());
+  std::string jsonCopy = copy.toJSON(options);
+  bool test = (jsonCopy == json);
+  EXPECT_TRUE(test);
+  if (!test) {
+    LOG(Debug,"Original JSON: " << std::endl << json);
+    LOG(Debug,"Copy JSON: " << std::endl << jsonCopy);
+  }
+}
+
 TEST_F(AnalysisFixture,Analysis_JSONSerialization_Versioning) {
   openstudio::path dir = resourcesPath() / toPath("analysis/version");
 
@@ -442,3 +481,61 @@ TEST_F(AnalysisFixture,Analysis_JSONSerialization_Versioning) {
   }
 }
 
+
+TEST_F(AnalysisFixture, Analysis_DataPointIndexPerformance) {
+  // 4 variables x 12 measures = 20,736 data points
+  Problem problem("Problem",VariableVector(),runmanager::Workflow());
+  RubyMeasure measure(toPath("myMeasure.rb"),
+                      FileReferenceType::OSM,
+                      FileReferenceType::OSM,
+                      true);
+  for (unsigned i = 0; i < 4; ++i) {
+    MeasureVector measures(1u,NullMeasure());
+    for (unsigned j = 1; j < 12; ++j) {
+      measures.push_back(measure.clone().cast<RubyMeasure>());
+    }
+    std::stringstream ss;
+    ss << "Variable " << i;
+    ASSERT_TRUE(problem.push(MeasureGroup(ss.str(),measures)));
+  }
+  DesignOfExperiments algorithm((DesignOfExperimentsOptions(DesignOfExperimentsType::FullFactorial)));
+  Analysis analysis("Analysis",problem,algorithm,FileReference(toPath("./in.osm")));
+
+  boost::timer t;
+  EXPECT_EQ(20736,algorithm.createNextIteration(analysis));
+  LOG(Info,"Time to create DesignOfExperiments data points: " << t.elapsed());
+  DataPointVector dataPoints = analysis.dataPoints();
+  ASSERT_EQ(20736u,dataPoints.size());
+
+  // adding an existing point again is rejected
+  DataPoint duplicate = problem.createDataPoint(dataPoints[1234].variableValues()).get();
+  EXPECT_FALSE(analysis.addDataPoint(duplicate));
+
+  t.restart();
+  BOOST_FOREACH(const DataPoint& dataPoint,dataPoints) {
+    OptionalDataPoint byUUID = analysis.getDataPointByUUID(dataPoint.uuid());
+    ASSERT_TRUE(byUUID);
+    EXPECT_TRUE(byUUID->uuidEqual(dataPoint));
+    DataPointVector byValues = analysis.getDataPoints(dataPoint.variableValues());
+    ASSERT_EQ(1u,byValues.size());
+    EXPECT_TRUE(byValues[0].uuidEqual(dataPoint));
+  }
+  LOG(Info,"Time to look up each data point by UUID and variable values: " << t.elapsed());
+
+  // partially specified values still work
+  std::vector<QVariant> partial(4u,QVariant());
+  partial[2] = 3;
+  EXPECT_EQ(1728u,analysis.getDataPoints(partial).size());
+  EXPECT_EQ(1728u,analysis.getDataPoints(std::vector<QVariant>(1u,QVariant(5))).size());
+
+  // removal keeps the index in sync
+  EXPECT_TRUE(analysis.removeDataPoint(dataPoints[42]));
+  EXPECT_FALSE(analysis.getDataPointByUUID(dataPoints[42]));
+  EXPECT_TRUE(analysis.getDataPoints(dataPoints[42].variableValues()).empty());
+  EXPECT_TRUE(analysis.addDataPoint(dataPoints[42]));
+  EXPECT_TRUE(analysis.getDataPointByUUID(dataPoints[42]));
+
+  analysis.removeAllDataPoints();
+  EXPECT_FALSE(analysis.getDataPointByUUID(dataPoints[0]));
+  EXPECT_TRUE(analysis.getDataPoints(dataPoints[0].variableValues()).empty());
+}
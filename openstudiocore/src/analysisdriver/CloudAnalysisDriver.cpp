@@ -33,6 +33,8 @@
 #include <runmanager/lib/AdvancedStatus.hpp>
 #include <runmanager/lib/JSON.hpp>
 
+#include <utilities/cloud/OSServer_Impl.hpp>
+
 #include <utilities/core/Assert.hpp>
 #include <utilities/core/Containers.hpp>
 #include <utilities/core/System.hpp>
@@ -65,13 +67,18 @@ namespace detail {
       m_maxAnalysisNotRunningCount(0),
       m_dataPointsNotRunningCount(0),
       m_maxDataPointsNotRunningCount(0),
-      m_numJsonTries(0),
+      m_maxConcurrentDownloads(1),
+      m_batchStatusRequests(false),
       m_onlyProcessingDownloadRequests(true),
       m_noNewReadyDataPointsCount(0),
-      m_numDetailsTries(0),
       m_waitForAlreadyRunningDataPoints(false)
   {}
 
+  CloudAnalysisDriver_Impl::DownloadSlot::DownloadSlot(const OSServer& t_server)
+    : server(t_server),
+      numTries(0)
+  {}
+
   CloudSession CloudAnalysisDriver_Impl::session() const {
     return m_session;
   }
@@ -99,8 +106,10 @@ namespace detail {
                m_waitingQueue.size() +
                m_runningQueue.size() +
                m_jsonQueue.size() +
+               numBusyDownloadSlots(m_requestJson) +
                m_preDetailsQueue.size() +
-               m_detailsQueue.size();
+               m_detailsQueue.size() +
+               numBusyDownloadSlots(m_requestDetails);
     }
 
     return result;
@@ -133,6 +142,30 @@ namespace detail {
     return dataPoint.isTag(sessionTag());
   }
 
+  unsigned CloudAnalysisDriver_Impl::maxConcurrentDownloads() const {
+    return m_maxConcurrentDownloads;
+  }
+
+  bool CloudAnalysisDriver_Impl::batchStatusRequests() const {
+    return m_batchStatusRequests;
+  }
+
+  bool CloudAnalysisDriver_Impl::setMaxConcurrentDownloads(unsigned maxConcurrentDownloads) {
+    if ((maxConcurrentDownloads == 0u) || isRunning() || isDownloading()) {
+      return false;
+    }
+    m_maxConcurrentDownloads = maxConcurrentDownloads;
+    return true;
+  }
+
+  bool CloudAnalysisDriver_Impl::setBatchStatusRequests(bool batchStatusRequests) {
+    if (isRunning()) {
+      return false;
+    }
+    m_batchStatusRequests = batchStatusRequests;
+    return true;
+  }
+
   bool CloudAnalysisDriver_Impl::run(int msec) {
     if (requestRun()) {
       waitForFinished(msec);
@@ -177,7 +210,7 @@ namespace detail {
   }
 
   bool CloudAnalysisDriver_Impl::isDownloading() const {
-    return (m_requestJson || m_checkForResultsToDownload || m_requestDetails);
+    return (!m_requestJson.empty() || m_checkForResultsToDownload || !m_requestDetails.empty());
   }
 
   std::vector<std::string> CloudAnalysisDriver_Impl::errors() const {
@@ -691,11 +724,11 @@ namespace detail {
       
       // restart download process(es)
       if (!m_jsonQueue.empty()) {
-        OS_ASSERT(!m_requestJson);
+        OS_ASSERT(m_requestJson.empty());
         startDownloadingJson();
       }
       if (!m_preDetailsQueue.empty()) {
-        OS_ASSERT(!m_checkForResultsToDownload && !m_requestDetails);
+        OS_ASSERT(!m_checkForResultsToDownload && m_requestDetails.empty());
         startDownloadingDetails();
       }
 
@@ -932,63 +965,8 @@ namespace detail {
     }
 
     if (success) {
-      UUIDVector temp = m_monitorDataPoints->lastCompleteDataPointUUIDs();
-      std::set<UUID> completeUUIDs(temp.begin(),temp.end());
-      LOG(Debug,"There are " << completeUUIDs.size() << " complete DataPoints on the server.");
-      // complete points could be running or waiting
-      DataPointVector::iterator it = m_waitingQueue.begin();
-      while (it != m_waitingQueue.end()) {
-        if (completeUUIDs.find(it->uuid()) != completeUUIDs.end()) {
-          DataPoint completePoint = *it;
-          m_jsonQueue.push_back(completePoint);
-          it = m_waitingQueue.erase(it);
-          OS_ASSERT(completePoint.topLevelJob());
-          completePoint.topLevelJob()->setStatus(AdvancedStatusEnum(AdvancedStatusEnum::CopyingResultFiles));
-          // if go straight from waiting to complete, go ahead and show the data point as
-          // running rather than queued (or complete--which will happen once json downloaded and
-          // incorporated)
-          emit dataPointRunning(project().analysis().uuid(),completePoint.uuid());
-        }
-        else {
-          ++it;
-        }
-      }
-      it = m_runningQueue.begin();
-      while (it != m_runningQueue.end()) {
-        if (completeUUIDs.find(it->uuid()) != completeUUIDs.end()) {
-          DataPoint completePoint = *it;
-          m_jsonQueue.push_back(completePoint);
-          it = m_runningQueue.erase(it);
-          OS_ASSERT(completePoint.topLevelJob());
-          completePoint.topLevelJob()->setStatus(AdvancedStatusEnum(AdvancedStatusEnum::CopyingResultFiles));
-        }
-        else {
-          ++it;
-        }
-      }
-
-      if (!m_jsonQueue.empty() && !m_requestJson) {
-        LOG(Debug,"Starting Json downloading.");
-        startDownloadingJson();
-      }
-
-      if (m_waitingQueue.empty() && m_runningQueue.empty() && m_jsonQueue.empty()) {
-        // got what we wanted, move into downloading only phase
-        LOG(Debug,"All DataPoints complete. Stop monitoring.");
-        appendErrorsAndWarnings(*m_monitorDataPoints); // keep warnings
-        m_monitorDataPoints.reset();
-        checkForRunCompleteOrStopped();
-      }
-      else if (isStopping() && m_lastStopSuccess &&
-               (!m_waitForAlreadyRunningDataPoints || m_runningQueue.empty()))
-      {
-        LOG(Debug,"Stop monitoring as part of stopping the analysis.");
-        appendErrorsAndWarnings(*m_monitorDataPoints); // keep warnings
-        m_monitorDataPoints.reset();
-        checkForRunCompleteOrStopped();
-      }
-      else {
-        LOG(Info,"Waiting on " << m_waitingQueue.size() + m_runningQueue.size() << " DataPoints.");
+      updateCompleteDataPoints(m_monitorDataPoints->lastCompleteDataPointUUIDs());
+      if (m_monitorDataPoints) {
         // ask if analysis is running
         QTimer::singleShot(1000,this,SLOT(askIfAnalysisIsRunning()));
       }
@@ -1020,28 +998,10 @@ namespace detail {
     }
 
     if (success) {
-      if (m_monitorDataPoints->lastIsAnalysisRunning()) {
-        m_analysisNotRunningCount = 0;
-      }
-      else {
-        ++m_analysisNotRunningCount;
-      }
-
-      if (m_analysisNotRunningCount > m_maxAnalysisNotRunningCount) {
-        if (isStopping() && m_lastStopSuccess && m_waitForAlreadyRunningDataPoints) {
-          LOG(Debug,"Was trying to wait for DataPoints to finish running as part of the stopping process, but have timed out. Stop monitoring.");
-          appendErrorsAndWarnings(*m_monitorDataPoints); // keep warnings
-          m_monitorDataPoints.reset();
-          checkForRunCompleteOrStopped();
-        }
-        else {
-          logError("Server reports that the analysis is complete, but we are still waiting on DataPoints.");
-          success = false;
-        }
-      }
+      success = updateAnalysisRunning(m_monitorDataPoints->lastIsAnalysisRunning());
     }
 
-    if (success) {
+    if (success && m_monitorDataPoints) {
       LOG(Debug,"The analysis is still running. Ask for running data point uuids.");
       QTimer::singleShot(1000,this,SLOT(askForRunningDataPointUUIDs()));
     }
@@ -1070,45 +1030,11 @@ namespace detail {
       logError("Run failed during monitoring. Request asking server for the UUIDs of any running data points failed.");
     }
 
-    UUIDVector temp;
     if (success) {
-      temp = m_monitorDataPoints->lastRunningDataPointUUIDs();
-      LOG(Debug,"There are " << temp.size() << " DataPoints running on the server.");
-      if (temp.empty()) {
-        ++m_dataPointsNotRunningCount;
-      }
-      else {
-        m_dataPointsNotRunningCount = 0;
-      }
-
-      if (m_dataPointsNotRunningCount > m_maxDataPointsNotRunningCount) {
-        std::stringstream ss;
-        ss << "Server reported no DataPoints running " << m_dataPointsNotRunningCount
-           << " times in a row. Assuming that server has stopped working as expected.";
-        logError(ss.str());
-        ss.str("");
-        success = false;
-      }
+      success = updateRunningDataPoints(m_monitorDataPoints->lastRunningDataPointUUIDs());
     }
 
     if (success) {
-      // move DataPoints from waiting to running
-      std::set<UUID> runningUUIDs(temp.begin(),temp.end());
-      DataPointVector::iterator it = m_waitingQueue.begin();
-      while (it != m_waitingQueue.end()) {
-        if (runningUUIDs.find(it->uuid()) != runningUUIDs.end()) {
-          DataPoint nowRunning = *it;
-          m_runningQueue.push_back(nowRunning);
-          it = m_waitingQueue.erase(it);
-          OS_ASSERT(nowRunning.topLevelJob());
-          nowRunning.topLevelJob()->setStatus(AdvancedStatusEnum(AdvancedStatusEnum::Processing));
-          emit dataPointRunning(project().analysis().uuid(),nowRunning.uuid());
-        }
-        else {
-          ++it;
-        }
-      }
-
       // ask for complete data points
       QTimer::singleShot(1000,this,SLOT(askForCompleteDataPointUUIDs()));
     }
@@ -1129,28 +1055,85 @@ namespace detail {
     }
   }
 
+  void CloudAnalysisDriver_Impl::analysisStatusReturned(bool success) {
+    bool test = m_monitorDataPoints->disconnect(SIGNAL(requestProcessed(bool)),this,SLOT(analysisStatusReturned(bool)));
+    OS_ASSERT(test);
+
+    if (!success) {
+      logError("Run failed during monitoring. Request for the status of the analysis and its DataPoints failed.");
+    }
+
+    // the same reply lists the DataPoints whose details can be downloaded, so those do not have
+    // to wait for the next download_status request
+    if (success && !m_preDetailsQueue.empty()) {
+      if (!updateDownloadReadyDataPoints(m_monitorDataPoints->lastDownloadReadyDataPointUUIDs())) {
+        registerDownloadingDetailsFailure();
+      }
+    }
+
+    // same order as the unbatched cycle: running, then complete, then analysis running
+    if (success) {
+      success = updateRunningDataPoints(m_monitorDataPoints->lastRunningDataPointUUIDs());
+    }
+
+    if (success) {
+      updateCompleteDataPoints(m_monitorDataPoints->lastCompleteDataPointUUIDs());
+      if (!m_monitorDataPoints) {
+        return;
+      }
+      success = updateAnalysisRunning(m_monitorDataPoints->lastIsAnalysisRunning());
+    }
+
+    if (success && m_monitorDataPoints) {
+      QTimer::singleShot(1000,this,SLOT(askForAnalysisStatus()));
+    }
+
+    if (!success) {
+      registerMonitoringFailure();
+    }
+  }
+
+  void CloudAnalysisDriver_Impl::askForAnalysisStatus() {
+    bool test = m_monitorDataPoints->connect(SIGNAL(requestProcessed(bool)),this,SLOT(analysisStatusReturned(bool)),Qt::QueuedConnection);
+    OS_ASSERT(test);
+
+    bool success = m_monitorDataPoints->requestAnalysisStatus(project().analysis().uuid());
+
+    if (!success) {
+      registerMonitoringFailure();
+    }
+  }
+
   void CloudAnalysisDriver_Impl::jsonDownloadComplete(bool success) {
+    int index = downloadSlotIndex(m_requestJson,sender());
+    if (index < 0) {
+      // reply from a download that has since been abandoned
+      return;
+    }
+    DownloadSlot& slot = m_requestJson[index];
+    OS_ASSERT(slot.dataPoint);
 
     if (!success) {
-      ++m_numJsonTries;
-      if (m_numJsonTries >= 3) {
+      ++slot.numTries;
+      if (slot.numTries >= 3) {
         logError("Unable to retrieve high level results for DataPoint '" +
-                 m_jsonQueue.front().name() + "', " + removeBraces(m_jsonQueue.front().uuid()) +
+                 slot.dataPoint->name() + "', " + removeBraces(slot.dataPoint->uuid()) +
                  " from server.");
-        m_jsonFailures.push_back(m_jsonQueue.front());
-        m_jsonQueue.pop_front();
+        m_jsonFailures.push_back(*slot.dataPoint);
+        slot.dataPoint.reset();
       }
       else {
+        m_jsonRetries.push_back(index);
         QTimer::singleShot(1000,this,SLOT(requestJsonRetry()));
         return;
       }
     }
 
     if (success) {
-      std::string json = m_requestJson->lastDataPointJSON();
-      DataPoint toUpdate = m_jsonQueue.front();
+      std::string json = slot.server.lastDataPointJSON();
+      DataPoint toUpdate = *slot.dataPoint;
       LOG(Debug,"Downloaded Json file for DataPoint '" << toUpdate.name() << "'.");
-      m_jsonQueue.pop_front();
+      slot.dataPoint.reset();
       boost::optional<RunManager> rm = project().runManager();
       bool test = toUpdate.updateFromJSON(json,rm);
       project().save();
@@ -1164,7 +1147,7 @@ namespace detail {
       if (test) {
         if (toUpdate.runType() == DataPointRunType::CloudDetailed) {
           m_preDetailsQueue.push_back(toUpdate);
-          if (!(m_checkForResultsToDownload || m_requestDetails)) {
+          if (!(m_checkForResultsToDownload || !m_requestDetails.empty())) {
             startDownloadingDetails();
           }
         }
@@ -1173,17 +1156,13 @@ namespace detail {
         logWarning("Update of DataPoint '" + toUpdate.name() + "', " + removeBraces(toUpdate.uuid()) + " from JSON string failed.");
       }
 
-      if (m_jsonQueue.empty()) {
-        test = m_requestJson->disconnect(SIGNAL(requestProcessed(bool)),this,SLOT(jsonDownloadComplete(bool)));
-        OS_ASSERT(test);
-        appendErrorsAndWarnings(*m_requestJson);
-        m_requestJson.reset();
+      if (m_jsonQueue.empty() && (numBusyDownloadSlots(m_requestJson) == 0u)) {
+        finishDownloadingJson();
         checkForRunCompleteOrStopped();
       }
-      else {
+      else if (!m_jsonQueue.empty()) {
         LOG(Info,"Have " << m_jsonQueue.size() << " DataPoints' slim results to download.");
-        m_numJsonTries = 0;
-        success = requestNextJsonDownload();
+        success = requestNextJsonDownloads();
       }
     }
 
@@ -1193,8 +1172,20 @@ namespace detail {
   }
 
   void CloudAnalysisDriver_Impl::requestJsonRetry() {
-    LOG(Info,"Have " << m_jsonQueue.size() << " DataPoints' slim results to download (retrying a point).");
-    bool success = requestNextJsonDownload();
+    if (m_jsonRetries.empty()) {
+      // download process was abandoned while waiting
+      return;
+    }
+    unsigned index = m_jsonRetries.front();
+    m_jsonRetries.pop_front();
+    OS_ASSERT(index < m_requestJson.size());
+    DownloadSlot& slot = m_requestJson[index];
+    OS_ASSERT(slot.dataPoint);
+
+    LOG(Info,"Have " << m_jsonQueue.size() + numBusyDownloadSlots(m_requestJson)
+        << " DataPoints' slim results to download (retrying a point).");
+    bool success = slot.server.requestDataPointJSON(project().analysis().uuid(),
+                                                    slot.dataPoint->uuid());
 
     if (!success) {
       registerDownloadingJsonFailure();
@@ -1207,21 +1198,8 @@ namespace detail {
     }
 
     if (success) {
-      UUIDVector temp = m_checkForResultsToDownload->lastDownloadReadyDataPointUUIDs();
-      std::set<UUID> readyUUIDs(temp.begin(),temp.end());
-      LOG(Debug,"Received reply to request for data points ready for download. There are "
-          << readyUUIDs.size() << ".");
       unsigned initialSize = m_preDetailsQueue.size();
-      DataPointVector::iterator it = m_preDetailsQueue.begin();
-      while (it != m_preDetailsQueue.end()) {
-        if (readyUUIDs.find(it->uuid()) != readyUUIDs.end()) {
-          m_detailsQueue.push_back(*it);
-          it = m_preDetailsQueue.erase(it);
-        }
-        else {
-          ++it;
-        }
-      }
+      success = updateDownloadReadyDataPoints(m_checkForResultsToDownload->lastDownloadReadyDataPointUUIDs());
 
       if (m_preDetailsQueue.size() < initialSize) {
         m_noNewReadyDataPointsCount = 0;
@@ -1229,12 +1207,9 @@ namespace detail {
       else {
         ++m_noNewReadyDataPointsCount;
       }
+    }
 
-      if (!m_detailsQueue.empty() && !m_requestDetails) {
-        LOG(Debug,"Start details downloading.");
-        success = startActualDownloads();
-      }
-
+    if (success) {
       if (m_preDetailsQueue.empty()) {
         LOG(Debug,"All DataPoints whose details we want have details available for download.");
         bool test = m_checkForResultsToDownload->disconnect(SIGNAL(requestProcessed(bool)),this,SLOT(readyForDownloadDataPointUUIDsReturned(bool)));
@@ -1268,31 +1243,39 @@ namespace detail {
   }
 
   void CloudAnalysisDriver_Impl::detailsDownloadComplete(bool success) {
+    int index = downloadSlotIndex(m_requestDetails,sender());
+    if (index < 0) {
+      // reply from a download that has since been abandoned
+      return;
+    }
+    DownloadSlot& slot = m_requestDetails[index];
+    OS_ASSERT(slot.dataPoint);
 
-    success = success && m_requestDetails->lastDownloadDataPointSuccess();
+    success = success && slot.server.lastDownloadDataPointSuccess();
 
     if (!success) {
-      ++m_numDetailsTries;
-      if (m_numDetailsTries >= 3) {
+      ++slot.numTries;
+      if (slot.numTries >= 3) {
         logError("Unable to retrieve detailed results for DataPoint '" +
-                 m_detailsQueue.front().name() + "', " + removeBraces(m_detailsQueue.front().uuid()) +
+                 slot.dataPoint->name() + "', " + removeBraces(slot.dataPoint->uuid()) +
                  " from server.");
-        m_detailsFailures.push_back(m_detailsQueue.front());
-        m_detailsQueue.pop_front();
+        m_detailsFailures.push_back(*slot.dataPoint);
+        slot.dataPoint.reset();
       }
       else {
+        m_detailsRetries.push_back(index);
         QTimer::singleShot(1000,this,SLOT(requestDetailsRetry()));
         return;
       }
     }
 
     if (success) {
-      DataPoint toUpdate = m_detailsQueue.front();
+      DataPoint toUpdate = *slot.dataPoint;
       boost::optional<RunManager> rm = project().runManager();
       LOG(Debug,"Getting detailed results for DataPoint '" << toUpdate.name() << "'.");
       bool test = toUpdate.updateDetails(rm);
       project().save();
-      m_detailsQueue.pop_front();
+      slot.dataPoint.reset();
       emit resultsChanged();
       emit dataPointDetailsComplete(project().analysis().uuid(),toUpdate.uuid());
       emit iterationProgress(numCompleteDataPoints(),numDataPointsInIteration());
@@ -1300,18 +1283,15 @@ namespace detail {
         logWarning("Incorporation of DataPoint '" + toUpdate.name() + "', " + removeBraces(toUpdate.uuid()) + " files and details failed.");
       }
 
-      if (m_detailsQueue.empty()) {
-        test = m_requestDetails->disconnect(SIGNAL(requestProcessed(bool)),this,SLOT(detailsDownloadComplete(bool)));
-        OS_ASSERT(test);
-        appendErrorsAndWarnings(*m_requestDetails);
-        m_requestDetails.reset();
+      if (m_detailsQueue.empty() && (numBusyDownloadSlots(m_requestDetails) == 0u)) {
+        finishDownloadingDetails();
         m_lastDownloadDetailedResultsSuccess = true;
         emit detailedDownloadRequestsComplete(true);
         checkForRunCompleteOrStopped();
       }
-      else {
+      else if (!m_detailsQueue.empty()) {
         LOG(Info,"Have " << m_detailsQueue.size() << " DataPoints' detailed results to download.");
-        success = requestNextDetailsDownload();
+        success = requestNextDetailsDownloads();
       }
 
       if (!m_checkForResultsToDownload && !m_preDetailsQueue.empty()) {
@@ -1325,7 +1305,15 @@ namespace detail {
   }
 
   void CloudAnalysisDriver_Impl::requestDetailsRetry() {
-    bool success = requestNextDetailsDownload();
+    if (m_detailsRetries.empty()) {
+      // download process was abandoned while waiting
+      return;
+    }
+    unsigned index = m_detailsRetries.front();
+    m_detailsRetries.pop_front();
+    OS_ASSERT(index < m_requestDetails.size());
+
+    bool success = requestDetailsDownload(m_requestDetails[index]);
     if (!success) {
       registerDownloadingDetailsFailure();
     }
@@ -1368,9 +1356,11 @@ namespace detail {
     m_waitingQueue.clear();
     m_runningQueue.clear();
     m_jsonQueue.clear();
+    m_jsonRetries.clear();
     m_jsonFailures.clear();
     m_preDetailsQueue.clear();
     m_detailsQueue.clear();
+    m_detailsRetries.clear();
     m_detailsFailures.clear();
 
     m_processingQueuesInitialized = false;
@@ -1378,9 +1368,7 @@ namespace detail {
     m_maxAnalysisNotRunningCount = 0;
     m_dataPointsNotRunningCount = 0;
     m_maxDataPointsNotRunningCount = 0;
-    m_numJsonTries = 0;
     m_noNewReadyDataPointsCount = 0;
-    m_numDetailsTries = 0;
   }
 
   void CloudAnalysisDriver_Impl::logError(const std::string& error) {
@@ -1495,10 +1483,18 @@ namespace detail {
     if (OptionalUrl url = session().serverUrl()) {
       m_monitorDataPoints = OSServer(*url);
 
-      bool test = m_monitorDataPoints->connect(SIGNAL(requestProcessed(bool)),this,SLOT(runningDataPointUUIDsReturned(bool)),Qt::QueuedConnection);
-      OS_ASSERT(test);
+      if (m_batchStatusRequests) {
+        bool test = m_monitorDataPoints->connect(SIGNAL(requestProcessed(bool)),this,SLOT(analysisStatusReturned(bool)),Qt::QueuedConnection);
+        OS_ASSERT(test);
+
+        success = m_monitorDataPoints->requestAnalysisStatus(project().analysis().uuid());
+      }
+      else {
+        bool test = m_monitorDataPoints->connect(SIGNAL(requestProcessed(bool)),this,SLOT(runningDataPointUUIDsReturned(bool)),Qt::QueuedConnection);
+        OS_ASSERT(test);
 
-      success = m_monitorDataPoints->requestRunningDataPointUUIDs(project().analysis().uuid());
+        success = m_monitorDataPoints->requestRunningDataPointUUIDs(project().analysis().uuid());
+      }
     }
     else {
       logError("Cannot start monitoring this run because the CloudSession has been terminated.");
@@ -1512,13 +1508,13 @@ namespace detail {
       registerMonitoringFailure();
     }
 
-    if (!m_jsonQueue.empty() && !m_requestJson) {
+    if (!m_jsonQueue.empty() && m_requestJson.empty()) {
       OS_ASSERT(success);
       startDownloadingJson();
     }
 
     if (!(m_preDetailsQueue.empty() && m_detailsQueue.empty()) &&
-        !m_checkForResultsToDownload && !m_requestDetails)
+        !m_checkForResultsToDownload && m_requestDetails.empty())
     {
       OS_ASSERT(success);
       startDownloadingDetails();
@@ -1533,6 +1529,129 @@ namespace detail {
     return success;
   }
 
+  bool CloudAnalysisDriver_Impl::updateRunningDataPoints(const std::vector<UUID>& runningUUIDs) {
+    LOG(Debug,"There are " << runningUUIDs.size() << " DataPoints running on the server.");
+    if (runningUUIDs.empty()) {
+      ++m_dataPointsNotRunningCount;
+    }
+    else {
+      m_dataPointsNotRunningCount = 0;
+    }
+
+    if (m_dataPointsNotRunningCount > m_maxDataPointsNotRunningCount) {
+      std::stringstream ss;
+      ss << "Server reported no DataPoints running " << m_dataPointsNotRunningCount
+         << " times in a row. Assuming that server has stopped working as expected.";
+      logError(ss.str());
+      return false;
+    }
+
+    // move DataPoints from waiting to running
+    std::set<UUID> running(runningUUIDs.begin(),runningUUIDs.end());
+    DataPointVector::iterator it = m_waitingQueue.begin();
+    while (it != m_waitingQueue.end()) {
+      if (running.find(it->uuid()) != running.end()) {
+        DataPoint nowRunning = *it;
+        m_runningQueue.push_back(nowRunning);
+        it = m_waitingQueue.erase(it);
+        OS_ASSERT(nowRunning.topLevelJob());
+        nowRunning.topLevelJob()->setStatus(AdvancedStatusEnum(AdvancedStatusEnum::Processing));
+        emit dataPointRunning(project().analysis().uuid(),nowRunning.uuid());
+      }
+      else {
+        ++it;
+      }
+    }
+
+    return true;
+  }
+
+  void CloudAnalysisDriver_Impl::updateCompleteDataPoints(const std::vector<UUID>& completeUUIDs) {
+    std::set<UUID> complete(completeUUIDs.begin(),completeUUIDs.end());
+    LOG(Debug,"There are " << complete.size() << " complete DataPoints on the server.");
+    // complete points could be running or waiting
+    DataPointVector::iterator it = m_waitingQueue.begin();
+    while (it != m_waitingQueue.end()) {
+      if (complete.find(it->uuid()) != complete.end()) {
+        DataPoint completePoint = *it;
+        m_jsonQueue.push_back(completePoint);
+        it = m_waitingQueue.erase(it);
+        OS_ASSERT(completePoint.topLevelJob());
+        completePoint.topLevelJob()->setStatus(AdvancedStatusEnum(AdvancedStatusEnum::CopyingResultFiles));
+        // if go straight from waiting to complete, go ahead and show the data point as
+        // running rather than queued (or complete--which will happen once json downloaded and
+        // incorporated)
+        emit dataPointRunning(project().analysis().uuid(),completePoint.uuid());
+      }
+      else {
+        ++it;
+      }
+    }
+    it = m_runningQueue.begin();
+    while (it != m_runningQueue.end()) {
+      if (complete.find(it->uuid()) != complete.end()) {
+        DataPoint completePoint = *it;
+        m_jsonQueue.push_back(completePoint);
+        it = m_runningQueue.erase(it);
+        OS_ASSERT(completePoint.topLevelJob());
+        completePoint.topLevelJob()->setStatus(AdvancedStatusEnum(AdvancedStatusEnum::CopyingResultFiles));
+      }
+      else {
+        ++it;
+      }
+    }
+
+    if (!m_jsonQueue.empty()) {
+      LOG(Debug,"Starting (or topping up) Json downloading.");
+      startDownloadingJson();
+    }
+
+    if (m_waitingQueue.empty() && m_runningQueue.empty() &&
+        m_jsonQueue.empty() && (numBusyDownloadSlots(m_requestJson) == 0u))
+    {
+      // got what we wanted, move into downloading only phase
+      LOG(Debug,"All DataPoints complete. Stop monitoring.");
+      appendErrorsAndWarnings(*m_monitorDataPoints); // keep warnings
+      m_monitorDataPoints.reset();
+      checkForRunCompleteOrStopped();
+    }
+    else if (isStopping() && m_lastStopSuccess &&
+             (!m_waitForAlreadyRunningDataPoints || m_runningQueue.empty()))
+    {
+      LOG(Debug,"Stop monitoring as part of stopping the analysis.");
+      appendErrorsAndWarnings(*m_monitorDataPoints); // keep warnings
+      m_monitorDataPoints.reset();
+      checkForRunCompleteOrStopped();
+    }
+    else {
+      LOG(Info,"Waiting on " << m_waitingQueue.size() + m_runningQueue.size() << " DataPoints.");
+    }
+  }
+
+  bool CloudAnalysisDriver_Impl::updateAnalysisRunning(bool isAnalysisRunning) {
+    if (isAnalysisRunning) {
+      m_analysisNotRunningCount = 0;
+    }
+    else {
+      ++m_analysisNotRunningCount;
+    }
+
+    if (m_analysisNotRunningCount > m_maxAnalysisNotRunningCount) {
+      if (isStopping() && m_lastStopSuccess && m_waitForAlreadyRunningDataPoints) {
+        LOG(Debug,"Was trying to wait for DataPoints to finish running as part of the stopping process, but have timed out. Stop monitoring.");
+        appendErrorsAndWarnings(*m_monitorDataPoints); // keep warnings
+        m_monitorDataPoints.reset();
+        checkForRunCompleteOrStopped();
+      }
+      else {
+        logError("Server reports that the analysis is complete, but we are still waiting on DataPoints.");
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   void CloudAnalysisDriver_Impl::registerMonitoringFailure() {
     appendErrorsAndWarnings(*m_monitorDataPoints);
     m_monitorDataPoints.reset();
@@ -1542,18 +1661,12 @@ namespace detail {
   }
 
   bool CloudAnalysisDriver_Impl::startDownloadingJson() {
-    OS_ASSERT(!m_requestJson);
     OS_ASSERT(!m_jsonQueue.empty());
 
     bool success(false);
 
-    if (OptionalUrl url = session().serverUrl()) {
-      m_requestJson = OSServer(*url);
-
-      bool test = m_requestJson->connect(SIGNAL(requestProcessed(bool)),this,SLOT(jsonDownloadComplete(bool)),Qt::QueuedConnection);
-      OS_ASSERT(test);
-
-      success = requestNextJsonDownload();
+    if (session().serverUrl()) {
+      success = requestNextJsonDownloads();
     }
     else {
       logError("Cannot start download of DataPoint because the CloudSession has been terminated.");
@@ -1569,20 +1682,37 @@ namespace detail {
     return success;
   }
 
-  bool CloudAnalysisDriver_Impl::requestNextJsonDownload() {
-    OS_ASSERT(m_requestJson);
-    return m_requestJson->requestDataPointJSON(project().analysis().uuid(),
-                                               m_jsonQueue.front().uuid());
+  bool CloudAnalysisDriver_Impl::requestNextJsonDownloads() {
+    bool result(true);
+    while (result && !m_jsonQueue.empty()) {
+      DownloadSlot* slot = idleDownloadSlot(m_requestJson,SLOT(jsonDownloadComplete(bool)));
+      if (!slot) {
+        // window is full
+        break;
+      }
+      slot->dataPoint = m_jsonQueue.front();
+      slot->numTries = 0;
+      m_jsonQueue.pop_front();
+      result = slot->server.requestDataPointJSON(project().analysis().uuid(),
+                                                 slot->dataPoint->uuid());
+    }
+    return result;
+  }
+
+  void CloudAnalysisDriver_Impl::finishDownloadingJson() {
+    OS_ASSERT(m_jsonQueue.empty());
+    clearDownloadSlots(m_requestJson,m_jsonQueue,SLOT(jsonDownloadComplete(bool)));
+    m_jsonRetries.clear();
   }
 
   void CloudAnalysisDriver_Impl::registerDownloadingJsonFailure() {
-    appendErrorsAndWarnings(*m_requestJson);
-    m_requestJson.reset();
+    clearDownloadSlots(m_requestJson,m_jsonQueue,SLOT(jsonDownloadComplete(bool)));
+    m_jsonRetries.clear();
   }
 
   bool CloudAnalysisDriver_Impl::startDownloadingDetails() {
     OS_ASSERT(!m_checkForResultsToDownload);
-    OS_ASSERT(!m_requestDetails);
+    OS_ASSERT(m_requestDetails.empty());
     OS_ASSERT(!(m_preDetailsQueue.empty() && m_detailsQueue.empty()));
 
     bool success(true);
@@ -1632,18 +1762,12 @@ namespace detail {
   }
 
   bool CloudAnalysisDriver_Impl::startActualDownloads() {
-    OS_ASSERT(!m_requestDetails);
     OS_ASSERT(!m_detailsQueue.empty());
 
     bool success(false);
 
-    if (OptionalUrl url = session().serverUrl()) {
-      m_requestDetails = OSServer(*url);
-
-      bool test = m_requestDetails->connect(SIGNAL(requestProcessed(bool)),this,SLOT(detailsDownloadComplete(bool)),Qt::QueuedConnection);
-      OS_ASSERT(test);
-
-      success = requestNextDetailsDownload();
+    if (session().serverUrl()) {
+      success = requestNextDetailsDownloads();
     }
     else {
       logError("Cannot start downloading data point details because the CloudSession has been terminated.");
@@ -1657,9 +1781,50 @@ namespace detail {
     return success;
   }
 
-  bool CloudAnalysisDriver_Impl::requestNextDetailsDownload() {
-    OS_ASSERT(m_requestDetails);
-    DataPoint needsDetails = m_detailsQueue.front();
+  bool CloudAnalysisDriver_Impl::updateDownloadReadyDataPoints(const std::vector<UUID>& readyUUIDs) {
+    std::set<UUID> ready(readyUUIDs.begin(),readyUUIDs.end());
+    LOG(Debug,"There are " << ready.size() << " DataPoints ready for download on the server.");
+    DataPointVector::iterator it = m_preDetailsQueue.begin();
+    while (it != m_preDetailsQueue.end()) {
+      if (ready.find(it->uuid()) != ready.end()) {
+        m_detailsQueue.push_back(*it);
+        it = m_preDetailsQueue.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    bool success(true);
+    if (!m_detailsQueue.empty()) {
+      LOG(Debug,"Start (or top up) details downloading.");
+      success = startActualDownloads();
+    }
+
+    // don't register failure here. calling method will do so.
+
+    return success;
+  }
+
+  bool CloudAnalysisDriver_Impl::requestNextDetailsDownloads() {
+    bool result(true);
+    while (result && !m_detailsQueue.empty()) {
+      DownloadSlot* slot = idleDownloadSlot(m_requestDetails,SLOT(detailsDownloadComplete(bool)));
+      if (!slot) {
+        // window is full
+        break;
+      }
+      slot->dataPoint = m_detailsQueue.front();
+      slot->numTries = 0;
+      m_detailsQueue.pop_front();
+      result = requestDetailsDownload(*slot);
+    }
+    return result;
+  }
+
+  bool CloudAnalysisDriver_Impl::requestDetailsDownload(DownloadSlot& slot) {
+    OS_ASSERT(slot.dataPoint);
+    DataPoint needsDetails = *slot.dataPoint;
     openstudio::path dataPointFolderName = toPath("dataPoint_" + removeBraces(needsDetails.uuid()));
     if (OptionalDataPointRecord dataPointRecord = project().projectDatabase().getObjectRecordByHandle<DataPointRecord>(needsDetails.uuid())) {
       std::stringstream ss;
@@ -1679,9 +1844,15 @@ namespace detail {
     needsDetails.setDirectory(resultsDirectory);
     project().save();
     emit resultsChanged();
-    return m_requestDetails->startDownloadDataPoint(project().analysis().uuid(),
-                                                    needsDetails.uuid(),
-                                                    resultsDirectory / toPath("dataPoint.zip"));
+    return slot.server.startDownloadDataPoint(project().analysis().uuid(),
+                                              needsDetails.uuid(),
+                                              resultsDirectory / toPath("dataPoint.zip"));
+  }
+
+  void CloudAnalysisDriver_Impl::finishDownloadingDetails() {
+    OS_ASSERT(m_detailsQueue.empty());
+    clearDownloadSlots(m_requestDetails,m_detailsQueue,SLOT(detailsDownloadComplete(bool)));
+    m_detailsRetries.clear();
   }
 
   void CloudAnalysisDriver_Impl::registerDownloadingDetailsFailure() {
@@ -1689,16 +1860,75 @@ namespace detail {
       appendErrorsAndWarnings(*m_checkForResultsToDownload);
       m_checkForResultsToDownload.reset();
     }
-    if (m_requestDetails) {
-      appendErrorsAndWarnings(*m_requestDetails);
-      m_requestDetails.reset();
-    }
+    clearDownloadSlots(m_requestDetails,m_detailsQueue,SLOT(detailsDownloadComplete(bool)));
+    m_detailsRetries.clear();
     if (m_onlyProcessingDownloadRequests) {
       OS_ASSERT(!m_lastDownloadDetailedResultsSuccess);
       emit detailedDownloadRequestsComplete(m_lastDownloadDetailedResultsSuccess);
     }
   }
 
+  CloudAnalysisDriver_Impl::DownloadSlot* CloudAnalysisDriver_Impl::idleDownloadSlot(
+      std::vector<DownloadSlot>& slots,
+      const char* completeSlot)
+  {
+    for (std::vector<DownloadSlot>::iterator it = slots.begin(), itEnd = slots.end(); it != itEnd; ++it) {
+      if (!it->dataPoint) {
+        return &(*it);
+      }
+    }
+
+    if (slots.size() < m_maxConcurrentDownloads) {
+      if (OptionalUrl url = session().serverUrl()) {
+        slots.push_back(DownloadSlot(OSServer(*url)));
+        bool test = slots.back().server.connect(SIGNAL(requestProcessed(bool)),this,completeSlot,Qt::QueuedConnection);
+        OS_ASSERT(test);
+        return &slots.back();
+      }
+    }
+
+    return 0;
+  }
+
+  void CloudAnalysisDriver_Impl::clearDownloadSlots(std::vector<DownloadSlot>& slots,
+                                                    std::deque<analysis::DataPoint>& queue,
+                                                    const char* completeSlot)
+  {
+    // put points back in their original order
+    for (std::vector<DownloadSlot>::reverse_iterator it = slots.rbegin(), itEnd = slots.rend(); it != itEnd; ++it) {
+      it->server.disconnect(SIGNAL(requestProcessed(bool)),this,completeSlot);
+      appendErrorsAndWarnings(it->server);
+      if (it->dataPoint) {
+        queue.push_front(*(it->dataPoint));
+      }
+    }
+    slots.clear();
+  }
+
+  int CloudAnalysisDriver_Impl::downloadSlotIndex(const std::vector<DownloadSlot>& slots,
+                                                  const QObject* server)
+  {
+    if (!server) {
+      return -1;
+    }
+    for (unsigned i = 0, n = slots.size(); i < n; ++i) {
+      if (slots[i].server.getImpl<openstudio::detail::OSServer_Impl>().get() == server) {
+        return int(i);
+      }
+    }
+    return -1;
+  }
+
+  unsigned CloudAnalysisDriver_Impl::numBusyDownloadSlots(const std::vector<DownloadSlot>& slots) {
+    unsigned result(0);
+    BOOST_FOREACH(const DownloadSlot& slot,slots) {
+      if (slot.dataPoint) {
+        ++result;
+      }
+    }
+    return result;
+  }
+
   void CloudAnalysisDriver_Impl::registerStopRequestFailure() {
     appendErrorsAndWarnings(*m_requestStop);
     m_requestStop.reset();
@@ -1761,12 +1991,22 @@ namespace detail {
     if (std::find(m_jsonQueue.begin(),m_jsonQueue.end(),dataPoint) != m_jsonQueue.end()) {
       return true;
     }
+    BOOST_FOREACH(const DownloadSlot& slot,m_requestJson) {
+      if (slot.dataPoint && (*slot.dataPoint == dataPoint)) {
+        return true;
+      }
+    }
     if (std::find(m_preDetailsQueue.begin(),m_preDetailsQueue.end(),dataPoint) != m_preDetailsQueue.end()) {
       return true;
     }
     if (std::find(m_detailsQueue.begin(),m_detailsQueue.end(),dataPoint) != m_detailsQueue.end()) {
       return true;
     }
+    BOOST_FOREACH(const DownloadSlot& slot,m_requestDetails) {
+      if (slot.dataPoint && (*slot.dataPoint == dataPoint)) {
+        return true;
+      }
+    }
     return false;
   }
 
@@ -1833,6 +2073,22 @@ bool CloudAnalysisDriver::inSession(const DataPoint& dataPoint) const {
   return getImpl<detail::CloudAnalysisDriver_Impl>()->inSession(dataPoint);
 }
 
+unsigned CloudAnalysisDriver::maxConcurrentDownloads() const {
+  return getImpl<detail::CloudAnalysisDriver_Impl>()->maxConcurrentDownloads();
+}
+
+bool CloudAnalysisDriver::batchStatusRequests() const {
+  return getImpl<detail::CloudAnalysisDriver_Impl>()->batchStatusRequests();
+}
+
+bool CloudAnalysisDriver::setMaxConcurrentDownloads(unsigned maxConcurrentDownloads) {
+  return getImpl<detail::CloudAnalysisDriver_Impl>()->setMaxConcurrentDownloads(maxConcurrentDownloads);
+}
+
+bool CloudAnalysisDriver::setBatchStatusRequests(bool batchStatusRequests) {
+  return getImpl<detail::CloudAnalysisDriver_Impl>()->setBatchStatusRequests(batchStatusRequests);
+}
+
 bool CloudAnalysisDriver::run(int msec) {
   return getImpl<detail::CloudAnalysisDriver_Impl>()->run(msec);
 }
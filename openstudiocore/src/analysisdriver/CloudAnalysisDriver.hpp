@@ -95,6 +95,31 @@ class ANALYSISDRIVER_API CloudAnalysisDriver {
    *  was with session() (not local, and not another CloudSession). */
   bool inSession(const analysis::DataPoint& dataPoint) const;
 
+  /** Returns the maximum number of slim (JSON) and, separately, detailed result downloads
+   *  that may be in flight at once. The default is 1, which downloads results one DataPoint
+   *  at a time. */
+  unsigned maxConcurrentDownloads() const;
+
+  /** Returns true if each monitoring cycle asks the server for the status of the analysis
+   *  and all of its DataPoints in a single request, rather than making separate requests
+   *  for whether the analysis is running, which DataPoints are running, and which are
+   *  complete. The same reply also says which DataPoints' detailed results are ready, so
+   *  those are downloaded without waiting for a separate request. This needs a server that
+   *  answers "/analyses/<id>/status.json" with all of that in one reply, which the current
+   *  OpenStudio server does not do, so the default is false. */
+  bool batchStatusRequests() const;
+
+  //@}
+  /** @name Setters */
+  //@{
+
+  /** Sets the size of the download window. Returns false if maxConcurrentDownloads is 0, or
+   *  if isRunning() or isDownloading(). */
+  bool setMaxConcurrentDownloads(unsigned maxConcurrentDownloads);
+
+  /** Turns single-request status polling on or off. Returns false if isRunning(). */
+  bool setBatchStatusRequests(bool batchStatusRequests);
+
   //@}
   /** @name Blocking Class Members */
   //@{
@@ -36,6 +36,7 @@
 #include <boost/enable_shared_from_this.hpp>
 
 #include <deque>
+#include <map>
 
 namespace openstudio {
 
@@ -92,6 +93,31 @@ namespace detail {
      *  was with session() (not local, and not another CloudSession). */
     bool inSession(const analysis::DataPoint& dataPoint) const;
 
+    /** Returns the maximum number of slim (JSON) and, separately, detailed result downloads
+     *  that may be in flight at once. The default is 1, which downloads results one DataPoint
+     *  at a time. */
+    unsigned maxConcurrentDownloads() const;
+
+    /** Returns true if each monitoring cycle asks the server for the status of the analysis
+     *  and all of its DataPoints in a single request, rather than making separate requests
+     *  for whether the analysis is running, which DataPoints are running, and which are
+     *  complete. The same reply also says which DataPoints' detailed results are ready, so
+     *  those are downloaded without waiting for a separate request. This needs a server that
+     *  answers "/analyses/<id>/status.json" with all of that in one reply, which the current
+     *  OpenStudio server does not do, so the default is false. */
+    bool batchStatusRequests() const;
+
+    //@}
+    /** @name Setters */
+    //@{
+
+    /** Sets the size of the download window. Returns false if maxConcurrentDownloads is 0, or
+     *  if isRunning() or isDownloading(). */
+    bool setMaxConcurrentDownloads(unsigned maxConcurrentDownloads);
+
+    /** Turns single-request status polling on or off. Returns false if isRunning(). */
+    bool setBatchStatusRequests(bool batchStatusRequests);
+
     //@}
     /** @name Blocking Class Members */
     //@{
@@ -274,6 +300,11 @@ namespace detail {
 
      void askForCompleteDataPointUUIDs();
 
+     // if batchStatusRequests(), the three requests above are replaced by this one
+     void analysisStatusReturned(bool success);
+
+     void askForAnalysisStatus();
+
      // DOWNLOADING ============================================================
 
      // slim results received
@@ -305,6 +336,16 @@ namespace detail {
    private:
     REGISTER_LOGGER("openstudio.analysisdriver.CloudAnalysisDriver");
 
+    /** An OSServer dedicated to one download at a time, and the DataPoint whose results it
+     *  is currently retrieving (if any). */
+    struct DownloadSlot {
+      DownloadSlot(const OSServer& t_server);
+
+      OSServer server;
+      boost::optional<analysis::DataPoint> dataPoint;
+      unsigned numTries;
+    };
+
     CloudSession m_session;
     SimpleProject m_project;
 
@@ -328,16 +369,18 @@ namespace detail {
     // the following are used in starting the run and in monitoring
     unsigned m_dataPointsNotRunningCount;
     unsigned m_maxDataPointsNotRunningCount;
+    unsigned m_maxConcurrentDownloads;
+    bool m_batchStatusRequests;
 
     // watch for complete data points
     boost::optional<OSServer> m_monitorDataPoints;
     std::vector<analysis::DataPoint> m_waitingQueue;
     std::vector<analysis::DataPoint> m_runningQueue;
 
-    // download slim data points
-    boost::optional<OSServer> m_requestJson;
+    // download slim data points (at most m_maxConcurrentDownloads at a time)
+    std::vector<DownloadSlot> m_requestJson;
     std::deque<analysis::DataPoint> m_jsonQueue;
-    unsigned m_numJsonTries;
+    std::deque<unsigned> m_jsonRetries; // indices into m_requestJson waiting to retry
     std::vector<analysis::DataPoint> m_jsonFailures;
 
     // check to see if details can be downloaded
@@ -347,10 +390,10 @@ namespace detail {
                                            // run or download of details
     unsigned m_noNewReadyDataPointsCount;
 
-    // download detailed results
-    boost::optional<OSServer> m_requestDetails;
+    // download detailed results (at most m_maxConcurrentDownloads at a time)
+    std::vector<DownloadSlot> m_requestDetails;
     std::deque<analysis::DataPoint> m_detailsQueue;
-    unsigned m_numDetailsTries;
+    std::deque<unsigned> m_detailsRetries; // indices into m_requestDetails waiting to retry
     std::vector<analysis::DataPoint> m_detailsFailures;
 
     // stop analysis
@@ -367,18 +410,38 @@ namespace detail {
     void registerRunRequestFailure();
     bool postNextDataPoint();
     bool startMonitoring();
+    bool updateRunningDataPoints(const std::vector<UUID>& runningUUIDs);
+    void updateCompleteDataPoints(const std::vector<UUID>& completeUUIDs);
+    bool updateAnalysisRunning(bool isAnalysisRunning);
     void registerMonitoringFailure();
 
     bool startDownloadingJson();
-    bool requestNextJsonDownload();
+    bool requestNextJsonDownloads();
+    void finishDownloadingJson();
     void registerDownloadingJsonFailure();
 
     bool startDownloadingDetails();
     bool startDetailsReadyMonitoring();
     bool startActualDownloads();
-    bool requestNextDetailsDownload();
+    /** Moves the DataPoints in m_preDetailsQueue that are listed in readyUUIDs to
+     *  m_detailsQueue, and starts (or tops up) their downloads. */
+    bool updateDownloadReadyDataPoints(const std::vector<UUID>& readyUUIDs);
+    bool requestNextDetailsDownloads();
+    bool requestDetailsDownload(DownloadSlot& slot);
+    void finishDownloadingDetails();
     void registerDownloadingDetailsFailure();
 
+    /** Returns an idle slot, adding one connected to completeSlot if there are fewer than
+     *  maxConcurrentDownloads(). Returns 0 if the window is full. The pointer is only valid
+     *  until slots is next modified. */
+    DownloadSlot* idleDownloadSlot(std::vector<DownloadSlot>& slots, const char* completeSlot);
+    /** Puts the DataPoints of busy slots back at the front of queue and releases all slots. */
+    void clearDownloadSlots(std::vector<DownloadSlot>& slots,
+                            std::deque<analysis::DataPoint>& queue,
+                            const char* completeSlot);
+    static int downloadSlotIndex(const std::vector<DownloadSlot>& slots, const QObject* server);
+    static unsigned numBusyDownloadSlots(const std::vector<DownloadSlot>& slots);
+
     void registerStopRequestFailure();
 
     void checkForRunCompleteOrStopped();
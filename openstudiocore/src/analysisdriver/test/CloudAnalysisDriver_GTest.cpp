@@ -0,0 +1,103 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include <analysisdriver/test/AnalysisDriverFixture.hpp>
+
+#include <analysisdriver/CloudAnalysisDriver.hpp>
+#include <analysisdriver/SimpleProject.hpp>
+
+#include <project/ProjectDatabase.hpp>
+
+#include <analysis/Analysis.hpp>
+#include <analysis/DataPoint.hpp>
+#include <analysis/Problem.hpp>
+
+#include <model/Model.hpp>
+
+#include <utilities/cloud/VagrantProvider.hpp>
+#include <utilities/cloud/test/MockOSServer.hpp>
+#include <utilities/core/FileReference.hpp>
+
+#include <boost/foreach.hpp>
+
+using namespace openstudio;
+using namespace openstudio::analysis;
+using namespace openstudio::analysisdriver;
+
+TEST_F(AnalysisDriverFixture,CloudAnalysisDriver_BatchedStatusAndDownloadWindow) {
+  SimpleProject project = getCleanSimpleProject("CloudAnalysisDriver_BatchedStatusAndDownloadWindow");
+  Analysis analysis = project.analysis();
+
+  Problem problem = retrieveProblem("Continuous",true,false);
+  analysis.setProblem(problem);
+
+  model::Model model = model::exampleModel();
+  openstudio::path p = toPath("./example.osm");
+  model.save(p,true);
+  analysis.setSeed(FileReference(p));
+
+  std::vector<QVariant> values;
+  values.push_back(QVariant(double(0.0)));
+  values.push_back(QVariant(double(0.7234532)));
+  values.push_back(QVariant(int(0)));
+  std::vector<UUID> dataPointUUIDs;
+  for (unsigned i = 0; i < 8; ++i) {
+    values[0] = QVariant(double(20.0 + 10.0 * i));
+    OptionalDataPoint dataPoint = problem.createDataPoint(values);
+    ASSERT_TRUE(dataPoint);
+    ASSERT_TRUE(analysis.addDataPoint(*dataPoint));
+    dataPointUUIDs.push_back(dataPoint->uuid());
+  }
+  project.save();
+
+  // every reply is held for 100 ms so that downloads overlap if the window allows it
+  MockOSServer mock(project.projectDatabase().handle(),analysis.uuid(),dataPointUUIDs,100);
+  ASSERT_FALSE(mock.url().isEmpty());
+  // waiting for the analysis to start and for a running DataPoint take the first two
+  // status requests, so the first monitoring request reports all of the DataPoints complete
+  mock.completeDataPointsAfter(3);
+
+  VagrantSession session(toString(createUUID()),mock.url(),UrlVector());
+  CloudAnalysisDriver driver(session,project);
+  EXPECT_TRUE(driver.setBatchStatusRequests(true));
+  EXPECT_TRUE(driver.setMaxConcurrentDownloads(3));
+
+  EXPECT_TRUE(driver.run(120000));
+  EXPECT_FALSE(driver.isRunning());
+  EXPECT_FALSE(driver.isDownloading());
+  EXPECT_EQ(8u,driver.numDataPointsInIteration());
+  EXPECT_EQ(0u,driver.numIncompleteDataPoints());
+
+  // monitoring never fell back to the per-state requests
+  std::string analysisResource = "/analyses/" + removeBraces(analysis.uuid());
+  EXPECT_EQ(1u,mock.numRequests(analysisResource + "/status.json?jobs=started"));
+  EXPECT_EQ(0u,mock.numRequests(analysisResource + "/status.json?jobs=completed"));
+  EXPECT_EQ(0u,mock.numRequests(analysisResource + "/download_status.json?downloads=completed"));
+  // three unfiltered status requests come before monitoring. the first monitoring request
+  // covered all eight DataPoints finishing; later ones only wait for the downloads to drain
+  EXPECT_LE(mock.numRequests(analysisResource + "/status.json"),6u);
+
+  // each slim result was downloaded once, never more than three at a time
+  BOOST_FOREACH(const UUID& dataPointUUID,dataPointUUIDs) {
+    EXPECT_EQ(1u,mock.numRequests("/data_points/" + removeBraces(dataPointUUID) + ".json"));
+  }
+  EXPECT_LE(mock.maxConcurrentDataPointRequests(),3u);
+  EXPECT_GE(mock.maxConcurrentDataPointRequests(),2u);
+}
@@ -0,0 +1,182 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <benchmarks/BenchmarkRunner.hpp>
+
+#include <utilities/core/String.hpp>
+
+#include <OpenStudio.hxx>
+
+#include <qjson/serializer.h>
+
+#include <QVariant>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+
+namespace openstudio {
+namespace benchmarks {
+
+  double BenchmarkResult::min() const
+  {
+    if (times.empty()) {
+      return 0.0;
+    }
+    return *std::min_element(times.begin(), times.end());
+  }
+
+  double BenchmarkResult::max() const
+  {
+    if (times.empty()) {
+      return 0.0;
+    }
+    return *std::max_element(times.begin(), times.end());
+  }
+
+  double BenchmarkResult::mean() const
+  {
+    if (times.empty()) {
+      return 0.0;
+    }
+    return std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+  }
+
+  double BenchmarkResult::median() const
+  {
+    if (times.empty()) {
+      return 0.0;
+    }
+    std::vector<double> sorted(times);
+    std::sort(sorted.begin(), sorted.end());
+    unsigned n = sorted.size();
+    if (n % 2 == 1) {
+      return sorted[n / 2];
+    }
+    return 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+  }
+
+  BenchmarkRunner::BenchmarkRunner(unsigned warmUpIterations, unsigned iterations)
+    : m_warmUpIterations(warmUpIterations), m_iterations(std::max(iterations, 1u))
+  {}
+
+  void BenchmarkRunner::addParameter(const std::string& name, const std::string& value)
+  {
+    m_parameters.push_back(std::make_pair(name, value));
+  }
+
+  void BenchmarkRunner::addCase(const std::string& name, const Function& setup, const Function& run)
+  {
+    Case c;
+    c.name = name;
+    c.setup = setup;
+    c.run = run;
+    m_cases.push_back(c);
+  }
+
+  void BenchmarkRunner::addCase(const std::string& name, const Function& run)
+  {
+    addCase(name, Function(), run);
+  }
+
+  std::vector<BenchmarkResult> BenchmarkRunner::run(const std::string& filter, std::ostream& log) const
+  {
+    using boost::posix_time::microsec_clock;
+    using boost::posix_time::ptime;
+
+    std::vector<BenchmarkResult> results;
+    BOOST_FOREACH(const Case& c, m_cases) {
+      if (!filter.empty() && (c.name.find(filter) == std::string::npos)) {
+        continue;
+      }
+
+      log << c.name << ": " << std::flush;
+      BenchmarkResult result;
+      result.name = c.name;
+      try {
+        for (unsigned i = 0; i < m_warmUpIterations; ++i) {
+          if (c.setup) {
+            c.setup();
+          }
+          c.run();
+        }
+
+        for (unsigned i = 0; i < m_iterations; ++i) {
+          if (c.setup) {
+            c.setup();
+          }
+          ptime start = microsec_clock::universal_time();
+          c.run();
+          ptime end = microsec_clock::universal_time();
+          result.times.push_back(1.0e-6 * (end - start).total_microseconds());
+        }
+      }
+      catch (const std::exception& e) {
+        log << "failed, " << e.what() << std::endl;
+        continue;
+      }
+
+      log << "median " << result.median() << "s, min " << result.min() << "s, max " << result.max() << "s" << std::endl;
+      results.push_back(result);
+    }
+    return results;
+  }
+
+  void BenchmarkRunner::writeJSON(const std::vector<BenchmarkResult>& results, std::ostream& os) const
+  {
+    QVariantMap parameters;
+    typedef std::pair<std::string, std::string> ParameterType;
+    BOOST_FOREACH(const ParameterType& parameter, m_parameters) {
+      parameters.insert(toQString(parameter.first), toQString(parameter.second));
+    }
+
+    QVariantList cases;
+    BOOST_FOREACH(const BenchmarkResult& result, results) {
+      QVariantList times;
+      BOOST_FOREACH(double time, result.times) {
+        times.push_back(time);
+      }
+
+      QVariantMap c;
+      c.insert("name", toQString(result.name));
+      c.insert("times", times);
+      c.insert("min", result.min());
+      c.insert("max", result.max());
+      c.insert("mean", result.mean());
+      c.insert("median", result.median());
+      cases.push_back(c);
+    }
+
+    QVariantMap document;
+    document.insert("openstudio_version", toQString(openStudioVersion()));
+    document.insert("parameters", parameters);
+    document.insert("warm_up_iterations", m_warmUpIterations);
+    document.insert("iterations", m_iterations);
+    document.insert("results", cases);
+
+    QJson::Serializer serializer;
+    serializer.setIndentMode(QJson::IndentFull);
+    os << serializer.serialize(document).constData() << std::endl;
+  }
+
+} // benchmarks
+} // openstudio
@@ -0,0 +1,85 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef BENCHMARKS_BENCHMARKRUNNER_HPP
+#define BENCHMARKS_BENCHMARKRUNNER_HPP
+
+#include <boost/function.hpp>
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openstudio {
+namespace benchmarks {
+
+  /** Wall clock timings of one benchmark case, in seconds. */
+  struct BenchmarkResult {
+    std::string name;
+    std::vector<double> times;
+
+    double min() const;
+    double max() const;
+    double mean() const;
+    double median() const;
+  };
+
+  /** BenchmarkRunner runs named cases a fixed number of times after a number of untimed warm up
+   *  runs, and writes the results as JSON so that they can be compared between releases. */
+  class BenchmarkRunner {
+   public:
+    typedef boost::function<void ()> Function;
+
+    BenchmarkRunner(unsigned warmUpIterations, unsigned iterations);
+
+    /** Describes the conditions of the run, e.g. the size of the generated model. Written to
+     *  the parameters section of the JSON output. */
+    void addParameter(const std::string& name, const std::string& value);
+
+    /** Registers a case. setup is called before every run, warm up or timed, and is not timed. */
+    void addCase(const std::string& name, const Function& setup, const Function& run);
+
+    /** Registers a case without setup. */
+    void addCase(const std::string& name, const Function& run);
+
+    /** Runs all cases whose name contains filter, in the order they were added. Progress is
+     *  written to log. A case that throws is reported to log and left out of the results. */
+    std::vector<BenchmarkResult> run(const std::string& filter, std::ostream& log) const;
+
+    /** Writes results, along with the parameters and iteration counts, as a JSON document. */
+    void writeJSON(const std::vector<BenchmarkResult>& results, std::ostream& os) const;
+
+   private:
+    struct Case {
+      std::string name;
+      Function setup;
+      Function run;
+    };
+
+    unsigned m_warmUpIterations;
+    unsigned m_iterations;
+    std::vector<std::pair<std::string, std::string> > m_parameters;
+    std::vector<Case> m_cases;
+  };
+
+} // benchmarks
+} // openstudio
+
+#endif // BENCHMARKS_BENCHMARKRUNNER_HPP
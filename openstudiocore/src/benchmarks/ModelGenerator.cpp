@@ -0,0 +1,186 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <benchmarks/ModelGenerator.hpp>
+
+#include <model/AirLoopHVAC.hpp>
+#include <model/AirTerminalSingleDuctUncontrolled.hpp>
+#include <model/Building.hpp>
+#include <model/CoilHeatingGas.hpp>
+#include <model/Construction.hpp>
+#include <model/DefaultConstructionSet.hpp>
+#include <model/DefaultSubSurfaceConstructions.hpp>
+#include <model/DefaultSurfaceConstructions.hpp>
+#include <model/FanConstantVolume.hpp>
+#include <model/FenestrationMaterial.hpp>
+#include <model/Lights.hpp>
+#include <model/LightsDefinition.hpp>
+#include <model/Node.hpp>
+#include <model/OpaqueMaterial.hpp>
+#include <model/People.hpp>
+#include <model/PeopleDefinition.hpp>
+#include <model/ScheduleDay.hpp>
+#include <model/ScheduleRule.hpp>
+#include <model/ScheduleRuleset.hpp>
+#include <model/SetpointManagerSingleZoneReheat.hpp>
+#include <model/SimpleGlazing.hpp>
+#include <model/Space.hpp>
+#include <model/StandardOpaqueMaterial.hpp>
+#include <model/StraightComponent.hpp>
+#include <model/Surface.hpp>
+#include <model/ThermalZone.hpp>
+#include <model/ThermostatSetpointDualSetpoint.hpp>
+
+#include <utilities/core/Assert.hpp>
+#include <utilities/core/Compare.hpp>
+#include <utilities/geometry/Point3d.hpp>
+#include <utilities/time/Time.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace openstudio {
+namespace benchmarks {
+
+  ModelGeneratorOptions::ModelGeneratorOptions()
+    : numSpaces(100), numAirLoops(4), numSchedules(20)
+  {}
+
+  model::Model generateModel(const ModelGeneratorOptions& options)
+  {
+    using namespace openstudio::model;
+
+    Model model;
+
+    // constructions
+    std::vector<OpaqueMaterial> opaqueMaterials;
+    opaqueMaterials.push_back(StandardOpaqueMaterial(model, "MediumRough", 0.2, 0.5, 1800.0, 900.0));
+    Construction opaqueConstruction(opaqueMaterials);
+    std::vector<FenestrationMaterial> fenestrationMaterials;
+    fenestrationMaterials.push_back(SimpleGlazing(model, 2.5, 0.4));
+    Construction windowConstruction(fenestrationMaterials);
+
+    DefaultSurfaceConstructions surfaceConstructions(model);
+    surfaceConstructions.setFloorConstruction(opaqueConstruction);
+    surfaceConstructions.setWallConstruction(opaqueConstruction);
+    surfaceConstructions.setRoofCeilingConstruction(opaqueConstruction);
+    DefaultSubSurfaceConstructions subSurfaceConstructions(model);
+    subSurfaceConstructions.setFixedWindowConstruction(windowConstruction);
+    DefaultConstructionSet constructionSet(model);
+    constructionSet.setDefaultExteriorSurfaceConstructions(surfaceConstructions);
+    constructionSet.setDefaultExteriorSubSurfaceConstructions(subSurfaceConstructions);
+    model.getUniqueModelObject<Building>().setDefaultConstructionSet(constructionSet);
+
+    // schedules, a weekday profile and a weekend rule so each one has some structure
+    std::vector<ScheduleRuleset> schedules;
+    for (unsigned i = 0; i < std::max(options.numSchedules, 1u); ++i) {
+      ScheduleRuleset schedule(model);
+      ScheduleDay weekday = schedule.defaultDaySchedule();
+      weekday.addValue(Time(0, 6 + i % 3), 0.1);
+      weekday.addValue(Time(0, 18 + i % 3), 0.9);
+      weekday.addValue(Time(0, 24), 0.1);
+      ScheduleRule weekend(schedule);
+      weekend.setApplySaturday(true);
+      weekend.setApplySunday(true);
+      weekend.daySchedule().addValue(Time(0, 24), 0.05);
+      schedules.push_back(schedule);
+    }
+
+    ScheduleRuleset heatingSetpoint(model);
+    heatingSetpoint.defaultDaySchedule().addValue(Time(0, 24), 21.0);
+    ScheduleRuleset coolingSetpoint(model);
+    coolingSetpoint.defaultDaySchedule().addValue(Time(0, 24), 24.0);
+
+    LightsDefinition lightsDefinition(model);
+    lightsDefinition.setWattsperSpaceFloorArea(10.0);
+    PeopleDefinition peopleDefinition(model);
+    peopleDefinition.setPeopleperSpaceFloorArea(0.05);
+
+    // spaces on a square grid of detached 10 m x 10 m boxes
+    std::vector<ThermalZone> zones;
+    unsigned columns = static_cast<unsigned>(std::ceil(std::sqrt(static_cast<double>(options.numSpaces))));
+    for (unsigned i = 0; i < options.numSpaces; ++i) {
+      double x = 12.0 * (i % columns);
+      double y = 12.0 * (i / columns);
+
+      Point3dVector floorPrint;
+      floorPrint.push_back(Point3d(x, y + 10, 0));
+      floorPrint.push_back(Point3d(x + 10, y + 10, 0));
+      floorPrint.push_back(Point3d(x + 10, y, 0));
+      floorPrint.push_back(Point3d(x, y, 0));
+      boost::optional<Space> space = Space::fromFloorPrint(floorPrint, 3, model);
+      OS_ASSERT(space);
+
+      BOOST_FOREACH(Surface surface, space->surfaces()) {
+        if (istringEqual("Wall", surface.surfaceType())) {
+          surface.setWindowToWallRatio(0.3);
+        }
+      }
+
+      ScheduleRuleset& schedule = schedules[i % schedules.size()];
+      Lights lights(lightsDefinition);
+      lights.setSpace(*space);
+      lights.setSchedule(schedule);
+      People people(peopleDefinition);
+      people.setSpace(*space);
+      people.setNumberofPeopleSchedule(schedule);
+
+      ThermalZone zone(model);
+      space->setThermalZone(zone);
+      ThermostatSetpointDualSetpoint thermostat(model);
+      thermostat.setHeatingSetpointTemperatureSchedule(heatingSetpoint);
+      thermostat.setCoolingSetpointTemperatureSchedule(coolingSetpoint);
+      zone.setThermostatSetpointDualSetpoint(thermostat);
+      zones.push_back(zone);
+    }
+
+    // air loops, zones are assigned round robin
+    ScheduleRuleset alwaysOn(model);
+    alwaysOn.defaultDaySchedule().addValue(Time(0, 24), 1.0);
+    std::vector<AirLoopHVAC> airLoops;
+    std::vector<SetpointManagerSingleZoneReheat> setpointManagers;
+    for (unsigned i = 0; i < options.numAirLoops; ++i) {
+      AirLoopHVAC airLoop(model);
+      Node supplyOutletNode = airLoop.supplyOutletNode();
+      FanConstantVolume fan(model, alwaysOn);
+      fan.addToNode(supplyOutletNode);
+      CoilHeatingGas coil(model, alwaysOn);
+      coil.addToNode(supplyOutletNode);
+      SetpointManagerSingleZoneReheat setpointManager(model);
+      setpointManager.addToNode(supplyOutletNode);
+      airLoops.push_back(airLoop);
+      setpointManagers.push_back(setpointManager);
+    }
+
+    for (unsigned i = 0; i < zones.size() && !airLoops.empty(); ++i) {
+      unsigned j = i % airLoops.size();
+      AirTerminalSingleDuctUncontrolled terminal(model, alwaysOn);
+      airLoops[j].addBranchForZone(zones[i], boost::optional<StraightComponent>(terminal));
+      if (i == j) {
+        setpointManagers[j].setControlZone(zones[i]);
+      }
+    }
+
+    return model;
+  }
+
+} // benchmarks
+} // openstudio
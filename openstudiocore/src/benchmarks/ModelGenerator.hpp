@@ -0,0 +1,49 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef BENCHMARKS_MODELGENERATOR_HPP
+#define BENCHMARKS_MODELGENERATOR_HPP
+
+#include <model/Model.hpp>
+
+namespace openstudio {
+namespace benchmarks {
+
+  /** Size of the synthetic model built by generateModel. */
+  struct ModelGeneratorOptions {
+    ModelGeneratorOptions();
+
+    /// number of spaces, each a 10 m x 10 m box with windows in its own thermal zone
+    unsigned numSpaces;
+    /// number of air loops, thermal zones are spread evenly across them
+    unsigned numAirLoops;
+    /// number of ruleset schedules, assigned round robin to loads and thermostats
+    unsigned numSchedules;
+  };
+
+  /** Builds a deterministic model of the given size for benchmarking. Spaces are laid out on a
+   *  grid of single story boxes, each with lights, people and a dual setpoint thermostat. Each air
+   *  loop has a constant volume fan and gas heating coil and serves its zones through uncontrolled
+   *  terminals. */
+  model::Model generateModel(const ModelGeneratorOptions& options);
+
+} // benchmarks
+} // openstudio
+
+#endif // BENCHMARKS_MODELGENERATOR_HPP
@@ -0,0 +1,289 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <benchmarks/BenchmarkRunner.hpp>
+#include <benchmarks/ModelGenerator.hpp>
+
+#include <energyplus/ForwardTranslator.hpp>
+
+#include <osversion/VersionTranslator.hpp>
+
+#include <model/AirLoopHVAC.hpp>
+#include <model/ModelObject.hpp>
+#include <model/Space.hpp>
+#include <model/Surface.hpp>
+#include <model/ThermalZone.hpp>
+
+#include <utilities/core/Application.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+#include <utilities/idd/IddFactory.hxx>
+#include <utilities/idd/IddFile.hpp>
+#include <utilities/idf/IdfFile.hpp>
+#include <utilities/idf/Workspace.hpp>
+#include <utilities/sql/SqlFile.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace openstudio;
+using namespace openstudio::benchmarks;
+
+/** State shared by the benchmark cases. Inputs are prepared once, outside of any timing. */
+class Workload {
+ public:
+  Workload(const ModelGeneratorOptions& options, const openstudio::path& outDir, const openstudio::path& sqlPath)
+    : m_options(options), m_outDir(outDir), m_sqlPath(sqlPath), m_model(generateModel(options))
+  {
+    std::stringstream idd;
+    IddFactory::instance().getIddFile(IddFileType::EnergyPlus).print(idd);
+    m_iddText = idd.str();
+
+    m_workspace = energyplus::ForwardTranslator().translateModel(m_model);
+
+    std::stringstream idf;
+    m_workspace.toIdfFile().print(idf);
+    m_idfText = idf.str();
+
+    std::stringstream osm;
+    m_model.toIdfFile().print(osm);
+    m_osmText = osm.str();
+  }
+
+  void loadIdd() 
+  {
+    std::istringstream is(m_iddText);
+    boost::optional<IddFile> iddFile = IddFile::load(is);
+    check(iddFile, "IDD did not load");
+  }
+
+  void loadIdf()
+  {
+    std::istringstream is(m_idfText);
+    boost::optional<IdfFile> idfFile = IdfFile::load(is, IddFileType::EnergyPlus);
+    check(idfFile, "IDF did not load");
+  }
+
+  void loadIdfParallel()
+  {
+    std::istringstream is(m_idfText);
+    boost::optional<IdfFile> idfFile = IdfFile::loadParallel(is, IddFileType::EnergyPlus);
+    check(idfFile, "IDF did not load");
+  }
+
+  void generate()
+  {
+    model::Model model = generateModel(m_options);
+    check(model.numObjects() > 0, "no objects generated");
+  }
+
+  void getModelObjects()
+  {
+    for (unsigned i = 0; i < 10; ++i) {
+      check(m_model.getModelObjects<model::Space>().size() == m_options.numSpaces, "wrong number of spaces");
+      check(!m_model.getModelObjects<model::Surface>().empty(), "no surfaces");
+      check(m_model.getModelObjects<model::ThermalZone>().size() == m_options.numSpaces, "wrong number of zones");
+      check(!m_model.getModelObjects<model::ModelObject>().empty(), "no model objects");
+    }
+  }
+
+  void cloneModel()
+  {
+    Workspace clone = m_model.clone();
+    check(clone.numObjects() == m_model.numObjects(), "clone lost objects");
+  }
+
+  void cloneModelKeepHandles()
+  {
+    Workspace clone = m_model.clone(true);
+    check(clone.numObjects() == m_model.numObjects(), "clone lost objects");
+  }
+
+  void cloneWorkspace()
+  {
+    Workspace clone = m_workspace.clone();
+    check(clone.numObjects() == m_workspace.numObjects(), "clone lost objects");
+  }
+
+  void cloneAndTranslate()
+  {
+    model::Model model = m_model.clone().cast<model::Model>();
+    Workspace workspace = energyplus::ForwardTranslator().translateModel(model);
+    check(workspace.numObjects() > 0, "nothing translated");
+  }
+
+  void cloneAirLoops()
+  {
+    model::Model model = m_model.clone().cast<model::Model>();
+    BOOST_FOREACH(const model::AirLoopHVAC& airLoop, model.getModelObjects<model::AirLoopHVAC>()) {
+      airLoop.clone(model);
+    }
+  }
+
+  void forwardTranslate()
+  {
+    Workspace workspace = energyplus::ForwardTranslator().translateModel(m_model);
+    check(workspace.numObjects() > 0, "nothing translated");
+  }
+
+  void versionTranslate()
+  {
+    std::istringstream is(m_osmText);
+    boost::optional<model::Model> model = osversion::VersionTranslator().loadModel(is);
+    check(model, "OSM did not load");
+  }
+
+  void saveOsm()
+  {
+    bool saved = m_model.save(m_outDir / toPath("benchmark.osm"), true);
+    check(saved, "OSM was not saved");
+  }
+
+  void readTimeSeries()
+  {
+    SqlFile sqlFile(m_sqlPath);
+    unsigned n = 0;
+    BOOST_FOREACH(const std::string& envPeriod, sqlFile.availableEnvPeriods()) {
+      BOOST_FOREACH(const std::string& reportingFrequency, sqlFile.availableReportingFrequencies(envPeriod)) {
+        BOOST_FOREACH(const std::string& name, sqlFile.availableVariableNames(envPeriod, reportingFrequency)) {
+          n += sqlFile.timeSeries(envPeriod, reportingFrequency, name).size();
+        }
+      }
+    }
+    check(n > 0, "no time series in sql file");
+  }
+
+ private:
+  template<typename T>
+  static void check(const T& test, const std::string& message)
+  {
+    if (!test) {
+      throw std::runtime_error(message);
+    }
+  }
+
+  ModelGeneratorOptions m_options;
+  openstudio::path m_outDir;
+  openstudio::path m_sqlPath;
+  model::Model m_model;
+  Workspace m_workspace;
+  std::string m_iddText;
+  std::string m_idfText;
+  std::string m_osmText;
+};
+
+int main(int argc, char *argv[])
+{
+  try {
+    ModelGeneratorOptions options;
+    unsigned warmUp;
+    unsigned iterations;
+    std::string filter;
+    std::string output;
+    std::string outDir;
+    std::string sql;
+
+    boost::program_options::options_description opts("Options", 100);
+    opts.add_options()
+      ("help,h", "prints help message")
+      ("spaces", boost::program_options::value<unsigned>(&options.numSpaces)->default_value(options.numSpaces),
+       "number of spaces (and thermal zones) in the generated model")
+      ("air-loops", boost::program_options::value<unsigned>(&options.numAirLoops)->default_value(options.numAirLoops),
+       "number of air loops in the generated model")
+      ("schedules", boost::program_options::value<unsigned>(&options.numSchedules)->default_value(options.numSchedules),
+       "number of ruleset schedules in the generated model")
+      ("warm-up", boost::program_options::value<unsigned>(&warmUp)->default_value(1),
+       "untimed runs of each case before timing")
+      ("iterations,n", boost::program_options::value<unsigned>(&iterations)->default_value(5),
+       "timed runs of each case")
+      ("filter,f", boost::program_options::value<std::string>(&filter),
+       "only run cases whose name contains this string")
+      ("output,o", boost::program_options::value<std::string>(&output),
+       "write JSON results to this file instead of standard output")
+      ("outdir", boost::program_options::value<std::string>(&outDir)->default_value(std::string(".")),
+       "directory for files written by the benchmarks")
+      ("sql", boost::program_options::value<std::string>(&sql),
+       "EnergyPlus sql output for the time series case, the case is skipped if not given")
+    ;
+
+    boost::program_options::variables_map vm;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), vm);
+    boost::program_options::notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << opts;
+      return 0;
+    }
+
+    // SqlFile and the version translator need a QApplication
+    openstudio::Application::instance().application();
+
+    // logging would dominate some timings
+    openstudio::Logger::instance().standardOutLogger().disable();
+
+    std::cerr << "Generating model with " << options.numSpaces << " spaces, " << options.numAirLoops 
+              << " air loops and " << options.numSchedules << " schedules" << std::endl;
+    Workload workload(options, boost::filesystem::system_complete(toPath(outDir)), toPath(sql));
+
+    BenchmarkRunner runner(warmUp, iterations);
+    runner.addParameter("spaces", boost::lexical_cast<std::string>(options.numSpaces));
+    runner.addParameter("air_loops", boost::lexical_cast<std::string>(options.numAirLoops));
+    runner.addParameter("schedules", boost::lexical_cast<std::string>(options.numSchedules));
+
+    runner.addCase("idd_load", boost::bind(&Workload::loadIdd, &workload));
+    runner.addCase("idf_load", boost::bind(&Workload::loadIdf, &workload));
+    runner.addCase("idf_load_parallel", boost::bind(&Workload::loadIdfParallel, &workload));
+    runner.addCase("model_generate", boost::bind(&Workload::generate, &workload));
+    runner.addCase("model_get_model_objects", boost::bind(&Workload::getModelObjects, &workload));
+    runner.addCase("model_clone", boost::bind(&Workload::cloneModel, &workload));
+    runner.addCase("model_clone_keep_handles", boost::bind(&Workload::cloneModelKeepHandles, &workload));
+    runner.addCase("workspace_clone", boost::bind(&Workload::cloneWorkspace, &workload));
+    runner.addCase("model_clone_translate", boost::bind(&Workload::cloneAndTranslate, &workload));
+    runner.addCase("model_clone_air_loops", boost::bind(&Workload::cloneAirLoops, &workload));
+    runner.addCase("forward_translate", boost::bind(&Workload::forwardTranslate, &workload));
+    runner.addCase("version_translate_load", boost::bind(&Workload::versionTranslate, &workload));
+    runner.addCase("osm_save", boost::bind(&Workload::saveOsm, &workload));
+    if (!sql.empty()) {
+      runner.addCase("sql_time_series", boost::bind(&Workload::readTimeSeries, &workload));
+    }
+
+    std::vector<BenchmarkResult> results = runner.run(filter, std::cerr);
+
+    if (output.empty()) {
+      runner.writeJSON(results, std::cout);
+    } else {
+      boost::filesystem::ofstream os(toPath(output));
+      runner.writeJSON(results, os);
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -47,6 +47,7 @@
 #include <utilities/idf/WorkspaceObjectOrder.hpp>
 #include <utilities/core/Logger.hpp>
 #include <utilities/core/Assert.hpp>
+#include <utilities/core/Instrumentation.hpp>
 #include <utilities/idd/FluidProperties_Name_FieldEnums.hxx>
 #include <utilities/idd/FluidProperties_GlycolConcentration_FieldEnums.hxx>
 #include <utilities/idd/GlobalGeometryRules_FieldEnums.hxx>
@@ -86,6 +87,7 @@ ForwardTranslator::ForwardTranslator()
 
 Workspace ForwardTranslator::translateModel( const Model & model, ProgressBar* progressBar )
 {
+  OS_TIMER("ForwardTranslator::translateModel");
   Model modelCopy = model.clone().cast<Model>();
 
   m_progressBar = progressBar;
@@ -142,6 +144,7 @@ void ForwardTranslator::setKeepRunControlSpecialDays(bool keepRunControlSpecialD
 
 Workspace ForwardTranslator::translateModelPrivate( model::Model & model, bool fullModelTranslation )
 {
+  OS_TIMER("ForwardTranslator::translateModelPrivate");
   m_idfObjects.clear();
 
   m_map.clear();
@@ -374,6 +377,7 @@ struct ChildSorter {
 
 boost::optional<IdfObject> ForwardTranslator::translateAndMapModelObject(ModelObject & modelObject)
 {
+  OS_TIMER("ForwardTranslator::translateAndMapModelObject");
   boost::optional<IdfObject> retVal;
 
   // if already translated then exit
@@ -337,6 +337,17 @@ namespace detail {
   }
 
   double Building_Impl::floorArea() const
+  {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedFloorArea){
+      m_cachedFloorArea = computeFloorArea();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "floor area", *m_cachedFloorArea, computeFloorArea());
+    }
+    return m_cachedFloorArea.get();
+  }
+
+  double Building_Impl::computeFloorArea() const
   {
     double result = 0;
     BOOST_FOREACH(const Space& space, spaces()){
@@ -349,6 +360,26 @@ namespace detail {
   }
 
   boost::optional<double> Building_Impl::conditionedFloorArea() const
+  {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedConditionedFloorArea){
+      m_cachedConditionedFloorArea = computeConditionedFloorArea();
+    }else if (verify){
+      boost::optional<double> cached = m_cachedConditionedFloorArea.get();
+      boost::optional<double> computed = computeConditionedFloorArea();
+      if (cached.is_initialized() != computed.is_initialized()){
+        LOG_AND_THROW("Cached conditioned floor area of " << briefDescription() << " is "
+                      << (cached ? "set" : "not set") << ", but the computed value is "
+                      << (computed ? "set" : "not set") << ".");
+      }
+      if (cached){
+        model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "conditioned floor area", *cached, *computed);
+      }
+    }
+    return m_cachedConditionedFloorArea.get();
+  }
+
+  boost::optional<double> Building_Impl::computeConditionedFloorArea() const
   {
     boost::optional<double> result;
 
@@ -376,6 +407,16 @@ namespace detail {
   }
 
   double Building_Impl::numberOfPeople() const {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedNumberOfPeople){
+      m_cachedNumberOfPeople = computeNumberOfPeople();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "number of people", *m_cachedNumberOfPeople, computeNumberOfPeople());
+    }
+    return m_cachedNumberOfPeople.get();
+  }
+
+  double Building_Impl::computeNumberOfPeople() const {
     double result(0.0);
     BOOST_FOREACH(const Space& space, spaces()) {
       result += space.numberOfPeople() * space.multiplier();
@@ -714,6 +755,19 @@ namespace detail {
     return true;
   }
 
+  bool Building_Impl::checkCachedAggregates() const
+  {
+    boost::shared_ptr<Model_Impl> modelImpl = model().getImpl<Model_Impl>();
+    unsigned revision = modelImpl->aggregatesRevision();
+    if (!m_cachedAggregatesRevision || (*m_cachedAggregatesRevision != revision)){
+      m_cachedFloorArea.reset();
+      m_cachedConditionedFloorArea.reset();
+      m_cachedNumberOfPeople.reset();
+      m_cachedAggregatesRevision = revision;
+    }
+    return modelImpl->verifyCachedAggregates();
+  }
+
 } // detail
 
 IddObjectType Building::iddObjectType() {
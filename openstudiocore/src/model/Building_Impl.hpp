@@ -301,6 +301,19 @@ namespace detail {
     bool setSpaceTypeAsModelObject(const boost::optional<ModelObject>& modelObject);
     bool setDefaultConstructionSetAsModelObject(const boost::optional<ModelObject>& modelObject);
     bool setDefaultScheduleSetAsModelObject(const boost::optional<ModelObject>& modelObject);
+
+    // clears cached aggregates if any space may have changed since they were cached,
+    // returns true if cached values should be verified
+    bool checkCachedAggregates() const;
+
+    double computeFloorArea() const;
+    boost::optional<double> computeConditionedFloorArea() const;
+    double computeNumberOfPeople() const;
+
+    mutable boost::optional<unsigned> m_cachedAggregatesRevision;
+    mutable boost::optional<double> m_cachedFloorArea;
+    mutable boost::optional<boost::optional<double> > m_cachedConditionedFloorArea;
+    mutable boost::optional<double> m_cachedNumberOfPeople;
   };
 
 } // detail
@@ -25,6 +25,8 @@
 #include <model/ModelObject_Impl.hpp>
 #include <model/ResourceObject.hpp>
 #include <model/ResourceObject_Impl.hpp>
+#include <model/ParentObject.hpp>
+#include <model/ParentObject_Impl.hpp>
 #include <model/Connection.hpp>
 
 // central list of all concrete ModelObject header files (_Impl and non-_Impl)
@@ -52,6 +54,8 @@
 #include <boost/foreach.hpp>
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 using openstudio::IddObjectType;
 using openstudio::detail::WorkspaceObject_Impl;
 
@@ -64,13 +68,21 @@ namespace detail {
 
   // default constructor
   Model_Impl::Model_Impl()
-    : Workspace_Impl(StrictnessLevel::Draft, IddFileType::OpenStudio)
+    : Workspace_Impl(StrictnessLevel::Draft, IddFileType::OpenStudio),
+      m_aggregatesTracked(false),
+      m_spaceAggregatesGeneration(0),
+      m_aggregatesRevision(0),
+      m_verifyCachedAggregates(false)
   {
     // careful not to call anything that calls shared_from_this here, this is not yet constructed
   }
 
   Model_Impl::Model_Impl(const IdfFile& idfFile)
-    : Workspace_Impl(idfFile,StrictnessLevel(StrictnessLevel::Draft))
+    : Workspace_Impl(idfFile,StrictnessLevel(StrictnessLevel::Draft)),
+      m_aggregatesTracked(false),
+      m_spaceAggregatesGeneration(0),
+      m_aggregatesRevision(0),
+      m_verifyCachedAggregates(false)
   {
     // careful not to call anything that calls shared_from_this here, this is not yet constructed
     if (iddFileType() != IddFileType::OpenStudio) {
@@ -82,7 +94,11 @@ namespace detail {
 
   Model_Impl::Model_Impl(const openstudio::detail::Workspace_Impl& workspace,
                          bool keepHandles)
-    : openstudio::detail::Workspace_Impl(workspace,keepHandles)
+    : openstudio::detail::Workspace_Impl(workspace,keepHandles),
+      m_aggregatesTracked(false),
+      m_spaceAggregatesGeneration(0),
+      m_aggregatesRevision(0),
+      m_verifyCachedAggregates(false)
   {
     // careful not to call anything that calls shared_from_this here, this is not yet constructed
     if (iddFileType() != IddFileType::OpenStudio) {
@@ -95,7 +111,11 @@ namespace detail {
   // copy constructor, used for clone
   Model_Impl::Model_Impl(const Model_Impl& other, bool keepHandles)
     : Workspace_Impl(other, keepHandles),
-      m_sqlFile((other.m_sqlFile)?(boost::shared_ptr<SqlFile>(new SqlFile(*other.m_sqlFile))):(other.m_sqlFile))
+      m_sqlFile((other.m_sqlFile)?(boost::shared_ptr<SqlFile>(new SqlFile(*other.m_sqlFile))):(other.m_sqlFile)),
+      m_aggregatesTracked(false),
+      m_spaceAggregatesGeneration(0),
+      m_aggregatesRevision(0),
+      m_verifyCachedAggregates(other.m_verifyCachedAggregates)
   {
     // notice we are cloning the sqlfile too, if necessary
     // careful not to call anything that calls shared_from_this here, this is not yet constructed
@@ -107,7 +127,11 @@ namespace detail {
                          bool keepHandles,
                          StrictnessLevel level)
     : Workspace_Impl(other,hs,keepHandles,level),
-      m_sqlFile((other.m_sqlFile)?(boost::shared_ptr<SqlFile>(new SqlFile(*other.m_sqlFile))):(other.m_sqlFile))
+      m_sqlFile((other.m_sqlFile)?(boost::shared_ptr<SqlFile>(new SqlFile(*other.m_sqlFile))):(other.m_sqlFile)),
+      m_aggregatesTracked(false),
+      m_spaceAggregatesGeneration(0),
+      m_aggregatesRevision(0),
+      m_verifyCachedAggregates(other.m_verifyCachedAggregates)
   {
     // notice we are cloning the sqlfile too, if necessary
   }
@@ -159,6 +183,16 @@ namespace detail {
     OptionalLifeCycleCostParameters tclccp = m_cachedLifeCycleCostParameters;
     m_cachedLifeCycleCostParameters = otherImpl->m_cachedLifeCycleCostParameters;
     otherImpl->m_cachedLifeCycleCostParameters = tclccp;
+
+    // objects changed hands, so every cached aggregate on either side is stale; move both
+    // counters past anything either model has handed out and track changes afresh
+    unsigned generation = std::max(m_spaceAggregatesGeneration, otherImpl->m_spaceAggregatesGeneration) + 1;
+    unsigned revision = std::max(m_aggregatesRevision, otherImpl->m_aggregatesRevision) + 1;
+    m_spaceAggregatesGeneration = otherImpl->m_spaceAggregatesGeneration = generation;
+    m_aggregatesRevision = otherImpl->m_aggregatesRevision = revision;
+    m_aggregateSpaces.clear();
+    otherImpl->m_aggregateSpaces.clear();
+    m_aggregatesTracked = otherImpl->m_aggregatesTracked = false;
   }
 
   void Model_Impl::createComponentWatchers() {
@@ -1116,6 +1150,173 @@ if (_className::iddObjectType() == typeToCreate) { \
   {
     m_cachedWeatherFile.reset();
   }
+
+  bool Model_Impl::verifyCachedAggregates() const
+  {
+    return m_verifyCachedAggregates;
+  }
+
+  void Model_Impl::setVerifyCachedAggregates(bool verifyCachedAggregates)
+  {
+    m_verifyCachedAggregates = verifyCachedAggregates;
+  }
+
+  unsigned Model_Impl::spaceAggregatesGeneration() const
+  {
+    if (!m_aggregatesTracked){
+      startTrackingAggregates();
+    }
+    if (inTransaction()){
+      // edits in an open transaction hold their onChange signals, so nothing computed now
+      // may be reused; commit and rollback emit the signals that invalidate it afterwards
+      invalidateAllAggregates();
+    }
+    return m_spaceAggregatesGeneration;
+  }
+
+  unsigned Model_Impl::aggregatesRevision() const
+  {
+    if (!m_aggregatesTracked){
+      startTrackingAggregates();
+    }
+    if (inTransaction()){
+      invalidateAllAggregates();
+    }
+    return m_aggregatesRevision;
+  }
+
+  void Model_Impl::verifyCachedAggregate(const ModelObject& object,
+                                         const std::string& description,
+                                         double cached,
+                                         double computed) const
+  {
+    if (m_verifyCachedAggregates && !equal(cached,computed)){
+      LOG_AND_THROW("Cached " << description << " of " << object.briefDescription() << " is "
+                    << cached << ", but the computed value is " << computed << ".");
+    }
+  }
+
+  void Model_Impl::startTrackingAggregates() const
+  {
+    m_aggregatesTracked = true;
+
+    // connections are unique so that tracking may be restarted after a swap, in which case
+    // connect returns false for those that already exist
+    QObject::connect(this,
+                     SIGNAL(addWorkspaceObject(const WorkspaceObject&, const openstudio::IddObjectType&, const openstudio::UUID&)),
+                     this,
+                     SLOT(aggregateObjectAdded(const WorkspaceObject&)),
+                     Qt::UniqueConnection);
+    QObject::connect(this,
+                     SIGNAL(removeWorkspaceObject(const WorkspaceObject&, const openstudio::IddObjectType&, const openstudio::UUID&)),
+                     this,
+                     SLOT(aggregateObjectRemoved(const WorkspaceObject&)),
+                     Qt::UniqueConnection);
+
+    BOOST_FOREACH(const WorkspaceObject& object, objects()) {
+      QObject::connect(object.getImpl<WorkspaceObject_Impl>().get(),
+                       SIGNAL(onChange()),
+                       this,
+                       SLOT(aggregateObjectChanged()),
+                       Qt::UniqueConnection);
+      if (boost::optional<ModelObject> modelObject = object.optionalCast<ModelObject>()){
+        if (boost::optional<Handle> spaceHandle = aggregateSpace(*modelObject)){
+          m_aggregateSpaces[object.handle()] = *spaceHandle;
+        }
+      }
+    }
+  }
+
+  boost::optional<Handle> Model_Impl::aggregateSpace(const ModelObject& object) const
+  {
+    boost::optional<ModelObject> current = object;
+    while (current){
+      if (current->iddObjectType() == IddObjectType::OS_Space){
+        return current->handle();
+      }
+      boost::optional<ParentObject> parent = current->parent();
+      if (!parent){
+        break;
+      }
+      current = *parent;
+    }
+    return boost::none;
+  }
+
+  void Model_Impl::invalidateAggregates(const ModelObject& object) const
+  {
+    Handle handle = object.handle();
+    boost::optional<Handle> spaceHandle = aggregateSpace(object);
+    std::map<Handle,Handle>::iterator it = m_aggregateSpaces.find(handle);
+
+    if (!spaceHandle){
+      if (it != m_aggregateSpaces.end()){
+        m_aggregateSpaces.erase(it);
+      }
+      // schedules, definitions, space types, thermal zones, etc. may affect any space
+      invalidateAllAggregates();
+      return;
+    }
+
+    if ((it != m_aggregateSpaces.end()) && (it->second != *spaceHandle)){
+      // object moved to another space
+      invalidateSpaceAggregates(it->second);
+    }
+    m_aggregateSpaces[handle] = *spaceHandle;
+    invalidateSpaceAggregates(*spaceHandle);
+  }
+
+  void Model_Impl::invalidateSpaceAggregates(const Handle& spaceHandle) const
+  {
+    if (boost::optional<WorkspaceObject> object = getObject(spaceHandle)){
+      if (boost::shared_ptr<Space_Impl> spaceImpl = object->getImpl<Space_Impl>()){
+        spaceImpl->clearCachedAggregates();
+      }
+    }
+    ++m_aggregatesRevision;
+  }
+
+  void Model_Impl::invalidateAllAggregates() const
+  {
+    ++m_spaceAggregatesGeneration;
+    ++m_aggregatesRevision;
+  }
+
+  void Model_Impl::aggregateObjectChanged()
+  {
+    ModelObject_Impl* impl = dynamic_cast<ModelObject_Impl*>(sender());
+    if (!impl || !impl->initialized()){
+      invalidateAllAggregates();
+      return;
+    }
+    invalidateAggregates(impl->getObject<ModelObject>());
+  }
+
+  void Model_Impl::aggregateObjectAdded(const WorkspaceObject& object)
+  {
+    QObject::connect(object.getImpl<WorkspaceObject_Impl>().get(),
+                     SIGNAL(onChange()),
+                     this,
+                     SLOT(aggregateObjectChanged()),
+                     Qt::UniqueConnection);
+    if (boost::optional<ModelObject> modelObject = object.optionalCast<ModelObject>()){
+      invalidateAggregates(*modelObject);
+    }else{
+      invalidateAllAggregates();
+    }
+  }
+
+  void Model_Impl::aggregateObjectRemoved(const WorkspaceObject& object)
+  {
+    // object is still in the model when this signal is emitted
+    if (boost::optional<ModelObject> modelObject = object.optionalCast<ModelObject>()){
+      invalidateAggregates(*modelObject);
+    }else{
+      invalidateAllAggregates();
+    }
+    m_aggregateSpaces.erase(object.handle());
+  }
+
 } // detail
 
 Model::Model()
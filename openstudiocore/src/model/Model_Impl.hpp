@@ -34,8 +34,11 @@
 
 #include <boost/optional.hpp>
 
+#include <map>
 #include <vector>
 
+class ModelFixture;
+
 namespace openstudio {
 
 class SqlFile;
@@ -140,6 +143,10 @@ namespace detail {
 
     Schedule alwaysOnDiscreteSchedule() const;
 
+    /** Returns true if cached Space, ThermalZone, SpaceType and Building aggregates are checked
+     *  against a fresh computation on every access. */
+    bool verifyCachedAggregates() const;
+
     //@}
     /** @name Setters */
     //@{
@@ -190,6 +197,28 @@ namespace detail {
 
     void disconnect(ModelObject object, unsigned port);
 
+    //@}
+    /** @name Cached Aggregates */
+    //@{
+
+    /** Returns a counter that changes whenever an object that is not attributable to a
+     *  single Space changes. Space aggregates cached under an older value are stale. Starts
+     *  change tracking on first call. Changes on every call while an edit transaction is open. */
+    unsigned spaceAggregatesGeneration() const;
+
+    /** Returns a counter that changes whenever any Space aggregate may have changed.
+     *  ThermalZone, SpaceType and Building aggregates cached under an older value are stale. Starts change tracking on first
+     *  call. Changes on every call while an edit transaction is open. */
+    unsigned aggregatesRevision() const;
+
+    /** Throws if verifyCachedAggregates() and cached is not equal to computed. */
+    void verifyCachedAggregate(const ModelObject& object,
+                               const std::string& description,
+                               double cached,
+                               double computed) const;
+
+    //@}
+
    public slots :
 
     virtual void obsoleteComponentWatcher(const ComponentWatcher& watcher);
@@ -229,6 +258,29 @@ namespace detail {
     mutable boost::optional<YearDescription> m_cachedYearDescription;
     mutable boost::optional<WeatherFile> m_cachedWeatherFile;
 
+    // Space, ThermalZone, SpaceType and Building aggregates are cached on the objects
+    // themselves; the model only tracks which changes invalidate them. m_aggregateSpaces maps
+    // every object under a Space (including the Space itself) to that Space so that edits to
+    // surfaces and loads invalidate one space rather than all of them.
+    mutable bool m_aggregatesTracked;
+    mutable unsigned m_spaceAggregatesGeneration;
+    mutable unsigned m_aggregatesRevision;
+    mutable std::map<Handle,Handle> m_aggregateSpaces;
+    bool m_verifyCachedAggregates;
+
+    // for testing
+    friend class ::ModelFixture;
+
+    /** If set to true, every access to a cached aggregate (floor area, volume, number of
+     *  people, etc.) also recomputes the value and throws if the two differ. */
+    void setVerifyCachedAggregates(bool verifyCachedAggregates);
+
+    void startTrackingAggregates() const;
+    boost::optional<Handle> aggregateSpace(const ModelObject& object) const;
+    void invalidateAggregates(const ModelObject& object) const;
+    void invalidateSpaceAggregates(const Handle& spaceHandle) const;
+    void invalidateAllAggregates() const;
+
   private slots:
 
     void clearCachedBuilding();
@@ -237,6 +289,10 @@ namespace detail {
     void clearCachedYearDescription();
     void clearCachedWeatherFile();
 
+    void aggregateObjectChanged();
+    void aggregateObjectAdded(const WorkspaceObject& object);
+    void aggregateObjectRemoved(const WorkspaceObject& object);
+
   };
 
 } // detail
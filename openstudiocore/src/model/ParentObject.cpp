@@ -22,6 +22,9 @@
 #include <model/ResourceObject.hpp>
 #include <model/LifeCycleCost.hpp>
 #include <model/Component.hpp>
+#include <model/PlanarSurface.hpp>
+#include <model/PlanarSurfaceGroup.hpp>
+#include <model/SpaceItem.hpp>
 
 #include <utilities/idf/Workspace_Impl.hpp>
 
@@ -93,8 +96,29 @@ namespace detail {
     return result;
   }
 
+  // True for children whose clone is the plain ModelObject_Impl or ParentObject_Impl one, and
+  // so can be cloned as part of a batch. Geometry and space loads make up the large subtrees.
+  bool usesDefaultClone(const ModelObject& object) {
+    return (object.optionalCast<PlanarSurface>() ||
+            object.optionalCast<PlanarSurfaceGroup>() ||
+            object.optionalCast<SpaceItem>() ||
+            object.optionalCast<LifeCycleCost>());
+  }
+
   ModelObject ParentObject_Impl::clone(Model model) const
   {
+    ModelObjectVector subTree = getRecursiveChildren(getObject<ParentObject>(), true);
+    bool batch = true;
+    for (ModelObjectVector::const_iterator it = subTree.begin() + 1; it != subTree.end(); ++it) {
+      if (!usesDefaultClone(*it)) {
+        batch = false;
+        break;
+      }
+    }
+    if (batch) {
+      return cloneSubTree(model, subTree);
+    }
+
     ModelObject newParentAsModelObject = ModelObject_Impl::clone(model);
     ParentObject newParent = newParentAsModelObject.cast<ParentObject>();
     BOOST_FOREACH(ModelObject child, children())
@@ -105,6 +129,46 @@ namespace detail {
     return newParentAsModelObject;
   }
 
+  ModelObject ParentObject_Impl::cloneSubTree(Model model, const std::vector<ModelObject>& subTree) const
+  {
+    OS_ASSERT(!subTree.empty() && (subTree[0].handle() == handle()));
+    WorkspaceObjectVector toAdd = castVector<WorkspaceObject>(subTree);
+    WorkspaceObjectVector result;
+
+    // If same model, non-recursive insert of resources should be sufficient.
+    Model m = this->model();
+    if (model == m) {
+      std::set<Handle> resourceHandles;
+      WorkspaceObjectVector toInsert;
+      BOOST_FOREACH(const ModelObject& object, subTree) {
+        BOOST_FOREACH(const ResourceObject& resource, object.resources()) {
+          if (resourceHandles.insert(resource.handle()).second) {
+            toInsert.push_back(resource);
+          }
+        }
+      }
+      result = m.addAndInsertObjects(toAdd,toInsert);
+      // adding this better have worked
+      OS_ASSERT(result.size() == toAdd.size() + toInsert.size());
+      return result[0].cast<ModelObject>();
+    }
+
+    // Not the same model. Bring each resource subtree along once.
+    std::set<Handle> resourceHandles;
+    std::vector<WorkspaceObjectVector> toInsert;
+    BOOST_FOREACH(const ModelObject& object, subTree) {
+      BOOST_FOREACH(const ModelObjectVector& resourceSubTree, getRecursiveResourceSubTrees(object, true)) {
+        if (!resourceSubTree.empty() && resourceHandles.insert(resourceSubTree[0].handle()).second) {
+          toInsert.push_back(castVector<WorkspaceObject>(resourceSubTree));
+        }
+      }
+    }
+    result = model.addAndInsertObjects(toAdd,toInsert);
+    // Operation should work.
+    OS_ASSERT(result.size() > 0u);
+    return result[0].cast<ModelObject>();
+  }
+
 } // detail
  
 ParentObject::ParentObject(IddObjectType type,const Model& model)
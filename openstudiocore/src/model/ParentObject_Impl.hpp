@@ -62,6 +62,11 @@ namespace detail {
 
    private:
 
+    // Adds clones of subTree (this object first, as returned by getRecursiveChildren with costs)
+    // to model in one batch, so that name conflicts and pointers are resolved once for the whole
+    // subtree. Only valid if no object in subTree but this one overrides clone.
+    ModelObject cloneSubTree(Model model, const std::vector<ModelObject>& subTree) const;
+
     REGISTER_LOGGER("openstudio.model.ParentObject");
   };
 
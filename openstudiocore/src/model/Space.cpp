@@ -851,6 +851,17 @@ namespace detail {
   }
 
   double Space_Impl::floorArea() const
+  {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedFloorArea){
+      m_cachedFloorArea = computeFloorArea();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "floor area", *m_cachedFloorArea, computeFloorArea());
+    }
+    return m_cachedFloorArea.get();
+  }
+
+  double Space_Impl::computeFloorArea() const
   {
     double result = 0;
     BOOST_FOREACH(const Surface& surface, this->surfaces()) {
@@ -863,6 +874,16 @@ namespace detail {
   }
 
   double Space_Impl::exteriorArea() const {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedExteriorArea){
+      m_cachedExteriorArea = computeExteriorArea();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "exterior area", *m_cachedExteriorArea, computeExteriorArea());
+    }
+    return m_cachedExteriorArea.get();
+  }
+
+  double Space_Impl::computeExteriorArea() const {
     double result = 0;
     BOOST_FOREACH(const Surface& surface, this->surfaces()) {
       if (istringEqual(surface.outsideBoundaryCondition(), "Outdoors"))
@@ -888,6 +909,16 @@ namespace detail {
   }
 
   double Space_Impl::volume() const {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedVolume){
+      m_cachedVolume = computeVolume();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "volume", *m_cachedVolume, computeVolume());
+    }
+    return m_cachedVolume.get();
+  }
+
+  double Space_Impl::computeVolume() const {
     double result = 0;
 
     // TODO: need a better method
@@ -919,6 +950,16 @@ namespace detail {
   }
 
   double Space_Impl::numberOfPeople() const {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedNumberOfPeople){
+      m_cachedNumberOfPeople = computeNumberOfPeople();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "number of people", *m_cachedNumberOfPeople, computeNumberOfPeople());
+    }
+    return m_cachedNumberOfPeople.get();
+  }
+
+  double Space_Impl::computeNumberOfPeople() const {
     double result = 0.0;
     double area = floorArea();
 
@@ -2616,6 +2657,25 @@ namespace detail {
     return boost::make_tuple(point3d.x(), point3d.y());
   }
 
+  void Space_Impl::clearCachedAggregates() const
+  {
+    m_cachedFloorArea.reset();
+    m_cachedExteriorArea.reset();
+    m_cachedVolume.reset();
+    m_cachedNumberOfPeople.reset();
+  }
+
+  bool Space_Impl::checkCachedAggregates() const
+  {
+    boost::shared_ptr<Model_Impl> modelImpl = model().getImpl<Model_Impl>();
+    unsigned generation = modelImpl->spaceAggregatesGeneration();
+    if (!m_cachedAggregatesGeneration || (*m_cachedAggregatesGeneration != generation)){
+      clearCachedAggregates();
+      m_cachedAggregatesGeneration = generation;
+    }
+    return modelImpl->verifyCachedAggregates();
+  }
+
 } // detail
 
 Space::Space(const Model& model)
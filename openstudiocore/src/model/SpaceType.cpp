@@ -974,6 +974,17 @@ namespace detail {
   }
 
   double SpaceType_Impl::floorArea() const
+  {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedFloorArea){
+      m_cachedFloorArea = computeFloorArea();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "floor area", *m_cachedFloorArea, computeFloorArea());
+    }
+    return m_cachedFloorArea.get();
+  }
+
+  double SpaceType_Impl::computeFloorArea() const
   {
     double result = 0;
     BOOST_FOREACH(const Space& space, this->model().getModelObjects<Space>()){
@@ -1158,6 +1169,17 @@ namespace detail {
     OS_ASSERT(count == 1);
   }
 
+  bool SpaceType_Impl::checkCachedAggregates() const
+  {
+    boost::shared_ptr<Model_Impl> modelImpl = model().getImpl<Model_Impl>();
+    unsigned revision = modelImpl->aggregatesRevision();
+    if (!m_cachedAggregatesRevision || (*m_cachedAggregatesRevision != revision)){
+      m_cachedFloorArea.reset();
+      m_cachedAggregatesRevision = revision;
+    }
+    return modelImpl->verifyCachedAggregates();
+  }
+
 } // detail
 
 SpaceType::SpaceType(const Model& model)
@@ -388,6 +388,15 @@ namespace detail {
 
     template <typename T>
     void removeAllButOneSpaceLoadInstance(std::vector<T>& instances, const T& instanceToKeep);
+
+    // clears the cached floor area if any space may have changed since it was cached,
+    // returns true if the cached value should be verified
+    bool checkCachedAggregates() const;
+
+    double computeFloorArea() const;
+
+    mutable boost::optional<unsigned> m_cachedAggregatesRevision;
+    mutable boost::optional<double> m_cachedFloorArea;
   };
 
 } // detail
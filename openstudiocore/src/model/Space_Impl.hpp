@@ -488,9 +488,28 @@ namespace detail {
     */
     std::vector<Point3d> floorPrint() const;
 
+    /** Clears cached floor area, exterior area, volume and number of people. Called by the
+     *  model when an object under this space changes. */
+    void clearCachedAggregates() const;
+
    private:
     REGISTER_LOGGER("openstudio.model.Space");
 
+    // clears cached aggregates if the model invalidated all of them since they were cached,
+    // returns true if cached values should be verified
+    bool checkCachedAggregates() const;
+
+    double computeFloorArea() const;
+    double computeExteriorArea() const;
+    double computeVolume() const;
+    double computeNumberOfPeople() const;
+
+    mutable boost::optional<unsigned> m_cachedAggregatesGeneration;
+    mutable boost::optional<double> m_cachedFloorArea;
+    mutable boost::optional<double> m_cachedExteriorArea;
+    mutable boost::optional<double> m_cachedVolume;
+    mutable boost::optional<double> m_cachedNumberOfPeople;
+
     openstudio::Quantity directionofRelativeNorth_SI() const;
     openstudio::Quantity directionofRelativeNorth_IP() const;
     bool setDirectionofRelativeNorth(const Quantity& directionofRelativeNorth);   
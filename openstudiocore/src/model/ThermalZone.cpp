@@ -661,6 +661,16 @@ namespace detail {
   }
 
   double ThermalZone_Impl::floorArea() const {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedFloorArea){
+      m_cachedFloorArea = computeFloorArea();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "floor area", *m_cachedFloorArea, computeFloorArea());
+    }
+    return m_cachedFloorArea.get();
+  }
+
+  double ThermalZone_Impl::computeFloorArea() const {
     double result(0.0);
     BOOST_FOREACH(const Space& space,spaces()) {
       result += space.floorArea();
@@ -669,6 +679,16 @@ namespace detail {
   }
 
   double ThermalZone_Impl::numberOfPeople() const {
+    bool verify = checkCachedAggregates();
+    if (!m_cachedNumberOfPeople){
+      m_cachedNumberOfPeople = computeNumberOfPeople();
+    }else if (verify){
+      model().getImpl<Model_Impl>()->verifyCachedAggregate(getObject<ModelObject>(), "number of people", *m_cachedNumberOfPeople, computeNumberOfPeople());
+    }
+    return m_cachedNumberOfPeople.get();
+  }
+
+  double ThermalZone_Impl::computeNumberOfPeople() const {
     double result(0.0);
     BOOST_FOREACH(const Space& space, spaces()) {
       result += space.numberOfPeople();
@@ -1694,6 +1714,18 @@ namespace detail {
     return tz;
   }
 
+  bool ThermalZone_Impl::checkCachedAggregates() const
+  {
+    boost::shared_ptr<Model_Impl> modelImpl = model().getImpl<Model_Impl>();
+    unsigned revision = modelImpl->aggregatesRevision();
+    if (!m_cachedAggregatesRevision || (*m_cachedAggregatesRevision != revision)){
+      m_cachedFloorArea.reset();
+      m_cachedNumberOfPeople.reset();
+      m_cachedAggregatesRevision = revision;
+    }
+    return modelImpl->verifyCachedAggregates();
+  }
+
 } // detail
 
 ThermalZone::ThermalZone(const Model& model)
@@ -401,6 +401,17 @@ namespace detail {
     bool setSecondaryDaylightingControlAsModelObject(const boost::optional<ModelObject>& modelObject);
     bool setIlluminanceMapAsModelObject(const boost::optional<ModelObject>& modelObject);
     bool setRenderingColorAsModelObject(const boost::optional<ModelObject>& modelObject);
+
+    // clears cached aggregates if any space may have changed since they were cached,
+    // returns true if cached values should be verified
+    bool checkCachedAggregates() const;
+
+    double computeFloorArea() const;
+    double computeNumberOfPeople() const;
+
+    mutable boost::optional<unsigned> m_cachedAggregatesRevision;
+    mutable boost::optional<double> m_cachedFloorArea;
+    mutable boost::optional<double> m_cachedNumberOfPeople;
   };
 
 } // detail
@@ -50,6 +50,7 @@
 #include <model/LifeCycleCost.hpp>
 
 #include <utilities/data/Attribute.hpp>
+#include <utilities/core/Compare.hpp>
 
 #include <boost/foreach.hpp>
 
@@ -303,4 +304,163 @@ TEST_F(ModelFixture, Building_Cost)
   EXPECT_DOUBLE_EQ(200, cost1->totalCost());
   EXPECT_DOUBLE_EQ(100, cost2->totalCost());
   EXPECT_DOUBLE_EQ(120, cost3->totalCost());
-}
\ No newline at end of file
+}
+
+TEST_F(ModelFixture, Building_CachedAggregates)
+{
+  Model model;
+  setVerifyCachedAggregates(model, true);
+
+  Building building = model.getUniqueModelObject<Building>();
+
+  Point3dVector floorPrint;
+  floorPrint.push_back(Point3d(0, 10, 0));
+  floorPrint.push_back(Point3d(10, 10, 0));
+  floorPrint.push_back(Point3d(10, 0, 0));
+  floorPrint.push_back(Point3d(0, 0, 0));
+
+  boost::optional<Space> space1 = Space::fromFloorPrint(floorPrint, 3, model);
+  ASSERT_TRUE(space1);
+  boost::optional<Space> space2 = Space::fromFloorPrint(floorPrint, 3, model);
+  ASSERT_TRUE(space2);
+
+  // every access below recomputes and throws if the cached value is stale
+  EXPECT_NEAR(100, space1->floorArea(), 0.0001);
+  EXPECT_NEAR(300, space1->volume(), 0.0001);
+  EXPECT_NEAR(200, building.floorArea(), 0.0001);
+  EXPECT_NEAR(0, building.numberOfPeople(), 0.0001);
+
+  // change geometry of one space
+  boost::optional<Surface> floor1;
+  BOOST_FOREACH(const Surface& surface, space1->surfaces()) {
+    if (istringEqual("Floor", surface.surfaceType())) {
+      floor1 = surface;
+    }
+  }
+  ASSERT_TRUE(floor1);
+  Point3dVector smallFloor;
+  smallFloor.push_back(Point3d(0, 5, 0));
+  smallFloor.push_back(Point3d(5, 5, 0));
+  smallFloor.push_back(Point3d(5, 0, 0));
+  smallFloor.push_back(Point3d(0, 0, 0));
+  EXPECT_TRUE(floor1->setVertices(smallFloor));
+  EXPECT_NEAR(25, space1->floorArea(), 0.0001);
+  EXPECT_NEAR(100, space2->floorArea(), 0.0001);
+  EXPECT_NEAR(125, building.floorArea(), 0.0001);
+
+  // move the floor to the other space
+  EXPECT_TRUE(floor1->setSpace(*space2));
+  EXPECT_NEAR(0, space1->floorArea(), 0.0001);
+  EXPECT_NEAR(125, space2->floorArea(), 0.0001);
+  EXPECT_NEAR(125, building.floorArea(), 0.0001);
+
+  // loads on the space and on a shared definition
+  PeopleDefinition peopleDefinition(model);
+  EXPECT_TRUE(peopleDefinition.setNumberofPeople(2));
+  People people(peopleDefinition);
+  EXPECT_TRUE(people.setSpace(*space2));
+  EXPECT_NEAR(2, space2->numberOfPeople(), 0.0001);
+  EXPECT_NEAR(2, building.numberOfPeople(), 0.0001);
+  EXPECT_TRUE(peopleDefinition.setNumberofPeople(4));
+  EXPECT_NEAR(4, space2->numberOfPeople(), 0.0001);
+  EXPECT_NEAR(4, building.numberOfPeople(), 0.0001);
+  EXPECT_NEAR(125.0 / 4.0, building.floorAreaPerPerson(), 0.0001);
+
+  // space and zone attributes
+  space2->setPartofTotalFloorArea(false);
+  EXPECT_NEAR(0, building.floorArea(), 0.0001);
+  space2->resetPartofTotalFloorArea();
+  ThermalZone thermalZone(model);
+  EXPECT_TRUE(space2->setThermalZone(thermalZone));
+  EXPECT_TRUE(thermalZone.setMultiplier(2));
+  EXPECT_NEAR(250, building.floorArea(), 0.0001);
+  EXPECT_NEAR(8, building.numberOfPeople(), 0.0001);
+  EXPECT_NEAR(125, thermalZone.floorArea(), 0.0001);
+  EXPECT_NEAR(4, thermalZone.numberOfPeople(), 0.0001);
+  EXPECT_TRUE(space1->setThermalZone(thermalZone));
+  EXPECT_NEAR(125, thermalZone.floorArea(), 0.0001);
+  EXPECT_TRUE(peopleDefinition.setNumberofPeople(6));
+  EXPECT_NEAR(6, thermalZone.numberOfPeople(), 0.0001);
+
+  SpaceType spaceType(model);
+  EXPECT_NEAR(0, spaceType.floorArea(), 0.0001);
+  EXPECT_TRUE(space2->setSpaceType(spaceType));
+  EXPECT_NEAR(250, spaceType.floorArea(), 0.0001);
+  EXPECT_TRUE(space1->setSpaceType(spaceType));
+  EXPECT_NEAR(250, spaceType.floorArea(), 0.0001);
+  EXPECT_TRUE(thermalZone.setMultiplier(1));
+  EXPECT_NEAR(125, spaceType.floorArea(), 0.0001);
+
+  // removal
+  floor1->remove();
+  EXPECT_NEAR(100, space2->floorArea(), 0.0001);
+  EXPECT_NEAR(200, building.floorArea(), 0.0001);
+  space1->remove();
+  EXPECT_NEAR(200, building.floorArea(), 0.0001);
+  EXPECT_NEAR(100, thermalZone.floorArea(), 0.0001);
+  EXPECT_NEAR(100, spaceType.floorArea(), 0.0001);
+  people.remove();
+  EXPECT_NEAR(0, building.numberOfPeople(), 0.0001);
+  EXPECT_NEAR(0, thermalZone.numberOfPeople(), 0.0001);
+}
+
+TEST_F(ModelFixture, Building_CachedAggregates_Transaction)
+{
+  Model model;
+  setVerifyCachedAggregates(model, true);
+
+  Building building = model.getUniqueModelObject<Building>();
+
+  Point3dVector floorPrint;
+  floorPrint.push_back(Point3d(0, 10, 0));
+  floorPrint.push_back(Point3d(10, 10, 0));
+  floorPrint.push_back(Point3d(10, 0, 0));
+  floorPrint.push_back(Point3d(0, 0, 0));
+
+  boost::optional<Space> space = Space::fromFloorPrint(floorPrint, 3, model);
+  ASSERT_TRUE(space);
+  ThermalZone thermalZone(model);
+  EXPECT_TRUE(space->setThermalZone(thermalZone));
+  EXPECT_NEAR(100, space->floorArea(), 0.0001);
+  EXPECT_NEAR(100, thermalZone.floorArea(), 0.0001);
+  EXPECT_NEAR(100, building.floorArea(), 0.0001);
+
+  boost::optional<Surface> floor;
+  BOOST_FOREACH(const Surface& surface, space->surfaces()) {
+    if (istringEqual("Floor", surface.surfaceType())) {
+      floor = surface;
+    }
+  }
+  ASSERT_TRUE(floor);
+  Point3dVector smallFloor;
+  smallFloor.push_back(Point3d(0, 5, 0));
+  smallFloor.push_back(Point3d(5, 5, 0));
+  smallFloor.push_back(Point3d(5, 0, 0));
+  smallFloor.push_back(Point3d(0, 0, 0));
+
+  // edits are seen inside the transaction even though their signals are held
+  {
+    WorkspaceTransaction transaction(model);
+    EXPECT_TRUE(floor->setVertices(smallFloor));
+    EXPECT_NEAR(25, space->floorArea(), 0.0001);
+    EXPECT_NEAR(25, thermalZone.floorArea(), 0.0001);
+    EXPECT_NEAR(25, building.floorArea(), 0.0001);
+  }
+
+  // and values cached inside the transaction are dropped by the rollback
+  EXPECT_FALSE(model.inTransaction());
+  EXPECT_NEAR(100, space->floorArea(), 0.0001);
+  EXPECT_NEAR(100, thermalZone.floorArea(), 0.0001);
+  EXPECT_NEAR(100, building.floorArea(), 0.0001);
+
+  // or by the commit
+  {
+    WorkspaceTransaction transaction(model);
+    EXPECT_TRUE(floor->setVertices(smallFloor));
+    EXPECT_NEAR(25, building.floorArea(), 0.0001);
+    EXPECT_TRUE(transaction.commit());
+  }
+  EXPECT_NEAR(25, space->floorArea(), 0.0001);
+  EXPECT_NEAR(25, thermalZone.floorArea(), 0.0001);
+  EXPECT_NEAR(25, building.floorArea(), 0.0001);
+}
@@ -18,6 +18,7 @@
 **********************************************************************/
 
 #include <model/test/ModelFixture.hpp>
+#include <model/Model_Impl.hpp>
 
 #include <utilities/idd/IddKey.hpp>
 #include <utilities/core/Finder.hpp>
@@ -65,5 +66,10 @@ void ModelFixture::testBooleanIddField(const openstudio::IddField& iddField,
   }
 }
 
+void ModelFixture::setVerifyCachedAggregates(openstudio::model::Model& model, bool verify)
+{
+  model.getImpl<openstudio::model::detail::Model_Impl>()->setVerifyCachedAggregates(verify);
+}
+
 double ModelFixture::tol(1.0E-5);
 boost::optional<openstudio::FileLogSink> ModelFixture::logFile;
@@ -49,6 +49,10 @@ class ModelFixture : public ::testing::Test {
   void testBooleanIddField(const openstudio::IddField& iddField,
                            const boost::optional<std::string>& defaultValue);
 
+  // check cached Space, ThermalZone, SpaceType and Building aggregates against a fresh
+  // computation on every access, throwing on mismatch
+  static void setVerifyCachedAggregates(openstudio::model::Model& model, bool verify);
+
   // set up logging
   REGISTER_LOGGER("ModelFixture");
 
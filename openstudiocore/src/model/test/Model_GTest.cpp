@@ -734,3 +734,33 @@ TEST_F(ModelFixture,Model_BadSwaps) {
   EXPECT_ANY_THROW(workspace.swap(model));
   EXPECT_ANY_THROW(model.swap(workspace));
 }
+
+
+TEST_F(ModelFixture, Model_CloneNewHandlesSharesFields) {
+  Model model = exampleModel();
+  Model modelClone = model.clone().cast<Model>();
+
+  typedef std::map<std::string,IdfObjectMemoryUsage> UsageMap;
+  IdfObjectMemoryUsage total;
+  BOOST_FOREACH(const UsageMap::value_type& p, modelClone.memoryUsage()) {
+    total += p.second;
+  }
+  // new handles are kept out of the field tables, so none of them is copied by the clone
+  EXPECT_EQ(modelClone.objects().size(), total.numObjects);
+  EXPECT_EQ(total.numObjects, total.numSharedFieldTables);
+
+  Space space = model.getModelObjects<Space>()[0];
+  ASSERT_TRUE(space.name());
+  boost::optional<Space> spaceClone = modelClone.getModelObjectByName<Space>(*space.name());
+  ASSERT_TRUE(spaceClone);
+  EXPECT_NE(space.handle(), spaceClone->handle());
+  ASSERT_TRUE(spaceClone->getString(0));
+  EXPECT_EQ(toString(spaceClone->handle()), spaceClone->getString(0).get());
+  EXPECT_EQ(toString(spaceClone->handle()), spaceClone->idfObject().getString(0).get());
+
+  // editing the clone copies its fields without touching the original
+  EXPECT_TRUE(spaceClone->setName("Cloned Space"));
+  EXPECT_EQ("Cloned Space", spaceClone->name().get());
+  EXPECT_NE("Cloned Space", space.name().get());
+  EXPECT_EQ(toString(space.handle()), space.getString(0).get());
+}
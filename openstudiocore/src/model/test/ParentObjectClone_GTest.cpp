@@ -0,0 +1,160 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <model/test/ModelFixture.hpp>
+
+#include <model/AirLoopHVAC.hpp>
+#include <model/FanConstantVolume.hpp>
+#include <model/Lights.hpp>
+#include <model/LightsDefinition.hpp>
+#include <model/LifeCycleCost.hpp>
+#include <model/Node.hpp>
+#include <model/ScheduleCompact.hpp>
+#include <model/Space.hpp>
+#include <model/SubSurface.hpp>
+#include <model/Surface.hpp>
+
+#include <utilities/geometry/Point3d.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/timer.hpp>
+
+using namespace openstudio;
+using namespace openstudio::model;
+
+TEST_F(ModelFixture, Space_ClonePerformance)
+{
+  unsigned number = 500;
+
+  Model model;
+  Space space(model);
+  LightsDefinition definition(model);
+
+  for (unsigned i = 0; i < number; ++i) {
+    double x = 4.0 * i;
+
+    Point3dVector points;
+    points.push_back(Point3d(x, 4, 0));
+    points.push_back(Point3d(x, 0, 0));
+    points.push_back(Point3d(x + 4, 0, 0));
+    points.push_back(Point3d(x + 4, 4, 0));
+    Surface surface(points, model);
+    EXPECT_TRUE(surface.setSpace(space));
+
+    points.clear();
+    points.push_back(Point3d(x + 1, 3, 0));
+    points.push_back(Point3d(x + 1, 1, 0));
+    points.push_back(Point3d(x + 3, 1, 0));
+    points.push_back(Point3d(x + 3, 3, 0));
+    SubSurface subSurface(points, model);
+    EXPECT_TRUE(subSurface.setSurface(surface));
+
+    Lights lights(definition);
+    EXPECT_TRUE(lights.setSpace(space));
+  }
+
+  boost::optional<LifeCycleCost> cost = LifeCycleCost::createLifeCycleCost("Space Cost", space, 1.0, "CostPerEach", "Construction");
+  ASSERT_TRUE(cost);
+
+  boost::timer t;
+  ModelObject clone = space.clone(model);
+  double sameModel = t.elapsed();
+
+  ASSERT_TRUE(clone.optionalCast<Space>());
+  Space spaceClone = clone.cast<Space>();
+  EXPECT_NE(space.handle(), spaceClone.handle());
+  ASSERT_EQ(number, spaceClone.surfaces().size());
+  BOOST_FOREACH(const Surface& surface, spaceClone.surfaces()) {
+    ASSERT_TRUE(surface.space());
+    EXPECT_EQ(spaceClone.handle(), surface.space()->handle());
+    std::vector<SubSurface> subSurfaces = surface.subSurfaces();
+    ASSERT_EQ(1u, subSurfaces.size());
+    ASSERT_TRUE(subSurfaces[0].surface());
+    EXPECT_EQ(surface.handle(), subSurfaces[0].surface()->handle());
+  }
+  ASSERT_EQ(number, spaceClone.lights().size());
+  BOOST_FOREACH(const Lights& lights, spaceClone.lights()) {
+    ASSERT_TRUE(lights.space());
+    EXPECT_EQ(spaceClone.handle(), lights.space()->handle());
+  }
+  // the original keeps its own children
+  EXPECT_EQ(number, space.surfaces().size());
+  EXPECT_EQ(number, space.lights().size());
+  EXPECT_EQ(1u, spaceClone.lifeCycleCosts().size());
+  EXPECT_EQ(2 * number, model.getModelObjects<Surface>().size());
+  EXPECT_EQ(2 * number, model.getModelObjects<SubSurface>().size());
+  // resources are shared within a model
+  EXPECT_EQ(1u, model.getModelObjects<LightsDefinition>().size());
+  EXPECT_EQ(definition.handle(), spaceClone.lights()[0].lightsDefinition().handle());
+
+  Model otherModel;
+  t.restart();
+  clone = space.clone(otherModel);
+  double otherModelTime = t.elapsed();
+
+  ASSERT_TRUE(clone.optionalCast<Space>());
+  spaceClone = clone.cast<Space>();
+  EXPECT_EQ(number, spaceClone.surfaces().size());
+  BOOST_FOREACH(const Surface& surface, spaceClone.surfaces()) {
+    ASSERT_TRUE(surface.space());
+    EXPECT_EQ(spaceClone.handle(), surface.space()->handle());
+    EXPECT_EQ(1u, surface.subSurfaces().size());
+  }
+  EXPECT_EQ(number, otherModel.getModelObjects<SubSurface>().size());
+  EXPECT_EQ(number, spaceClone.lights().size());
+  // resources are brought along once
+  EXPECT_EQ(1u, otherModel.getModelObjects<LightsDefinition>().size());
+
+  LOG(Info, "Cloned space with " << number << " surfaces, sub surfaces and lights in "
+      << sameModel << "s within its model and in " << otherModelTime << "s into a new model");
+}
+
+TEST_F(ModelFixture, AirLoopHVAC_ClonePerformance)
+{
+  unsigned number = 20;
+
+  Model model;
+  ScheduleCompact schedule(model);
+  AirLoopHVAC airLoop(model);
+  FanConstantVolume fan(model, schedule);
+  Node supplyOutletNode = airLoop.supplyOutletNode();
+  ASSERT_TRUE(fan.addToNode(supplyOutletNode));
+
+  boost::timer t;
+  for (unsigned i = 0; i < number; ++i) {
+    ModelObject clone = airLoop.clone(model);
+    EXPECT_TRUE(clone.optionalCast<AirLoopHVAC>());
+  }
+  double elapsed = t.elapsed();
+
+  std::vector<AirLoopHVAC> airLoops = model.getModelObjects<AirLoopHVAC>();
+  EXPECT_EQ(number + 1, airLoops.size());
+  EXPECT_EQ(number + 1, model.getModelObjects<FanConstantVolume>().size());
+  BOOST_FOREACH(AirLoopHVAC loop, airLoops) {
+    // each loop owns its own fan on its supply side
+    std::vector<ModelObject> fans = loop.supplyComponents(FanConstantVolume::iddObjectType());
+    ASSERT_EQ(1u, fans.size());
+    ASSERT_TRUE(fans[0].cast<FanConstantVolume>().airLoopHVAC());
+    EXPECT_EQ(loop.handle(), fans[0].cast<FanConstantVolume>().airLoopHVAC()->handle());
+  }
+
+  LOG(Info, "Cloned air loop " << number << " times in " << elapsed << "s");
+}
@@ -58,6 +58,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/bind.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 
 namespace openstudio {
 namespace osversion {
@@ -230,6 +231,10 @@ std::vector< std::pair<IdfObject,IdfObject> > VersionTranslator::refactoredObjec
   return m_refactored;
 }
 
+std::vector< std::pair<VersionString,double> > VersionTranslator::updateStepTimes() const {
+  return m_stepTimes;
+}
+
 boost::optional<model::Model> VersionTranslator::updateVersion(std::istream& is, 
                                                                bool isComponent,
                                                                ProgressBar* progressBar) {
@@ -241,6 +246,7 @@ boost::optional<model::Model> VersionTranslator::updateVersion(std::istream& is,
   m_untranslated.clear();
   m_new.clear();
   m_refactored.clear();
+  m_stepTimes.clear();
   m_nObjectsStart = 0;
   m_nObjectsFinalIdf = 0;
   m_nObjectsFinalModel = 0;
@@ -401,9 +407,10 @@ void VersionTranslator::update(const VersionString& startVersion) {
   std::map<VersionString, IdfFile>::const_iterator start = m_map.find(startVersion);
   if (start != m_map.end()) {
 
-    std::string translatedIdf;
+    boost::posix_time::ptime stepStart = boost::posix_time::microsec_clock::universal_time();
+
     VersionString lastVersion("0.0.0");
-    boost::optional<IddFileAndFactoryWrapper> oIddFile;
+    std::map<VersionString, OSVersionUpdater>::const_iterator method = m_updateMethods.end();
     for (std::map<VersionString, OSVersionUpdater>::const_iterator it = m_updateMethods.begin(),
          itEnd = m_updateMethods.end(); it != itEnd; ++it)
     {
@@ -411,67 +418,106 @@ void VersionTranslator::update(const VersionString& startVersion) {
       OS_ASSERT(lastVersion < it->first);
       lastVersion = it->first;
       if (startVersion < it->first) {
-        oIddFile = getIddFile(it->first);
-        translatedIdf = it->second(this,start->second,*oIddFile);
+        method = it;
         break;
       }
     }
 
-    if (translatedIdf.empty()) {
+    if (method == m_updateMethods.end()) {
       LOG(Error,"Unable to complete translation from " << startVersion.str() << " to "
           << lastVersion.str() << ". Unable to find and execute the appropriate update method.");
       return;
     }
-    std::stringstream ss(translatedIdf);
-    OptionalIdfFile oIdfFile;
-    if (oIddFile->iddFileType() == IddFileType::UserCustom) {
-      oIdfFile = IdfFile::load(ss,oIddFile->iddFile());
+
+    // the translated file is passed on to the next step as is, it is never printed and re-parsed
+    m_targetIddObjects.clear();
+    IdfFile idfFile = method->second(this,start->second,getIddFile(lastVersion));
+    m_map[idfFile.version()] = idfFile;
+    double seconds = (boost::posix_time::microsec_clock::universal_time() - stepStart).total_microseconds() / 1.0e6;
+    m_stepTimes.push_back(std::make_pair(idfFile.version(),seconds));
+    LOG(Debug,"Translation to " << lastVersion.str() << " model has " << idfFile.numObjects()
+        << " objects, and took " << seconds << " s.");
+  }
+}
+
+IdfFile VersionTranslator::newTargetIdf(const IdfFile& idf,
+                                        const IddFileAndFactoryWrapper& targetIdd)
+{
+  IdfFile result = (targetIdd.iddFileType() == IddFileType::UserCustom) ?
+                   IdfFile(targetIdd.iddFile()) :
+                   IdfFile(targetIdd.iddFileType());
+  result.setHeader(idf.header());
+  return result;
+}
+
+void VersionTranslator::addObject(IdfFile& targetIdf,
+                                  const IdfObject& object,
+                                  const IddFileAndFactoryWrapper& targetIdd)
+{
+  // look up by name, since IddObjectTypes are only meaningful for the current version
+  std::string name = object.iddObject().name();
+  OptionalIddObject targetIddObject;
+  std::map<std::string,IddObject>::const_iterator it = m_targetIddObjects.find(name);
+  if (it != m_targetIddObjects.end()) {
+    targetIddObject = it->second;
+  }
+  else {
+    if (object.iddObject().type() == IddObjectType::CommentOnly) {
+      targetIddObject = targetIdd.getObject(IddObjectType::CommentOnly);
     }
     else {
-      oIdfFile = IdfFile::load(ss,oIddFile->iddFileType());
+      targetIddObject = targetIdd.getObject(name);
     }
-    if (!oIdfFile) {
-      LOG(Error,"Unable to complete translation from " << startVersion.str()
-          << " to " << lastVersion.str() << ". Could not load translated IDF using the "
-          << "latter version's IddFile. Translated text: " << std::endl << translatedIdf);
-      return;
+    if (targetIddObject) {
+      m_targetIddObjects.insert(std::make_pair(name,*targetIddObject));
+    }
+  }
+
+  if (!targetIddObject) {
+    LOG(Warn,"Unable to find " << name << " in the Version " << targetIdf.version().str()
+        << " IDD. Removing " << object.briefDescription() << " from the model.");
+    m_untranslated.push_back(object);
+    return;
+  }
+
+  targetIdf.addObject(object.cloneWithIddObject(*targetIddObject));
+}
+
+void VersionTranslator::copyField(const IdfObject& source,
+                                  unsigned sourceIndex,
+                                  IdfObject& target,
+                                  unsigned targetIndex)
+{
+  if (sourceIndex < source.numFields()) {
+    target.setString(targetIndex,source.getString(sourceIndex).get());
+    OptionalString comment = source.fieldComment(sourceIndex);
+    if (comment && !comment->empty()) {
+      target.setFieldComment(targetIndex,*comment);
     }
-    IdfFile idfFile = *oIdfFile;
-    m_map[oIdfFile->version()] = idfFile;
-    LOG(Debug,"Translation to " << lastVersion.str() << " model has " << oIdfFile->numObjects()
-        << " objects.");
   }
 }
 
-std::string VersionTranslator::defaultUpdate(const IdfFile& idf,
-                                             const IddFileAndFactoryWrapper& targetIdd)
+IdfFile VersionTranslator::defaultUpdate(const IdfFile& idf,
+                                         const IddFileAndFactoryWrapper& targetIdd)
 {
   // use for version increments with no IDD changes
-  std::stringstream ss;
-
-  ss << idf.header() << std::endl << std::endl;
 
-  // new version object
-  IdfFile targetIdf(targetIdd.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf,targetIdd);
 
   // all other objects
   BOOST_FOREACH(const IdfObject& object,idf.objects()) {
-    ss << object;
+    addObject(targetIdf,object,targetIdd);
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2) {
+IdfFile VersionTranslator::update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2) {
   // Url field refinements
-  std::stringstream ss;
 
-  ss << idf_0_7_1.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_7_2.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_7_1,idd_0_7_2);
 
   // all other objects
   BOOST_FOREACH(const IdfObject& object,idf_0_7_1.objects()) {
@@ -486,10 +532,10 @@ std::string VersionTranslator::update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, c
       toPrint = updateUrlField_0_7_1_to_0_7_2(object,1);
     }
 
-    ss << toPrint;
+    addObject(targetIdf,toPrint,idd_0_7_2);
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
 IdfObject VersionTranslator::updateUrlField_0_7_1_to_0_7_2(const IdfObject& object, unsigned index) {
@@ -513,15 +559,11 @@ IdfObject VersionTranslator::updateUrlField_0_7_1_to_0_7_2(const IdfObject& obje
   return result;
 }
 
-std::string VersionTranslator::update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3) {
+IdfFile VersionTranslator::update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3) {
   // use for version increments with no IDD changes
-  std::stringstream ss;
-
-  ss << idf_0_7_2.header() << std::endl << std::endl;
 
-  // new version object
-  IdfFile targetIdf(idd_0_7_3.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_7_2,idd_0_7_3);
 
   // all other objects
   BOOST_FOREACH(const IdfObject& object,idf_0_7_2.objects()) {
@@ -530,23 +572,18 @@ std::string VersionTranslator::update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, c
       LOG(Warn,"This model contains an out-of-date " << object.iddObject().name() << " object. "
           << "In particular, it needs a bypass branch added in order to run properly in EnergyPlus.");
     }
-    ss << object;
+    addObject(targetIdf,object,idd_0_7_3);
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, const IddFileAndFactoryWrapper& idd_0_7_4) {
-  std::stringstream ss;
+IdfFile VersionTranslator::update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, const IddFileAndFactoryWrapper& idd_0_7_4) {
   IddObject componentDataIdd = idd_0_7_4.getObject("OS:ComponentData").get();
   IdfObject componentDataIdf(componentDataIdd);
-  int fs = IdfObject::printedFieldSpace();
 
-  ss << idf_0_7_3.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_7_4.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_7_3,idd_0_7_4);
 
   // all other objects
   BOOST_FOREACH(IdfObject object, idf_0_7_3.objects()) {
@@ -559,20 +596,13 @@ std::string VersionTranslator::update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, c
       continue;
     }
 
-    std::stringstream objectSS;
-    object.printName(objectSS);
-    std::string handleStr = toString(object.handle());
-    objectSS << "  " << handleStr;
-    if (object.numFields() == 0) {
-      objectSS << ";";
-    }
-    else {
-      objectSS << ",";
-    }
-    for (int cnt = handleStr.size(); cnt < fs; ++cnt) {
-      objectSS << " ";
+    if (object.iddObject().type() == IddObjectType::CommentOnly) {
+      addObject(targetIdf,object,idd_0_7_4);
+      continue;
     }
-    objectSS << "  " << componentDataIdf.fieldComment(0,true) << std::endl;
+
+    // the handle is now stored as the first field
+    std::string handleStr = toString(object.handle());
 
     if (istringEqual(object.iddObject().name(),"OS:ComponentData")) {
       // create new, refactored OS:ComponentData object from original data
@@ -698,15 +728,10 @@ std::string VersionTranslator::update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, c
         continue;
       }
 
-      for (unsigned i = 1, n = componentDataIdf.numFields(); i < n; ++i) {
-        if (i == n - 1) {
-          componentDataIdf.printField(objectSS,i,true);
-        }
-        else {
-          componentDataIdf.printField(objectSS,i);
-        }
-      }
+      componentDataIdf.setComment(object.comment());
+      componentDataIdf.setString(0,handleStr);
       m_refactored.push_back( std::pair<IdfObject,IdfObject>(object,componentDataIdf) );
+      addObject(targetIdf,componentDataIdf,idd_0_7_4);
     }
     else
     {
@@ -738,21 +763,25 @@ std::string VersionTranslator::update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, c
         }
       }
 
-      // loop over all the fields
+      OptionalIddObject iddObject = idd_0_7_4.getObject(object.iddObject().name());
+      if (!iddObject) {
+        // addObject logs and lists the object as untranslated
+        addObject(targetIdf,object,idd_0_7_4);
+        continue;
+      }
+
+      // loop over all the fields, shifting each one to make room for the handle
+      IdfObject newObject(*iddObject);
+      newObject.setComment(object.comment());
+      newObject.setString(0,handleStr);
       for (unsigned i = 0, n = object.numFields(); i < n; ++i) {
-        if (i == n - 1) {
-          object.printField(objectSS,i,true);
-        }
-        else {
-          object.printField(objectSS,i);
-        }
+        copyField(object, i, newObject, i + 1);
       }
+      addObject(targetIdf,newObject,idd_0_7_4);
     }
-
-    ss << objectSS.str();
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
 std::vector< boost::shared_ptr<VersionTranslator::InterobjectIssueInformation> >
@@ -1152,16 +1181,12 @@ void VersionTranslator::fixInterobjectIssuesStage2_0_8_3_to_0_8_4(
 
 }
 
-std::string VersionTranslator::update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, const IddFileAndFactoryWrapper& idd_0_9_2)
+IdfFile VersionTranslator::update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, const IddFileAndFactoryWrapper& idd_0_9_2)
 {
   // use for version increments with no IDD changes
-  std::stringstream ss;
-
-  ss << idf_0_9_1.header() << std::endl << std::endl;
 
-  // new version object
-  IdfFile targetIdf(idd_0_9_2.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_9_1,idd_0_9_2);
 
   // Fixup all thermal zone objects
   BOOST_FOREACH(const IdfObject& object,idf_0_9_1.objects()) {
@@ -1357,10 +1382,10 @@ std::string VersionTranslator::update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, c
         }
       }
 
-      ss << newThermalZone;
-      ss << newInletPortList;
-      ss << newExhaustPortList;
-      ss << newZoneHVACEquipmentList;
+      addObject(targetIdf,newThermalZone,idd_0_9_2);
+      addObject(targetIdf,newInletPortList,idd_0_9_2);
+      addObject(targetIdf,newExhaustPortList,idd_0_9_2);
+      addObject(targetIdf,newZoneHVACEquipmentList,idd_0_9_2);
 
       m_new.push_back(newInletPortList);
       m_new.push_back(newExhaustPortList);
@@ -1368,7 +1393,7 @@ std::string VersionTranslator::update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, c
 
       if( newFPTSecondaryInletConn )
       {
-        ss << newFPTSecondaryInletConn.get();
+        addObject(targetIdf,newFPTSecondaryInletConn.get(),idd_0_9_2);
       }
     }
   }
@@ -1376,14 +1401,14 @@ std::string VersionTranslator::update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, c
   BOOST_FOREACH(const IdfObject& object,idf_0_9_1.objects()) {
     if( object.iddObject().name() != "OS:ThermalZone" )
     {
-      ss << object;
+      addObject(targetIdf,object,idd_0_9_2);
     }
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6)
+IdfFile VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6)
 {
   // if multiple OS:RunPeriod objects remove them all
   bool skipRunPeriods = false;
@@ -1404,13 +1429,9 @@ std::string VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, c
   }
 
   // use for version increments with no IDD changes
-  std::stringstream ss;
-
-  ss << idf_0_9_5.header() << std::endl << std::endl;
 
-  // new version object
-  IdfFile targetIdf(idd_0_9_6.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_9_5,idd_0_9_6);
 
   BOOST_FOREACH(const IdfObject& object,idf_0_9_5.objects()) {
     if( object.iddObject().name() == "OS:PlantLoop" )
@@ -1427,11 +1448,11 @@ std::string VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, c
 
       newSizingPlant.setDouble(4,0.001);
 
-      ss << newSizingPlant;
+      addObject(targetIdf,newSizingPlant,idd_0_9_6);
 
       m_new.push_back(newSizingPlant);
 
-      ss << object;
+      addObject(targetIdf,object,idd_0_9_6);
     }
     else if( object.iddObject().name() == "OS:Sizing:Parameters" )
     {
@@ -1447,7 +1468,7 @@ std::string VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, c
         newSizingParameters.setDouble(2,1.15);
       }
 
-      ss << newSizingParameters;
+      addObject(targetIdf,newSizingParameters,idd_0_9_6);
     }
     else if( object.iddObject().name() == "OS:RunPeriod" )
     {
@@ -1457,28 +1478,24 @@ std::string VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, c
       }
       else
       {
-        ss << object;
+        addObject(targetIdf,object,idd_0_9_6);
       }
     }
     else
     {
-      ss << object;
+      addObject(targetIdf,object,idd_0_9_6);
     }
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1)
+IdfFile VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1)
 {
   // use for version increments with no IDD changes
-  std::stringstream ss;
 
-  ss << idf_0_11_0.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_11_1.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_11_0,idd_0_11_1);
 
   // hold OS:ComponentData objects for later
   std::vector<IdfObject> componentDataObjects;
@@ -1496,7 +1513,7 @@ std::string VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0
     }
     else
     {
-      ss << object;
+      addObject(targetIdf,object,idd_0_11_1);
     }
   }
 
@@ -1519,13 +1536,14 @@ std::string VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0
     }
 
     // translate base fields
-    componentDataObject.printName(ss,true);
-    componentDataObject.printField(ss, 0, false); // Handle
-    componentDataObject.printField(ss, 1, false); // Name
-    componentDataObject.printField(ss, 2, false); // UUID
-    componentDataObject.printField(ss, 3, false); // Version UUID
-    componentDataObject.printField(ss, 4, false); // Creation Timestamp
-    componentDataObject.printField(ss, 5, false); // Version Timestamp
+    IdfObject newComponentData(idd_0_11_1.getObject("OS:ComponentData").get());
+    newComponentData.setComment(componentDataObject.comment());
+    copyField(componentDataObject, 0, newComponentData, 0); // Handle
+    copyField(componentDataObject, 1, newComponentData, 1); // Name
+    copyField(componentDataObject, 2, newComponentData, 2); // UUID
+    copyField(componentDataObject, 3, newComponentData, 3); // Version UUID
+    copyField(componentDataObject, 4, newComponentData, 4); // Creation Timestamp
+    copyField(componentDataObject, 5, newComponentData, 5); // Version Timestamp
 
     // make list of fields to keep
     std::vector<unsigned> extensibleIndicesToKeep;
@@ -1539,32 +1557,26 @@ std::string VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0
     }
 
     // write out remaining fields
+    unsigned index = 6;
     for(std::vector<unsigned>::const_iterator it = extensibleIndicesToKeep.begin(), itend = extensibleIndicesToKeep.end(); it < itend; ++it){
-      if (it == itend-1){
-        componentDataObject.printField(ss, *it, true);
-      }else{
-        componentDataObject.printField(ss, *it, false);
-      }
+      copyField(componentDataObject, *it, newComponentData, index++);
     }
 
+    addObject(targetIdf,newComponentData,idd_0_11_1);
+
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1, const IddFileAndFactoryWrapper& idd_0_11_2)
+IdfFile VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1, const IddFileAndFactoryWrapper& idd_0_11_2)
 {
   // This version update has two things to do.  
   // Make updates for new control related objects.
   // Make updates for component costs.
 
-  std::stringstream ss;
-
-  ss << idf_0_11_1.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_11_2.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_11_1,idd_0_11_2);
 
   // hold OS:ComponentData objects for later
   std::vector<IdfObject> componentDataObjects;
@@ -1628,9 +1640,9 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
       alwaysOnSchedule->setString(2,typeLimits.getString(0).get());
 
 
-      ss << alwaysOnSchedule.get();
+      addObject(targetIdf,alwaysOnSchedule.get(),idd_0_11_2);
 
-      ss << typeLimits;
+      addObject(targetIdf,typeLimits,idd_0_11_2);
 
       m_new.push_back(alwaysOnSchedule.get());
 
@@ -1657,9 +1669,9 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
       newOAController.setString(20,newMechVentController.getString(0).get());
       
 
-      ss << newOAController;
+      addObject(targetIdf,newOAController,idd_0_11_2);
 
-      ss << newMechVentController;
+      addObject(targetIdf,newMechVentController,idd_0_11_2);
 
       m_new.push_back(newMechVentController);
     }
@@ -1695,13 +1707,13 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
       eg.setString(0,newAvailabilityManagerNightCycle.getString(0).get());
 
 
-      ss << newAirLoopHVAC;
+      addObject(targetIdf,newAirLoopHVAC,idd_0_11_2);
 
-      ss << newAvailList;
+      addObject(targetIdf,newAvailList,idd_0_11_2);
 
-      ss << newAvailabilityManagerScheduled;
+      addObject(targetIdf,newAvailabilityManagerScheduled,idd_0_11_2);
 
-      ss << newAvailabilityManagerNightCycle;
+      addObject(targetIdf,newAvailabilityManagerNightCycle,idd_0_11_2);
 
       m_new.push_back(newAvailList);
 
@@ -1715,7 +1727,7 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
 
       // this was made unique, remove if more than 1
       if (numComponentCostAdjustment == 1){
-        ss << object;
+        addObject(targetIdf,object,idd_0_11_2);
       }else{
         numComponentCostAdjustmentRemoved += 1;
         removedItemHandles.push_back(toString(object.handle()));
@@ -1736,17 +1748,16 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
     }
     else if( object.iddObject().name() == "OS:LifeCycleCost:Parameters" )
     {
-      object.printName(ss,true);
-      object.printField(ss, 0, false); // Handle
-      ss << "Custom, !- AnalysisType" << std::endl; // Name -> AnalysisType
+      IdfObject newParameters(idd_0_11_2.getObject("OS:LifeCycleCost:Parameters").get());
+      newParameters.setComment(object.comment());
+      copyField(object, 0, newParameters, 0); // Handle
+      newParameters.setString(1, "Custom"); // Name -> AnalysisType
 
       for(unsigned i = 2, imax = 12; i < imax; ++i){
-        if (i == imax-1){
-          object.printField(ss, i, true);
-        }else{
-          object.printField(ss, i, false);
-        }
+        copyField(object, i, newParameters, i);
       }
+
+      addObject(targetIdf,newParameters,idd_0_11_2);
     }
     else if( object.iddObject().name() == "OS:ComponentData" )
     {
@@ -1754,7 +1765,7 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
     }
     else
     {
-      ss << object;
+      addObject(targetIdf,object,idd_0_11_2);
     }
   }
 
@@ -1783,13 +1794,14 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
     }
 
     // translate base fields
-    componentDataObject.printName(ss,true);
-    componentDataObject.printField(ss, 0, false); // Handle
-    componentDataObject.printField(ss, 1, false); // Name
-    componentDataObject.printField(ss, 2, false); // UUID
-    componentDataObject.printField(ss, 3, false); // Version UUID
-    componentDataObject.printField(ss, 4, false); // Creation Timestamp
-    componentDataObject.printField(ss, 5, false); // Version Timestamp
+    IdfObject newComponentData(idd_0_11_2.getObject("OS:ComponentData").get());
+    newComponentData.setComment(componentDataObject.comment());
+    copyField(componentDataObject, 0, newComponentData, 0); // Handle
+    copyField(componentDataObject, 1, newComponentData, 1); // Name
+    copyField(componentDataObject, 2, newComponentData, 2); // UUID
+    copyField(componentDataObject, 3, newComponentData, 3); // Version UUID
+    copyField(componentDataObject, 4, newComponentData, 4); // Creation Timestamp
+    copyField(componentDataObject, 5, newComponentData, 5); // Version Timestamp
 
     // make list of fields to keep
     std::vector<unsigned> extensibleIndicesToKeep;
@@ -1803,31 +1815,25 @@ std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1
     }
 
     // write out remaining fields
+    unsigned index = 6;
     for(std::vector<unsigned>::const_iterator it = extensibleIndicesToKeep.begin(), itend = extensibleIndicesToKeep.end(); it < itend; ++it){
-      if (it == itend-1){
-        componentDataObject.printField(ss, *it, true);
-      }else{
-        componentDataObject.printField(ss, *it, false);
-      }
+      copyField(componentDataObject, *it, newComponentData, index++);
     }
 
+    addObject(targetIdf,newComponentData,idd_0_11_2);
+
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
 
-std::string VersionTranslator::update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5)
+IdfFile VersionTranslator::update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5)
 {
   // Make updates for component costs.
 
-  std::stringstream ss;
-
-  ss << idf_0_11_4.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_11_5.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_11_4,idd_0_11_5);
 
   // hold OS:ComponentData objects for later
   std::vector<IdfObject> componentDataObjects;
@@ -1863,7 +1869,7 @@ std::string VersionTranslator::update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4
     }
     else
     {
-      ss << object;
+      addObject(targetIdf,object,idd_0_11_5);
     }
   }
 
@@ -1893,13 +1899,14 @@ std::string VersionTranslator::update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4
     }
 
     // translate base fields
-    componentDataObject.printName(ss,true);
-    componentDataObject.printField(ss, 0, false); // Handle
-    componentDataObject.printField(ss, 1, false); // Name
-    componentDataObject.printField(ss, 2, false); // UUID
-    componentDataObject.printField(ss, 3, false); // Version UUID
-    componentDataObject.printField(ss, 4, false); // Creation Timestamp
-    componentDataObject.printField(ss, 5, false); // Version Timestamp
+    IdfObject newComponentData(idd_0_11_5.getObject("OS:ComponentData").get());
+    newComponentData.setComment(componentDataObject.comment());
+    copyField(componentDataObject, 0, newComponentData, 0); // Handle
+    copyField(componentDataObject, 1, newComponentData, 1); // Name
+    copyField(componentDataObject, 2, newComponentData, 2); // UUID
+    copyField(componentDataObject, 3, newComponentData, 3); // Version UUID
+    copyField(componentDataObject, 4, newComponentData, 4); // Creation Timestamp
+    copyField(componentDataObject, 5, newComponentData, 5); // Version Timestamp
 
     // make list of fields to keep
     std::vector<unsigned> extensibleIndicesToKeep;
@@ -1913,30 +1920,24 @@ std::string VersionTranslator::update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4
     }
 
     // write out remaining fields
+    unsigned index = 6;
     for(std::vector<unsigned>::const_iterator it = extensibleIndicesToKeep.begin(), itend = extensibleIndicesToKeep.end(); it < itend; ++it){
-      if (it == itend-1){
-        componentDataObject.printField(ss, *it, true);
-      }else{
-        componentDataObject.printField(ss, *it, false);
-      }
+      copyField(componentDataObject, *it, newComponentData, index++);
     }
 
+    addObject(targetIdf,newComponentData,idd_0_11_5);
+
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5, const IddFileAndFactoryWrapper& idd_0_11_6)
+IdfFile VersionTranslator::update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5, const IddFileAndFactoryWrapper& idd_0_11_6)
 {
   // Update the OS:PortList object to point back to the OS:ThermalZone
 
-  std::stringstream ss;
-
-  ss << idf_0_11_5.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_11_6.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_0_11_5,idd_0_11_6);
 
   BOOST_FOREACH(const IdfObject& object,idf_0_11_5.objects()) {
 
@@ -1983,7 +1984,7 @@ std::string VersionTranslator::update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5
 
               m_refactored.push_back( std::pair<IdfObject,IdfObject>(object2,newPortList) );
 
-              ss << newPortList;
+              addObject(targetIdf,newPortList,idd_0_11_6);
 
             } 
 
@@ -1993,7 +1994,7 @@ std::string VersionTranslator::update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5
 
       }
 
-      ss << object;
+      addObject(targetIdf,object,idd_0_11_6);
 
     } else if ( object.iddObject().name() == "OS:PortList" ) {
 
@@ -2001,23 +2002,18 @@ std::string VersionTranslator::update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5
 
     } else {
 
-      ss << object;
+      addObject(targetIdf,object,idd_0_11_6);
 
     }
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
-std::string VersionTranslator::update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2)
+IdfFile VersionTranslator::update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2)
 {
-  std::stringstream ss;
-
-  ss << idf_1_0_1.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_1_0_2.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_1_0_1,idd_1_0_2);
 
   BOOST_FOREACH(const IdfObject& object,idf_1_0_1.objects()) {
 
@@ -2032,11 +2028,11 @@ std::string VersionTranslator::update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, c
 
         m_refactored.push_back( std::pair<IdfObject,IdfObject>(object,newBoiler) );
 
-        ss << newBoiler;
+        addObject(targetIdf,newBoiler,idd_1_0_2);
 
       } else {
 
-        ss << object;
+        addObject(targetIdf,object,idd_1_0_2);
 
       }
     } else if( object.iddObject().name() == "OS:Boiler:HotWater" ) {
@@ -2050,34 +2046,29 @@ std::string VersionTranslator::update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, c
 
         m_refactored.push_back( std::pair<IdfObject,IdfObject>(object,newChiller) );
 
-        ss << newChiller;
+        addObject(targetIdf,newChiller,idd_1_0_2);
 
       } else {
 
-        ss << object;
+        addObject(targetIdf,object,idd_1_0_2);
 
       }
 
     } else {
 
-      ss << object;
+      addObject(targetIdf,object,idd_1_0_2);
 
     }
   }
 
-  return ss.str();
+  return targetIdf;
 }
 
 
-std::string VersionTranslator::update_1_0_2_to_1_0_3(const IdfFile& idf_1_0_2, const IddFileAndFactoryWrapper& idd_1_0_3)
+IdfFile VersionTranslator::update_1_0_2_to_1_0_3(const IdfFile& idf_1_0_2, const IddFileAndFactoryWrapper& idd_1_0_3)
 {
-  std::stringstream ss;
-
-  ss << idf_1_0_2.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_1_0_3.iddFile());
-  ss << targetIdf.versionObject().get();
+  // new file, with new version object
+  IdfFile targetIdf = newTargetIdf(idf_1_0_2,idd_1_0_3);
 
   BOOST_FOREACH(const IdfObject& object,idf_1_0_2.objects()) {
 
@@ -2097,16 +2088,16 @@ std::string VersionTranslator::update_1_0_2_to_1_0_3(const IdfFile& idf_1_0_2, c
 
         m_refactored.push_back( std::pair<IdfObject,IdfObject>(object, newParameters) );
 
-        ss << newParameters;
+        addObject(targetIdf,newParameters,idd_1_0_3);
       } else {
-        ss << object;
+        addObject(targetIdf,object,idd_1_0_3);
       }
     } else {
-      ss << object;
+      addObject(targetIdf,object,idd_1_0_3);
     }
   }
     
-  return ss.str();
+  return targetIdf;
 }
 
 } // osversion
@@ -135,11 +135,15 @@ class OSVERSION_API VersionTranslator {
    *  refactored. */
   std::vector< std::pair<IdfObject,IdfObject> > refactoredObjects() const;
 
+  /** Returns the wall-clock time, in seconds, spent in each update step of the last translation,
+   *  keyed on the version produced by the step. */
+  std::vector< std::pair<VersionString,double> > updateStepTimes() const;
+
   //@}  
  private:
   REGISTER_LOGGER("openstudio.osversion.VersionTranslator");
 
-  typedef boost::function<std::string (VersionTranslator*, const IdfFile&, const IddFileAndFactoryWrapper& )> OSVersionUpdater;
+  typedef boost::function<IdfFile (VersionTranslator*, const IdfFile&, const IddFileAndFactoryWrapper& )> OSVersionUpdater;
   std::map<VersionString, OSVersionUpdater> m_updateMethods;
   std::vector<VersionString> m_startVersions;
 
@@ -148,6 +152,8 @@ class OSVERSION_API VersionTranslator {
   StringStreamLogSink m_logSink;
   std::vector<IdfObject> m_deprecated, m_untranslated, m_new;
   std::vector< std::pair<IdfObject,IdfObject> > m_refactored;
+  std::vector< std::pair<VersionString,double> > m_stepTimes;
+  std::map<std::string,IddObject> m_targetIddObjects;
   int m_nObjectsStart;
   int m_nObjectsFinalIdf;
   int m_nObjectsFinalModel;
@@ -163,18 +169,30 @@ class OSVERSION_API VersionTranslator {
   
   void update(const VersionString& startVersion);
 
-  std::string defaultUpdate(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
-  std::string update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2);
-  std::string update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3);
-  std::string update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, const IddFileAndFactoryWrapper& idd_0_7_4);
-  std::string update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, const IddFileAndFactoryWrapper& idd_0_9_2);
-  std::string update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6);
-  std::string update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1);
-  std::string update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1, const IddFileAndFactoryWrapper& idd_0_11_2);
-  std::string update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5);
-  std::string update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5, const IddFileAndFactoryWrapper& idd_0_11_6);
-  std::string update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2);
-  std::string update_1_0_2_to_1_0_3(const IdfFile& idf_1_0_2, const IddFileAndFactoryWrapper& idd_1_0_3);
+  /** Returns an empty file in the version of targetIdd, with the header of idf. Update methods
+   *  fill it in with addObject, so each version is held in memory and never printed and
+   *  re-parsed. */
+  IdfFile newTargetIdf(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
+  /** Adds object to targetIdf, re-associated with the IddObject of the same name in targetIdd, as
+   *  if it had been printed and parsed with targetIdd. Objects with no such IddObject are added
+   *  to the untranslated list. */
+  void addObject(IdfFile& targetIdf, const IdfObject& object, const IddFileAndFactoryWrapper& targetIdd);
+  /** Copies field sourceIndex of source, with its comment, to field targetIndex of target, if
+   *  source has that field. */
+  void copyField(const IdfObject& source, unsigned sourceIndex, IdfObject& target, unsigned targetIndex);
+
+  IdfFile defaultUpdate(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
+  IdfFile update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2);
+  IdfFile update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3);
+  IdfFile update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, const IddFileAndFactoryWrapper& idd_0_7_4);
+  IdfFile update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, const IddFileAndFactoryWrapper& idd_0_9_2);
+  IdfFile update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6);
+  IdfFile update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1);
+  IdfFile update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1, const IddFileAndFactoryWrapper& idd_0_11_2);
+  IdfFile update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5);
+  IdfFile update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5, const IddFileAndFactoryWrapper& idd_0_11_6);
+  IdfFile update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2);
+  IdfFile update_1_0_2_to_1_0_3(const IdfFile& idf_1_0_2, const IddFileAndFactoryWrapper& idd_1_0_3);
 
   IdfObject updateUrlField_0_7_1_to_0_7_2(const IdfObject& object, unsigned index);
 
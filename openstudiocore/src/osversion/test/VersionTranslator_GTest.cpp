@@ -45,6 +45,7 @@
 #include <utilities/idd/OS_Version_FieldEnums.hxx>
 
 #include <utilities/core/Compare.hpp>
+#include <utilities/core/Instrumentation.hpp>
 
 #include <boost/filesystem.hpp>
 #include <boost/foreach.hpp>
@@ -461,3 +462,57 @@ TEST_F(OSVersionFixture,OnDemandComponent) {
   Component component = *oComponent;
   EXPECT_EQ(IddObjectType("OS:SpaceType"),component.primaryObject().iddObjectType());
 }
+
+TEST_F(OSVersionFixture,VersionTranslator_UpdateStepTimes) {
+  osversion::VersionTranslator translator;
+
+  // one step per update method: 1.0.1 -> 1.0.2 -> 1.0.3 -> current
+  openstudio::path modelPath = resourcesPath() / toPath("osversion/1_0_1/example.osm");
+  model::OptionalModel result = translator.loadModel(modelPath);
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(translator.errors().empty());
+  EXPECT_TRUE(translator.warnings().empty());
+
+  std::vector< std::pair<VersionString,double> > stepTimes = translator.updateStepTimes();
+  ASSERT_EQ(3u,stepTimes.size());
+  EXPECT_EQ(VersionString("1.0.2"),stepTimes[0].first);
+  EXPECT_EQ(VersionString("1.0.3"),stepTimes[1].first);
+  EXPECT_EQ(VersionString(openStudioVersion()),stepTimes[2].first);
+  typedef std::pair<VersionString,double> StepTime;
+  BOOST_FOREACH(const StepTime& stepTime,stepTimes) {
+    EXPECT_GE(stepTime.second,0.0);
+  }
+
+  // no update methods are registered between 1.0.4 and current, so there is a single step
+  openstudio::path currentPath = resourcesPath() / toPath("osversion/1_0_4/example.osm");
+  result = translator.loadModel(currentPath);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(1u,translator.updateStepTimes().size());
+  EXPECT_TRUE(translator.untranslatedObjects().empty());
+}
+
+TEST_F(OSVersionFixture,VersionTranslator_NoReparseBetweenSteps) {
+  osversion::VersionTranslator translator;
+
+  bool wasEnabled = Instrumentation::instance().enabled();
+  Instrumentation::instance().setEnabled(true);
+  Instrumentation::instance().clear();
+
+  openstudio::path modelPath = resourcesPath() / toPath("osversion/0_7_0/example.osm");
+  model::OptionalModel result = translator.loadModel(modelPath);
+  std::vector<InstrumentationEvent> events = Instrumentation::instance().events();
+  Instrumentation::instance().setEnabled(wasEnabled);
+  ASSERT_TRUE(result);
+
+  // every update method from 0.7.2 on is run, each passing its IdfFile to the next
+  EXPECT_EQ(12u,translator.updateStepTimes().size());
+
+  // so the original file is the only text parsed
+  unsigned numLoads = 0;
+  BOOST_FOREACH(const InstrumentationEvent& event,events) {
+    if (!event.isCounter && (event.name == "IdfFile::load")) {
+      ++numLoads;
+    }
+  }
+  EXPECT_EQ(1u,numLoads);
+}
@@ -29,6 +29,12 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/tokenizer.hpp>
+#include <boost/cstdint.hpp>
+
+#include <QFile>
+
+#include <cstdlib>
+#include <cstring>
 
 using namespace std;
 using namespace boost;
@@ -37,12 +43,76 @@ using namespace openstudio;
 namespace openstudio{
 namespace radiance{
 
+  namespace {
+
+    // conversion from footcandles to lux
+    const double footcandlesToLux(10.76);
+
+    // binary file layout: header, x points and y points as doubles, numTimesteps blocks of
+    // numX*numY float32 values in lux (x varies fastest), then one BinaryTimestep per block;
+    // all values are in native byte order
+    const char binaryMagic[8] = {'O', 'S', 'A', 'I', 'M', 'A', 'P', '1'};
+
+    struct BinaryHeader {
+      char magic[8];
+      boost::uint32_t numX;
+      boost::uint32_t numY;
+      boost::uint32_t numTimesteps;
+      boost::uint32_t reserved;
+    };
+
+    struct BinaryTimestep {
+      boost::uint32_t month;
+      boost::uint32_t day;
+      double hours;
+    };
+
+    // each line contains the month, day, time (in hours),
+    // Solar Azimuth(degrees from south), Solar Altitude(degrees), Global Horizontal Illuminance (fc)
+    // followed by M*N illuminance points in footcandles
+    bool parseTimestep(const std::string& line, unsigned& month, unsigned& day, double& hours, std::vector<double>& values)
+    {
+      values.clear();
+
+      const char* begin = line.c_str();
+      char* end = NULL;
+
+      double header[6];
+      for (unsigned i = 0; i < 6; ++i){
+        header[i] = std::strtod(begin, &end);
+        if (end == begin){
+          return false;
+        }
+        begin = end;
+      }
+
+      // ignore solar angles and global horizontal for now
+      month = static_cast<unsigned>(header[0]);
+      day = static_cast<unsigned>(header[1]);
+      hours = header[2];
+
+      while (true){
+        double value = std::strtod(begin, &end);
+        if (end == begin){
+          break;
+        }
+        values.push_back(value);
+        begin = end;
+      }
+
+      return true;
+    }
+
+  }
+
   /// default constructor
   AnnualIlluminanceMap::AnnualIlluminanceMap()
+    : m_binaryData(NULL)
   {}
 
   /// constructor with path
   AnnualIlluminanceMap::AnnualIlluminanceMap(const openstudio::path& path)
+    : m_binaryData(NULL)
   {
     init(path);
   }
@@ -55,6 +125,10 @@ namespace radiance{
       return;
     }
 
+    if (initBinary(path)){
+      return;
+    }
+
     // open file
     boost::filesystem::ifstream file(path);
 
@@ -71,14 +145,8 @@ namespace radiance{
     // lines 1 and 2 are the header lines
     string line1, line2;
 
-    // this will contain matches to regular expressions
-    smatch matches;
-
-    // matches a single number followed by either tabs or spaces
-    const regex singleNumber("([-+]?[0-9]*\\.?[0-9]+)[\\s\\t]*");
-
-    // conversion from footcandles to lux
-    const double footcandlesToLux(10.76);
+    // values read from each line
+    vector<double> values;
 
     // read the rest of the file line by line
     while(getline(file, line)){
@@ -107,43 +175,30 @@ namespace radiance{
 
       }else{
 
-        // each line contains the month, day, time (in hours),
-        // Solar Azimuth(degrees from south), Solar Altitude(degrees), Global Horizontal Illuminance (fc)
-        // followed by M*N illuminance points
-
-        // break the line up by spaces
-        vector<string> lineVector;
-        tokenizer<char_separator<char>, std::string::const_iterator, std::string > tk(line, char_separator<char>(" "));
-        for (tokenizer<char_separator<char>, std::string::const_iterator, std::string >::iterator it(tk.begin()); it!=tk.end(); ++it)
-        {
-           lineVector.push_back(*it);
+        unsigned month = 0;
+        unsigned day = 0;
+        double hours = 0;
+        if (!parseTimestep(line, month, day, hours, values)){
+          LOG(Fatal,  "Cannot read timestep on line " << lineNum << ".");
+          return;
         }
 
-        // total number minus 6 standard header items
-        unsigned numValues = lineVector.size() - 6;
-
-        if (numValues != M*N){
-          LOG(Fatal,  "Incorrect number of illuminance values read " << numValues << ", expecting " << M*N << ".");
+        if (values.size() != M*N){
+          LOG(Fatal,  "Incorrect number of illuminance values read " << values.size() << ", expecting " << M*N << ".");
           return;
         }else{
 
-          MonthOfYear month = monthOfYear(lexical_cast<unsigned>(lineVector[0]));
-          unsigned day = lexical_cast<unsigned>(lineVector[1]);
-          double fracDays = lexical_cast<double>(lineVector[2]) / 24.0;
-
-          // ignore solar angles and global horizontal for now
-
           // make the date time
-          DateTime dateTime(Date(month, day), Time(fracDays));
+          DateTime dateTime(Date(monthOfYear(month), day), Time(hours / 24.0));
 
           // matrix we are going to read in
           Matrix illuminanceMap(M,N);
 
           // read in the values
-          unsigned index = 6;
+          unsigned index = 0;
           for (unsigned j = 0; j < N; ++j){
             for (unsigned i = 0; i < M; ++i){
-              illuminanceMap(i,j) = footcandlesToLux*lexical_cast<double>(lineVector[index]);
+              illuminanceMap(i,j) = footcandlesToLux*values[index];
               ++index;
             }
           }
@@ -158,6 +213,82 @@ namespace radiance{
     file.close();
   }
 
+  bool AnnualIlluminanceMap::initBinary(const openstudio::path& path)
+  {
+    boost::shared_ptr<QFile> file(new QFile(toQString(path)));
+    if (!file->open(QIODevice::ReadOnly)){
+      return false;
+    }
+
+    BinaryHeader header;
+    if (file->read(reinterpret_cast<char*>(&header), sizeof(header)) != static_cast<qint64>(sizeof(header))){
+      return false;
+    }
+    if (memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) != 0){
+      return false;
+    }
+
+    unsigned M = header.numX;
+    unsigned N = header.numY;
+    unsigned T = header.numTimesteps;
+
+    qint64 valuesOffset = sizeof(BinaryHeader) + sizeof(double)*(static_cast<qint64>(M) + N);
+    qint64 valuesSize = sizeof(float)*static_cast<qint64>(M)*N*T;
+    qint64 timestepsOffset = valuesOffset + valuesSize;
+    if (file->size() != timestepsOffset + static_cast<qint64>(sizeof(BinaryTimestep))*T){
+      LOG(Fatal,  "Binary illuminance map '" << toString(path) << "' is truncated or corrupt.");
+      return true;
+    }
+
+    vector<double> points(M + N);
+    if (!points.empty()){
+      file->read(reinterpret_cast<char*>(&points[0]), sizeof(double)*points.size());
+    }
+    m_xVector = Vector(M);
+    for (unsigned i = 0; i < M; ++i){
+      m_xVector[i] = points[i];
+    }
+    m_yVector = Vector(N);
+    for (unsigned j = 0; j < N; ++j){
+      m_yVector[j] = points[M + j];
+    }
+
+    vector<BinaryTimestep> timesteps(T);
+    if (!timesteps.empty()){
+      file->seek(timestepsOffset);
+      file->read(reinterpret_cast<char*>(&timesteps[0]), sizeof(BinaryTimestep)*timesteps.size());
+    }
+    for (unsigned t = 0; t < T; ++t){
+      DateTime dateTime(Date(monthOfYear(timesteps[t].month), timesteps[t].day), Time(timesteps[t].hours / 24.0));
+      m_dateTimes.push_back(dateTime);
+      m_dateTimeIndex[dateTime] = t;
+    }
+
+    if (valuesSize > 0){
+      uchar* mapped = file->map(valuesOffset, valuesSize);
+      if (mapped){
+        m_binaryFile = file;
+        m_binaryData = reinterpret_cast<const float*>(mapped);
+      }else{
+        LOG(Debug, "Cannot map '" << toString(path) << "', reading values into memory.");
+        m_binaryBuffer = boost::shared_ptr<vector<float> >(new vector<float>(static_cast<size_t>(M)*N*T));
+        file->seek(valuesOffset);
+        file->read(reinterpret_cast<char*>(&(*m_binaryBuffer)[0]), valuesSize);
+        m_binaryData = &(*m_binaryBuffer)[0];
+      }
+    }
+
+    return true;
+  }
+
+  const float* AnnualIlluminanceMap::binaryValues(unsigned timestep) const
+  {
+    if (!m_binaryData){
+      return NULL;
+    }
+    return m_binaryData + static_cast<size_t>(timestep)*m_xVector.size()*m_yVector.size();
+  }
+
   /// get the illuminance map in lux corresponding to date and time
   const openstudio::Matrix& AnnualIlluminanceMap::illuminanceMap(const openstudio::DateTime& dateTime) const
   {
@@ -166,9 +297,200 @@ namespace radiance{
       return it->second;
     }
 
+    std::map<DateTime, unsigned>::const_iterator index = m_dateTimeIndex.find(dateTime);
+    if (m_binaryData && (index != m_dateTimeIndex.end())){
+      unsigned M = m_xVector.size();
+      unsigned N = m_yVector.size();
+      const float* values = binaryValues(index->second);
+
+      Matrix& illuminanceMap = m_dateTimeIlluminanceMap[dateTime];
+      illuminanceMap = Matrix(M,N);
+      for (unsigned j = 0; j < N; ++j){
+        for (unsigned i = 0; i < M; ++i){
+          illuminanceMap(i,j) = values[j*M + i];
+        }
+      }
+      return illuminanceMap;
+    }
+
     return m_nullIlluminanceMap;
   }
 
+  openstudio::Vector AnnualIlluminanceMap::illuminanceValues(const openstudio::DateTime& dateTime) const
+  {
+    unsigned M = m_xVector.size();
+    unsigned N = m_yVector.size();
+
+    if (m_binaryData){
+      std::map<DateTime, unsigned>::const_iterator index = m_dateTimeIndex.find(dateTime);
+      if (index == m_dateTimeIndex.end()){
+        return Vector();
+      }
+
+      const float* values = binaryValues(index->second);
+      Vector result(M*N);
+      for (unsigned k = 0; k < M*N; ++k){
+        result[k] = values[k];
+      }
+      return result;
+    }
+
+    DateTimeIlluminanceMap::const_iterator it = m_dateTimeIlluminanceMap.find(dateTime);
+    if (it == m_dateTimeIlluminanceMap.end()){
+      return Vector();
+    }
+
+    Vector result(M*N);
+    for (unsigned j = 0; j < N; ++j){
+      for (unsigned i = 0; i < M; ++i){
+        result[j*M + i] = it->second(i,j);
+      }
+    }
+    return result;
+  }
+
+  openstudio::Vector AnnualIlluminanceMap::sensorIlluminance(unsigned xIndex, unsigned yIndex) const
+  {
+    unsigned M = m_xVector.size();
+    unsigned N = m_yVector.size();
+    if ((xIndex >= M) || (yIndex >= N)){
+      LOG(Error, "Point (" << xIndex << ", " << yIndex << ") is outside of the " << M << " by " << N << " illuminance map.");
+      return Vector();
+    }
+
+    Vector result(m_dateTimes.size());
+    for (unsigned t = 0; t < m_dateTimes.size(); ++t){
+      if (m_binaryData){
+        result[t] = binaryValues(t)[yIndex*M + xIndex];
+      }else{
+        result[t] = illuminanceMap(m_dateTimes[t])(xIndex, yIndex);
+      }
+    }
+    return result;
+  }
+
+  bool AnnualIlluminanceMap::isBinary() const
+  {
+    return (m_binaryData != NULL);
+  }
+
+  bool AnnualIlluminanceMap::convertToBinary(const openstudio::path& textPath, const openstudio::path& binaryPath)
+  {
+    // file must exist
+    if (!exists(textPath)){
+      LOG(Error,  "File does not exist: '" << toString(textPath) << "'" );
+      return false;
+    }
+
+    boost::filesystem::ifstream file(textPath);
+    boost::filesystem::ofstream out(binaryPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!out){
+      LOG(Error,  "Cannot write to '" << toString(binaryPath) << "'" );
+      return false;
+    }
+
+    BinaryHeader header;
+    memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+    header.numX = 0;
+    header.numY = 0;
+    header.numTimesteps = 0;
+    header.reserved = 0;
+
+    unsigned lineNum = 0;
+    unsigned M = 0;
+    unsigned N = 0;
+    string line, line1;
+    vector<double> values;
+    vector<float> luxValues;
+    vector<BinaryTimestep> timesteps;
+    bool result = true;
+
+    while(getline(file, line)){
+      ++lineNum;
+
+      if (lineNum == 1){
+
+        line1 = line;
+
+      }else if (lineNum == 2){
+
+        HeaderInfo headerInfo(line1, line);
+        M = headerInfo.xVector().size();
+        N = headerInfo.yVector().size();
+
+        // header is written again with the number of timesteps at the end
+        header.numX = M;
+        header.numY = N;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (unsigned i = 0; i < M; ++i){
+          double x = headerInfo.xVector()[i];
+          out.write(reinterpret_cast<const char*>(&x), sizeof(x));
+        }
+        for (unsigned j = 0; j < N; ++j){
+          double y = headerInfo.yVector()[j];
+          out.write(reinterpret_cast<const char*>(&y), sizeof(y));
+        }
+
+      }else{
+
+        BinaryTimestep timestep;
+        unsigned month = 0;
+        unsigned day = 0;
+        if (!parseTimestep(line, month, day, timestep.hours, values)){
+          LOG(Error,  "Cannot read timestep on line " << lineNum << " of '" << toString(textPath) << "'.");
+          result = false;
+          break;
+        }
+
+        if (values.size() != M*N){
+          LOG(Error,  "Incorrect number of illuminance values read " << values.size() << ", expecting " << M*N << ".");
+          result = false;
+          break;
+        }
+
+        timestep.month = month;
+        timestep.day = day;
+        timesteps.push_back(timestep);
+
+        luxValues.resize(values.size());
+        for (unsigned k = 0; k < values.size(); ++k){
+          luxValues[k] = static_cast<float>(footcandlesToLux*values[k]);
+        }
+        if (!luxValues.empty()){
+          out.write(reinterpret_cast<const char*>(&luxValues[0]), sizeof(float)*luxValues.size());
+        }
+      }
+    }
+
+    if (result && (lineNum < 2)){
+      LOG(Error,  "Missing header in '" << toString(textPath) << "'.");
+      result = false;
+    }
+
+    if (result){
+      if (!timesteps.empty()){
+        out.write(reinterpret_cast<const char*>(&timesteps[0]), sizeof(BinaryTimestep)*timesteps.size());
+      }
+
+      header.numTimesteps = timesteps.size();
+      out.seekp(0);
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+      if (!out.good()){
+        LOG(Error,  "Cannot write to '" << toString(binaryPath) << "'" );
+        result = false;
+      }
+    }
+
+    out.close();
+    if (!result){
+      boost::filesystem::remove(binaryPath);
+    }
+
+    return result;
+  }
+
 
 } // radiance
 } // openstudio
@@ -28,12 +28,21 @@
 #include <utilities/core/Logger.hpp>
 #include <utilities/core/Path.hpp>
 
+#include <boost/shared_ptr.hpp>
+
+class QFile;
+
 namespace openstudio{
 namespace radiance{
 
   /** AnnualIlluminanceMap represents illuminance map for an entire year.
   *   We assume that the output files is from SPOT, with length in meters and illuminance 
   *   values in footcandles.  All illuminance values are converted to lux.
+  *
+  *   The text output can be converted once with convertToBinary to a compact binary file
+  *   holding float32 values in lux, one block of x by y values per timestep.  Binary files
+  *   are memory mapped when loaded, so illuminanceValues and sensorIlluminance read slices
+  *   straight from the file without building a Matrix for every timestep.
   */ 
   class RADIANCE_API AnnualIlluminanceMap
   {
@@ -47,7 +56,8 @@ namespace radiance{
       /// default constructor
       AnnualIlluminanceMap();
 
-      /// constructor with path
+      /// constructor with path, path may be a text illuminance file or a binary file
+      /// written by convertToBinary
       AnnualIlluminanceMap(const openstudio::path& path);
 
       /// virtual destructor
@@ -63,20 +73,48 @@ namespace radiance{
       /// get the y points corresponding to illuminance matrix rows in meters
       const openstudio::Vector& yVector() const {return m_yVector;}
 
-      /// get the illuminance map in lux corresponding to date and time
+      /// get the illuminance map in lux corresponding to date and time, when loaded from a
+      /// binary file the matrix is built on first request and kept
       const openstudio::Matrix& illuminanceMap(const openstudio::DateTime& dateTime) const;
 
+      /// get the illuminance values in lux for all points at date and time, x varies fastest,
+      /// empty if there is no data for date and time
+      openstudio::Vector illuminanceValues(const openstudio::DateTime& dateTime) const;
+
+      /// get the illuminance in lux at point (xIndex, yIndex) for each of dateTimes()
+      openstudio::Vector sensorIlluminance(unsigned xIndex, unsigned yIndex) const;
+
+      /// returns true if data is read from a binary file
+      bool isBinary() const;
+
+      /// convert a text annual illuminance file to the binary format, the text file is read one
+      /// line at a time, returns false if the text file cannot be read or the binary file written
+      static bool convertToBinary(const openstudio::path& textPath, const openstudio::path& binaryPath);
+
     private:
 
       REGISTER_LOGGER("radiance.AnnualIlluminanceMap");
 
       void init(const openstudio::path& path);
 
+      bool initBinary(const openstudio::path& path);
+
+      // values for timestep, null if not loaded from a binary file
+      const float* binaryValues(unsigned timestep) const;
+
       openstudio::DateTimeVector m_dateTimes;
       openstudio::Vector m_xVector;
       openstudio::Vector m_yVector;
       openstudio::Matrix m_nullIlluminanceMap; // used when there is no data
-      DateTimeIlluminanceMap m_dateTimeIlluminanceMap;
+
+      // matrices read from a text file, or built on request from a binary file
+      mutable DateTimeIlluminanceMap m_dateTimeIlluminanceMap;
+
+      // binary file data, shared between copies
+      boost::shared_ptr<QFile> m_binaryFile;
+      boost::shared_ptr<std::vector<float> > m_binaryBuffer; // used if the file cannot be mapped
+      const float* m_binaryData;
+      std::map<openstudio::DateTime, unsigned> m_dateTimeIndex;
   };
 
 } // radiance
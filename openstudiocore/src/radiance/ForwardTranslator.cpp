@@ -54,6 +54,7 @@
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/bind.hpp>
+#include <boost/thread.hpp>
 #include <boost/algorithm/string/regex.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/filesystem.hpp>
@@ -121,8 +122,366 @@ namespace radiance {
     return boost::lexical_cast<std::string>(t);
   }
 
+  namespace {
+
+    // replace characters radiance does not accept in identifiers
+    std::string radianceName(const std::string& name)
+    {
+      return boost::algorithm::replace_all_regex_copy(name, boost::regex("[ :]"), std::string("_"));
+    }
+
+    // subtract sub surface polygons from a surface polygon given in space coordinates and
+    // return the result in absolute coordinates, warnings are returned rather than logged
+    // so that this can run on a worker thread
+    openstudio::Point3dVector subtractSubSurfaces(const Transformation& buildingTransformation,
+                                                  const Transformation& spaceTransformation,
+                                                  const openstudio::Point3dVector& vertices,
+                                                  const std::vector<openstudio::Point3dVector>& subSurfaceVertices,
+                                                  std::vector<std::string>& warnings)
+    {
+      openstudio::Point3dVector result;
+
+      // transformation from space coordinates to face coordinates
+      Transformation alignFace = Transformation::alignFace(vertices);
+      Transformation toFace = alignFace.inverse();
+
+      // get the current vertices and convert to face coordinates
+      Point3dVector surfaceFaceVertices = toFace*vertices;
+
+      // subtract sub surface polygons from surface polygon
+      //jgs20100615 added
+      QPolygonF outer;
+      BOOST_FOREACH(const Point3d& point, surfaceFaceVertices){
+        if (abs(point.z()) > 0.001){
+          std::stringstream ss;
+          ss << "Surface point z not on plane, z =" << point.z();
+          warnings.push_back(ss.str());
+        }
+        outer << QPointF(point.x(),point.y());
+      }
+
+      BOOST_FOREACH(const Point3dVector& subSurface, subSurfaceVertices){
+        Point3dVector subsurfaceFaceVertices = toFace*subSurface;
+        QPolygonF inner;
+        BOOST_FOREACH(const Point3d& point, subsurfaceFaceVertices){
+          if (abs(point.z()) > 0.001){
+            std::stringstream ss;
+            ss << "Subsurface point z not on plane, z =" << point.z();
+            warnings.push_back(ss.str());
+          }
+          inner << QPointF(point.x(),point.y());
+        }
+        outer = outer.subtracted(inner);
+      }
+
+      BOOST_FOREACH(const QPointF& point, outer){
+        result.push_back(openstudio::Point3d(point.x(),point.y(), 0));
+      }
+
+      return buildingTransformation*spaceTransformation*alignFace*result;
+    }
+
+    // convert visible transmittance (Tn) to transmissivity (tn) for a radiance glass material
+    // tn = (sqrt(.8402528435+.0072522239*Tn*Tn)-.9166530661)/.0036261119/Tn
+    double transmissivity(double tVis)
+    {
+      if (tVis == 0.0) {
+        return 0.0;
+      }
+      double tn_x = 0.0072522239 * tVis * tVis;
+      double tn_y = sqrt(tn_x + 0.8402528435) - 0.9166530661;
+      return tn_y / 0.0036261119 /tVis;
+    }
+
+    /// Plain data for one sub surface, read from the model on the translating thread.
+    struct RadSubSurface {
+      std::string name;
+      std::string type;
+      boost::optional<double> visibleTransmittance;
+      double interiorVisibleReflectance;
+      double exteriorVisibleReflectance;
+      openstudio::Point3dVector polygon; // absolute coordinates
+    };
+
+    /// Plain data for one surface, read from the model on the translating thread.
+    struct RadSurface {
+      std::string name;
+      std::string constructionName;
+      double interiorVisibleReflectance;
+      double exteriorVisibleReflectance;
+      double azimuth;
+      openstudio::Point3dVector vertices; // space coordinates
+      std::vector<openstudio::Point3dVector> subSurfaceVertices; // space coordinates
+      std::vector<RadSubSurface> subSurfaces;
+    };
+
+    /// Plain data for a shading or interior partition surface.
+    struct RadPlanarSurface {
+      std::string name;
+      std::string constructionName;
+      double interiorVisibleReflectance;
+      double exteriorVisibleReflectance;
+      openstudio::Point3dVector polygon; // absolute coordinates
+    };
+
+    /// Everything needed to generate the radiance input for one space. Gathering this is the
+    /// only part of the space translation that touches the model, which is not safe to read
+    /// from several threads at once.
+    struct RadSpace {
+      std::string name;
+      Transformation buildingTransformation;
+      Transformation spaceTransformation;
+      std::vector<RadSurface> surfaces;
+      std::vector<RadPlanarSurface> shadingSurfaces;
+      std::vector<RadPlanarSurface> interiorPartitionSurfaces;
+      // each entry is a point followed by a direction, one vector per line of output
+      std::vector<std::pair<Point3d, Vector3dVector> > daylightingControls;
+      std::vector<std::pair<Point3d, Vector3dVector> > glareSensors;
+      std::vector<std::pair<openstudio::Handle, Point3dVector> > illuminanceMaps;
+    };
+
+    /// Radiance input generated for one space.
+    struct RadSpaceScene {
+      std::string geometry;
+      // aperture headings in the order surfaces were visited
+      std::vector<std::string> apertureHeadings;
+      std::map<std::string, std::string> apertures;
+      boost::optional<std::string> sensors;
+      boost::optional<std::string> glareSensors;
+      boost::optional<std::string> map;
+      boost::optional<openstudio::Handle> mapHandle;
+      std::set<std::string> materials;
+      std::set<std::string> materialsDC;
+      std::set<std::string> dcMats;
+      std::vector<std::pair<LogLevel, std::string> > messages;
+    };
+
+    std::string formatPoints(const Point3dVector& points, const std::string& lineEnd)
+    {
+      std::string result;
+      for (Point3dVector::const_iterator vertex = points.begin();
+          vertex != points.end();
+          ++vertex)
+      {
+        result += formatString(vertex->x()) + " " + formatString(vertex->y()) + " " + formatString(vertex->z()) + lineEnd;
+      }
+      return result;
+    }
+
+    std::string formatRays(const std::pair<Point3d, Vector3dVector>& rays)
+    {
+      std::string result;
+      BOOST_FOREACH(const Vector3d& direction, rays.second){
+        result += formatString(rays.first.x()) + " " + formatString(rays.first.y()) + " " + formatString(rays.first.z()) + " "
+          + formatString(direction.x()) + " " + formatString(direction.y()) + " " + formatString(direction.z()) + "\n";
+      }
+      return result;
+    }
+
+    std::string plasticMaterial(double reflectance, const std::string& end)
+    {
+      return "void plastic refl_" + formatString(reflectance) + "\n0\n0\n5\n" + formatString(reflectance) + " "
+        + formatString(reflectance) + " " + formatString(reflectance) + " 0 0\n" + end;
+    }
+
+    void translateSpace(const RadSpace& space, RadSpaceScene& scene)
+    {
+      const std::string& space_name = space.name;
+
+      // split model into zone-based Radiance .rad files
+      scene.geometry = "#Space = " + space_name + "\n";
+
+      BOOST_FOREACH(const RadSurface& surface, space.surfaces){
+        const std::string& surface_name = surface.name;
+
+        // add surface to space geometry
+        scene.geometry += "#-Surface = " + surface_name + "\n";
+        scene.geometry += "#--constructionName = " + surface.constructionName + "\n";
+
+        double interiorVisibleReflectance = surface.interiorVisibleReflectance;
+        scene.geometry += "#--interiorVisibleReflectance = " + formatString(interiorVisibleReflectance) + "\n";
+        scene.geometry += "#--exteriorVisibleReflectance = " + formatString(surface.exteriorVisibleReflectance) + "\n";
+
+        // write material to library array
+        /// \todo deal with exterior surfaces
+        scene.materials.insert(plasticMaterial(interiorVisibleReflectance, ""));
+
+        // write surface polygon
+        std::vector<std::string> warnings;
+        openstudio::Point3dVector polygon = subtractSubSurfaces(space.buildingTransformation, space.spaceTransformation,
+                                                                surface.vertices, surface.subSurfaceVertices, warnings);
+        BOOST_FOREACH(const std::string& warning, warnings){
+          scene.messages.push_back(std::make_pair(Warn, warning));
+        }
+
+        scene.geometry += "refl_" + formatString(interiorVisibleReflectance)
+          + " polygon " + surface_name + "\n0\n0\n" + formatString(polygon.size()*3) +"\n";
+        scene.geometry += formatPoints(polygon, "\n");
+
+        // figure out azimuth for window bins
+        // changed to creating separate bins per heading (RPG 2012.02.21)
+        // TODO: allow grouping for highly discretized elevations
+        double azi = surface.azimuth;
+        std::string aperture_heading = formatString(azi, 4);
+        scene.apertureHeadings.push_back(aperture_heading);
+
+        BOOST_FOREACH(const RadSubSurface& subSurface, surface.subSurfaces){
+          const std::string& subSurface_name = subSurface.name;
+
+          scene.geometry += "#--SubSurface = " + subSurface_name + "\n";
+
+          std::string subSurfaceUpCase = boost::algorithm::to_upper_copy(subSurface.type);
+
+          if (subSurfaceUpCase == "FIXEDWINDOW"
+              || subSurfaceUpCase == "OPERABLEWINDOW"
+              || subSurfaceUpCase == "GLASSDOOR")
+          {
+            std::string& aperture = scene.apertures[aperture_heading];
+            if (aperture.empty())
+            {
+              aperture = "#SpaceApertures = " + space_name + "_" + aperture_heading + "\n";
+            }
+
+            scene.messages.push_back(std::make_pair(Info, "found a " + subSurface.type + ", azimuth = " + formatString(azi) + "(" + subSurface_name + ")"));
+
+            if (!subSurface.visibleTransmittance)
+            {
+              scene.messages.push_back(std::make_pair(Warn, "Cannot determine visible transmittance for SubSurface " + subSurface_name + ", it will not be translated."));
+              continue;
+            }
+
+            double tVis = subSurface.visibleTransmittance.get();
+            double tn = transmissivity(tVis);
+            if (tVis == 0.0) {
+              scene.messages.push_back(std::make_pair(Warn, subSurface_name + " has transmittance of zero."));
+            }
+
+            std::string glazingName = "glaz_" + space_name + "_azi-" + formatString(azi, 4) + "_tn-" + formatString(tn, 4);
+
+            /// \todo add support for translucent materials
+            aperture += "#---Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")\n";
+            // write material
+            scene.materials.insert("void glass " + glazingName + "\n0\n0\n3\n" + formatString(tn, 4) + " " + formatString(tn, 4) + " " + formatString(tn, 4) + "\n");
+            scene.materialsDC.insert("void light glaz_spc-" + space_name + "_azi-" + formatString(azi, 4) + "_tn-" + formatString(tn, 4) + "\n0\n0\n3\n1 1 1\n");
+            scene.dcMats.insert(glazingName + ".vmx,glazing.xml,glazing_blind.xml," + glazingName + ".dmx,\n");
+            // polygon header
+            aperture += "#--SubSurface = " + subSurface_name + "\n";
+            aperture += "#---Tvis = " + formatString(tVis, 4) + " (tn = " + formatString(tn, 4) + ")\n";
+            // write the polygon
+            aperture += glazingName + " polygon " + subSurface_name + "\n";
+            aperture += "0\n0\n" + formatString(subSurface.polygon.size()*3) + "\n";
+            aperture += formatPoints(Point3dVector(subSurface.polygon.rbegin(), subSurface.polygon.rend()), "\n");
+
+          } else if (subSurfaceUpCase == "DOOR") {
+
+            scene.messages.push_back(std::make_pair(Info, std::string("found a door, using interior reflectance")));
+
+            double doorInteriorVisibleReflectance = subSurface.interiorVisibleReflectance;
+            //polygon header
+            scene.geometry += "#--interiorVisibleReflectance = " + formatString(doorInteriorVisibleReflectance) + "\n";
+            scene.geometry += "#--exteriorVisibleReflectance = " + formatString(subSurface.exteriorVisibleReflectance) + "\n";
+            // write material
+            scene.materials.insert(plasticMaterial(doorInteriorVisibleReflectance, "\n"));
+            // write polygon
+            scene.geometry += "refl_" + formatString(doorInteriorVisibleReflectance) + " polygon " + subSurface_name + "\n";
+            scene.geometry += "0\n0\n" + formatString(subSurface.polygon.size()*3) + "\n";
+            scene.geometry += formatPoints(subSurface.polygon, "\n\n");
+
+          } else if (subSurfaceUpCase == "SKYLIGHT") {
+            /// \todo place skylights in their own file by space, separate from geometry
+            double tVis = subSurface.visibleTransmittance.get();
+            double tn = transmissivity(tVis);
+            if (tVis == 0.0) {
+              scene.messages.push_back(std::make_pair(Warn, subSurface_name + " has transmittance of zero."));
+            }
+
+            scene.messages.push_back(std::make_pair(Debug, "Found a skylight, (" + subSurface_name + "), using simple glass model (Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")"));
+
+            scene.geometry += "#---Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")\n";
+            // write material
+            scene.materials.insert("void glass glaz_skylight_" + space_name + "_" + formatString(tn) + "\n0\n0\n3\n" + formatString(tn) + " " + formatString(tn) + " " + formatString(tn) + "\n");
+            scene.materialsDC.insert("void light glaz_skylight_" + space_name + "_vmx\n0\n0\n3\n1 1 1\nvoid alias glaz_skylight_" + space_name + "_" + formatString(tn) + " glaz_skylight_" + space_name + "_vmx\n");
+            scene.dcMats.insert("glaz_skylight_" + space_name + ",");
+            // polygon header
+            scene.geometry += "#--SubSurface = " + subSurface_name + "\n";
+            scene.geometry += "#---Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")\n";
+            // write the polygon
+            scene.geometry += "glaz_skylight_" + space_name + "_" + formatString(tn) + " polygon " + space_name + "_" + subSurface_name + "\n";
+            scene.geometry += "0\n0\n" + formatString(subSurface.polygon.size()*3) + "\n";
+            scene.geometry += formatPoints(subSurface.polygon, "\n");
+
+          } else if (subSurfaceUpCase == "TUBULARDAYLIGHTDOME") {
+            scene.messages.push_back(std::make_pair(Warn, std::string("subsurface is a tdd dome, not translated (not yet implemented).")));
+          } else if (subSurfaceUpCase == "TUBULARDAYLIGHTDIFFUSER") {
+            scene.messages.push_back(std::make_pair(Warn, std::string("subsurface is a tdd diffuser, not translated (not yet implemented).")));
+          }
+        }
+      } // loop over surfaces
+
+      // shading and interior partition surfaces
+      /// \note no constructions for shading surfaces yet, so they are hard coded to 20% Rvis, 100% opaque
+      std::vector<const RadPlanarSurface*> planarSurfaces;
+      BOOST_FOREACH(const RadPlanarSurface& planarSurface, space.shadingSurfaces){
+        planarSurfaces.push_back(&planarSurface);
+      }
+      BOOST_FOREACH(const RadPlanarSurface& planarSurface, space.interiorPartitionSurfaces){
+        planarSurfaces.push_back(&planarSurface);
+      }
+      BOOST_FOREACH(const RadPlanarSurface* planarSurface, planarSurfaces){
+        double interiorVisibleReflectance = planarSurface->interiorVisibleReflectance;
+
+        // add surface to zone geometry
+        scene.geometry += "#-Surface = " + planarSurface->name + "\n";
+        scene.geometry += "#--constructionName = " + planarSurface->constructionName + "\n";
+        // write material
+        scene.materials.insert(plasticMaterial(interiorVisibleReflectance, "\n"));
+        // polygon header
+        scene.geometry += "#--interiorVisibleReflectance = " + formatString(interiorVisibleReflectance) + "\n";
+        scene.geometry += "#--exteriorVisibleReflectance = " + formatString(planarSurface->exteriorVisibleReflectance) + "\n";
+        // write surface polygon
+        scene.geometry += "refl_" + formatString(interiorVisibleReflectance) + " polygon " + planarSurface->name + "\n0\n0\n" + formatString(planarSurface->polygon.size()*3) + "\n";
+        scene.geometry += formatPoints(planarSurface->polygon, "\n\n");
+      }
+
+      // daylighting control points, glare sensors and illuminance maps, if a space has more
+      // than one of a kind the last one is written
+      if (!space.daylightingControls.empty()){
+        scene.sensors = formatRays(space.daylightingControls.back());
+      }
+
+      if (!space.glareSensors.empty()){
+        scene.glareSensors = formatRays(space.glareSensors.back());
+      }
+
+      if (!space.illuminanceMaps.empty()){
+        std::string map;
+        BOOST_FOREACH(const Point3d& point, space.illuminanceMaps.back().second){
+          map += formatString(point.x()) + " " + formatString(point.y()) + " " + formatString(point.z()) + " 0 0 1\n";
+        }
+        if (!map.empty()){
+          scene.map = map;
+        }
+        scene.mapHandle = space.illuminanceMaps.back().first;
+      }
+    }
+
+    void translateSpaces(const std::vector<RadSpace>& spaces, std::vector<RadSpaceScene>& scenes,
+                         unsigned first, unsigned stride)
+    {
+      for (unsigned i = first; i < spaces.size(); i += stride){
+        try {
+          translateSpace(spaces[i], scenes[i]);
+        } catch (const std::exception& e) {
+          scenes[i].messages.push_back(std::make_pair(Error, "Failed to translate Space " + spaces[i].name + ": " + e.what()));
+        }
+      }
+    }
+
+  } // anonymous namespace
+
   // basic constructor
   ForwardTranslator::ForwardTranslator()
+    : m_numThreads(0), m_combinedScene(false)
   {
     m_logSink.setLogLevel(Warn);
     m_logSink.setChannelRegex(boost::regex("openstudio\\.radiance\\.ForwardTranslator"));
@@ -133,6 +492,15 @@ namespace radiance {
   {
     m_model = model.clone(true).cast<openstudio::model::Model>();
 
+    // reset state from any previous translation
+    m_radMaterials.clear();
+    m_radMaterialsDC.clear();
+    m_radDCmats.clear();
+    m_radSceneFiles.clear();
+    m_radCombinedScene.clear();
+    m_radMapHandles.clear();
+    aperture_headings.clear();
+
     m_logSink.setThreadId(QThread::currentThread());
 
     m_logSink.resetStringStream();
@@ -378,10 +746,28 @@ namespace radiance {
     return result;
   }
 
-  openstudio::Point3dVector ForwardTranslator::getPolygon(const openstudio::model::Surface& surface)
+  void ForwardTranslator::setNumThreads(unsigned numThreads)
+  {
+    m_numThreads = numThreads;
+  }
+
+  unsigned ForwardTranslator::numThreads() const
+  {
+    return m_numThreads;
+  }
+
+  void ForwardTranslator::setCombinedScene(bool combinedScene)
   {
-    openstudio::Point3dVector result;
+    m_combinedScene = combinedScene;
+  }
 
+  bool ForwardTranslator::combinedScene() const
+  {
+    return m_combinedScene;
+  }
+
+  openstudio::Point3dVector ForwardTranslator::getPolygon(const openstudio::model::Surface& surface)
+  {
     Transformation buildingTransformation;
     OptionalBuilding building = surface.model().getOptionalUniqueModelObject<Building>();
     if (building){
@@ -394,40 +780,19 @@ namespace radiance {
       spaceTransformation = space->transformation();
     }
 
-    // transformation from space coordinates to face coordinates
-    Transformation alignFace = Transformation::alignFace(surface.vertices());
-
-    // get the current vertices and convert to face coordinates
-    Point3dVector surfaceFaceVertices = alignFace.inverse()*surface.vertices();
-
-    // subtract sub surface polygons from surface polygon
-    //jgs20100615 added
-    QPolygonF outer;
-    BOOST_FOREACH(const Point3d& point, surfaceFaceVertices){
-      if (abs(point.z()) > 0.001){
-        LOG(Warn, "Surface point z not on plane, z =" << point.z());
-      }
-      outer << QPointF(point.x(),point.y());
-    }
-
+    std::vector<openstudio::Point3dVector> subSurfaceVertices;
     BOOST_FOREACH(const SubSurface& subSurface, surface.subSurfaces()){
-      Point3dVector subsurfaceFaceVertices = alignFace.inverse()*subSurface.vertices();
-      QPolygonF inner;
-      BOOST_FOREACH(const Point3d& point, subsurfaceFaceVertices){
-        if (abs(point.z()) > 0.001){
-          LOG(Warn, "Subsurface point z not on plane, z =" << point.z());
-        }
-        inner << QPointF(point.x(),point.y());
-      }
-      outer = outer.subtracted(inner);
-
+      subSurfaceVertices.push_back(subSurface.vertices());
     }
 
-    BOOST_FOREACH(const QPointF& point, outer){
-      result.push_back(openstudio::Point3d(point.x(),point.y(), 0));
+    std::vector<std::string> warnings;
+    openstudio::Point3dVector result = subtractSubSurfaces(buildingTransformation, spaceTransformation,
+                                                           surface.vertices(), subSurfaceVertices, warnings);
+    BOOST_FOREACH(const std::string& warning, warnings){
+      LOG(Warn, warning);
     }
 
-    return buildingTransformation*spaceTransformation*alignFace*result;
+    return result;
   }
 
   openstudio::Point3dVector ForwardTranslator::getPolygon(const openstudio::model::SubSurface& subSurface)
@@ -727,8 +1092,7 @@ namespace radiance {
             ++shadingSurface)
         {
           // clean name
-          std::string shadingSurface_name = boost::algorithm::replace_all_regex_copy(shadingSurface->name().get(),
-              boost::regex("[ :]"),  std::string("_"));
+          std::string shadingSurface_name = radianceName(shadingSurface->name().get());
 
           LOG(Debug, "Site shading surface: " << shadingSurface_name );
           // get reflectance
@@ -757,19 +1121,16 @@ namespace radiance {
         }
       }
 
-      openstudio::path filename = t_radDir / openstudio::toPath("/scene/shading_site.rad");
-      t_outfiles.push_back(filename);
-      m_radSceneFiles.push_back(filename);
-
-      std::ofstream f(openstudio::toString(filename).c_str(), std::ios_base::out | std::ios_base::trunc);
-
+      std::string contents;
       for (std::set<std::string>::const_iterator line = siteShadingSurfaces.begin();
           line != siteShadingSurfaces.end();
           ++line)
       {
-        f << *line;
+        contents += *line;
       }
 
+      writeScene(t_radDir / openstudio::toPath("/scene/shading_site.rad"), contents, t_outfiles);
+
     }
 
 
@@ -796,8 +1157,7 @@ namespace radiance {
             ++shadingSurface)
         {
           // clean name
-          std::string shadingSurface_name = boost::algorithm::replace_all_regex_copy(shadingSurface->name().get(),
-              boost::regex("[ :]"),  std::string("_"));
+          std::string shadingSurface_name = radianceName(shadingSurface->name().get());
 
           LOG(Debug, "Building shading surface: " << shadingSurface_name);
           // get reflectance
@@ -825,569 +1185,243 @@ namespace radiance {
         }
       }
 
-      openstudio::path filename = t_radDir / openstudio::toPath("scene/shading_building.rad");
-      t_outfiles.push_back(filename);
-      m_radSceneFiles.push_back(filename);
-
-      std::ofstream f(openstudio::toString(filename).c_str(), std::ios_base::out | std::ios_base::trunc);
-
+      std::string contents;
       for (std::set<std::string>::const_iterator line = buildingShadingSurfaces.begin();
           line != buildingShadingSurfaces.end();
           ++line)
       {
-        f << *line;
+        contents += *line;
       }
+
+      writeScene(t_radDir / openstudio::toPath("scene/shading_building.rad"), contents, t_outfiles);
     }
   }
 
   void ForwardTranslator::buildingSpaces(const openstudio::path &t_radDir, const std::vector<openstudio::model::Space> &t_spaces,
       std::vector<openstudio::path> &t_outfiles)
   {
-    std::vector<std::string> space_names;
-
-    for (std::vector<openstudio::model::Space>::const_iterator space = t_spaces.begin();
-        space != t_spaces.end();
-        ++space)
-    {
-      std::string space_name = boost::algorithm::replace_all_regex_copy(space->name().get(),
-          boost::regex("[ :]"),  std::string("_"));
-      space_names.push_back(space_name);
-      LOG(Debug, "Processing space: " << space_name);
-      openstudio::Transformation space_transformation = space->transformation();
-
-      // split model into zone-based Radiance .rad files
-      m_radSpaces[space_name] = "#Space = " + space_name + "\n";
-
-      // clear out apertures for space
+    if (t_spaces.empty()){
+      return;
+    }
 
-      //  aperture_headings.each {|aperture_heading| m_radApertures[aperture_heading] = nil}
-      m_radApertures.clear();
+    Transformation buildingTransformation;
+    OptionalBuilding building = m_model.getOptionalUniqueModelObject<Building>();
+    if (building){
+      buildingTransformation = building->transformation();
+    }
 
-      // loop over surfaces in space
+    // read everything the translation needs from the model on this thread, the model is not
+    // safe to read from several threads at once
+    std::vector<RadSpace> spaces(t_spaces.size());
+    for (unsigned i = 0; i < t_spaces.size(); ++i)
+    {
+      const openstudio::model::Space& space = t_spaces[i];
+      RadSpace& radSpace = spaces[i];
 
-      std::vector<openstudio::model::Surface> surfaces = space->surfaces();
+      radSpace.name = radianceName(space.name().get());
+      radSpace.buildingTransformation = buildingTransformation;
+      radSpace.spaceTransformation = space.transformation();
+      LOG(Debug, "Processing space: " << radSpace.name);
 
-      for (std::vector<openstudio::model::Surface>::const_iterator surface = surfaces.begin();
-          surface != surfaces.end();
-          ++surface)
-      {
+      BOOST_FOREACH(const openstudio::model::Surface& surface, space.surfaces()){
 
         // skip if air wall
-        if (surface->isAirWall()) continue;
-
-        std::string surface_name = boost::algorithm::replace_all_regex_copy(surface->name().get(),
-            boost::regex("[ :]"),  std::string("_"));
-
-        // add surface to space geometry
-        m_radSpaces[space_name] += "#-Surface = " + surface_name + "\n";
-
-        // set construction of surface
-        std::string constructionName = surface->getString(2).get();
-        m_radSpaces[space_name] += "#--constructionName = " + constructionName + "\n";
-
-        double interiorVisibleAbsorbtance = surface->interiorVisibleAbsorbtance().get();
-        double exteriorVisibleAbsorbtance = surface->exteriorVisibleAbsorbtance().get();
-        double interiorVisibleReflectance = 1.0 - interiorVisibleAbsorbtance;
-        double exteriorVisibleReflectance = 1.0 - exteriorVisibleAbsorbtance;
-
-        m_radSpaces[space_name] += "#--interiorVisibleReflectance = " + formatString(interiorVisibleReflectance) + "\n";
-        m_radSpaces[space_name] += "#--exteriorVisibleReflectance = " + formatString(exteriorVisibleReflectance) + "\n";
-
-        // write material to library array
-        /// \todo deal with exterior surfaces
-        m_radMaterials.insert("void plastic refl_" + formatString(interiorVisibleReflectance)
-            + "\n0\n0\n5\n" + formatString(interiorVisibleReflectance)
-            + " " + formatString(interiorVisibleReflectance)
-            + " " + formatString(interiorVisibleReflectance) + " 0 0\n");
-
-        // write surface polygon
-        openstudio::Point3dVector polygon = openstudio::radiance::ForwardTranslator::getPolygon(*surface);
-
-        m_radSpaces[space_name] += "refl_" + formatString(interiorVisibleReflectance)
-          + " polygon " + surface_name + "\n0\n0\n" + formatString(polygon.size()*3) +"\n";
-
-        for (Point3dVector::const_iterator vertex = polygon.begin();
-            vertex != polygon.end();
-            ++vertex)
-        {
-          m_radSpaces[space_name] += formatString(vertex->x()) + " "
-            + formatString(vertex->y()) + " "
-            + formatString(vertex->z()) +"\n";
-        }
-
-
-        // figure out azimuth for window bins
-        // 15 degree bins per IES LM-83, currently under review (2012.01.20)
-        // changed to creating separate bins per heading (RPG 2012.02.21)
-        // TODO: allow grouping for highly discretized elevations
-
-        // trying to save some time here...
-        //
-        // double azi = surface->azimuth() * (180 / PI());
-        double azi = surface->azimuth();
-
-        // std::string aperture_heading = boost::lexical_cast<std::string>(azi);
-        std::string aperture_heading = boost::lexical_cast<std::string>(azi);
-          aperture_heading = formatString(azi, 4);
-
-        if (std::find(aperture_headings.begin(),aperture_headings.end(),aperture_heading) == aperture_headings.end())
-        {
-          aperture_headings.push_back(aperture_heading);
-        }
-
-// keep for future feature (offer auto-binning to window groups for highly tesselated facades)
-//
-//         if (azi >= 352.50 && azi < 7.50)
-//         {
-//           aperture_heading = "WG00";
-//         } else if (azi >= 7.50 && azi < 22.50) {
-//           aperture_heading = "WG01";
-//         } else if (azi >= 22.50 && azi < 37.50) {
-//           aperture_heading = "WG02";
-//         } else if (azi >= 37.50 && azi < 52.50) {
-//           aperture_heading = "WG03";
-//         } else if (azi >= 52.50 && azi < 67.50) {
-//           aperture_heading = "WG04";
-//         } else if (azi >= 67.50 && azi < 82.50) {
-//           aperture_heading = "WG05";
-//         } else if (azi >= 82.50 && azi < 97.50) {
-//           aperture_heading = "WG06";
-//         } else if (azi >= 97.50 && azi < 112.50) {
-//           aperture_heading = "WG07";
-//         } else if (azi >= 112.50 && azi < 127.50) {
-//           aperture_heading = "WG08";
-//         } else if (azi >= 127.50 && azi < 142.50) {
-//           aperture_heading = "WG09";
-//         } else if (azi >= 142.50 && azi < 157.50) {
-//           aperture_heading = "WG10";
-//         } else if (azi >= 157.51 && azi < 172.50) {
-//           aperture_heading = "WG11";
-//         } else if (azi >= 172.50 && azi < 187.50) {
-//           aperture_heading = "WG12";
-//         } else if (azi >= 187.50 && azi < 202.50) {
-//           aperture_heading = "WG13";
-//         } else if (azi >= 202.50 && azi < 217.50) {
-//           aperture_heading = "WG14";
-//         } else if (azi >= 217.51 && azi < 232.50) {
-//           aperture_heading = "WG15";
-//         } else if (azi >= 232.50 && azi < 247.50) {
-//           aperture_heading = "WG16";
-//         } else if (azi >= 247.50 && azi < 262.50) {
-//           aperture_heading = "WG17";
-//         } else if (azi >= 262.50 && azi < 277.50) {
-//           aperture_heading = "WG18";
-//         } else if (azi >= 277.50 && azi < 292.50) {
-//           aperture_heading = "WG19";
-//         } else if (azi >= 292.50 && azi < 307.50) {
-//           aperture_heading = "WG20";
-//         } else if (azi >= 207.50 && azi < 322.50) {
-//           aperture_heading = "WG21";
-//         } else if (azi >= 322.50 && azi < 337.50) {
-//           aperture_heading = "WG22";
-//         } else {
-//           aperture_heading = "WG23";
-//         }
-
-        std::vector<openstudio::model::SubSurface> subSurfaces = surface->subSurfaces();
-
-        for (std::vector<openstudio::model::SubSurface>::const_iterator subSurface = subSurfaces.begin();
-            subSurface != subSurfaces.end();
-            ++subSurface)
-        {
-          std::string subSurface_name = boost::algorithm::replace_all_regex_copy(subSurface->name().get(),
-              boost::regex("[ :]"),  std::string("_"));
-
-          m_radSpaces[space_name] += "#--SubSurface = " + subSurface_name + "\n";
-
-          std::string subSurfaceUpCase = boost::algorithm::to_upper_copy(subSurface->subSurfaceType());
-
+        if (surface.isAirWall()) continue;
+
+        RadSurface radSurface;
+        radSurface.name = radianceName(surface.name().get());
+        radSurface.constructionName = surface.getString(2).get();
+        radSurface.interiorVisibleReflectance = 1.0 - surface.interiorVisibleAbsorbtance().get();
+        radSurface.exteriorVisibleReflectance = 1.0 - surface.exteriorVisibleAbsorbtance().get();
+        radSurface.azimuth = surface.azimuth();
+        radSurface.vertices = surface.vertices();
+
+        BOOST_FOREACH(const openstudio::model::SubSurface& subSurface, surface.subSurfaces()){
+          radSurface.subSurfaceVertices.push_back(subSurface.vertices());
+
+          RadSubSurface radSubSurface;
+          radSubSurface.name = radianceName(subSurface.name().get());
+          radSubSurface.type = subSurface.subSurfaceType();
+          radSubSurface.interiorVisibleReflectance = 0.0;
+          radSubSurface.exteriorVisibleReflectance = 0.0;
+
+          std::string subSurfaceUpCase = boost::algorithm::to_upper_copy(radSubSurface.type);
           if (subSurfaceUpCase == "FIXEDWINDOW"
               || subSurfaceUpCase == "OPERABLEWINDOW"
               || subSurfaceUpCase == "GLASSDOOR")
           {
-
-            if (m_radApertures.find(aperture_heading) == m_radApertures.end())
-            {
-              m_radApertures[aperture_heading] = "#SpaceApertures = " + space_name + "_" + aperture_heading + "\n";
-            }
-
-            LOG(Info, "found a "+subSurface->subSurfaceType()+", azimuth = "+formatString(azi)+ "("+subSurface_name+")");
-
-            if (!subSurface->visibleTransmittance())
-            {
-              LOG(Warn, "Cannot determine visible transmittance for SubSurface " << subSurface_name << ", it will not be translated.");
-              continue;
-            }
-
-            double visibleTransmittance = subSurface->visibleTransmittance().get();
-
-            // convert transmittance (Tn) to transmissivity (tn) for Radiance material
-            // tn = (sqrt(.8402528435+.0072522239*Tn*Tn)-.9166530661)/.0036261119/Tn
-            double tVis = visibleTransmittance;
-            double tn = 0;
-            if (tVis == 0.0) {
-              LOG(Warn, subSurface_name << " has transmittance of zero.");
-              tn = 0.0;
-              LOG(Debug, "Tvis = " << tVis << " (tn = " << tn << ")");
-            } else {
-              double tn_x = 0.0072522239 * tVis * tVis;
-              double tn_y = sqrt(tn_x + 0.8402528435) - 0.9166530661;
-              tn = tn_y / 0.0036261119 /tVis;
-              LOG(Debug, "Tvis = " << tVis << " (tn = " << tn << ")");
-            }
-
-            /// \todo add support for translucent materials
-            m_radApertures[aperture_heading] += "#---Tvis = " + formatString(tVis) + " (tn = "+formatString(tn)+")\n";
-            // write material
-            m_radMaterials.insert("void glass glaz_"+space_name+"_azi-"+formatString(azi, 4)+"_tn-"+formatString(tn, 4)+"\n0\n0\n3\n"+formatString(tn, 4)+" "+formatString(tn, 4)+" "+ formatString(tn, 4) +"\n");
-            m_radMaterialsDC.insert("void light glaz_spc-"+space_name+"_azi-"+formatString(azi, 4)+"_tn-"+formatString(tn, 4)+"\n0\n0\n3\n1 1 1\n");
-            m_radDCmats.insert("glaz_"+space_name+"_azi-"+formatString(azi, 4)+"_tn-"+formatString(tn, 4)+ ".vmx,glazing.xml,glazing_blind.xml,glaz_" + space_name + "_azi-" + formatString(azi, 4) + "_tn-" + formatString(tn, 4) + ".dmx,\n");
-            // polygon header
-            m_radApertures[aperture_heading] += "#--SubSurface = " + subSurface_name + "\n";
-            m_radApertures[aperture_heading] += "#---Tvis = " + formatString(tVis, 4) + " (tn = " + formatString(tn, 4) + ")\n";
-            // get/write the polygon
-            openstudio::Point3dVector polygon = openstudio::radiance::ForwardTranslator::getPolygon(*subSurface);
-            m_radApertures[aperture_heading] += "glaz_" + space_name + "_azi-" + formatString(azi, 4) + "_tn-" + formatString(tn, 4) + " polygon " + subSurface_name + "\n";
-            m_radApertures[aperture_heading] += "0\n0\n" + formatString(polygon.size()*3) + "\n";
-
-            for (Point3dVector::const_reverse_iterator vertex = polygon.rbegin();
-                vertex != polygon.rend();
-                ++vertex)
-            {
-              m_radApertures[aperture_heading] += "" + formatString(vertex->x()) + " " + formatString(vertex->y()) + " " + formatString(vertex->z()) + "\n";
-            }
-
+            radSubSurface.visibleTransmittance = subSurface.visibleTransmittance();
           } else if (subSurfaceUpCase == "DOOR") {
-
-            LOG(Info, "found a door, using interior reflectance");
-
-            double interiorVisibleAbsorbtance = subSurface->interiorVisibleAbsorbtance().get();
-            double exteriorVisibleAbsorbtance = subSurface->exteriorVisibleAbsorbtance().get();
-            double interiorVisibleReflectance = 1.0 - interiorVisibleAbsorbtance;
-            double exteriorVisibleReflectance = 1.0 - exteriorVisibleAbsorbtance;
-            //polygon header
-            m_radSpaces[space_name] += "#--interiorVisibleReflectance = " + formatString(interiorVisibleReflectance) + "\n";
-            m_radSpaces[space_name] += "#--exteriorVisibleReflectance = " + formatString(exteriorVisibleReflectance) + "\n";
-            // write material
-            m_radMaterials.insert("void plastic refl_" + formatString(interiorVisibleReflectance) + "\n0\n0\n5\n" + formatString(interiorVisibleReflectance) + " " + formatString(interiorVisibleReflectance) + " " + formatString(interiorVisibleReflectance) + " 0 0\n\n");
-            // get / write polygon
-
-            openstudio::Point3dVector polygon = openstudio::radiance::ForwardTranslator::getPolygon(*subSurface);
-            m_radSpaces[space_name] += "refl_" + formatString(interiorVisibleReflectance) + " polygon " + subSurface_name + "\n";
-            m_radSpaces[space_name] += "0\n0\n" + formatString(polygon.size()*3) + "\n";
-
-            for (Point3dVector::const_iterator vertex = polygon.begin();
-                vertex != polygon.end();
-                ++vertex)
-            {
-              m_radSpaces[space_name] += formatString(vertex->x()) + " " + formatString(vertex->y()) + " " + formatString(vertex->z()) + "\n\n";
-            }
-
+            radSubSurface.interiorVisibleReflectance = 1.0 - subSurface.interiorVisibleAbsorbtance().get();
+            radSubSurface.exteriorVisibleReflectance = 1.0 - subSurface.exteriorVisibleAbsorbtance().get();
           } else if (subSurfaceUpCase == "SKYLIGHT") {
-            /// \todo place skylights in their own file by space, separate from geometry
-            double visibleTransmittance = subSurface->visibleTransmittance().get();
-            // convert transmittance (Tn) to transmissivity (tn) for Radiance material
-            // tn = (sqrt(.8402528435+.0072522239*Tn*Tn)-.9166530661)/.0036261119/Tn
-            double tVis = visibleTransmittance;
-            double tn = 0.0;
-            if (tVis == 0.0)
-            {
-              LOG(Warn, subSurface_name << " has transmittance of zero.");
-              tn = 0.0;
-              LOG(Debug, "Tvis = " << tVis << " (tn = " << tn << ")");
-            } else  {
-              double tn_x = 0.0072522239 * tVis * tVis;
-              double tn_y = sqrt(tn_x + 0.8402528435) - 0.9166530661;
-              tn = tn_y / 0.0036261119 /tVis;
-              LOG(Debug, "Tvis = " << tVis << " (tn = " << tn << ")");
-            }
-
-            LOG(Debug, "Found a skylight, (" + subSurface_name + "), using simple glass model (Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")");
-
-            m_radSpaces[space_name] += "#---Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")\n";
-            // write material
-            m_radMaterials.insert("void glass glaz_skylight_" + space_name + "_" + formatString(tn) + "\n0\n0\n3\n" + formatString(tn) + " " + formatString(tn) + " " + formatString(tn) + "\n");
-            m_radMaterialsDC.insert("void light glaz_skylight_" + space_name + "_vmx\n0\n0\n3\n1 1 1\nvoid alias glaz_skylight_" + space_name + "_" + formatString(tn) + " glaz_skylight_" + space_name + "_vmx\n");
-            m_radDCmats.insert("glaz_skylight_" + space_name + ",");
-            // polygon header
-            m_radSpaces[space_name] += "#--SubSurface = " + subSurface_name + "\n";
-            m_radSpaces[space_name] += "#---Tvis = " + formatString(tVis) + " (tn = " + formatString(tn) + ")\n";
-
-            // get/write the polygon
-            openstudio::Point3dVector polygon = openstudio::radiance::ForwardTranslator::getPolygon(*subSurface);
-
-            m_radSpaces[space_name] += "glaz_skylight_" + space_name + "_" + formatString(tn) + " polygon " + space_name + "_" + subSurface_name + "\n";
-            m_radSpaces[space_name] += "0\n0\n" + formatString(polygon.size()*3) + "\n";
-            for (Point3dVector::const_iterator vertex = polygon.begin();
-                vertex != polygon.end();
-                ++vertex)
-            {
-              m_radSpaces[space_name] += "" + formatString(vertex->x()) + " " + formatString(vertex->y()) + " " + formatString(vertex->z()) + "\n";
-            }
-          } else if (subSurfaceUpCase == "TUBULARDAYLIGHTDOME") {
-            LOG(Warn, "subsurface is a tdd dome, not translated (not yet implemented).");
-          } else if (subSurfaceUpCase == "TUBULARDAYLIGHTDIFFUSER") {
-            LOG(Warn, "subsurface is a tdd diffuser, not translated (not yet implemented).");
+            radSubSurface.visibleTransmittance = subSurface.visibleTransmittance().get();
           }
-        }
-      } // loop over surfaces
+          radSubSurface.polygon = openstudio::radiance::ForwardTranslator::getPolygon(subSurface);
 
-      // get shading surfaces
-      /// \note no constructions yet, so surface properties are hard coded to 20% Rvis, 100% opaque
-
-      std::vector<openstudio::model::ShadingSurfaceGroup> shadingSurfaceGroups = space->shadingSurfaceGroups();
-      for (std::vector<openstudio::model::ShadingSurfaceGroup>::const_iterator shadingSurfaceGroup = shadingSurfaceGroups.begin();
-          shadingSurfaceGroup != shadingSurfaceGroups.end();
-          ++shadingSurfaceGroup)
-      {
-        std::vector<openstudio::model::ShadingSurface> shadingSurfaces = shadingSurfaceGroup->shadingSurfaces();
-        for (std::vector<openstudio::model::ShadingSurface>::const_iterator shadingSurface = shadingSurfaces.begin();
-            shadingSurface != shadingSurfaces.end();
-            ++shadingSurface)
-        {
-          std::string shadingSurface_name = boost::algorithm::replace_all_regex_copy(shadingSurface->name().get(),
-              boost::regex("[ :]"),  std::string("_"));
-
-          //puts "found a shading surface"
-          // add surface to zone geometry
-          m_radSpaces[space_name] += "#-Surface = " + shadingSurface_name + "\n";
+          radSurface.subSurfaces.push_back(radSubSurface);
+        }
 
-          // set construction of shadingSurface
-          std::string constructionName = shadingSurface->getString(1).get();
-          m_radSpaces[space_name] += "#--constructionName = " + constructionName + "\n";
+        radSpace.surfaces.push_back(radSurface);
+      }
 
-          // get reflectance
+      BOOST_FOREACH(const openstudio::model::ShadingSurfaceGroup& shadingSurfaceGroup, space.shadingSurfaceGroups()){
+        BOOST_FOREACH(const openstudio::model::ShadingSurface& shadingSurface, shadingSurfaceGroup.shadingSurfaces()){
+          RadPlanarSurface radShadingSurface;
+          radShadingSurface.name = radianceName(shadingSurface.name().get());
+          radShadingSurface.constructionName = shadingSurface.getString(1).get();
           // no constructions yet, Rvis = .2 (same as EnergyPlus default)
-          double interiorVisibleReflectance = 0.2;
-          double exteriorVisibleReflectance = 0.2;
-          // write material
-          m_radMaterials.insert("void plastic refl_" + formatString(interiorVisibleReflectance) + "\n0\n0\n5\n" + formatString(interiorVisibleReflectance) + " " + formatString(interiorVisibleReflectance) + " " + formatString(interiorVisibleReflectance) + " 0 0\n\n");
-          // polygon header
-          m_radSpaces[space_name] += "#--interiorVisibleReflectance = " + formatString(interiorVisibleReflectance) + "\n";
-          m_radSpaces[space_name] += "#--exteriorVisibleReflectance = " + formatString(exteriorVisibleReflectance) + "\n";
-          // get / write surface polygon
-          //
-          openstudio::Point3dVector polygon = openstudio::radiance::ForwardTranslator::getPolygon(*shadingSurface);
-          m_radSpaces[space_name] += "refl_" + formatString(interiorVisibleReflectance) + " polygon " + shadingSurface_name + "\n0\n0\n" + formatString(polygon.size()*3) + "\n";
-
-          for (Point3dVector::const_iterator vertex = polygon.begin();
-              vertex != polygon.end();
-              ++vertex)
-          {
-            m_radSpaces[space_name] += "" + formatString(vertex->x()) + " " + formatString(vertex->y()) + " " + formatString(vertex->z()) + "\n\n";
-          }
+          radShadingSurface.interiorVisibleReflectance = 0.2;
+          radShadingSurface.exteriorVisibleReflectance = 0.2;
+          radShadingSurface.polygon = openstudio::radiance::ForwardTranslator::getPolygon(shadingSurface);
+          radSpace.shadingSurfaces.push_back(radShadingSurface);
+        }
+      }
 
+      BOOST_FOREACH(const openstudio::model::InteriorPartitionSurfaceGroup& interiorPartitionSurfaceGroup, space.interiorPartitionSurfaceGroups()){
+        BOOST_FOREACH(const openstudio::model::InteriorPartitionSurface& interiorPartitionSurface, interiorPartitionSurfaceGroup.interiorPartitionSurfaces()){
+          RadPlanarSurface radInteriorPartitionSurface;
+          radInteriorPartitionSurface.name = radianceName(interiorPartitionSurface.name().get());
+          radInteriorPartitionSurface.constructionName = interiorPartitionSurface.getString(1).get();
+          radInteriorPartitionSurface.interiorVisibleReflectance = 1.0 - interiorPartitionSurface.interiorVisibleAbsorbtance().get();
+          radInteriorPartitionSurface.exteriorVisibleReflectance = 1.0 - interiorPartitionSurface.exteriorVisibleAbsorbtance().get();
+          radInteriorPartitionSurface.polygon = openstudio::radiance::ForwardTranslator::getPolygon(interiorPartitionSurface);
+          radSpace.interiorPartitionSurfaces.push_back(radInteriorPartitionSurface);
         }
       }
 
-      std::vector<openstudio::model::InteriorPartitionSurfaceGroup> interiorPartitionSurfaceGroups = space->interiorPartitionSurfaceGroups();
-      for (std::vector<openstudio::model::InteriorPartitionSurfaceGroup>::const_iterator interiorPartitionSurfaceGroup
-          = interiorPartitionSurfaceGroups.begin();
-          interiorPartitionSurfaceGroup != interiorPartitionSurfaceGroups.end();
-          ++interiorPartitionSurfaceGroup)
-      {
-        std::vector<openstudio::model::InteriorPartitionSurface> interiorPartitionSurfaces = interiorPartitionSurfaceGroup->interiorPartitionSurfaces();
-        for (std::vector<openstudio::model::InteriorPartitionSurface>::const_iterator interiorPartitionSurface = interiorPartitionSurfaces.begin();
-            interiorPartitionSurface != interiorPartitionSurfaces.end();
-            ++interiorPartitionSurface)
-        {
-          std::string interiorPartitionSurface_name = boost::algorithm::replace_all_regex_copy(interiorPartitionSurface->name().get(),
-              boost::regex("[ :]"),  std::string("_"));
+      ///  \todo translate luminaires once they are fully supported in model
 
-          // add surface to zone geometry
-          m_radSpaces[space_name] += "#-Surface = " + interiorPartitionSurface_name + "\n";
+      BOOST_FOREACH(const openstudio::model::DaylightingControl& control, space.daylightingControls()){
+        Vector3dVector sensorVector(1u, openstudio::radiance::ForwardTranslator::getSensorVector(control));
+        radSpace.daylightingControls.push_back(std::make_pair(openstudio::radiance::ForwardTranslator::getReferencePoint(control), sensorVector));
+      }
 
-          // set construction of interiorPartitionSurface
-          std::string constructionName = interiorPartitionSurface->getString(1).get();
-          m_radSpaces[space_name] += "#--constructionName = " + constructionName + "\n";
+      BOOST_FOREACH(const openstudio::model::GlareSensor& sensor, space.glareSensors()){
+        radSpace.glareSensors.push_back(std::make_pair(openstudio::radiance::ForwardTranslator::getReferencePoint(sensor),
+                                                       openstudio::radiance::ForwardTranslator::getViewVectors(sensor)));
+      }
 
-          // get reflectance
-          double interiorVisibleAbsorbtance = interiorPartitionSurface->interiorVisibleAbsorbtance().get();
-          double exteriorVisibleAbsorbtance = interiorPartitionSurface->exteriorVisibleAbsorbtance().get();
-          double interiorVisibleReflectance = 1.0 - interiorVisibleAbsorbtance;
-          double exteriorVisibleReflectance = 1.0 - exteriorVisibleAbsorbtance;
+      BOOST_FOREACH(const openstudio::model::IlluminanceMap& map, space.illuminanceMaps()){
+        radSpace.illuminanceMaps.push_back(std::make_pair(map.handle(), openstudio::radiance::ForwardTranslator::getReferencePoints(map)));
+      }
+    }
 
-          // write material
-          m_radMaterials.insert("void plastic refl_" + formatString(interiorVisibleReflectance) + "\n0\n0\n5\n" + formatString(interiorVisibleReflectance) + " " + formatString(interiorVisibleReflectance) + " " + formatString(interiorVisibleReflectance) + " 0 0\n\n");
-          // polygon header
-          m_radSpaces[space_name] += "#--interiorVisibleReflectance = " + formatString(interiorVisibleReflectance) + "\n";
-          m_radSpaces[space_name] += "#--exteriorVisibleReflectance = " + formatString(exteriorVisibleReflectance) + "\n";
-          // get / write surface polygon
+    // clip polygons and generate radiance input for each space, spaces are independent so
+    // they are split across threads
+    std::vector<RadSpaceScene> scenes(spaces.size());
+    unsigned numThreads = m_numThreads;
+    if (numThreads == 0){
+      numThreads = std::max(1u, boost::thread::hardware_concurrency());
+    }
+    numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, spaces.size()));
 
-          openstudio::Point3dVector polygon = openstudio::radiance::ForwardTranslator::getPolygon(*interiorPartitionSurface);
-          m_radSpaces[space_name] += "refl_" + formatString(interiorVisibleReflectance) + " polygon " + interiorPartitionSurface_name + "\n0\n0\n" + formatString(polygon.size()*3) + "\n";
-          for (Point3dVector::const_iterator vertex = polygon.begin();
-              vertex != polygon.end();
-              ++vertex)
-          {
-            m_radSpaces[space_name] += formatString(vertex->x()) + " " + formatString(vertex->y()) + " " + formatString(vertex->z()) + "\n\n";
-          }
-        }
+    if (numThreads <= 1){
+      translateSpaces(spaces, scenes, 0, 1);
+    }else{
+      boost::thread_group threads;
+      for (unsigned i = 0; i < numThreads; ++i){
+        threads.create_thread(boost::bind(&translateSpaces, boost::cref(spaces), boost::ref(scenes), i, numThreads));
       }
+      threads.join_all();
+    }
 
-      // get luminaires
-      ///  \todo fully implement once luminaires are fully supported in model
-      std::vector<openstudio::model::Luminaire> luminaires = space->luminaires();
-      for (std::vector<openstudio::model::Luminaire>::const_iterator luminaire = luminaires.begin();
-          luminaire != luminaires.end();
-          ++luminaire)
-      {
-        //    luminaire_name = luminaire.name.get.gsub(' ', '_').gsub(':', '_')
-        //    polygon = OpenStudio::Radiance::ForwardTranslator::getPolygon(luminaire)
+    // write results in space order so that output does not depend on thread scheduling
+    for (unsigned i = 0; i < spaces.size(); ++i)
+    {
+      const std::string& space_name = spaces[i].name;
+      const RadSpaceScene& scene = scenes[i];
+
+      typedef std::pair<LogLevel, std::string> Message;
+      BOOST_FOREACH(const Message& message, scene.messages){
+        LOG(message.first, message.second);
       }
 
-      // get daylighting control points
-      std::vector<openstudio::model::DaylightingControl> daylightingControls = space->daylightingControls();
-      for (std::vector<openstudio::model::DaylightingControl>::const_iterator control = daylightingControls.begin();
-          control != daylightingControls.end();
-          ++control)
-      {
-        m_radSensors[space_name] = "";
+      m_radMaterials.insert(scene.materials.begin(), scene.materials.end());
+      m_radMaterialsDC.insert(scene.materialsDC.begin(), scene.materialsDC.end());
+      m_radDCmats.insert(scene.dcMats.begin(), scene.dcMats.end());
+
+      BOOST_FOREACH(const std::string& aperture_heading, scene.apertureHeadings){
+        if (std::find(aperture_headings.begin(),aperture_headings.end(),aperture_heading) == aperture_headings.end())
+        {
+          aperture_headings.push_back(aperture_heading);
+        }
+      }
 
-        openstudio::Point3d sensor_point = openstudio::radiance::ForwardTranslator::getReferencePoint(*control);
-        openstudio::Vector3d sensor_aimVector = openstudio::radiance::ForwardTranslator::getSensorVector(*control);
-        m_radSensors[space_name] += formatString(sensor_point.x()) + " " + formatString(sensor_point.y()) + " " + formatString(sensor_point.z()) + " " + formatString(sensor_aimVector.x()) + " " + formatString(sensor_aimVector.y()) + " " + formatString(sensor_aimVector.z()) + "\n";
-       
+      if (scene.sensors){
         // write daylighting controls
         openstudio::path filename = t_radDir/openstudio::toPath("numeric")/openstudio::toPath(space_name + ".sns");
         std::ofstream file(openstudio::toString(filename).c_str());
         t_outfiles.push_back(filename);
-        file << m_radSensors[space_name];
+        file << *scene.sensors;
 
         LOG(Debug, "INFO: wrote " << space_name << ".sns");
       }
-       
-      
-      // get glare sensor
-      std::vector<openstudio::model::GlareSensor> glareSensors = space->glareSensors();
-      for (std::vector<openstudio::model::GlareSensor>::const_iterator sensor = glareSensors.begin();
-          sensor != glareSensors.end();
-          ++sensor)
-      {
-        m_radGlareSensors[space_name] = "";
 
-        openstudio::Point3d sensor_point = openstudio::radiance::ForwardTranslator::getReferencePoint(*sensor);
-        // openstudio::Vector3dVector sensor_viewVector = openstudio::radiance::ForwardTranslator::getViewVectors(*sensor);
-        openstudio::Vector3dVector viewVectors = openstudio::radiance::ForwardTranslator::getViewVectors(*sensor);
-        BOOST_FOREACH(const Vector3d& viewVector, viewVectors){        
-        m_radGlareSensors[space_name] += formatString(sensor_point.x()) + " " + formatString(sensor_point.y()) + " " + formatString(sensor_point.z()) + " " + formatString(viewVector.x()) + " " + formatString(viewVector.y()) + " " + formatString(viewVector.z()) + "\n";
-        }
+      if (scene.glareSensors){
         // write glare sensor
         openstudio::path filename = t_radDir/openstudio::toPath("numeric")/openstudio::toPath(space_name + ".glr");
         std::ofstream file(openstudio::toString(filename).c_str());
         t_outfiles.push_back(filename);
-        file << m_radGlareSensors[space_name];
+        file << *scene.glareSensors;
 
         LOG(Debug, "INFO: wrote " << space_name << ".glr");
       }
 
-      //{  
-      //  m_radViews[space_name] = "";
-      //
-      //  openstudio::Point3d sensor_point = openstudio::radiance::ForwardTranslator::getReferencePoint(*viewpoints);
-      //  openstudio::Vector3dVector sensor_viewVector = openstudio::radiance::ForwardTranslator::getViewVectors(*viewpoints);
-      //  m_radViews[space_name] += "rvu -vta -vp " + formatString(sensor_point.x()) + " " + formatString(sensor_point.y()) + " " + formatString(sensor_point.z()) + " -vd " + formatString(sensor_viewVector[0].x()) + " " + formatString(sensor_viewVector[0].y()) + " " + formatString(sensor_viewVector[0].z()) + " -vu 0 0 1 -vh 180 -vv 180 -vo 0 -vs 0 -vl 0\n";
-      //
-      //  // write views
-      //  openstudio::path filename = t_radDir/openstudio::toPath("views")/openstudio::toPath(space_name + ".vw");
-      //  std::ofstream file(openstudio::toString(filename).c_str());
-      //  t_outfiles.push_back(filename);
-      //  file << m_radViews[space_name];
-      //
-      //  LOG(Debug, "INFO: wrote " << space_name << ".vw");
-      //}
-      
-      // get output illuminance map points, write to file
-      std::vector<openstudio::model::IlluminanceMap> illuminanceMaps = space->illuminanceMaps();
-      for (std::vector<openstudio::model::IlluminanceMap>::const_iterator map = illuminanceMaps.begin();
-          map != illuminanceMaps.end();
-          ++map)
-      {
-        m_radMaps[space_name] = "";
-        m_radMapHandles[space_name] = map->handle();
-
-        std::vector<Point3d> referencePoints = openstudio::radiance::ForwardTranslator::getReferencePoints(*map);
+      if (scene.mapHandle){
+        m_radMapHandles[space_name] = *scene.mapHandle;
+      }
 
-        for (std::vector<Point3d>::const_iterator point = referencePoints.begin();
-            point != referencePoints.end();
-            ++point)
-        {
-          m_radMaps[space_name] += "" + formatString(point->x()) + " " + formatString(point->y()) + " " + formatString(point->z()) + " 0 0 1\n";
-          // write map file
-          openstudio::path filename = t_radDir/openstudio::toPath("numeric")/openstudio::toPath(space_name + ".map");
-          std::ofstream file(openstudio::toString(filename).c_str());
-          t_outfiles.push_back(filename);
-          file << m_radMaps[space_name];
-        }
+      if (scene.map){
+        // write map file
+        openstudio::path filename = t_radDir/openstudio::toPath("numeric")/openstudio::toPath(space_name + ".map");
+        std::ofstream file(openstudio::toString(filename).c_str());
+        t_outfiles.push_back(filename);
+        file << *scene.map;
 
         LOG(Debug, "wrote " << space_name << ".map");
       }
 
       // write geometry
-      openstudio::path filename = t_radDir / openstudio::toPath("scene") / openstudio::toPath(space_name + "_geom.rad");
-      t_outfiles.push_back(filename);
-      m_radSceneFiles.push_back(filename);
-
-      std::ofstream file(toString(filename).c_str());
-      file << m_radSpaces[space_name];
+      writeScene(t_radDir / openstudio::toPath("scene") / openstudio::toPath(space_name + "_geom.rad"), scene.geometry, t_outfiles);
 
       for (std::vector<std::string>::const_iterator aperture_heading = aperture_headings.begin();
           aperture_heading != aperture_headings.end();
           ++aperture_heading)
       {
         //write windows (and glazed doors)
-        if (m_radApertures.find(*aperture_heading) != m_radApertures.end())
+        std::map<std::string, std::string>::const_iterator aperture = scene.apertures.find(*aperture_heading);
+        if (aperture != scene.apertures.end())
         {
           openstudio::path glazefilename = t_radDir / openstudio::toPath("scene/glazing") / openstudio::toPath(space_name + "_glaz_" + *aperture_heading + ".rad");
-          m_radSceneFiles.push_back(glazefilename);
-          std::ofstream glazefile(openstudio::toString(glazefilename).c_str());
-          t_outfiles.push_back(glazefilename);
-          glazefile << m_radApertures[*aperture_heading];
+          writeScene(glazefilename, aperture->second, t_outfiles);
         }
       }
+    }
 
-      // write radiance materials file
-      openstudio::path materialsfilename = t_radDir / openstudio::toPath("materials/materials.rad");
-      t_outfiles.push_back(materialsfilename);
-      std::ofstream materialsfile(openstudio::toString(materialsfilename).c_str());
-
-      for (std::set<std::string>::const_iterator line = m_radMaterials.begin();
-          line != m_radMaterials.end();
-          ++line)
-      {
-        materialsfile << *line;
-      };
-
-      // write radiance DC vmx materials (lights) file
-      openstudio::path materials_vmxfilename = t_radDir / openstudio::toPath("materials/materials_vmx.rad");
-      t_outfiles.push_back(materials_vmxfilename);
-      std::ofstream materials_vmxfile(openstudio::toString(materials_vmxfilename).c_str());
-
-      for (std::set<std::string>::const_iterator line = m_radMaterialsDC.begin();
-          line != m_radMaterialsDC.end();
-          ++line)
-      {
-        materials_vmxfile << *line;
-      };
-
-      // write radiance vmx materials list
-      openstudio::path materials_dcfilename = t_radDir / openstudio::toPath("bsdf/mapping.rad");
-      t_outfiles.push_back(materials_dcfilename);
-      std::ofstream materials_dcfile(openstudio::toString(materials_dcfilename).c_str());
+    // write radiance materials file
+    openstudio::path materialsfilename = t_radDir / openstudio::toPath("materials/materials.rad");
+    t_outfiles.push_back(materialsfilename);
+    writeLines(materialsfilename, m_radMaterials);
 
-      for (std::set<std::string>::const_iterator line = m_radDCmats.begin();
-          line != m_radDCmats.end();
-          ++line)
-      {
-        materials_dcfile << *line;
-      };
+    // write radiance DC vmx materials (lights) file
+    openstudio::path materials_vmxfilename = t_radDir / openstudio::toPath("materials/materials_vmx.rad");
+    t_outfiles.push_back(materials_vmxfilename);
+    writeLines(materials_vmxfilename, m_radMaterialsDC);
 
+    // write radiance vmx materials list
+    openstudio::path materials_dcfilename = t_radDir / openstudio::toPath("bsdf/mapping.rad");
+    t_outfiles.push_back(materials_dcfilename);
+    writeLines(materials_dcfilename, m_radDCmats);
 
-      // write complete scene
-      openstudio::path modelfilename= t_radDir / openstudio::toPath("model.rad");
-      t_outfiles.push_back(modelfilename);
-      std::ofstream modelfile(openstudio::toString(modelfilename).c_str());
+    // write complete scene
+    openstudio::path modelfilename= t_radDir / openstudio::toPath("model.rad");
+    t_outfiles.push_back(modelfilename);
+    std::ofstream modelfile(openstudio::toString(modelfilename).c_str());
 
+    if (m_combinedScene){
+      modelfile << m_radCombinedScene;
+    }else{
       // materials not included in model.rad (suport for 3-phase method)
       // modelfile << "!xform materials/materials.rad\n";
 
@@ -1397,8 +1431,36 @@ namespace radiance {
       {
         modelfile << "!xform ./" << openstudio::toString(openstudio::relativePath(*filename, t_radDir)) << std::endl;
       }
+    }
+  }
+
+  void ForwardTranslator::writeScene(const openstudio::path &t_filename, const std::string &t_contents,
+      std::vector<openstudio::path> &t_outfiles)
+  {
+    if (m_combinedScene){
+      m_radCombinedScene += "#Scene = " + openstudio::toString(t_filename.filename()) + "\n";
+      m_radCombinedScene += t_contents;
+      return;
+    }
+
+    t_outfiles.push_back(t_filename);
+    m_radSceneFiles.push_back(t_filename);
+
+    std::ofstream f(openstudio::toString(t_filename).c_str(), std::ios_base::out | std::ios_base::trunc);
+    f << t_contents;
+  }
+
+  void ForwardTranslator::writeLines(const openstudio::path &t_filename, const std::set<std::string> &t_lines)
+  {
+    std::ofstream f(openstudio::toString(t_filename).c_str());
 
+    for (std::set<std::string>::const_iterator line = t_lines.begin();
+        line != t_lines.end();
+        ++line)
+    {
+      f << *line;
     }
   }
+
 } // radiance
 } // openstudio
@@ -60,6 +60,25 @@ namespace radiance {
      */
     std::vector<LogMessage> errors() const;
 
+    /** Set the number of threads used to generate space geometry, materials and sensors. Model
+     *  data is always read on the calling thread and output is written in space order, so results
+     *  do not depend on this setting. Zero, the default, uses one thread per hardware core.
+     */
+    void setNumThreads(unsigned numThreads);
+
+    /** Number of threads used to generate space geometry, zero means one thread per hardware core.
+     */
+    unsigned numThreads() const;
+
+    /** If true, space, glazing and shading geometry is written directly into model.rad instead of
+     *  to separate files under scene/ that model.rad references with !xform. Defaults to false.
+     */
+    void setCombinedScene(bool combinedScene);
+
+    /** Whether geometry is written directly into model.rad.
+     */
+    bool combinedScene() const;
+
     // for now just implement some functionality and let the Ruby script
     // be the main driver
 
@@ -118,17 +137,17 @@ namespace radiance {
       // scene files
       std::vector<openstudio::path> m_radSceneFiles;
 
-      // create space geometry, hashes of space name to file contents
-      std::map<std::string, std::string> m_radSpaces;
-      std::map<std::string, std::string> m_radSensors;
-      std::map<std::string, std::string> m_radGlareSensors;
-      std::map<std::string, std::string> m_radMaps;
+      // scene contents when writing a combined scene
+      std::string m_radCombinedScene;
+
+      // hash of space name to illuminance map handle
       std::map<std::string, openstudio::Handle> m_radMapHandles;
-      std::map<std::string, std::string> m_radViewPoints;
-      std::map<std::string, std::string> m_radApertures;
 
       std::vector<std::string> aperture_headings;
 
+      unsigned m_numThreads;
+      bool m_combinedScene;
+
       void siteShadingSurfaceGroups(const openstudio::path &t_radDir, 
           const std::vector<openstudio::model::ShadingSurfaceGroup> &t_radShadingSurfaceGroups,
           std::vector<openstudio::path> &t_outpaths);
@@ -140,6 +159,12 @@ namespace radiance {
       void buildingSpaces(const openstudio::path &t_radDir, 
           const std::vector<openstudio::model::Space> &t_spaces,
           std::vector<openstudio::path> &t_outpaths);
+
+      // write a scene file and reference it from model.rad, or append it to the combined scene
+      void writeScene(const openstudio::path &t_filename, const std::string &t_contents,
+          std::vector<openstudio::path> &t_outpaths);
+
+      static void writeLines(const openstudio::path &t_filename, const std::set<std::string> &t_lines);
     
     StringStreamLogSink m_logSink;
 
@@ -21,6 +21,8 @@
 
 #include <radiance/AnnualIlluminanceMap.hpp>
 
+#include <utilities/core/Path.hpp>
+
 #include <resources.hxx>
 
 #include <boost/filesystem.hpp>
@@ -71,3 +73,78 @@ TEST_F(RadAnnualIlluminanceMapFixture, AnnualIlluminanceMap)
 
 }
 
+// converts textPath to binaryPath and compares the two maps; the binary map is closed on return
+static void checkBinaryConversion(const openstudio::path& textPath, const openstudio::path& binaryPath,
+                                  const AnnualIlluminanceMap& outFile)
+{
+  ASSERT_TRUE(AnnualIlluminanceMap::convertToBinary(textPath, binaryPath));
+  ASSERT_TRUE(boost::filesystem::exists(binaryPath));
+
+  AnnualIlluminanceMap binaryFile(binaryPath);
+  EXPECT_TRUE(binaryFile.isBinary());
+  EXPECT_FALSE(outFile.isBinary());
+
+  ASSERT_EQ(outFile.xVector().size(), binaryFile.xVector().size());
+  ASSERT_EQ(outFile.yVector().size(), binaryFile.yVector().size());
+  ASSERT_EQ(outFile.dateTimes().size(), binaryFile.dateTimes().size());
+  ASSERT_FALSE(outFile.dateTimes().empty());
+
+  unsigned M = outFile.xVector().size();
+  unsigned N = outFile.yVector().size();
+  for (unsigned i = 0; i < M; ++i){
+    EXPECT_DOUBLE_EQ(outFile.xVector()[i], binaryFile.xVector()[i]);
+  }
+  for (unsigned j = 0; j < N; ++j){
+    EXPECT_DOUBLE_EQ(outFile.yVector()[j], binaryFile.yVector()[j]);
+  }
+
+  openstudio::DateTimeVector dateTimes = outFile.dateTimes();
+  openstudio::DateTimeVector binaryDateTimes = binaryFile.dateTimes();
+  for (unsigned t = 0; t < dateTimes.size(); ++t){
+    EXPECT_EQ(dateTimes[t], binaryDateTimes[t]);
+  }
+
+  // values are stored as float32 in the binary file
+  openstudio::DateTime dateTime = dateTimes[dateTimes.size() / 2];
+  const openstudio::Matrix& textMap = outFile.illuminanceMap(dateTime);
+  const openstudio::Matrix& binaryMap = binaryFile.illuminanceMap(dateTime);
+  openstudio::Vector textValues = outFile.illuminanceValues(dateTime);
+  openstudio::Vector binaryValues = binaryFile.illuminanceValues(dateTime);
+  ASSERT_EQ(M*N, textValues.size());
+  ASSERT_EQ(M*N, binaryValues.size());
+  for (unsigned j = 0; j < N; ++j){
+    for (unsigned i = 0; i < M; ++i){
+      EXPECT_NEAR(textMap(i,j), binaryMap(i,j), 1.0e-4*(1.0 + textMap(i,j)));
+      EXPECT_NEAR(textMap(i,j), binaryValues[j*M + i], 1.0e-4*(1.0 + textMap(i,j)));
+      EXPECT_DOUBLE_EQ(textMap(i,j), textValues[j*M + i]);
+    }
+  }
+
+  openstudio::Vector textSensor = outFile.sensorIlluminance(M - 1, N - 1);
+  openstudio::Vector binarySensor = binaryFile.sensorIlluminance(M - 1, N - 1);
+  ASSERT_EQ(dateTimes.size(), textSensor.size());
+  ASSERT_EQ(dateTimes.size(), binarySensor.size());
+  for (unsigned t = 0; t < dateTimes.size(); ++t){
+    EXPECT_NEAR(textSensor[t], binarySensor[t], 1.0e-4*(1.0 + textSensor[t]));
+  }
+
+  EXPECT_EQ(0u, binaryFile.sensorIlluminance(M, 0).size());
+  EXPECT_EQ(0u, binaryFile.illuminanceValues(openstudio::DateTime()).size());
+
+  // copies share the mapped file
+  AnnualIlluminanceMap copy = binaryFile;
+  EXPECT_EQ(binaryFile.illuminanceValues(dateTime).size(), copy.illuminanceValues(dateTime).size());
+}
+
+TEST_F(RadAnnualIlluminanceMapFixture, AnnualIlluminanceMap_Binary)
+{
+  openstudio::path textPath = resourcesPath() / toPath("radiance/Daylighting/annual_day.ill");
+  openstudio::path outDir = openstudio::tempDir() / toPath("AnnualIlluminanceMap_Binary");
+  boost::filesystem::remove_all(outDir);
+  ASSERT_TRUE(boost::filesystem::create_directories(outDir));
+
+  checkBinaryConversion(textPath, outDir / toPath("annual_day.ill.bin"), outFile);
+
+  boost::filesystem::remove_all(outDir);
+  EXPECT_FALSE(boost::filesystem::exists(outDir));
+}
@@ -40,12 +40,16 @@
 
 #include <utilities/geometry/Point3d.hpp>
 #include <utilities/core/Logger.hpp>
+#include <utilities/core/PathHelpers.hpp>
 #include <utilities/idd/BuildingSurface_Detailed_FieldEnums.hxx>
 #include <utilities/idd/FenestrationSurface_Detailed_FieldEnums.hxx>
 
 #include <boost/foreach.hpp>
 #include <QTemporaryFile>
 
+#include <fstream>
+#include <sstream>
+
 using namespace openstudio;
 using namespace openstudio::model;
 using namespace openstudio::radiance;
@@ -260,4 +264,82 @@ TEST(Radiance, ForwardTranslator_ExampleModel_NoThermalZoneLinks)
   EXPECT_FALSE(ft.warnings().empty());
 
   boost::filesystem::remove_all(outpath);
-}
\ No newline at end of file
+}
+
+std::string readRadianceFile(const openstudio::path& p)
+{
+  std::ifstream f(openstudio::toString(p).c_str());
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return ss.str();
+}
+
+TEST(Radiance, ForwardTranslator_ExampleModel_NumThreads)
+{
+  Model model = exampleModel();
+
+  openstudio::path outpath1 = openstudio::tempDir() / toPath("rad_1thread");
+  openstudio::path outpath2 = openstudio::tempDir() / toPath("rad_4thread");
+  boost::filesystem::remove_all(outpath1);
+  boost::filesystem::remove_all(outpath2);
+
+  ForwardTranslator ft1;
+  ft1.setNumThreads(1);
+  EXPECT_EQ(1u, ft1.numThreads());
+  std::vector<path> outpaths1 = ft1.translateModel(outpath1, model);
+
+  ForwardTranslator ft2;
+  ft2.setNumThreads(4);
+  std::vector<path> outpaths2 = ft2.translateModel(outpath2, model);
+
+  ASSERT_FALSE(outpaths1.empty());
+  ASSERT_EQ(outpaths1.size(), outpaths2.size());
+  for (unsigned i = 0; i < outpaths1.size(); ++i){
+    path relative1 = relativePath(outpaths1[i], outpath1);
+    path relative2 = relativePath(outpaths2[i], outpath2);
+    EXPECT_EQ(toString(relative1), toString(relative2));
+    EXPECT_EQ(readRadianceFile(outpaths1[i]), readRadianceFile(outpaths2[i])) << toString(relative1);
+  }
+
+  // translating again with the same translator gives the same files
+  std::vector<std::string> contents1;
+  BOOST_FOREACH(const path& p, outpaths1){
+    contents1.push_back(readRadianceFile(p));
+  }
+  std::vector<path> outpaths3 = ft1.translateModel(outpath1, model);
+  ASSERT_EQ(outpaths1.size(), outpaths3.size());
+  for (unsigned i = 0; i < outpaths3.size(); ++i){
+    EXPECT_EQ(toString(outpaths1[i]), toString(outpaths3[i]));
+    EXPECT_EQ(contents1[i], readRadianceFile(outpaths3[i])) << toString(outpaths3[i]);
+  }
+
+  boost::filesystem::remove_all(outpath1);
+  boost::filesystem::remove_all(outpath2);
+}
+
+TEST(Radiance, ForwardTranslator_ExampleModel_CombinedScene)
+{
+  Model model = exampleModel();
+
+  openstudio::path outpath = openstudio::tempDir() / toPath("rad_combined");
+  boost::filesystem::remove_all(outpath);
+
+  ForwardTranslator ft;
+  EXPECT_FALSE(ft.combinedScene());
+  ft.setCombinedScene(true);
+  EXPECT_TRUE(ft.combinedScene());
+
+  std::vector<path> outpaths = ft.translateModel(outpath, model);
+  EXPECT_FALSE(outpaths.empty());
+  EXPECT_TRUE(ft.errors().empty());
+
+  std::string scene = readRadianceFile(outpath / toPath("model.rad"));
+  EXPECT_EQ(std::string::npos, scene.find("!xform"));
+  EXPECT_NE(std::string::npos, scene.find("#Space = "));
+
+  BOOST_FOREACH(const path& p, outpaths){
+    EXPECT_NE("scene", toString(p.parent_path().filename()));
+  }
+
+  boost::filesystem::remove_all(outpath);
+}
@@ -77,8 +77,9 @@ namespace resultsviewer{
   /** LinePlotCurve is a line plot curve item to track alias and source
   and hold scaled and unscaled y-values
   and hold smooth and stair x-values
+  large series are drawn from a decimated level matched to the zoomed range
   */
-  class LinePlotCurve : public QwtPlotCurve
+  class LinePlotCurve : public openstudio::DecimatedPlotCurve
   {
   public:
     LinePlotCurve(QString& title, openstudio::TimeSeriesLinePlotData& data);
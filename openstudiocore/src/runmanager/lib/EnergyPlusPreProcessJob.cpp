@@ -153,23 +153,7 @@ namespace detail {
           LOG_AND_THROW("Unable to load idf into workspace");
         }
 
-        std::vector<openstudio::WorkspaceObject> sqliteobjs = ws->getObjectsByType(IddObjectType::Output_SQLite);
-
-        if (sqliteobjs.empty())
-        {
-          //          ws->addObject(IdfObject(IddObjectType::Output_SQLite));
-          needssqlobj = true;
-          //          sqliteobjs = ws->getObjectsByType(IddObjectType::Output_SQLite);
-        }
-
-        if (ws->getObjectsByName("Building Energy Performance - Natural Gas").empty()
-            || ws->getObjectsByName("Building Energy Performance - Electricity").empty()
-            || ws->getObjectsByName("Building Energy Performance - District Heating").empty()
-            || ws->getObjectsByName("Building Energy Performance - District Cooling").empty()
-           )
-        {
-          needsmonthlyoutput = true;
-        }
+        checkRequiredOutputs(*ws, needssqlobj, needsmonthlyoutput);
       }
 
       if (needssqlobj || needsmonthlyoutput)
@@ -188,245 +172,7 @@ namespace detail {
         boost::filesystem::copy_file(m_idf->fullPath, outfile, boost::filesystem::copy_option::overwrite_if_exists);
         std::ofstream ofs(openstudio::toString(outfile).c_str(), std::ios::app);
 
-        if (needssqlobj)
-        {
-          ofs << "Output:SQLite," << std::endl;
-          ofs << "  SimpleAndTabular;         ! Option Type" << std::endl;
-        }
-
-        if (needsmonthlyoutput)
-        {
-          //energy consumption
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - Electricity,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    InteriorLights:Electricity,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorLights:Electricity,  !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    InteriorEquipment:Electricity,  !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    ExteriorEquipment:Electricity,  !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    Fans:Electricity,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Pumps:Electricity,       !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 6" << std::endl;
-          ofs << "    Heating:Electricity,     !- Variable or Meter 7 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 7" << std::endl;
-          ofs << "    Cooling:Electricity,     !- Variable or Meter 8 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 8" << std::endl;
-          ofs << "    HeatRejection:Electricity,  !- Variable or Meter 9 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 9" << std::endl;
-          ofs << "    Humidifier:Electricity,  !- Variable or Meter 10 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 10" << std::endl;
-          ofs << "    HeatRecovery:Electricity,!- Variable or Meter 11 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 11" << std::endl;
-          ofs << "    WaterSystems:Electricity,!- Variable or Meter 12 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 12" << std::endl;
-          ofs << "    Cogeneration:Electricity,!- Variable or Meter 13 Name" << std::endl;
-          ofs << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 13" << std::endl;
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - Natural Gas,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    InteriorEquipment:Gas,   !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorEquipment:Gas,   !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    Heating:Gas,             !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    Cooling:Gas,             !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    WaterSystems:Gas,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Cogeneration:Gas,        !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 6" << std::endl;
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - District Heating,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    InteriorLights:DistrictHeating,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorLights:DistrictHeating,  !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    InteriorEquipment:DistrictHeating,  !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    ExteriorEquipment:DistrictHeating,  !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    Fans:DistrictHeating,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Pumps:DistrictHeating,       !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 6" << std::endl;
-          ofs << "    Heating:DistrictHeating,     !- Variable or Meter 7 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 7" << std::endl;
-          ofs << "    Cooling:DistrictHeating,     !- Variable or Meter 8 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 8" << std::endl;
-          ofs << "    HeatRejection:DistrictHeating,  !- Variable or Meter 9 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 9" << std::endl;
-          ofs << "    Humidifier:DistrictHeating,  !- Variable or Meter 10 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 10" << std::endl;
-          ofs << "    HeatRecovery:DistrictHeating,!- Variable or Meter 11 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 11" << std::endl;
-          ofs << "    WaterSystems:DistrictHeating,!- Variable or Meter 12 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 12" << std::endl;
-          ofs << "    Cogeneration:DistrictHeating,!- Variable or Meter 13 Name" << std::endl;
-          ofs << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 13" << std::endl;
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - District Cooling,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    InteriorLights:DistrictCooling,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorLights:DistrictCooling,  !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    InteriorEquipment:DistrictCooling,  !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    ExteriorEquipment:DistrictCooling,  !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    Fans:DistrictCooling,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Pumps:DistrictCooling,       !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 6" << std::endl;
-          ofs << "    Heating:DistrictCooling,     !- Variable or Meter 7 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 7" << std::endl;
-          ofs << "    Cooling:DistrictCooling,     !- Variable or Meter 8 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 8" << std::endl;
-          ofs << "    HeatRejection:DistrictCooling,  !- Variable or Meter 9 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 9" << std::endl;
-          ofs << "    Humidifier:DistrictCooling,  !- Variable or Meter 10 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 10" << std::endl;
-          ofs << "    HeatRecovery:DistrictCooling,!- Variable or Meter 11 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 11" << std::endl;
-          ofs << "    WaterSystems:DistrictCooling,!- Variable or Meter 12 Name" << std::endl;
-          ofs << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 12" << std::endl;
-          ofs << "    Cogeneration:DistrictCooling,!- Variable or Meter 13 Name" << std::endl;
-          ofs << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 13" << std::endl;
-
-          //energy demand
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - Electricity Peak Demand,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    Electricity:Facility,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    InteriorLights:Electricity,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorLights:Electricity,  !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    InteriorEquipment:Electricity,  !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    ExteriorEquipment:Electricity,  !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    Fans:Electricity,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Pumps:Electricity,       !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 6" << std::endl;
-          ofs << "    Heating:Electricity,     !- Variable or Meter 7 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 7" << std::endl;
-          ofs << "    Cooling:Electricity,     !- Variable or Meter 8 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 8" << std::endl;
-          ofs << "    HeatRejection:Electricity,  !- Variable or Meter 9 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 9" << std::endl;
-          ofs << "    Humidifier:Electricity,  !- Variable or Meter 10 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 10" << std::endl;
-          ofs << "    HeatRecovery:Electricity,!- Variable or Meter 11 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 11" << std::endl;
-          ofs << "    WaterSystems:Electricity,!- Variable or Meter 12 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 12" << std::endl;
-          ofs << "    Cogeneration:Electricity,!- Variable or Meter 13 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 13" << std::endl;
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - Natural Gas Peak Demand,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    Gas:Facility,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    InteriorEquipment:Gas,   !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorEquipment:Gas,   !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    Heating:Gas,             !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    Cooling:Gas,             !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    WaterSystems:Gas,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Cogeneration:Gas,        !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 6" << std::endl;
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - District Heating Peak Demand,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    DistrictHeating:Facility,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    InteriorLights:DistrictHeating,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorLights:DistrictHeating,  !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    InteriorEquipment:DistrictHeating,  !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    ExteriorEquipment:DistrictHeating,  !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    Fans:DistrictHeating,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Pumps:DistrictHeating,       !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 6" << std::endl;
-          ofs << "    Heating:DistrictHeating,     !- Variable or Meter 7 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 7" << std::endl;
-          ofs << "    Cooling:DistrictHeating,     !- Variable or Meter 8 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 8" << std::endl;
-          ofs << "    HeatRejection:DistrictHeating,  !- Variable or Meter 9 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 9" << std::endl;
-          ofs << "    Humidifier:DistrictHeating,  !- Variable or Meter 10 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 10" << std::endl;
-          ofs << "    HeatRecovery:DistrictHeating,!- Variable or Meter 11 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 11" << std::endl;
-          ofs << "    WaterSystems:DistrictHeating,!- Variable or Meter 12 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 12" << std::endl;
-          ofs << "    Cogeneration:DistrictHeating,!- Variable or Meter 13 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 13" << std::endl;
-
-          ofs << "Output:Table:Monthly," << std::endl;
-          ofs << "  Building Energy Performance - District Cooling Peak Demand,  !- Name" << std::endl;
-          ofs << "    2,                       !- Digits After Decimal" << std::endl;
-          ofs << "    DistrictCooling:Facility,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    InteriorLights:DistrictCooling,  !- Variable or Meter 1 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
-          ofs << "    ExteriorLights:DistrictCooling,  !- Variable or Meter 2 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
-          ofs << "    InteriorEquipment:DistrictCooling,  !- Variable or Meter 3 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
-          ofs << "    ExteriorEquipment:DistrictCooling,  !- Variable or Meter 4 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
-          ofs << "    Fans:DistrictCooling,        !- Variable or Meter 5 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
-          ofs << "    Pumps:DistrictCooling,       !- Variable or Meter 6 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 6" << std::endl;
-          ofs << "    Heating:DistrictCooling,     !- Variable or Meter 7 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 7" << std::endl;
-          ofs << "    Cooling:DistrictCooling,     !- Variable or Meter 8 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 8" << std::endl;
-          ofs << "    HeatRejection:DistrictCooling,  !- Variable or Meter 9 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 9" << std::endl;
-          ofs << "    Humidifier:DistrictCooling,  !- Variable or Meter 10 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 10" << std::endl;
-          ofs << "    HeatRecovery:DistrictCooling,!- Variable or Meter 11 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 11" << std::endl;
-          ofs << "    WaterSystems:DistrictCooling,!- Variable or Meter 12 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 12" << std::endl;
-          ofs << "    Cogeneration:DistrictCooling,!- Variable or Meter 13 Name" << std::endl;
-          ofs << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 13" << std::endl;
-
-        }
-
-        //timestep-level utility demand by fuel type to calculate demand
-        ofs << "    Output:Meter,Electricity:Facility,Timestep; !- [J]" << std::endl;
-        ofs << "    Output:Meter,Gas:Facility,Timestep; !- [J]" << std::endl;
-        ofs << "    Output:Meter,DistrictCooling:Facility,Timestep; !- [J]" << std::endl;
-        ofs << "    Output:Meter,DistrictHeating:Facility,Timestep; !- [J]" << std::endl;
+        writeRequiredOutputs(ofs, needssqlobj, needsmonthlyoutput);
 
 
         ofs.flush();
@@ -446,6 +192,260 @@ namespace detail {
     setErrors(errors);
   }
 
+  void EnergyPlusPreProcessJob::checkRequiredOutputs(const openstudio::Workspace &t_workspace, 
+      bool &t_needsSqlObj, bool &t_needsMonthlyOutput)
+  {
+    t_needsSqlObj = t_workspace.getObjectsByType(IddObjectType::Output_SQLite).empty();
+
+    t_needsMonthlyOutput = t_workspace.getObjectsByName("Building Energy Performance - Natural Gas").empty()
+      || t_workspace.getObjectsByName("Building Energy Performance - Electricity").empty()
+      || t_workspace.getObjectsByName("Building Energy Performance - District Heating").empty()
+      || t_workspace.getObjectsByName("Building Energy Performance - District Cooling").empty();
+  }
+
+  void EnergyPlusPreProcessJob::writeRequiredOutputs(std::ostream &t_os, bool t_needsSqlObj, bool t_needsMonthlyOutput)
+  {
+    if (t_needsSqlObj)
+    {
+      t_os << "Output:SQLite," << std::endl;
+      t_os << "  SimpleAndTabular;         ! Option Type" << std::endl;
+    }
+
+    if (t_needsMonthlyOutput)
+    {
+      //energy consumption
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - Electricity,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    InteriorLights:Electricity,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorLights:Electricity,  !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    InteriorEquipment:Electricity,  !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    ExteriorEquipment:Electricity,  !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    Fans:Electricity,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Pumps:Electricity,       !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 6" << std::endl;
+      t_os << "    Heating:Electricity,     !- Variable or Meter 7 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 7" << std::endl;
+      t_os << "    Cooling:Electricity,     !- Variable or Meter 8 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 8" << std::endl;
+      t_os << "    HeatRejection:Electricity,  !- Variable or Meter 9 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 9" << std::endl;
+      t_os << "    Humidifier:Electricity,  !- Variable or Meter 10 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 10" << std::endl;
+      t_os << "    HeatRecovery:Electricity,!- Variable or Meter 11 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 11" << std::endl;
+      t_os << "    WaterSystems:Electricity,!- Variable or Meter 12 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 12" << std::endl;
+      t_os << "    Cogeneration:Electricity,!- Variable or Meter 13 Name" << std::endl;
+      t_os << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 13" << std::endl;
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - Natural Gas,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    InteriorEquipment:Gas,   !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorEquipment:Gas,   !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    Heating:Gas,             !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    Cooling:Gas,             !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    WaterSystems:Gas,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Cogeneration:Gas,        !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 6" << std::endl;
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - District Heating,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    InteriorLights:DistrictHeating,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorLights:DistrictHeating,  !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    InteriorEquipment:DistrictHeating,  !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    ExteriorEquipment:DistrictHeating,  !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    Fans:DistrictHeating,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Pumps:DistrictHeating,       !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 6" << std::endl;
+      t_os << "    Heating:DistrictHeating,     !- Variable or Meter 7 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 7" << std::endl;
+      t_os << "    Cooling:DistrictHeating,     !- Variable or Meter 8 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 8" << std::endl;
+      t_os << "    HeatRejection:DistrictHeating,  !- Variable or Meter 9 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 9" << std::endl;
+      t_os << "    Humidifier:DistrictHeating,  !- Variable or Meter 10 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 10" << std::endl;
+      t_os << "    HeatRecovery:DistrictHeating,!- Variable or Meter 11 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 11" << std::endl;
+      t_os << "    WaterSystems:DistrictHeating,!- Variable or Meter 12 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 12" << std::endl;
+      t_os << "    Cogeneration:DistrictHeating,!- Variable or Meter 13 Name" << std::endl;
+      t_os << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 13" << std::endl;
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - District Cooling,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    InteriorLights:DistrictCooling,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorLights:DistrictCooling,  !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    InteriorEquipment:DistrictCooling,  !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    ExteriorEquipment:DistrictCooling,  !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    Fans:DistrictCooling,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Pumps:DistrictCooling,       !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 6" << std::endl;
+      t_os << "    Heating:DistrictCooling,     !- Variable or Meter 7 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 7" << std::endl;
+      t_os << "    Cooling:DistrictCooling,     !- Variable or Meter 8 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 8" << std::endl;
+      t_os << "    HeatRejection:DistrictCooling,  !- Variable or Meter 9 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 9" << std::endl;
+      t_os << "    Humidifier:DistrictCooling,  !- Variable or Meter 10 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 10" << std::endl;
+      t_os << "    HeatRecovery:DistrictCooling,!- Variable or Meter 11 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 11" << std::endl;
+      t_os << "    WaterSystems:DistrictCooling,!- Variable or Meter 12 Name" << std::endl;
+      t_os << "    SumOrAverage,            !- Aggregation Type for Variable or Meter 12" << std::endl;
+      t_os << "    Cogeneration:DistrictCooling,!- Variable or Meter 13 Name" << std::endl;
+      t_os << "    SumOrAverage;            !- Aggregation Type for Variable or Meter 13" << std::endl;
+
+      //energy demand
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - Electricity Peak Demand,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    Electricity:Facility,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    InteriorLights:Electricity,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorLights:Electricity,  !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    InteriorEquipment:Electricity,  !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    ExteriorEquipment:Electricity,  !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    Fans:Electricity,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Pumps:Electricity,       !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 6" << std::endl;
+      t_os << "    Heating:Electricity,     !- Variable or Meter 7 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 7" << std::endl;
+      t_os << "    Cooling:Electricity,     !- Variable or Meter 8 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 8" << std::endl;
+      t_os << "    HeatRejection:Electricity,  !- Variable or Meter 9 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 9" << std::endl;
+      t_os << "    Humidifier:Electricity,  !- Variable or Meter 10 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 10" << std::endl;
+      t_os << "    HeatRecovery:Electricity,!- Variable or Meter 11 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 11" << std::endl;
+      t_os << "    WaterSystems:Electricity,!- Variable or Meter 12 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 12" << std::endl;
+      t_os << "    Cogeneration:Electricity,!- Variable or Meter 13 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 13" << std::endl;
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - Natural Gas Peak Demand,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    Gas:Facility,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    InteriorEquipment:Gas,   !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorEquipment:Gas,   !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    Heating:Gas,             !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    Cooling:Gas,             !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    WaterSystems:Gas,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Cogeneration:Gas,        !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 6" << std::endl;
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - District Heating Peak Demand,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    DistrictHeating:Facility,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    InteriorLights:DistrictHeating,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorLights:DistrictHeating,  !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    InteriorEquipment:DistrictHeating,  !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    ExteriorEquipment:DistrictHeating,  !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    Fans:DistrictHeating,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Pumps:DistrictHeating,       !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 6" << std::endl;
+      t_os << "    Heating:DistrictHeating,     !- Variable or Meter 7 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 7" << std::endl;
+      t_os << "    Cooling:DistrictHeating,     !- Variable or Meter 8 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 8" << std::endl;
+      t_os << "    HeatRejection:DistrictHeating,  !- Variable or Meter 9 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 9" << std::endl;
+      t_os << "    Humidifier:DistrictHeating,  !- Variable or Meter 10 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 10" << std::endl;
+      t_os << "    HeatRecovery:DistrictHeating,!- Variable or Meter 11 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 11" << std::endl;
+      t_os << "    WaterSystems:DistrictHeating,!- Variable or Meter 12 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 12" << std::endl;
+      t_os << "    Cogeneration:DistrictHeating,!- Variable or Meter 13 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 13" << std::endl;
+
+      t_os << "Output:Table:Monthly," << std::endl;
+      t_os << "  Building Energy Performance - District Cooling Peak Demand,  !- Name" << std::endl;
+      t_os << "    2,                       !- Digits After Decimal" << std::endl;
+      t_os << "    DistrictCooling:Facility,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    Maximum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    InteriorLights:DistrictCooling,  !- Variable or Meter 1 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 1" << std::endl;
+      t_os << "    ExteriorLights:DistrictCooling,  !- Variable or Meter 2 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 2" << std::endl;
+      t_os << "    InteriorEquipment:DistrictCooling,  !- Variable or Meter 3 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 3" << std::endl;
+      t_os << "    ExteriorEquipment:DistrictCooling,  !- Variable or Meter 4 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 4" << std::endl;
+      t_os << "    Fans:DistrictCooling,        !- Variable or Meter 5 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 5" << std::endl;
+      t_os << "    Pumps:DistrictCooling,       !- Variable or Meter 6 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 6" << std::endl;
+      t_os << "    Heating:DistrictCooling,     !- Variable or Meter 7 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 7" << std::endl;
+      t_os << "    Cooling:DistrictCooling,     !- Variable or Meter 8 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 8" << std::endl;
+      t_os << "    HeatRejection:DistrictCooling,  !- Variable or Meter 9 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 9" << std::endl;
+      t_os << "    Humidifier:DistrictCooling,  !- Variable or Meter 10 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 10" << std::endl;
+      t_os << "    HeatRecovery:DistrictCooling,!- Variable or Meter 11 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 11" << std::endl;
+      t_os << "    WaterSystems:DistrictCooling,!- Variable or Meter 12 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum,            !- Aggregation Type for Variable or Meter 12" << std::endl;
+      t_os << "    Cogeneration:DistrictCooling,!- Variable or Meter 13 Name" << std::endl;
+      t_os << "    ValueWhenMaximumOrMinimum;            !- Aggregation Type for Variable or Meter 13" << std::endl;
+
+    }
+
+    //timestep-level utility demand by fuel type to calculate demand
+    t_os << "    Output:Meter,Electricity:Facility,Timestep; !- [J]" << std::endl;
+    t_os << "    Output:Meter,Gas:Facility,Timestep; !- [J]" << std::endl;
+    t_os << "    Output:Meter,DistrictCooling:Facility,Timestep; !- [J]" << std::endl;
+    t_os << "    Output:Meter,DistrictHeating:Facility,Timestep; !- [J]" << std::endl;
+  }
+
   std::string EnergyPlusPreProcessJob::getOutput() const
   {
     return "";
@@ -27,6 +27,9 @@
 #include "Job_Impl.hpp"
 #include "JobParam.hpp"
 #include <utilities/core/Checksum.hpp>
+#include <utilities/idf/Workspace.hpp>
+
+#include <ostream>
 
 #include <QFileSystemWatcher>
 #include <QFileInfo>
@@ -71,6 +74,13 @@ namespace detail {
 
       virtual void requestStop();
 
+      /// Determines which of the outputs added by this job are missing from t_workspace
+      static void checkRequiredOutputs(const openstudio::Workspace &t_workspace, 
+          bool &t_needsSqlObj, bool &t_needsMonthlyOutput);
+
+      /// Writes the idf text of the outputs added by this job, to be appended to an idf
+      static void writeRequiredOutputs(std::ostream &t_os, bool t_needsSqlObj, bool t_needsMonthlyOutput);
+
     protected:
       virtual void startImpl(const boost::shared_ptr<ProcessCreator> &t_creator);
 
@@ -26,6 +26,7 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <utilities/core/Application.hpp>
 #include <utilities/core/Assert.hpp>
+#include <utilities/core/Instrumentation.hpp>
 #include <utilities/core/PathHelpers.hpp>
 #include <QDir>
 
@@ -242,6 +243,11 @@ namespace detail {
     }
     m_lastStartTime = QDateTime::currentDateTime();
     m_osLastStartTime = openstudio::toDateTime(*m_lastStartTime);
+    m_instrumentedRun.reset();
+    if (Instrumentation::instance().enabled())
+    {
+      m_instrumentedRun = std::make_pair(Instrumentation::instance().currentThread(), Instrumentation::instance().now());
+    }
     {
       QWriteLocker l2(&m_cacheMutex);
       m_allTools.reset();
@@ -251,7 +257,10 @@ namespace detail {
     }
     l.unlock();
 
-    startImpl(m_processCreator);
+    {
+      OS_TIMER("Job::run");
+      startImpl(m_processCreator);
+    }
 
     l.relock();
     m_lastEndTime = QDateTime::currentDateTime();
@@ -312,6 +321,7 @@ namespace detail {
         }
       } 
 
+      OS_TIMER("Job::cleanup");
       if (type == standard)
       {
         standardClean();
@@ -322,11 +332,37 @@ namespace detail {
       LOG(Info, "Not running cleanup, job failed");
     }
 
+    // written after cleanup so that it is not removed with other intermediate files
+    writeInstrumentationSummary();
+
     emitFinished(errors, lastRun(), outputFiles());
 
     //LOG(Info, boost::posix_time::microsec_clock::local_time() << " thread joined: " << toString(m_id));
   }
 
+  void Job_Impl::writeInstrumentationSummary()
+  {
+    QReadLocker l(&m_mutex);
+    boost::optional<std::pair<unsigned, long long> > instrumentedRun = m_instrumentedRun;
+    l.unlock();
+
+    if (!instrumentedRun)
+    {
+      return;
+    }
+
+    openstudio::path dir = outdir();
+    if (dir.empty() || !boost::filesystem::is_directory(dir))
+    {
+      return;
+    }
+
+    // only the work done on the job's own thread is attributed to it
+    InstrumentationSingleton::saveSummary(
+        Instrumentation::instance().events(instrumentedRun->first, instrumentedRun->second),
+        dir / openstudio::toPath("instrumentation_summary.txt"));
+  }
+
   bool Job_Impl::fileComparitor(const openstudio::path &t_lhs, const openstudio::path &t_rhs)
   {
     // Err on the side of caution, always be case insensitive
@@ -478,6 +478,9 @@ namespace detail {
       void maximumClean();
 
       void standardClean();
+
+      /// Writes the instrumentation summary of the last run to the output directory, if instrumentation was enabled
+      void writeInstrumentationSummary();
 	  
       void sendSignals(JobState oldState, JobState newState, const openstudio::UUID &t_oldUUID, const openstudio::UUID &t_newUUID);
 
@@ -514,6 +517,9 @@ namespace detail {
 
       boost::optional<QDateTime> m_lastRun;
 
+      /// Instrumentation thread and start time of the last run, if instrumentation was enabled
+      boost::optional<std::pair<unsigned, long long> > m_instrumentedRun;
+
       std::vector<std::pair<boost::posix_time::ptime, AdvancedStatus> > m_history;
 
       openstudio::path m_basePath; //< Path from which relative paths in this job will be evaluated
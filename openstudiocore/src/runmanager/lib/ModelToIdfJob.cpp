@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include "ModelToIdfJob.hpp"
+#include "EnergyPlusPreProcessJob.hpp"
 #include "FileInfo.hpp"
 #include "JobOutputCleanup.hpp"
 #include "RunManager_Util.hpp"
@@ -42,9 +43,13 @@
 
 #include <QDir>
 #include <QDateTime>
+#include <QProcess>
+#include <QTime>
 
 #include <boost/bind.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/lexical_cast.hpp>
 
 namespace openstudio {
 namespace runmanager {
@@ -144,11 +149,20 @@ namespace detail {
 
     openstudio::energyplus::ForwardTranslator ft;
 
+    JobParams jobParams = params();
+    bool fuseExpandObjects = jobParams.has("fuseExpandObjects");
+    bool fusePreProcess = jobParams.has("fuseEnergyPlusPreProcess");
+
+    StageTimes stageTimes;
+    QTime stageTimer;
+    stageTimer.start();
+
     try {
       boost::filesystem::create_directories(outpath);
 
       osversion::VersionTranslator translator;
       model::OptionalModel m = translator.loadModel(m_model->fullPath);
+      stageTimes.push_back(std::make_pair(std::string("Load Model"), stageTimer.restart()));
 
       if (!m)
       {
@@ -163,12 +177,19 @@ namespace detail {
         }
 
         openstudio::Workspace workspace = ft.translateModel(*m);
+        stageTimes.push_back(std::make_pair(std::string("ModelToIdf"), stageTimer.restart()));
 
         if (workspace.numObjects() > 0){
-          boost::filesystem::ofstream ofs(outpath / openstudio::toPath("in.idf"));
-          workspace.toIdfFile().print(ofs);
-          ofs.flush();
-          ofs.close();
+          if (fuseExpandObjects || fusePreProcess)
+          {
+            writeFusedIdf(workspace, outpath, fuseExpandObjects, fusePreProcess, stageTimes);
+          } else {
+            boost::filesystem::ofstream ofs(outpath / openstudio::toPath("in.idf"));
+            workspace.toIdfFile().print(ofs);
+            ofs.flush();
+            ofs.close();
+            stageTimes.push_back(std::make_pair(std::string("Write IDF"), stageTimer.restart()));
+          }
           OS_ASSERT(boost::filesystem::exists(outpath / openstudio::toPath("in.idf")));
         } else {
           errors.addError(ErrorType::Error, "Converted OSM didn't create any objects, output idf not created");
@@ -198,13 +219,131 @@ namespace detail {
       errors.addError(ErrorType::Error, itr->logMessage());
     }
 
+    std::stringstream output;
+    for (StageTimes::const_iterator itr = stageTimes.begin();
+         itr != stageTimes.end();
+         ++itr)
+    {
+      output << itr->first << ": " << itr->second << " ms" << std::endl;
+
+      if (fuseExpandObjects || fusePreProcess)
+      {
+        errors.addError(ErrorType::Info, "Stage " + itr->first + " took " 
+            + boost::lexical_cast<std::string>(itr->second) + " ms");
+      }
+    }
+
+    l.relock();
+    m_output = output.str();
+    l.unlock();
+
+    emitOutputDataAdded(output.str());
     emitOutputFileChanged(RunManager_Util::dirFile(outpath / openstudio::toPath("in.idf")));
     setErrors(errors);
   }
 
+  void ModelToIdfJob::writeFusedIdf(const openstudio::Workspace &t_workspace, const openstudio::path &t_outpath,
+      bool t_expandObjects, bool t_preProcess, StageTimes &t_stageTimes) const
+  {
+    QTime stageTimer;
+    stageTimer.start();
+
+    openstudio::path idfpath = t_outpath / openstudio::toPath("in.idf");
+
+    bool needssqlobj = false;
+    bool needsmonthlyoutput = false;
+
+    if (t_preProcess)
+    {
+      EnergyPlusPreProcessJob::checkRequiredOutputs(t_workspace, needssqlobj, needsmonthlyoutput);
+    }
+
+    if (t_expandObjects && needsExpandObjects(t_workspace))
+    {
+      // ExpandObjects is an external tool, so this is the one case where an intermediate idf is written
+      openstudio::path expanddir = t_outpath / openstudio::toPath("expandobjects");
+      boost::filesystem::create_directories(expanddir);
+
+      {
+        boost::filesystem::ofstream ofs(expanddir / openstudio::toPath("in.idf"));
+        t_workspace.toIdfFile().print(ofs);
+      }
+
+      openstudio::path expanded = expandObjects(expanddir);
+      boost::filesystem::copy_file(expanded, idfpath, boost::filesystem::copy_option::overwrite_if_exists);
+      t_stageTimes.push_back(std::make_pair(std::string("ExpandObjects"), stageTimer.restart()));
+    } else {
+      boost::filesystem::ofstream ofs(idfpath);
+      t_workspace.toIdfFile().print(ofs);
+      t_stageTimes.push_back(std::make_pair(std::string("Write IDF"), stageTimer.restart()));
+    }
+
+    if (needssqlobj || needsmonthlyoutput)
+    {
+      std::ofstream ofs(openstudio::toString(idfpath).c_str(), std::ios::app);
+      EnergyPlusPreProcessJob::writeRequiredOutputs(ofs, needssqlobj, needsmonthlyoutput);
+    }
+
+    if (t_preProcess)
+    {
+      t_stageTimes.push_back(std::make_pair(std::string("EnergyPlusPreProcess"), stageTimer.restart()));
+    }
+  }
+
+  bool ModelToIdfJob::needsExpandObjects(const openstudio::Workspace &t_workspace)
+  {
+    std::vector<openstudio::WorkspaceObject> objects = t_workspace.objects();
+
+    for (std::vector<openstudio::WorkspaceObject>::const_iterator itr = objects.begin();
+         itr != objects.end();
+         ++itr)
+    {
+      std::string type = itr->iddObject().name();
+      if (boost::algorithm::istarts_with(type, "HVACTemplate:")
+          || boost::algorithm::istarts_with(type, "GroundHeatTransfer:"))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  openstudio::path ModelToIdfJob::expandObjects(const openstudio::path &t_dir) const
+  {
+    ToolInfo ti = allTools().getTool("expandobjects");
+
+    // ExpandObjects reads in.idf and Energy+.idd from its working directory
+    openstudio::path idd = ti.localBinPath.parent_path() / openstudio::toPath("Energy+.idd");
+    if (boost::filesystem::exists(idd))
+    {
+      boost::filesystem::copy_file(idd, t_dir / openstudio::toPath("Energy+.idd"), 
+          boost::filesystem::copy_option::overwrite_if_exists);
+    }
+
+    QProcess process;
+    process.setWorkingDirectory(openstudio::toQString(t_dir));
+    process.start(openstudio::toQString(ti.localBinPath), QStringList());
+
+    if (!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0)
+    {
+      throw std::runtime_error("ExpandObjects failed: " + toString(ti.localBinPath));
+    }
+
+    openstudio::path expanded = t_dir / openstudio::toPath("expanded.idf");
+    if (boost::filesystem::exists(expanded))
+    {
+      return expanded;
+    } else {
+      // nothing was expanded
+      return t_dir / openstudio::toPath("in.idf");
+    }
+  }
+
   std::string ModelToIdfJob::getOutput() const
   {
-    return "";
+    QReadLocker l(&m_mutex);
+    return m_output;
   }
 
   void ModelToIdfJob::basePathChanged()
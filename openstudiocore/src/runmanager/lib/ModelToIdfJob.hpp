@@ -26,6 +26,7 @@
 #include "Job_Impl.hpp"
 #include "JobParam.hpp"
 #include <utilities/core/Checksum.hpp>
+#include <utilities/idf/Workspace.hpp>
 
 #include <QFileSystemWatcher>
 #include <QFileInfo>
@@ -37,6 +38,11 @@ namespace detail {
 
   /**
    * Job type that converts a Model file into an IDF in process.
+   *
+   * With the "fuseExpandObjects" and / or "fuseEnergyPlusPreProcess" params (see
+   * Workflow::fusePreProcessing) the ExpandObjects and EnergyPlusPreProcess stages are
+   * applied to the translated Workspace before anything is written, and only the final
+   * in.idf is created. The time taken by each stage is reported by getOutput().
    */
   class ModelToIdfJob : public Job_Impl
   {
@@ -80,6 +86,18 @@ namespace detail {
 
       FileInfo modelFile() const;
 
+      typedef std::vector<std::pair<std::string, int> > StageTimes;
+
+      /// Applies the fused pre-processing stages to t_workspace and writes the final in.idf
+      void writeFusedIdf(const openstudio::Workspace &t_workspace, const openstudio::path &t_outpath,
+          bool t_expandObjects, bool t_preProcess, StageTimes &t_stageTimes) const;
+
+      /// \returns true if t_workspace contains objects that must be expanded by ExpandObjects
+      static bool needsExpandObjects(const openstudio::Workspace &t_workspace);
+
+      /// Runs the ExpandObjects tool on the in.idf in t_dir, \returns the expanded idf
+      openstudio::path expandObjects(const openstudio::path &t_dir) const;
+
       std::string checksum(const QUrl &t_url) const
       {
         if (t_url.scheme() == "file")
@@ -104,6 +122,7 @@ namespace detail {
       boost::optional<FileInfo> m_model; //< Model that is being converted
       boost::optional<QDateTime> m_lastrun; //< time of last job run
       mutable boost::optional<Files> m_outputfiles; //< IDF file that was created from run
+      std::string m_output; //< Per stage timing of the last run
 
       std::string m_description; //< Description of job
   }; 
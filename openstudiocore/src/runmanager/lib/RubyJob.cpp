@@ -141,16 +141,6 @@ namespace detail {
       }
     }
 
-    // Add tool parameters that go straight to ruby
-    std::vector<std::string> toolparams = rjb.getToolParameters();
-
-    for (std::vector<std::string>::const_iterator itr = toolparams.begin();
-         itr != toolparams.end();
-         ++itr)
-    {
-      addParameter("ruby", *itr);
-    }
-
     // set up files that need to have "requiredFiles" copied from input to output
     typedef std::vector<boost::tuple<std::string, std::string, std::string> > copyvectype;
     copyvectype copyfiles = rjb.copyRequiredFiles();
@@ -168,11 +158,36 @@ namespace detail {
       }
     }
 
+    // Add tool parameters that go straight to ruby. When a warm worker is available the worker
+    // was started with them and the client script hands it our script
+    std::vector<std::string> toolparams = rjb.getToolParameters();
+
+    m_workerLease.reset();
+    if (RubyWorkerPool::instance().enabled() && !runningRemotely())
+    {
+      m_workerLease = RubyWorkerPool::instance().acquire(getTool("ruby").localBinPath, toolparams);
+    }
+
+    if (m_workerLease)
+    {
+      LOG(Info, "Running in ruby worker " << toString(m_workerLease->socketPath()));
+      addParameter("ruby", toString(RubyWorkerPool::clientScript()));
+      addParameter("ruby", toString(m_workerLease->socketPath()));
+    } else {
+      for (std::vector<std::string>::const_iterator itr = toolparams.begin();
+           itr != toolparams.end();
+           ++itr)
+      {
+        addParameter("ruby", *itr);
+      }
+    }
+
     // Add ruby script file name
     try {
       addRequiredFile(inputfiles.getLastByExtension("rb"), toPath("in.rb"));
       addParameter("ruby", toString("in.rb"));
     } catch (const std::exception &) {
+      m_workerLease.reset();
       throw std::runtime_error("No rb file found in input files");
     }
 
@@ -212,6 +227,18 @@ namespace detail {
 
   }
 
+  void RubyJob::endHandlerImpl()
+  {
+    // hand the worker back to the pool
+    m_workerLease.reset();
+  }
+
+  void RubyJob::toolStartErrorHandlerImpl()
+  {
+    // the job ends without reaching endHandlerImpl
+    m_workerLease.reset();
+  }
+
   void RubyJob::getFiles(const RubyJobBuilder &t_rjb)
   {
     LOG(Info, "Getting files");
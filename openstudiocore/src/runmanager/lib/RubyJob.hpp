@@ -26,6 +26,7 @@
 #include "Job_Impl.hpp"
 #include "ToolInfo.hpp"
 #include "ToolBasedJob.hpp"
+#include "RubyWorkerPool.hpp"
 #include <energyplus/ErrorFile.hpp>
 
 #include <QProcess>
@@ -74,6 +75,8 @@ namespace detail {
 
       virtual ToolVersion getToolVersionImpl(const std::string &t_toolName) const;
       virtual void startHandlerImpl();
+      virtual void endHandlerImpl();
+      virtual void toolStartErrorHandlerImpl();
 
       virtual void basePathChanged();
 
@@ -84,6 +87,9 @@ namespace detail {
 
       std::vector<std::pair<Files, std::string> > m_inputfiles;
       std::string m_description;
+
+      /// Warm ruby worker running the current job, if any
+      boost::shared_ptr<RubyWorkerPool::Lease> m_workerLease;
    }; 
 
 }
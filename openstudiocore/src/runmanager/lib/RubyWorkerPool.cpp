@@ -0,0 +1,375 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include "RubyWorkerPool.hpp"
+
+#include <utilities/core/ApplicationPathHelpers.hpp>
+#include <utilities/core/String.hpp>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QStringList>
+#include <QTime>
+
+#include <boost/thread.hpp>
+#include <boost/lexical_cast.hpp>
+
+#ifndef Q_WS_WIN
+#include <signal.h>
+#endif
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  RubyWorkerPool::Lease::Lease(int t_workerId, const openstudio::path &t_socketPath)
+    : m_workerId(t_workerId), m_socketPath(t_socketPath)
+  {
+  }
+
+  RubyWorkerPool::Lease::~Lease()
+  {
+    RubyWorkerPool::instance().release(m_workerId);
+  }
+
+  openstudio::path RubyWorkerPool::Lease::socketPath() const
+  {
+    return m_socketPath;
+  }
+
+  RubyWorkerPool &RubyWorkerPool::instance()
+  {
+    static RubyWorkerPool pool;
+    return pool;
+  }
+
+  RubyWorkerPool::RubyWorkerPool()
+    : m_numWorkers(0), m_maxJobsPerWorker(0), m_nextId(0),
+      m_jobs(0), m_fallbacks(0), m_starts(0), m_restarts(0), m_startFailures(0),
+      m_missingScriptsLogged(false)
+  {
+  }
+
+  RubyWorkerPool::~RubyWorkerPool()
+  {
+    shutdown();
+  }
+
+  void RubyWorkerPool::setLimits(unsigned t_numWorkers, unsigned t_maxJobsPerWorker)
+  {
+#ifdef Q_WS_WIN
+    if (t_numWorkers > 0)
+    {
+      LOG(Warn, "Ruby worker pool is not supported on this platform, ruby jobs will start their own process");
+    }
+#endif
+
+    {
+      QMutexLocker l(&m_mutex);
+      m_numWorkers = t_numWorkers;
+      m_maxJobsPerWorker = t_maxJobsPerWorker;
+    }
+
+    if (t_numWorkers == 0)
+    {
+      shutdown();
+    }
+  }
+
+  bool RubyWorkerPool::enabled() const
+  {
+#ifdef Q_WS_WIN
+    return false;
+#else
+    QMutexLocker l(&m_mutex);
+    return m_numWorkers > 0;
+#endif
+  }
+
+  boost::shared_ptr<RubyWorkerPool::Lease> RubyWorkerPool::acquire(const openstudio::path &t_ruby, 
+      const std::vector<std::string> &t_rubyParams)
+  {
+    if (!enabled())
+    {
+      return boost::shared_ptr<Lease>();
+    }
+
+    if (!boost::filesystem::exists(serverScript()) || !boost::filesystem::exists(clientScript()))
+    {
+      QMutexLocker l(&m_mutex);
+      if (!m_missingScriptsLogged)
+      {
+        LOG(Warn, "Ruby worker scripts not found in " << toString(serverScript().parent_path()) 
+            << ", ruby jobs will start their own process");
+        m_missingScriptsLogged = true;
+      }
+      ++m_fallbacks;
+      return boost::shared_ptr<Lease>();
+    }
+
+    std::string key = toString(t_ruby);
+    for (std::vector<std::string>::const_iterator itr = t_rubyParams.begin();
+         itr != t_rubyParams.end();
+         ++itr)
+    {
+      key += "\n" + *itr;
+    }
+
+    QMutexLocker l(&m_mutex);
+
+    // drop workers whose server has gone away
+    for (std::vector<Worker>::iterator itr = m_workers.begin();
+         itr != m_workers.end();)
+    {
+      if (itr->ready && !itr->busy && !boost::filesystem::exists(itr->socketPath))
+      {
+        LOG(Warn, "Ruby worker " << itr->id << " exited unexpectedly");
+        itr = m_workers.erase(itr);
+      } else {
+        ++itr;
+      }
+    }
+
+    for (std::vector<Worker>::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if (itr->ready && !itr->busy && !itr->retired && itr->key == key)
+      {
+        itr->busy = true;
+        ++itr->jobs;
+        ++m_jobs;
+        return boost::shared_ptr<Lease>(new Lease(itr->id, itr->socketPath));
+      }
+    }
+
+    if (m_workers.size() >= m_numWorkers)
+    {
+      // make room by stopping an idle worker started for another ruby configuration
+      std::vector<Worker>::iterator idle = m_workers.begin();
+      while (idle != m_workers.end() && (idle->busy || !idle->ready))
+      {
+        ++idle;
+      }
+
+      if (idle == m_workers.end())
+      {
+        ++m_fallbacks;
+        return boost::shared_ptr<Lease>();
+      }
+
+      stopWorker(*idle);
+      m_workers.erase(idle);
+    }
+
+    Worker worker;
+    worker.id = m_nextId++;
+    worker.key = key;
+    worker.socketPath = toPath(QDir::tempPath()) / toPath("osrubyworker-" 
+        + boost::lexical_cast<std::string>(QCoreApplication::applicationPid()) 
+        + "-" + boost::lexical_cast<std::string>(worker.id) + ".sock");
+    worker.pid = 0;
+    worker.ready = false;
+    worker.busy = true;
+    worker.retired = false;
+    worker.jobs = 0;
+    m_workers.push_back(worker);
+
+    // the lock is not held while the server loads the bindings
+    l.unlock();
+    bool started = startWorker(t_ruby, t_rubyParams, worker);
+    l.relock();
+
+    for (std::vector<Worker>::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if (itr->id == worker.id)
+      {
+        if (!started)
+        {
+          ++m_startFailures;
+          ++m_fallbacks;
+          m_workers.erase(itr);
+          return boost::shared_ptr<Lease>();
+        }
+
+        itr->ready = true;
+        itr->jobs = 1;
+        ++m_starts;
+        ++m_jobs;
+        return boost::shared_ptr<Lease>(new Lease(itr->id, itr->socketPath));
+      }
+    }
+
+    // the pool was shut down while the worker was starting
+    stopWorker(worker);
+    ++m_fallbacks;
+    return boost::shared_ptr<Lease>();
+  }
+
+  void RubyWorkerPool::release(int t_workerId)
+  {
+    QMutexLocker l(&m_mutex);
+
+    for (std::vector<Worker>::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if (itr->id == t_workerId)
+      {
+        itr->busy = false;
+
+        bool recycle = m_maxJobsPerWorker > 0 && itr->jobs >= m_maxJobsPerWorker;
+        if (recycle)
+        {
+          LOG(Debug, "Recycling ruby worker " << itr->id << " after " << itr->jobs << " jobs");
+          ++m_restarts;
+        }
+
+        if (recycle || itr->retired || m_workers.size() > m_numWorkers)
+        {
+          stopWorker(*itr);
+          m_workers.erase(itr);
+        }
+        return;
+      }
+    }
+  }
+
+  bool RubyWorkerPool::startWorker(const openstudio::path &t_ruby, const std::vector<std::string> &t_rubyParams, 
+      const Worker &t_worker) const
+  {
+#ifdef Q_WS_WIN
+    return false;
+#else
+    QStringList args;
+    for (std::vector<std::string>::const_iterator itr = t_rubyParams.begin();
+         itr != t_rubyParams.end();
+         ++itr)
+    {
+      args.push_back(toQString(*itr));
+    }
+
+    args.push_back(toQString(serverScript()));
+    args.push_back(toQString(t_worker.socketPath));
+    args.push_back(QString::number(QCoreApplication::applicationPid()));
+
+    qint64 pid = 0;
+    if (!QProcess::startDetached(toQString(t_ruby), args, QDir::tempPath(), &pid))
+    {
+      LOG(Error, "Unable to start ruby worker: " << toString(t_ruby));
+      return false;
+    }
+
+    LOG(Info, "Starting ruby worker " << t_worker.id << " pid " << pid << " on " << toString(t_worker.socketPath));
+
+    QTime timer;
+    timer.start();
+    while (timer.elapsed() < 60000)
+    {
+      if (boost::filesystem::exists(t_worker.socketPath))
+      {
+        return true;
+      }
+
+      if (::kill(static_cast<pid_t>(pid), 0) != 0)
+      {
+        LOG(Error, "Ruby worker " << t_worker.id << " exited during start up");
+        return false;
+      }
+
+      boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    }
+
+    LOG(Error, "Timed out waiting for ruby worker " << t_worker.id << " to start");
+    ::kill(static_cast<pid_t>(pid), SIGKILL);
+    return false;
+#endif
+  }
+
+  void RubyWorkerPool::stopWorker(const Worker &t_worker)
+  {
+    QFile::remove(toQString(t_worker.socketPath));
+  }
+
+  void RubyWorkerPool::shutdown()
+  {
+    QMutexLocker l(&m_mutex);
+
+    for (std::vector<Worker>::iterator itr = m_workers.begin();
+         itr != m_workers.end();)
+    {
+      if (itr->busy)
+      {
+        itr->retired = true;
+        ++itr;
+      } else {
+        stopWorker(*itr);
+        itr = m_workers.erase(itr);
+      }
+    }
+  }
+
+  std::map<std::string, double> RubyWorkerPool::statistics() const
+  {
+    QMutexLocker l(&m_mutex);
+
+    unsigned busy = 0;
+    for (std::vector<Worker>::const_iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if (itr->busy)
+      {
+        ++busy;
+      }
+    }
+
+    std::map<std::string, double> stats;
+    stats["Ruby Workers"] = m_workers.size();
+    stats["Ruby Workers Busy"] = busy;
+    stats["Ruby Worker Jobs"] = m_jobs;
+    stats["Ruby Worker Fallback Jobs"] = m_fallbacks;
+    stats["Ruby Worker Starts"] = m_starts;
+    stats["Ruby Worker Restarts"] = m_restarts;
+    stats["Ruby Worker Start Failures"] = m_startFailures;
+    stats["Ruby Worker Utilization"] = m_numWorkers > 0 ? double(busy) / double(m_numWorkers) : 0.0;
+    stats["Ruby Worker Hit Rate"] = (m_jobs + m_fallbacks) > 0 ? double(m_jobs) / double(m_jobs + m_fallbacks) : 0.0;
+    return stats;
+  }
+
+  openstudio::path RubyWorkerPool::clientScript()
+  {
+    return openstudio::getSharedResourcesPath() / openstudio::toPath("runmanager") / openstudio::toPath("ruby_worker_client.rb");
+  }
+
+  openstudio::path RubyWorkerPool::serverScript()
+  {
+    return openstudio::getSharedResourcesPath() / openstudio::toPath("runmanager") / openstudio::toPath("ruby_worker_server.rb");
+  }
+
+} // detail
+} // runmanager
+} // openstudio
@@ -0,0 +1,144 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#ifndef OPENSTUDIO_RUBYWORKERPOOL_HPP_
+#define OPENSTUDIO_RUBYWORKERPOOL_HPP_
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <QMutex>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  /// Pool of long lived, forking ruby servers used by RubyJob so that jobs do not pay for
+  /// ruby start up and loading of the OpenStudio bindings. See ruby_worker_server.rb and
+  /// ruby_worker_client.rb in the runmanager shared resources.
+  ///
+  /// Each worker runs one job at a time, in a child forked from the warm server, and is
+  /// retired once it has run the configured number of jobs. Jobs that cannot get a worker
+  /// run in a fresh ruby process as before. The pool is disabled by default and is not
+  /// available on Windows.
+  class RubyWorkerPool
+  {
+    public:
+      /// A worker reserved for a single job, handed back to the pool on destruction
+      class Lease
+      {
+        public:
+          ~Lease();
+
+          /// \returns the socket the client script connects to
+          openstudio::path socketPath() const;
+
+        private:
+          friend class RubyWorkerPool;
+
+          Lease(int t_workerId, const openstudio::path &t_socketPath);
+          Lease(const Lease &);
+          Lease &operator=(const Lease &);
+
+          int m_workerId;
+          openstudio::path m_socketPath;
+      };
+
+      static RubyWorkerPool &instance();
+
+      ~RubyWorkerPool();
+
+      /// Sets the maximum number of workers and the number of jobs after which a worker is
+      /// replaced with a fresh one. A t_numWorkers of 0 disables the pool.
+      void setLimits(unsigned t_numWorkers, unsigned t_maxJobsPerWorker);
+
+      /// \returns true if the pool is enabled and supported on this platform
+      bool enabled() const;
+
+      /// Reserves an idle worker started with the given ruby binary and interpreter parameters,
+      /// starting one if there is room.
+      /// \returns an empty pointer if no worker could be reserved
+      boost::shared_ptr<Lease> acquire(const openstudio::path &t_ruby, const std::vector<std::string> &t_rubyParams);
+
+      /// \returns the script to run in place of the job script when holding a Lease.
+      /// Its parameters are the lease socket, the job script and the job script parameters.
+      static openstudio::path clientScript();
+
+      /// \returns named statistics regarding pool utilization
+      std::map<std::string, double> statistics() const;
+
+      /// Stops all idle workers, busy workers stop once their job is released
+      void shutdown();
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.RubyWorkerPool");
+
+      struct Worker
+      {
+        int id;
+        std::string key;
+        openstudio::path socketPath;
+        qint64 pid;
+        bool ready;
+        bool busy;
+        bool retired;
+        unsigned jobs;
+      };
+
+      RubyWorkerPool();
+      RubyWorkerPool(const RubyWorkerPool &);
+      RubyWorkerPool &operator=(const RubyWorkerPool &);
+
+      void release(int t_workerId);
+
+      /// Starts the server for t_worker and waits for it to listen, called without holding the lock
+      bool startWorker(const openstudio::path &t_ruby, const std::vector<std::string> &t_rubyParams, 
+          const Worker &t_worker) const;
+
+      /// Removes the socket of a worker, which makes its server exit
+      static void stopWorker(const Worker &t_worker);
+
+      static openstudio::path serverScript();
+
+      mutable QMutex m_mutex;
+      std::vector<Worker> m_workers;
+      unsigned m_numWorkers;
+      unsigned m_maxJobsPerWorker;
+      int m_nextId;
+
+      unsigned m_jobs;
+      unsigned m_fallbacks;
+      unsigned m_starts;
+      unsigned m_restarts;
+      unsigned m_startFailures;
+      bool m_missingScriptsLogged;
+  };
+
+} // detail
+} // runmanager
+} // openstudio
+
+#endif
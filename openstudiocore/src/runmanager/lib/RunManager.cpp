@@ -23,6 +23,7 @@
 
 #include "Workflow.hpp"
 #include "RunManager_Impl.hpp"
+#include "RubyWorkerPool.hpp"
 #include <map>
 
 #include <utilities/core/Path.hpp>
@@ -245,6 +246,26 @@ namespace runmanager {
     m_impl->clearJobs();
   }
 
+  void RunManager::setWriteBehind(unsigned t_maxPendingWrites, int t_maxDelayMsecs)
+  {
+    m_impl->setWriteBehind(t_maxPendingWrites, t_maxDelayMsecs);
+  }
+
+  void RunManager::flushDatabase()
+  {
+    m_impl->flushDatabase();
+  }
+
+  unsigned RunManager::numDatabaseWriteTransactions() const
+  {
+    return m_impl->numDatabaseWriteTransactions();
+  }
+
+  void RunManager::setRubyWorkerPool(unsigned t_numWorkers, unsigned t_maxJobsPerWorker)
+  {
+    detail::RubyWorkerPool::instance().setLimits(t_numWorkers, t_maxJobsPerWorker);
+  }
+
   /*
   void RunManager::waitForCompletion() const 
   {
@@ -275,6 +275,26 @@ namespace detail {
       /// safely clears all jobs from the runmanager
       void clearJobs();
 
+      /// Job changes are queued and written to the database in one transaction once
+      /// t_maxPendingWrites changes are queued or the oldest has waited t_maxDelayMsecs.
+      /// Changes are always written in the order they were made, and before any read of
+      /// the database and on destruction. A t_maxPendingWrites of 0 writes every change
+      /// immediately. Defaults to 1000 changes and 1000 msecs.
+      void setWriteBehind(unsigned t_maxPendingWrites, int t_maxDelayMsecs);
+
+      /// Write all queued job changes to the database now
+      void flushDatabase();
+
+      /// Number of database transactions used so far to write queued job changes
+      unsigned numDatabaseWriteTransactions() const;
+
+      /// Run local ruby jobs in a pool of up to t_numWorkers warm ruby processes which have
+      /// already loaded the OpenStudio bindings. Each worker is replaced after running
+      /// t_maxJobsPerWorker jobs, 0 for no limit. A t_numWorkers of 0 (the default) starts a
+      /// new ruby process for every job. The pool is shared by all RunManagers and is not
+      /// available on Windows.
+      static void setRubyWorkerPool(unsigned t_numWorkers, unsigned t_maxJobsPerWorker);
+
       /// perform some model simplifications that reduce the simulation time
       /// with accuracy being an acceptable loss
       ///
@@ -24,6 +24,7 @@
 #include <runmanager/lib/runmanagerdatabase.hxx>
 #include "JobFactory.hpp"
 #include "Workflow.hpp"
+#include "RubyWorkerPool.hpp"
 #include <QFileInfo>
 #include <QDateTime>
 #include <QMessageBox>
@@ -34,6 +35,7 @@
 #include <OpenStudio.hxx>
 
 #include <boost/bind.hpp>
+#include <boost/function.hpp>
 
 namespace openstudio {
 namespace runmanager {
@@ -167,11 +169,108 @@ namespace detail {
           m_config(initConfigOptions(m_db, DB)),
           m_loading(false),
           m_dbPath(DB),
-          m_configOptions(new ConfigOptions(toConfigOptions(m_db, m_config)))
+          m_configOptions(new ConfigOptions(toConfigOptions(m_db, m_config))),
+          m_maxPendingWrites(1000),
+          m_maxWriteDelay(1000),
+          m_numWriteTransactions(0)
       {
 
       }
 
+      ~DBHolder()
+      {
+        flushPendingWrites();
+      }
+
+      /// Set the limits for queued job changes. Changes are written in one transaction
+      /// once t_maxPendingWrites are queued or the oldest has waited t_maxWriteDelay msecs.
+      /// A t_maxPendingWrites of 0 writes every change immediately.
+      void setWriteBehind(unsigned t_maxPendingWrites, int t_maxWriteDelay)
+      {
+        {
+          QMutexLocker l(&m_pendingMutex);
+          m_maxPendingWrites = t_maxPendingWrites;
+          m_maxWriteDelay = t_maxWriteDelay;
+        }
+
+        flushPendingWrites();
+      }
+
+      /// Write all queued changes if the oldest queued change is older than the write delay
+      void flushIfDue()
+      {
+        {
+          QMutexLocker l(&m_pendingMutex);
+          if (m_pendingWrites.empty()
+              || m_oldestPendingWrite.msecsTo(QDateTime::currentDateTime()) < m_maxWriteDelay)
+          {
+            return;
+          }
+        }
+
+        flushPendingWrites();
+      }
+
+      /// Write all queued changes in a single transaction, in the order they were queued.
+      /// If any change fails the transaction is rolled back and the changes are retried in
+      /// order, each in its own transaction. A change that fails again is logged and dropped,
+      /// so one bad change cannot block the queue. Errors are not rethrown.
+      void flushPendingWrites()
+      {
+        QMutexLocker w(&m_writeMutex);
+
+        std::deque<boost::function<void ()> > writes;
+        {
+          QMutexLocker l(&m_pendingMutex);
+          writes.swap(m_pendingWrites);
+        }
+
+        if (writes.empty())
+        {
+          return;
+        }
+
+        LOG(Debug, "(" << openstudio::toString(m_dbPath) << ") Writing " << writes.size() << " queued job changes");
+
+        try {
+          m_db.begin();
+          for (std::deque<boost::function<void ()> >::const_iterator itr = writes.begin();
+               itr != writes.end();
+               ++itr)
+          {
+            (*itr)();
+          }
+          m_db.commit();
+          ++m_numWriteTransactions;
+        } catch (const std::exception &e) {
+          LOG(Warn, "(" << openstudio::toString(m_dbPath) << ") Error writing " << writes.size()
+              << " queued job changes, rolling back and writing them one at a time: " << e.what());
+          rollbackPendingWrites();
+
+          for (std::deque<boost::function<void ()> >::const_iterator itr = writes.begin();
+               itr != writes.end();
+               ++itr)
+          {
+            try {
+              m_db.begin();
+              (*itr)();
+              m_db.commit();
+              ++m_numWriteTransactions;
+            } catch (const std::exception &e2) {
+              LOG(Error, "(" << openstudio::toString(m_dbPath) << ") Error writing queued job change, dropping it: " << e2.what());
+              rollbackPendingWrites();
+            }
+          }
+        }
+      }
+
+      /// Number of transactions that have written queued changes
+      unsigned numWriteTransactions()
+      {
+        QMutexLocker w(&m_writeMutex);
+        return m_numWriteTransactions;
+      }
+
       ConfigOptions getConfigOptions()
       {
         // we know that the m_configOptions object is not going to be modified
@@ -198,6 +297,8 @@ namespace detail {
 
       void setConfigOptions(const ConfigOptions &t_co)
       {
+        flushPendingWrites();
+        QMutexLocker w(&m_writeMutex);
         QMutexLocker l(&m_mutex);
         updateConfiguration(m_db, m_config, t_co);
         m_db.commit();
@@ -206,19 +307,27 @@ namespace detail {
 
       void setRemoteProcessId(const openstudio::UUID &t_uuid, int t_remoteId, int t_remoteTaskId)
       {
-        QMutexLocker l(&m_mutex);
-        if (m_loading) return; // we are currently loading, don't persist that which we are loading
+        if (isLoading()) return; // we are currently loading, don't persist that which we are loading
 
+        queueWrite(boost::bind(&DBHolder::setRemoteProcessIdInternal, this, t_uuid, t_remoteId, t_remoteTaskId));
+      }
+
+      void setRemoteProcessIdInternal(const openstudio::UUID &t_uuid, int t_remoteId, int t_remoteTaskId)
+      {
+        QMutexLocker l(&m_mutex);
         RunManagerDB::RemoteJob rj(m_db);
         rj.uuid = toString(t_uuid);
         rj.remoteId = t_remoteId;
         rj.remoteTaskId = t_remoteTaskId;
         rj.update();
-        m_db.commit();
-
       }
 
       void clearRemoteProcessId(const openstudio::UUID &t_uuid, int t_remoteId, int t_remoteTaskId)
+      {
+        queueWrite(boost::bind(&DBHolder::clearRemoteProcessIdInternal, this, t_uuid));
+      }
+
+      void clearRemoteProcessIdInternal(const openstudio::UUID &t_uuid)
       {
         QMutexLocker l(&m_mutex);
         std::vector<RunManagerDB::RemoteJob> jobs
@@ -230,11 +339,12 @@ namespace detail {
         {
           itr->del();
         }
-        m_db.commit();
       }
 
       std::map<openstudio::UUID, std::pair<int, int> > loadRemoteJobs()
       {
+        flushPendingWrites();
+
         std::map<openstudio::UUID, std::pair<int, int> > retvals;
 
         std::vector<RunManagerDB::RemoteJob> remotejobs
@@ -262,12 +372,14 @@ namespace detail {
 
       std::vector<openstudio::runmanager::Job> loadJobs()
       {
+        flushPendingWrites();
         QMutexLocker l(&m_mutex);
         return loadJobsImpl(false, "");
       }
 
       std::vector<openstudio::runmanager::Workflow> loadWorkflows()
       {
+        flushPendingWrites();
         QMutexLocker l(&m_mutex);
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
 
@@ -282,6 +394,7 @@ namespace detail {
 
       openstudio::runmanager::Workflow loadWorkflowByName(const std::string &t_name)
       {
+        flushPendingWrites();
         QMutexLocker l(&m_mutex);
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
 
@@ -304,6 +417,8 @@ namespace detail {
 
       void deleteWorkflowByName(const std::string &t_name)
       {
+        flushPendingWrites();
+        QMutexLocker w(&m_writeMutex);
         QMutexLocker l(&m_mutex);
         m_db.begin();
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
@@ -316,7 +431,7 @@ namespace detail {
             if (itr->jobParams().get("workflowname").children.at(0).value == t_name)
             {
               LOG(Debug, "WorkflowFound " << t_name << " with uuid " << toString(itr->uuid()) << " deleting" );
-              deleteJobRecursiveInternal(*itr);
+              deleteJobInternal(jobTreeUuids(*itr));
             }
           } catch (const std::exception &) {
             // continue
@@ -327,6 +442,8 @@ namespace detail {
       
       void deleteWorkflows()
       {
+        flushPendingWrites();
+        QMutexLocker w(&m_writeMutex);
         QMutexLocker l(&m_mutex);
         m_db.begin();
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
@@ -335,7 +452,7 @@ namespace detail {
              itr != jobs.end(); 
              ++itr)
         {
-          deleteJobRecursiveInternal(*itr);
+          deleteJobInternal(jobTreeUuids(*itr));
         }
 
         m_db.commit();
@@ -343,13 +460,19 @@ namespace detail {
 
       void deleteJobTree(const openstudio::runmanager::Job &t_job)
       {
-        QMutexLocker l(&m_mutex);
-        m_db.begin();
-        deleteJobRecursiveInternal(t_job);
-        m_db.commit();
+        // the tree is walked now, it may be changed before the delete is written
+        queueWrite(boost::bind(&DBHolder::deleteJobsLocked, this, jobTreeUuids(t_job)));
+      }
+
+      /// \returns the uuids of t_job and all of its children and finished jobs, children first
+      static std::vector<openstudio::UUID> jobTreeUuids(const openstudio::runmanager::Job &t_job)
+      {
+        std::vector<openstudio::UUID> uuids;
+        jobTreeUuidsImpl(t_job, uuids);
+        return uuids;
       }
 
-      void deleteJobRecursiveInternal(const openstudio::runmanager::Job &t_job)
+      static void jobTreeUuidsImpl(const openstudio::runmanager::Job &t_job, std::vector<openstudio::UUID> &t_uuids)
       {
         std::vector<openstudio::runmanager::Job> children = t_job.children();
 
@@ -357,15 +480,15 @@ namespace detail {
              itr != children.end();
              ++itr)
         {
-          deleteJobRecursiveInternal(*itr);
+          jobTreeUuidsImpl(*itr, t_uuids);
         }
 
         if (t_job.finishedJob())
         {
-          deleteJobRecursiveInternal(*t_job.finishedJob());
+          jobTreeUuidsImpl(*t_job.finishedJob(), t_uuids);
         }
 
-        deleteJobInternal(t_job);
+        t_uuids.push_back(t_job.uuid());
       }
 
       bool workflowExists(const std::string &t_key)
@@ -405,11 +528,11 @@ namespace detail {
       }
 
 
-      void deleteJobInternal(const openstudio::runmanager::Job &t_job)
+      void deleteJobInternal(const openstudio::UUID &t_uuid)
       {
         std::vector<RunManagerDB::Job> jobs
           = litesql::select<RunManagerDB::Job>(m_db,
-              RunManagerDB::Job::Uuid == toString(t_job.uuid())).all();
+              RunManagerDB::Job::Uuid == toString(t_uuid)).all();
         for (std::vector<RunManagerDB::Job>::iterator itr = jobs.begin();
             itr != jobs.end();
             ++itr)
@@ -417,50 +540,45 @@ namespace detail {
           itr->del();
         }
 
-        deleteJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_job);
-        deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(t_job);
-        deleteJobTools(t_job);
-        deleteJobParams(t_job);
-        deleteJobStatus(t_job.uuid());
+        deleteJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_uuid);
+        deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(t_uuid);
+        deleteJobTools(t_uuid);
+        deleteJobParams(t_uuid);
+        deleteJobStatus(t_uuid);
       }
 
+      void deleteJobInternal(const std::vector<openstudio::UUID> &t_uuids)
+      {
+        for (std::vector<openstudio::UUID>::const_iterator itr = t_uuids.begin();
+             itr != t_uuids.end();
+             ++itr)
+        {
+          deleteJobInternal(*itr);
+        }
+      }
 
-      void deleteJob(const openstudio::runmanager::Job &t_job)
+      void deleteJobsLocked(const std::vector<openstudio::UUID> &t_uuids)
       {
         QMutexLocker l(&m_mutex);
-        m_db.begin();
-        deleteJobInternal(t_job);
-        m_db.commit();
+        deleteJobInternal(t_uuids);
+      }
+
+      void deleteJob(const openstudio::runmanager::Job &t_job)
+      {
+        queueWrite(boost::bind(&DBHolder::deleteJobsLocked, this, std::vector<openstudio::UUID>(1, t_job.uuid())));
       }
 
       template<typename Itr>
         void deleteJobs(Itr begin, const Itr &end)
         {
-          QMutexLocker l(&m_mutex);
-
-          m_db.begin();
+          std::vector<openstudio::UUID> uuids;
           while (begin != end)
           {
-            std::vector<RunManagerDB::Job> jobs
-              = litesql::select<RunManagerDB::Job>(m_db,
-                  RunManagerDB::Job::Uuid == toString(begin->uuid())).all();
-
-            for (std::vector<RunManagerDB::Job>::iterator itr = jobs.begin();
-                itr != jobs.end();
-                ++itr)
-            {
-              itr->del();
-            }
-
-            deleteJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(*begin);
-            deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(*begin);
-            deleteJobTools(*begin);
-            deleteJobParams(*begin);
-            deleteJobStatus(begin->uuid());
+            uuids.push_back(begin->uuid());
             ++begin;
           }
 
-          m_db.commit();
+          queueWrite(boost::bind(&DBHolder::deleteJobsLocked, this, uuids));
         }
 
       std::string persistWorkflow(openstudio::runmanager::Workflow t_workflow /*we want a copy*/)
@@ -468,11 +586,15 @@ namespace detail {
         Job j = t_workflow.create();
 
         std::string key = j.jobParams().get("workflowkey").children.at(0).value;
-        
+
+        if (isLoading()) return key; // we are currently loading, don't persist that which we are loading
+
+        flushPendingWrites();
+        QMutexLocker w(&m_writeMutex);
         m_db.begin();
         if (!workflowExists(key))
         {
-          persistJobRecursive(j, true);
+          persistJobs(snapshotJobTree(j, true));
           // workflow did not exist, is now added
         }
         m_db.commit();
@@ -482,32 +604,86 @@ namespace detail {
 
       void persistJobTree(const openstudio::runmanager::Job &t_job)
       {
-        m_db.begin();
-        persistJobRecursive(t_job, false);
-        m_db.commit();
+        if (isLoading()) return; // we are currently loading, don't persist that which we are loading
+
+        // the tree is copied now, like job status, so the queued write records the state at the time of the call
+        queueWrite(boost::bind(&DBHolder::persistJobs, this, snapshotJobTree(t_job, false)));
       }
 
       void persistJobTrees(const std::vector<openstudio::runmanager::Job> &t_jobs)
       {
-        m_db.begin();
+        if (isLoading()) return; // we are currently loading, don't persist that which we are loading
 
         for (std::vector<openstudio::runmanager::Job>::const_iterator itr = t_jobs.begin();
              itr != t_jobs.end();
              ++itr)
         {
-          persistJobRecursive(*itr, false);
+          queueWrite(boost::bind(&DBHolder::persistJobs, this, snapshotJobTree(*itr, false)));
         }
+      }
 
-        m_db.commit();
+      /// Copy of everything persisted for one job, so a queued write does not depend on
+      /// the state of the job when the queue is flushed
+      struct JobSnapshot
+      {
+        openstudio::UUID uuid;
+        std::string parentUuid;
+        bool isFinishedJob;
+        bool isWorkflow;
+        int index;
+        std::string jobType;
+        std::vector<FileInfo> inputFiles;
+        std::vector<ToolInfo> tools;
+        std::vector<JobParam> params;
+        openstudio::path basePath;
+        JobErrors errors;
+        boost::optional<openstudio::DateTime> lastRun;
+        Files outputFiles;
+      };
+
+      /// \returns snapshots of t_job, its finished job and all of its children, parents first
+      static std::vector<JobSnapshot> snapshotJobTree(const openstudio::runmanager::Job &t_job, bool isWorkflow)
+      {
+        std::vector<JobSnapshot> snapshots;
+        snapshotJobTreeImpl(t_job, isWorkflow, snapshots);
+        return snapshots;
       }
 
-      void persistJobRecursive(const openstudio::runmanager::Job &t_job, bool isWorkflow)
+      static void snapshotJobTreeImpl(const openstudio::runmanager::Job &t_job, bool isWorkflow, std::vector<JobSnapshot> &t_snapshots)
       {
-        persistJob(t_job, isWorkflow);
+        JobSnapshot s;
+        s.uuid = t_job.uuid();
+        s.isFinishedJob = false;
+        s.isWorkflow = isWorkflow;
+        boost::optional<Job> parent = t_job.parent();
+        if (parent)
+        {
+          s.parentUuid = toString(parent->uuid());
+          boost::optional<Job> finishedJob = parent->finishedJob();
+
+          if (finishedJob)
+          {
+            if (*finishedJob == t_job)
+            {
+              s.isFinishedJob = true;
+            }
+          }
+        }
+        s.index = t_job.index();
+        s.jobType = t_job.jobType().valueName();
+        s.inputFiles = t_job.rawInputFiles();
+        s.tools = t_job.tools();
+        s.params = t_job.params();
+        s.basePath = t_job.getBasePath();
+        s.errors = t_job.errors();
+        s.lastRun = t_job.lastRun();
+        s.outputFiles = openstudio::runmanager::Files(t_job.outputFiles());
+        t_snapshots.push_back(s);
+
         boost::optional<openstudio::runmanager::Job> fj = t_job.finishedJob();
         if (fj)
         {
-          persistJobRecursive(*fj, isWorkflow);
+          snapshotJobTreeImpl(*fj, isWorkflow, t_snapshots);
         }
 
         std::vector<openstudio::runmanager::Job> children = t_job.children();
@@ -515,42 +691,41 @@ namespace detail {
              itr != children.end();
              ++itr)
         {
-          persistJobRecursive(*itr, isWorkflow);
+          snapshotJobTreeImpl(*itr, isWorkflow, t_snapshots);
         }
+      }
 
+      void persistJobs(const std::vector<JobSnapshot> &t_jobs)
+      {
+        for (std::vector<JobSnapshot>::const_iterator itr = t_jobs.begin();
+             itr != t_jobs.end();
+             ++itr)
+        {
+          persistJob(*itr);
+        }
       }
 
-      void persistJob(const openstudio::runmanager::Job &t_job, bool isWorkflow = false)
+      void persistJob(const JobSnapshot &t_job)
       {
         QMutexLocker l(&m_mutex);
-        if (m_loading) return; // we are currently loading, don't persist that which we are loading
 
         RunManagerDB::Job j(m_db);
-        j.uuid = toString(t_job.uuid());
-        j.isFinishedJob = false;
-        j.isWorkflowJob = isWorkflow;
-        if (t_job.parent())
+        j.uuid = toString(t_job.uuid);
+        j.isFinishedJob = t_job.isFinishedJob;
+        j.isWorkflowJob = t_job.isWorkflow;
+        if (!t_job.parentUuid.empty())
         {
-          j.parentUuid = toString(t_job.parent()->uuid());
-          boost::optional<Job> finishedJob = t_job.parent()->finishedJob();
-
-          if (finishedJob)
-          {
-            if (*finishedJob == t_job)
-            {
-              j.isFinishedJob = true;
-            }
-          }
+          j.parentUuid = t_job.parentUuid;
         }
-        j.index = t_job.index();
-        j.jobType = t_job.jobType().valueName();
+        j.index = t_job.index;
+        j.jobType = t_job.jobType;
         j.update();
 
 
-        persistJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_job);
-        persistJobTools(t_job);
-        persistJobParams(t_job);
-        persistJobStatusInternal(t_job);
+        persistJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_job.uuid, t_job.inputFiles);
+        persistJobTools(t_job.uuid, t_job.tools);
+        persistJobParams(t_job.uuid, t_job.params, t_job.basePath);
+        persistJobStatusInternal(t_job.uuid, t_job.errors, t_job.lastRun, t_job.outputFiles);
       }
 
 
@@ -609,9 +784,15 @@ namespace detail {
       void persistJobStatus(const openstudio::UUID &t_uuid, const JobErrors &t_errors, const boost::optional<openstudio::DateTime> &t_lastRun,
           const Files &t_files)
       {
-        m_db.begin();
+        // status is copied now, so the queued write records the state at the time of the call
+        queueWrite(boost::bind(&DBHolder::persistJobStatusLocked, this, t_uuid, t_errors, t_lastRun, t_files));
+      }
+
+      void persistJobStatusLocked(const openstudio::UUID &t_uuid, const JobErrors &t_errors, const boost::optional<openstudio::DateTime> &t_lastRun,
+          const Files &t_files)
+      {
+        QMutexLocker l(&m_mutex);
         persistJobStatusInternal(t_uuid, t_errors, t_lastRun, t_files);
-        m_db.commit();
       }
 
 
@@ -661,11 +842,6 @@ namespace detail {
         LOG(Debug, "Done persisting job, committing " << openstudio::toString(t_uuid));
       }
 
-      void persistJobStatusInternal(const openstudio::runmanager::Job &t_job)
-      {
-        persistJobStatusInternal(t_job.uuid(), t_job.errors(), t_job.lastRun(), openstudio::runmanager::Files(t_job.outputFiles()));
-      }
-
       void persistJobStatus(const openstudio::runmanager::Job &t_job)
       {
         persistJobStatus(t_job.uuid(), t_job.errors(), t_job.lastRun(), openstudio::runmanager::Files(t_job.outputFiles()));
@@ -673,13 +849,49 @@ namespace detail {
 
 
     private:
+      void rollbackPendingWrites()
+      {
+        try {
+          m_db.rollback();
+        } catch (const std::exception &e) {
+          LOG(Error, "(" << openstudio::toString(m_dbPath) << ") Error rolling back queued job changes: " << e.what());
+        }
+      }
+
+      /// Queue a change to be written in order with the other queued changes
+      void queueWrite(const boost::function<void ()> &t_write)
+      {
+        bool flush = false;
+        {
+          QMutexLocker l(&m_pendingMutex);
+          if (m_pendingWrites.empty())
+          {
+            m_oldestPendingWrite = QDateTime::currentDateTime();
+          }
+          m_pendingWrites.push_back(t_write);
+          flush = m_pendingWrites.size() >= m_maxPendingWrites;
+        }
+
+        if (flush)
+        {
+          flushPendingWrites();
+        }
+      }
+
       mutable QMutex m_mutex;
+      QMutex m_writeMutex; //< held while a transaction is open, taken before m_mutex
+      QMutex m_pendingMutex; //< protects the queue of pending writes
+      std::deque<boost::function<void ()> > m_pendingWrites;
+      QDateTime m_oldestPendingWrite;
       RunManagerDB::RunManagerDatabase m_db;
       RunManagerDB::ConfigOptions m_config;
       bool m_loading;
       bool m_newConfig;
       openstudio::path m_dbPath;
       boost::shared_ptr<openstudio::runmanager::ConfigOptions> m_configOptions;
+      unsigned m_maxPendingWrites;
+      int m_maxWriteDelay;
+      unsigned m_numWriteTransactions; //< protected by m_writeMutex
 
       std::vector<openstudio::runmanager::Job> loadJobsImpl(bool isWorkflow, const std::string &workflowkey)
       {
@@ -926,12 +1138,12 @@ namespace detail {
         return params;
       }
 
-      void deleteJobParams(const openstudio::runmanager::Job &t_job)
+      void deleteJobParams(const openstudio::UUID &t_uuid)
       {
         // delete the old
         std::vector<RunManagerDB::JobParam> tools
           = litesql::select<RunManagerDB::JobParam>(m_db,
-              RunManagerDB::JobParam::JobUuid == toString(t_job.uuid())).all();
+              RunManagerDB::JobParam::JobUuid == toString(t_uuid)).all();
         for (std::vector<RunManagerDB::JobParam>::iterator itr = tools.begin();
             itr != tools.end();
             ++itr)
@@ -940,12 +1152,10 @@ namespace detail {
         }
       }
 
-      void persistJobParams(const openstudio::runmanager::Job &t_job)
+      void persistJobParams(const openstudio::UUID &t_uuid, const std::vector<JobParam> &t_params, const openstudio::path &basePath)
       {
         // add the new
-        std::vector<JobParam> params = t_job.params();
-
-        openstudio::path basePath = t_job.getBasePath();
+        std::vector<JobParam> params = t_params;
 
         if (!basePath.empty() && basePath != boost::filesystem::initial_path<openstudio::path>()
             && basePath != m_dbPath.parent_path())
@@ -960,16 +1170,16 @@ namespace detail {
             itr != params.end();
             ++itr)
         {
-          persistJobParamsImpl(t_job, *itr);
+          persistJobParamsImpl(t_uuid, *itr);
         }
       }
 
-      void persistJobParamsImpl(const openstudio::runmanager::Job &t_job,
+      void persistJobParamsImpl(const openstudio::UUID &t_uuid,
           const openstudio::runmanager::JobParam &t_param,
           boost::optional<int> parentid = boost::optional<int>())
       {
         RunManagerDB::JobParam p(m_db);
-        p.jobUuid = toString(t_job.uuid());
+        p.jobUuid = toString(t_uuid);
 
         if (parentid)
         {
@@ -984,7 +1194,7 @@ namespace detail {
              itr != t_param.children.end();
              ++itr)
         {
-          persistJobParamsImpl(t_job, *itr, boost::optional<int>(p.id));
+          persistJobParamsImpl(t_uuid, *itr, boost::optional<int>(p.id));
         }
       }
 
@@ -1038,12 +1248,12 @@ namespace detail {
         return ret;
       }
 
-      void deleteJobTools(const openstudio::runmanager::Job &t_job)
+      void deleteJobTools(const openstudio::UUID &t_uuid)
       {
         // delete the old
         std::vector<RunManagerDB::JobToolInfo> tools
           = litesql::select<RunManagerDB::JobToolInfo>(m_db,
-              RunManagerDB::JobToolInfo::JobUuid == toString(t_job.uuid())).all();
+              RunManagerDB::JobToolInfo::JobUuid == toString(t_uuid)).all();
         for (std::vector<RunManagerDB::JobToolInfo>::iterator itr = tools.begin();
             itr != tools.end();
             ++itr)
@@ -1052,17 +1262,16 @@ namespace detail {
         }
       }
 
-      void persistJobTools(const openstudio::runmanager::Job &t_job)
+      void persistJobTools(const openstudio::UUID &t_uuid, const std::vector<ToolInfo> &jobTools)
       {
         // Add the new
-        std::vector<ToolInfo> jobTools = t_job.tools();
 
         for (std::vector<ToolInfo>::const_iterator itr = jobTools.begin();
              itr != jobTools.end();
              ++itr)
         {
           RunManagerDB::JobToolInfo j(m_db);
-          j.jobUuid = toString(t_job.uuid());
+          j.jobUuid = toString(t_uuid);
           j.name = itr->name;
           j.localBinPath = toString(itr->localBinPath);
           j.remoteArchive = toString(itr->remoteArchive);
@@ -1180,12 +1389,6 @@ namespace detail {
         }
       }
 
-      template<typename JobFileType, typename RequiredFileType>
-      void persistJobFiles(const openstudio::runmanager::Job &t_job)
-      {
-        persistJobFiles<JobFileType, RequiredFileType>(t_job.uuid(), t_job.rawInputFiles());
-      }
-
       template<typename JobFileType, typename RequiredFileType>
       void persistJobFiles(const openstudio::UUID &t_uuid, const std::vector<FileInfo> &t_files)
       {
@@ -2192,6 +2395,11 @@ namespace detail {
 
   void RunManager_Impl::processQueue()
   {
+    // write queued job changes once they have waited long enough
+    if (m_dbholder)
+    {
+      m_dbholder->flushIfDue();
+    }
 
     if (m_activate_mutex.tryLock())
     {
@@ -2313,6 +2521,9 @@ namespace detail {
     stats["Locally Running Jobs"] = locallyrunningjobs;
     stats["Remotely Running Jobs"] = remotelyrunningjobs;
 
+    std::map<std::string, double> rubyWorkerStats = RubyWorkerPool::instance().statistics();
+    stats.insert(rubyWorkerStats.begin(), rubyWorkerStats.end());
+
     return stats;
   }
 
@@ -2494,6 +2705,21 @@ namespace detail {
 
 
 
+  void RunManager_Impl::setWriteBehind(unsigned t_maxPendingWrites, int t_maxDelayMsecs)
+  {
+    m_dbholder->setWriteBehind(t_maxPendingWrites, t_maxDelayMsecs);
+  }
+
+  void RunManager_Impl::flushDatabase()
+  {
+    m_dbholder->flushPendingWrites();
+  }
+
+  unsigned RunManager_Impl::numDatabaseWriteTransactions() const
+  {
+    return m_dbholder->numWriteTransactions();
+  }
+
   void RunManager_Impl::run()
   {
     while (getContinue())
@@ -213,6 +213,15 @@ namespace detail {
       /// Clear all jobs from the runmanager
       void clearJobs();
 
+      /// Set the number of queued job changes and the delay that trigger a database write
+      void setWriteBehind(unsigned t_maxPendingWrites, int t_maxDelayMsecs);
+
+      /// Write all queued job changes to the database now
+      void flushDatabase();
+
+      /// Number of database transactions used so far to write queued job changes
+      unsigned numDatabaseWriteTransactions() const;
+
       Workflow loadWorkflowByName(const std::string &t_name) const;
 
       void deleteWorkflowByName(const std::string &t_name);
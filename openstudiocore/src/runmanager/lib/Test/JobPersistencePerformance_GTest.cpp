@@ -0,0 +1,110 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/lib/RunManager.hpp>
+#include <runmanager/lib/Workflow.hpp>
+
+#include <utilities/core/Path.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/timer.hpp>
+
+using namespace openstudio;
+using namespace openstudio::runmanager;
+
+/// Returns the number of transactions used to write the job changes, and the elapsed time in t_elapsed
+unsigned enqueueAndRunJobs(const openstudio::path &t_db, unsigned t_maxPendingWrites, int t_number, double &t_elapsed)
+{
+  if (boost::filesystem::exists(t_db))
+  {
+    boost::filesystem::remove(t_db);
+  }
+
+  boost::timer t;
+  unsigned transactions = 0;
+
+  {
+    RunManager rm(t_db, true, true);
+    rm.setWriteBehind(t_maxPendingWrites, 1000);
+
+    for (int i = 0; i < t_number; ++i)
+    {
+      Workflow wf("null->null");
+      // keep filepaths short enough for Windows
+      wf.addParam(runmanager::JobParam("flatoutdir"));
+      rm.enqueue(wf.create(t_db.parent_path()), true);
+    }
+
+    rm.setPaused(false);
+    rm.waitForFinished();
+    rm.flushDatabase();
+    transactions = rm.numDatabaseWriteTransactions();
+  }
+
+  t_elapsed = t.elapsed();
+  return transactions;
+}
+
+TEST_F(RunManagerTestFixture, JobPersistencePerformanceTest)
+{
+  int number = 500;
+
+  openstudio::path outdir = openstudio::tempDir() / openstudio::toPath("JobPersistencePerformanceTest");
+  boost::filesystem::create_directories(outdir);
+  openstudio::path db = outdir / openstudio::toPath("test.db");
+
+  // every enqueue and every finished job is its own transaction
+  double immediate = 0;
+  unsigned immediateTransactions = enqueueAndRunJobs(db, 0, number, immediate);
+  EXPECT_GE(immediateTransactions, static_cast<unsigned>(number));
+
+  // enqueues and finished jobs are grouped into larger transactions
+  double batched = 0;
+  unsigned batchedTransactions = enqueueAndRunJobs(db, 1000, number, batched);
+  EXPECT_LT(batchedTransactions, immediateTransactions);
+
+  {
+    // everything queued was written by the flush
+    RunManager rm(db, true, true);
+    std::vector<Job> jobs = rm.getJobs();
+    ASSERT_EQ(2 * number, static_cast<int>(jobs.size()));
+
+    for (std::vector<Job>::const_iterator itr = jobs.begin();
+         itr != jobs.end();
+         ++itr)
+    {
+      EXPECT_TRUE(itr->lastRun());
+    }
+
+    // removals queued with a long delay are written by flushDatabase
+    rm.setWriteBehind(1000, 60000);
+    rm.clearJobs();
+    rm.flushDatabase();
+  }
+
+  {
+    RunManager rm(db, true, true);
+    EXPECT_TRUE(rm.getJobs().empty());
+  }
+
+  LOG_FREE(Info, "RunManagerTiming", "Immediate: " << immediate << " (" << immediateTransactions
+           << " transactions) Batched: " << batched << " (" << batchedTransactions << " transactions)");
+}
@@ -0,0 +1,153 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/Test/ToolBin.hxx>
+#include <runmanager/lib/RunManager.hpp>
+#include <runmanager/lib/RubyJobUtils.hpp>
+#include <runmanager/lib/RubyWorkerPool.hpp>
+
+#include <utilities/core/ApplicationPathHelpers.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <resources.hxx>
+
+using namespace openstudio;
+
+
+TEST_F(RunManagerTestFixture, RubyWorkerPool)
+{
+  // two workers, each recycled after two jobs
+  openstudio::runmanager::RunManager::setRubyWorkerPool(2, 2);
+
+  openstudio::runmanager::RunManager rm;
+  openstudio::path rubyscriptfile = resourcesPath() / openstudio::toPath("runmanager/create_os_result_success.rb");
+
+  openstudio::runmanager::Tools tools 
+    = openstudio::runmanager::ConfigOptions::makeTools(energyPlusExePath().parent_path(), openstudio::path(), openstudio::path(), 
+        rubyExePath().parent_path(), openstudio::path(),
+        openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path());
+
+  std::vector<openstudio::runmanager::Job> jobs;
+
+  for (int i = 0; i < 5; ++i)
+  {
+    openstudio::runmanager::Workflow wf;
+    openstudio::runmanager::RubyJobBuilder rubyjobbuilder;
+    rubyjobbuilder.setScriptFile(rubyscriptfile);
+    rubyjobbuilder.setIncludeDir(getOpenStudioRubyIncludePath());
+    rubyjobbuilder.addToWorkflow(wf);
+    wf.add(tools);
+
+    openstudio::path outdir = openstudio::tempDir() / openstudio::toPath("RubyWorkerPoolTest") 
+      / openstudio::toPath(boost::lexical_cast<std::string>(i));
+    boost::filesystem::remove_all(outdir); // Clean up test dir before starting
+
+    openstudio::runmanager::Job j = wf.create(outdir);
+    rm.enqueue(j, true);
+    jobs.push_back(j);
+  }
+
+  rm.waitForFinished();
+
+  for (std::vector<openstudio::runmanager::Job>::const_iterator itr = jobs.begin();
+       itr != jobs.end();
+       ++itr)
+  {
+    openstudio::runmanager::JobErrors e = itr->errors();
+    EXPECT_EQ(openstudio::ruleset::OSResultValue(openstudio::ruleset::OSResultValue::Success), e.result);
+    EXPECT_EQ(0u, e.allErrors.size());
+  }
+
+  std::map<std::string, double> stats = openstudio::runmanager::detail::RubyWorkerPool::instance().statistics();
+
+#ifdef Q_WS_WIN
+  EXPECT_EQ(0, stats["Ruby Worker Jobs"]);
+#else
+  // every job either ran in a worker or fell back to its own ruby process
+  EXPECT_EQ(5, stats["Ruby Worker Jobs"] + stats["Ruby Worker Fallback Jobs"]);
+  EXPECT_LE(stats["Ruby Workers"], 2);
+  EXPECT_EQ(0, stats["Ruby Workers Busy"]);
+  EXPECT_GT(stats["Ruby Worker Jobs"], 0);
+#endif
+
+  openstudio::runmanager::RunManager::setRubyWorkerPool(0, 0);
+  EXPECT_FALSE(openstudio::runmanager::detail::RubyWorkerPool::instance().enabled());
+  EXPECT_EQ(0, openstudio::runmanager::detail::RubyWorkerPool::instance().statistics()["Ruby Workers"]);
+}
+
+TEST_F(RunManagerTestFixture, RubyWorkerPool_ToolStartError)
+{
+  // one worker, never recycled, so a lease that is not handed back blocks the next job
+  openstudio::runmanager::RunManager::setRubyWorkerPool(1, 0);
+  openstudio::runmanager::detail::RubyWorkerPool &pool = openstudio::runmanager::detail::RubyWorkerPool::instance();
+  std::map<std::string, double> before = pool.statistics();
+
+  openstudio::runmanager::RunManager rm;
+
+  openstudio::runmanager::Tools tools 
+    = openstudio::runmanager::ConfigOptions::makeTools(energyPlusExePath().parent_path(), openstudio::path(), openstudio::path(), 
+        rubyExePath().parent_path(), openstudio::path(),
+        openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path());
+
+  std::vector<openstudio::path> scripts;
+  // the ruby process cannot be created because its script is missing
+  scripts.push_back(openstudio::tempDir() / openstudio::toPath("RubyWorkerPoolToolStartError/missing.rb"));
+  scripts.push_back(resourcesPath() / openstudio::toPath("runmanager/create_os_result_success.rb"));
+
+  std::vector<openstudio::runmanager::Job> jobs;
+  for (unsigned i = 0; i < scripts.size(); ++i)
+  {
+    openstudio::runmanager::Workflow wf;
+    openstudio::runmanager::RubyJobBuilder rubyjobbuilder;
+    rubyjobbuilder.setScriptFile(scripts[i]);
+    rubyjobbuilder.setIncludeDir(getOpenStudioRubyIncludePath());
+    rubyjobbuilder.addToWorkflow(wf);
+    wf.add(tools);
+
+    openstudio::path outdir = openstudio::tempDir() / openstudio::toPath("RubyWorkerPoolToolStartError") 
+      / openstudio::toPath(boost::lexical_cast<std::string>(i));
+    boost::filesystem::remove_all(outdir);
+
+    openstudio::runmanager::Job j = wf.create(outdir);
+    rm.enqueue(j, true);
+    rm.waitForFinished();
+    jobs.push_back(j);
+
+    // the lease is handed back whether or not the tool started
+    EXPECT_EQ(0, pool.statistics()["Ruby Workers Busy"]);
+  }
+
+  EXPECT_EQ(openstudio::ruleset::OSResultValue(openstudio::ruleset::OSResultValue::Fail), jobs[0].errors().result);
+  EXPECT_EQ(openstudio::ruleset::OSResultValue(openstudio::ruleset::OSResultValue::Success), jobs[1].errors().result);
+
+  std::map<std::string, double> after = pool.statistics();
+#ifndef Q_WS_WIN
+  // the second job reused the worker leased by the first instead of falling back
+  EXPECT_EQ(2, after["Ruby Worker Jobs"] - before["Ruby Worker Jobs"]);
+  EXPECT_EQ(before["Ruby Worker Fallback Jobs"], after["Ruby Worker Fallback Jobs"]);
+  EXPECT_EQ(1, after["Ruby Worker Starts"] - before["Ruby Worker Starts"]);
+#endif
+
+  openstudio::runmanager::RunManager::setRubyWorkerPool(0, 0);
+}
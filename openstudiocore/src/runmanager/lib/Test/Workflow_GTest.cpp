@@ -362,6 +362,43 @@ TEST_F(RunManagerTestFixture, Workflow_ToWorkItemsFailed)
   EXPECT_THROW(wf2.toWorkItems(), std::runtime_error);
 }
 
+TEST_F(RunManagerTestFixture, Workflow_FusePreProcessing)
+{
+  Workflow wf;
+  wf.addJob(JobType::ModelToIdf);
+  wf.addJob(JobType::ExpandObjects);
+  wf.addJob(JobType::EnergyPlusPreProcess);
+  wf.addJob(JobType::EnergyPlus);
+
+  wf.fusePreProcessing();
+
+  std::vector<WorkItem> wis = wf.toWorkItems();
+  ASSERT_EQ(2u, wis.size());
+  EXPECT_EQ(JobType(JobType::ModelToIdf), wis[0].type);
+  EXPECT_TRUE(wis[0].params.has("fuseExpandObjects"));
+  EXPECT_TRUE(wis[0].params.has("fuseEnergyPlusPreProcess"));
+  EXPECT_EQ(JobType(JobType::EnergyPlus), wis[1].type);
+
+  // jobs between ExpandObjects and EnergyPlusPreProcess keep the preprocess job separate
+  Workflow wf2;
+  wf2.addJob(JobType::ModelToIdf);
+  wf2.addJob(JobType::ExpandObjects);
+  wf2.addJob(JobType::Null);
+  wf2.addJob(JobType::EnergyPlusPreProcess);
+  wf2.addJob(JobType::EnergyPlus);
+
+  wf2.fusePreProcessing();
+
+  wis = wf2.toWorkItems();
+  ASSERT_EQ(4u, wis.size());
+  EXPECT_EQ(JobType(JobType::ModelToIdf), wis[0].type);
+  EXPECT_TRUE(wis[0].params.has("fuseExpandObjects"));
+  EXPECT_FALSE(wis[0].params.has("fuseEnergyPlusPreProcess"));
+  EXPECT_EQ(JobType(JobType::Null), wis[1].type);
+  EXPECT_EQ(JobType(JobType::EnergyPlusPreProcess), wis[2].type);
+  EXPECT_EQ(JobType(JobType::EnergyPlus), wis[3].type);
+}
+
 TEST_F(RunManagerTestFixture, Workflow_AddWorkItem)
 {
   WorkItem wi(JobType::Null);
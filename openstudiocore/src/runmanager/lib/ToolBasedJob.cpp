@@ -737,6 +737,8 @@ namespace detail {
 
   void ToolBasedJob::handleToolStartError(const std::exception &e)
   {
+    toolStartErrorHandlerImpl();
+
     QWriteLocker l(&m_mutex);
     std::vector<std::pair<ErrorType, std::string> > err;
     err.push_back(std::make_pair(ErrorType::Error, e.what()));
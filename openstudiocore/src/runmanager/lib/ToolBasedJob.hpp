@@ -146,6 +146,10 @@ namespace detail {
       /// Called internally when all tools have finished executing.
       virtual void endHandlerImpl() {}
 
+      /// Called internally when a tool could not be started. The job may end without
+      /// endHandlerImpl being called, so resources taken in startHandlerImpl are released here.
+      virtual void toolStartErrorHandlerImpl() {}
+
       /// Lets derived class notify base of parameters to send to process
       void addParameter(const std::string &t_toolname, const std::string &t_param);
 
@@ -961,5 +961,48 @@ namespace runmanager {
     }
   }
 
+  void Workflow::fusePreProcessing()
+  {
+    std::vector<WorkItem> workitems;
+
+    try {
+      workitems = toWorkItems();
+    } catch (const std::exception &) {
+      throw std::runtime_error("The fusePreProcessing process only works with linear workflows");
+    }
+
+    Workflow newwf;
+    newwf.m_uuid = m_uuid;
+    newwf.m_workflowName = m_workflowName;
+
+    for (size_t i = 0; i < workitems.size(); ++i)
+    {
+      WorkItem workitem = workitems[i];
+
+      if (workitem.type == JobType::ModelToIdf)
+      {
+        if (i + 1 < workitems.size() && workitems[i + 1].type == JobType::ExpandObjects)
+        {
+          ++i;
+          workitem.tools.append(workitems[i].tools);
+          workitem.files.append(workitems[i].files);
+          workitem.params.append(JobParam("fuseExpandObjects"));
+        }
+
+        if (i + 1 < workitems.size() && workitems[i + 1].type == JobType::EnergyPlusPreProcess)
+        {
+          ++i;
+          workitem.tools.append(workitems[i].tools);
+          workitem.files.append(workitems[i].files);
+          workitem.params.append(JobParam("fuseEnergyPlusPreProcess"));
+        }
+      }
+
+      newwf.addJob(workitem);
+    }
+
+    swap(newwf);
+  }
+
 }
 }
@@ -398,6 +398,12 @@ namespace runmanager {
       /// \param[in] t_offset 
       void parallelizeEnergyPlus(int t_numSplits, int t_offset);
 
+      /// Folds any ExpandObjects and EnergyPlusPreProcess jobs directly following a ModelToIdf job
+      /// into the ModelToIdf job, which then applies them to the translated Workspace in memory and
+      /// writes only the final in.idf. ExpandObjects is only run if the idf contains objects to expand.
+      /// Jobs separated from the ModelToIdf job by other jobs, such as idf scripts, are left alone.
+      void fusePreProcessing();
+
     private:
       REGISTER_LOGGER("openstudio.runmanager.Workflow");
 
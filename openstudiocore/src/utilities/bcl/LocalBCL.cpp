@@ -30,6 +30,7 @@
 
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QIcon>
 #include <QInputDialog>
 #include <QSettings>
@@ -42,17 +43,65 @@
 #include <boost/lexical_cast.hpp>
 
 #include <algorithm>
+#include <iterator>
 #include <set>
 #include <vector>
 
 namespace openstudio{
 
+  namespace {
+
+    // directory mtime catches added or removed files, xml mtime catches edits in place
+    QDateTime lastModified(const openstudio::path& dir, const std::string& xmlName)
+    {
+      QFileInfo dirInfo(toQString(dir));
+      if (!dirInfo.exists()){
+        return QDateTime();
+      }
+      QDateTime result = dirInfo.lastModified();
+      QDateTime xmlModified = QFileInfo(toQString(dir / toPath(xmlName))).lastModified();
+      if (xmlModified > result){
+        result = xmlModified;
+      }
+      return result;
+    }
+
+    // lower case words, anything other than a letter or number is a separator
+    std::vector<std::string> searchTokens(const std::string& text)
+    {
+      std::vector<std::string> result;
+      QString word;
+      Q_FOREACH(const QChar& c, toQString(text).toLower()){
+        if (c.isLetterOrNumber()){
+          word.append(c);
+        }else if (!word.isEmpty()){
+          result.push_back(toString(word));
+          word.clear();
+        }
+      }
+      if (!word.isEmpty()){
+        result.push_back(toString(word));
+      }
+      return result;
+    }
+
+    void addToIndex(std::map<std::string, std::set<std::pair<std::string, std::string> > >& index,
+                    const std::pair<std::string, std::string>& uidVersion,
+                    const std::string& text)
+    {
+      Q_FOREACH(const std::string& token, searchTokens(text)){
+        index[token].insert(uidVersion);
+      }
+    }
+
+  }
+
   boost::shared_ptr<LocalBCL> LocalBCL::ptr;
 
   LocalBCL::LocalBCL(const path& libraryPath):
     m_libraryPath(QDir().cleanPath(toQString(libraryPath))),
     m_dbName(QString("/components.sql")),
-    dbVersion("1.3")
+    dbVersion("1.4")
   {
     //Make sure a QApplication exists
     openstudio::Application::instance().application();
@@ -156,6 +205,7 @@ namespace openstudio{
         "value VARCHAR, units VARCHAR, type VARCHAR)");
       success = success && query.exec("CREATE TABLE Measures (uid VARCHAR, version_id VARCHAR, name VARCHAR, "
         "description VARCHAR, modeler_description VARCHAR, date_added DATETIME, date_modified DATETIME)");
+      success = success && query.exec("CREATE TABLE Tags (uid VARCHAR, version_id VARCHAR, tag VARCHAR)");
       query.prepare("INSERT INTO Settings VALUES (:name, :data)");
       query.bindValue(":name", "dbVersion");
       query.bindValue(":data", dbVersion);
@@ -259,6 +309,39 @@ namespace openstudio{
         success = success && query.exec("ALTER TABLE Files ADD checksum VARCHAR");
 
         success = success && query.exec("CREATE TABLE Measures (uid VARCHAR, version_id VARCHAR, name VARCHAR, description VARCHAR, modeler_description VARCHAR, date_added DATETIME, date_modified DATETIME)");
+        success = success && query.exec("CREATE TABLE Tags (uid VARCHAR, version_id VARCHAR, tag VARCHAR)");
+
+        query.prepare("UPDATE Settings SET data = :dbVersion WHERE name = 'dbVersion'");
+        query.bindValue(":dbVersion", dbVersion);
+        success = success && query.exec();
+        return success;
+      }
+    }
+
+    // 1.3 -> 1.4
+    success = query.exec("SELECT data FROM Settings WHERE name='dbVersion'");
+    if (success && query.next())
+    {
+      QString localDbVersion = query.value(0).toString();
+      if (localDbVersion == "1.3")
+      {
+        success = success && query.exec("CREATE TABLE Tags (uid VARCHAR, version_id VARCHAR, tag VARCHAR)");
+
+        // tags were previously only stored in measure.xml
+        success = success && query.exec("SELECT uid, version_id FROM Measures");
+        QSqlQuery queryLoop(*m_qSqlDatabase);
+        queryLoop.prepare("INSERT INTO Tags (uid, version_id, tag) VALUES (:uid, :versionId, :tag)");
+        while (query.next()) {
+          boost::optional<BCLMeasure> measure = BCLMeasure::load(toPath(m_libraryPath) / toPath(query.value(0).toString()) / toPath(query.value(1).toString()));
+          if (measure) {
+            Q_FOREACH(const std::string& tag, measure->tags()) {
+              queryLoop.bindValue(":uid", query.value(0));
+              queryLoop.bindValue(":versionId", query.value(1));
+              queryLoop.bindValue(":tag", toQString(tag));
+              success = success && queryLoop.exec();
+            }
+          }
+        }
 
         query.prepare("UPDATE Settings SET data = :dbVersion WHERE name = 'dbVersion'");
         query.bindValue(":dbVersion", dbVersion);
@@ -280,14 +363,14 @@ namespace openstudio{
       query.exec(QString("SELECT version_id FROM Components WHERE uid='%1'").arg(escape(uid)));
       if (query.next())
       {
-        return boost::optional<BCLComponent>(toString(m_libraryPath) + "/" + uid + "/" + toString(query.value(0).toString()));
+        return cachedComponent(uid, toString(query.value(0).toString()));
       }
       return boost::none;
     }
     query.exec(QString("SELECT version_id FROM Components WHERE uid='%1' AND version_id='%2'").arg(escape(uid), escape(versionId)));
     if (query.next())
     {
-      return boost::optional<BCLComponent>(toString(m_libraryPath) + "/" + uid + "/" + versionId);
+      return cachedComponent(uid, versionId);
     }
     return boost::none;
   }
@@ -300,20 +383,14 @@ namespace openstudio{
       query.exec(QString("SELECT version_id FROM Measures WHERE uid='%1'").arg(escape(uid)));
       if (query.next())
       {
-        try{
-          return boost::optional<BCLMeasure>(toPath(m_libraryPath) / toPath(uid) / toPath(toString(query.value(0).toString())));
-        }catch(const std::exception&){
-        }
+        return cachedMeasure(uid, toString(query.value(0).toString()));
       }
       return boost::none;
     }
     query.exec(QString("SELECT version_id FROM Measures WHERE uid='%1' AND version_id='%2'").arg(escape(uid), escape(versionId)));
     if (query.next())
     {
-      try{
-        return boost::optional<BCLMeasure>(toPath(m_libraryPath) / toPath(uid) / toPath(versionId));
-      }catch(const std::exception&){
-      }
+      return cachedMeasure(uid, versionId);
     }
     return boost::none;
   }
@@ -361,11 +438,7 @@ namespace openstudio{
     while (query.next())
     {
       // DLM: this does not look like it is handling error of missing file correctly
-      boost::optional<BCLComponent> current(toString(toPath(m_libraryPath) / toPath(query.value(0).toString()) / toPath(query.value(1).toString())));
-      if (current)
-      {
-        allComponents.push_back(*current);
-      }
+      allComponents.push_back(cachedComponent(toString(query.value(0).toString()), toString(query.value(1).toString())));
     }
     return allComponents;
   }
@@ -377,7 +450,7 @@ namespace openstudio{
     query.exec("SELECT uid, version_id FROM Measures");
     while (query.next())
     {
-      boost::optional<BCLMeasure> current = BCLMeasure::load(toPath(m_libraryPath) / toPath(query.value(0).toString()) / toPath(query.value(1).toString()));
+      boost::optional<BCLMeasure> current = cachedMeasure(toString(query.value(0).toString()), toString(query.value(1).toString()));
       if (current)
       {
         allMeasures.push_back(*current);
@@ -402,16 +475,10 @@ namespace openstudio{
     const std::string& componentType) const 
   {
     std::vector<BCLComponent> results;
-    QSqlQuery query(*m_qSqlDatabase);
-    query.exec(toQString("SELECT uid, version_id FROM Components where name LIKE \"%"+searchTerm+"%\" OR description LIKE \"%"+searchTerm+"%\""));
-    while (query.next())
+    Q_FOREACH(const UidVersion& uidVersion, searchIndex(searchTerm, "component"))
     {
       // DLM: this does not look like it is handling error of missing file correctly
-      boost::optional<BCLComponent> current(toString(toPath(m_libraryPath) / toPath(query.value(0).toString()) / toPath(query.value(1).toString())));
-      if (current)
-      {
-        results.push_back(*current);
-      }
+      results.push_back(cachedComponent(uidVersion.first, uidVersion.second));
     }
     return results;
   }
@@ -426,12 +493,9 @@ namespace openstudio{
     const std::string& componentType) const 
   {
     std::vector<BCLMeasure> results;
-    QSqlQuery query(*m_qSqlDatabase);
-    query.exec(toQString("SELECT uid, version_id FROM Measures where name LIKE \"%"+searchTerm+"%\""
-      "OR description LIKE \"%"+searchTerm+"%\" OR modeler_description LIKE \"%"+searchTerm+"%\""));
-    while (query.next())
+    Q_FOREACH(const UidVersion& uidVersion, searchIndex(searchTerm, "measure"))
     {
-      boost::optional<BCLMeasure> current = BCLMeasure::load(toPath(m_libraryPath) / toPath(query.value(0).toString()) / toPath(query.value(1).toString()));
+      boost::optional<BCLMeasure> current = cachedMeasure(uidVersion.first, uidVersion.second);
       if (current)
       {
         results.push_back(*current);
@@ -454,6 +518,9 @@ namespace openstudio{
     //Check for uid
     if (!component.uid().empty() && !component.versionId().empty())
     {
+      invalidateSearchIndex();
+      m_componentCache.erase(UidVersion(component.uid(), component.versionId()));
+
       if (!query.exec(QString("DELETE FROM Components WHERE uid='%1' AND version_id='%2'").arg(
         escape(component.uid()), escape(component.versionId()))))
         return false;
@@ -532,6 +599,9 @@ namespace openstudio{
     }
     removeDirectory(pathToRemove);
 
+    invalidateSearchIndex();
+    m_componentCache.erase(UidVersion(component.uid(), component.versionId()));
+
     QSqlQuery query(*m_qSqlDatabase);
     bool test = query.exec(QString("DELETE FROM Components WHERE uid='%1' AND version_id='%2'").arg(escape(component.uid()),
       escape(component.versionId())));
@@ -554,6 +624,9 @@ namespace openstudio{
     //Check for uid
     if (!measure.uid().empty() && !measure.versionId().empty())
     {
+      invalidateSearchIndex();
+      m_measureCache.erase(UidVersion(measure.uid(), measure.versionId()));
+
       if (!query.exec(QString("DELETE FROM Measures WHERE uid='%1' AND version_id='%2'").arg(
         escape(measure.uid()), escape(measure.versionId()))))
         return false;
@@ -579,6 +652,17 @@ namespace openstudio{
         }
       }
 
+      //Insert tags
+      if (!query.exec(QString("DELETE FROM Tags WHERE uid='%1' AND version_id='%2'").arg(
+          escape(measure.uid()), escape(measure.versionId()))))
+          return false;
+      Q_FOREACH(const std::string& tag, measure.tags())
+      {
+        if (!query.exec(QString("INSERT INTO Tags (uid, version_id, tag) VALUES('%1', '%2', '%3')").arg(
+          escape(measure.uid()), escape(measure.versionId()), escape(tag))))
+          return false;
+      }
+
       //Insert attributes
       if (!query.exec(QString("DELETE FROM Attributes WHERE uid='%1' AND version_id='%2'").arg(
           escape(measure.uid()), escape(measure.versionId()))))
@@ -632,11 +716,18 @@ namespace openstudio{
     }
     removeDirectory(pathToRemove);
 
+    invalidateSearchIndex();
+    m_measureCache.erase(UidVersion(measure.uid(), measure.versionId()));
+
     QSqlQuery query(*m_qSqlDatabase);
     bool test = query.exec(QString("DELETE FROM Measures WHERE uid='%1' AND version_id='%2'").arg(escape(measure.uid()),
       escape(measure.versionId())));
     OS_ASSERT(test);
 
+    test = query.exec(QString("DELETE FROM Tags WHERE uid='%1' AND version_id='%2'").arg(escape(measure.uid()),
+      escape(measure.versionId())));
+    OS_ASSERT(test);
+
     test = query.exec(QString("DELETE FROM Files WHERE uid='%1' AND version_id='%2'").arg(escape(measure.uid()),
       escape(measure.versionId())));
     OS_ASSERT(test);
@@ -753,6 +844,130 @@ namespace openstudio{
     return s;
   }
 
+  boost::optional<BCLMeasure> LocalBCL::cachedMeasure(const std::string& uid, const std::string& versionId) const
+  {
+    UidVersion key(uid, versionId);
+    openstudio::path dir = toPath(m_libraryPath) / toPath(uid) / toPath(versionId);
+    QDateTime modified = lastModified(dir, "measure.xml");
+    if (!modified.isValid()){
+      m_measureCache.erase(key);
+      return boost::none;
+    }
+
+    std::map<UidVersion, std::pair<QDateTime, BCLMeasure> >::const_iterator it = m_measureCache.find(key);
+    if (it != m_measureCache.end() && it->second.first == modified){
+      return it->second.second;
+    }
+
+    m_measureCache.erase(key);
+    boost::optional<BCLMeasure> result = BCLMeasure::load(dir);
+    if (result){
+      m_measureCache.insert(std::make_pair(key, std::make_pair(modified, *result)));
+    }
+    return result;
+  }
+
+  BCLComponent LocalBCL::cachedComponent(const std::string& uid, const std::string& versionId) const
+  {
+    UidVersion key(uid, versionId);
+    openstudio::path dir = toPath(m_libraryPath) / toPath(uid) / toPath(versionId);
+    QDateTime modified = lastModified(dir, "component.xml");
+    if (!modified.isValid()){
+      m_componentCache.erase(key);
+      return BCLComponent(toString(dir));
+    }
+
+    std::map<UidVersion, std::pair<QDateTime, BCLComponent> >::const_iterator it = m_componentCache.find(key);
+    if (it != m_componentCache.end() && it->second.first == modified){
+      return it->second.second;
+    }
+
+    m_componentCache.erase(key);
+    BCLComponent result(toString(dir));
+    m_componentCache.insert(std::make_pair(key, std::make_pair(modified, result)));
+    return result;
+  }
+
+  void LocalBCL::buildSearchIndex(SearchIndex& index, const std::string& componentType) const
+  {
+    index.clear();
+
+    QSqlQuery query(*m_qSqlDatabase);
+    if (componentType == "measure"){
+      query.exec("SELECT uid, version_id, name, description, modeler_description FROM Measures");
+    }else{
+      query.exec("SELECT uid, version_id, name, description, '' FROM Components");
+    }
+    while (query.next())
+    {
+      UidVersion uidVersion(toString(query.value(0).toString()), toString(query.value(1).toString()));
+      // every entry is indexed, even one without any words, so that an empty search returns it
+      index[std::string()].insert(uidVersion);
+      addToIndex(index, uidVersion, toString(query.value(2).toString()));
+      addToIndex(index, uidVersion, toString(query.value(3).toString()));
+      addToIndex(index, uidVersion, toString(query.value(4).toString()));
+    }
+
+    std::string tableName = componentType == "measure" ? "Measures" : "Components";
+    query.exec(toQString("SELECT a.uid, a.version_id, a.name, a.value FROM Attributes a INNER JOIN " + tableName +
+      " t ON a.uid = t.uid AND a.version_id = t.version_id"));
+    while (query.next())
+    {
+      UidVersion uidVersion(toString(query.value(0).toString()), toString(query.value(1).toString()));
+      addToIndex(index, uidVersion, toString(query.value(2).toString()));
+      addToIndex(index, uidVersion, toString(query.value(3).toString()));
+    }
+
+    if (componentType == "measure"){
+      query.exec("SELECT uid, version_id, tag FROM Tags");
+      while (query.next())
+      {
+        UidVersion uidVersion(toString(query.value(0).toString()), toString(query.value(1).toString()));
+        addToIndex(index, uidVersion, toString(query.value(2).toString()));
+      }
+    }
+  }
+
+  std::vector<std::pair<std::string, std::string> > LocalBCL::searchIndex(const std::string& searchTerm,
+    const std::string& componentType) const
+  {
+    boost::optional<SearchIndex>& index = (componentType == "measure") ? m_measureIndex : m_componentIndex;
+    if (!index){
+      index = SearchIndex();
+      buildSearchIndex(*index, componentType);
+    }
+
+    // the empty key holds every entry
+    std::set<UidVersion> result = (*index)[std::string()];
+
+    // each word of the search term must appear within some word of the entry, like the LIKE '%term%' search this replaces
+    Q_FOREACH(const std::string& token, searchTokens(searchTerm)){
+      std::set<UidVersion> matches;
+      for (SearchIndex::const_iterator it = index->begin(), itend = index->end(); it != itend; ++it){
+        if (it->first.find(token) != std::string::npos){
+          matches.insert(it->second.begin(), it->second.end());
+        }
+      }
+
+      std::set<UidVersion> intersection;
+      std::set_intersection(result.begin(), result.end(), matches.begin(), matches.end(),
+        std::inserter(intersection, intersection.begin()));
+      result.swap(intersection);
+
+      if (result.empty()){
+        break;
+      }
+    }
+
+    return std::vector<UidVersion>(result.begin(), result.end());
+  }
+
+  void LocalBCL::invalidateSearchIndex()
+  {
+    m_measureIndex.reset();
+    m_componentIndex.reset();
+  }
+
 
   bool LocalBCL::prodAuthKeyUserPrompt(QWidget* parent)
   {
@@ -24,11 +24,15 @@
 #include <utilities/core/Optional.hpp>
 #include <utilities/core/Path.hpp>
 
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
 
+#include <QDateTime>
+
 class QSqlDatabase;
 class QWidget;
 
@@ -158,6 +162,11 @@ namespace openstudio{
     //@}
   private:
 
+    typedef std::pair<std::string, std::string> UidVersion;
+
+    /// Maps each lower case word to the uid and version of every entry containing it
+    typedef std::map<std::string, std::set<UidVersion> > SearchIndex;
+
     /// private constructor
     LocalBCL(const path& libraryPath);
 
@@ -179,12 +188,32 @@ namespace openstudio{
 
     std::string formatString(double d, uint prec = 15);
 
+    /// Returns the measure from the metadata cache, measure.xml is only re-read if its directory has changed
+    boost::optional<BCLMeasure> cachedMeasure(const std::string& uid, const std::string& versionId) const;
+
+    /// Returns the component from the metadata cache, component.xml is only re-read if its directory has changed
+    BCLComponent cachedComponent(const std::string& uid, const std::string& versionId) const;
+
+    /// Builds the search index over name, description, tags and attributes of all components or measures
+    void buildSearchIndex(SearchIndex& index, const std::string& componentType) const;
+
+    /// Returns uid and version of all components or measures containing every word of searchTerm
+    std::vector<UidVersion> searchIndex(const std::string& searchTerm, const std::string& componentType) const;
+
+    /// Drops the search indices, they are rebuilt from the database on the next search
+    void invalidateSearchIndex();
+
     QString m_libraryPath;
     const QString m_dbName;
     QString dbVersion;
     boost::shared_ptr<QSqlDatabase> m_qSqlDatabase;
     std::string m_prodAuthKey;
     std::string m_devAuthKey;
+
+    mutable std::map<UidVersion, std::pair<QDateTime, BCLMeasure> > m_measureCache;
+    mutable std::map<UidVersion, std::pair<QDateTime, BCLComponent> > m_componentCache;
+    mutable boost::optional<SearchIndex> m_measureIndex;
+    mutable boost::optional<SearchIndex> m_componentIndex;
   };
 
 } // openstudio
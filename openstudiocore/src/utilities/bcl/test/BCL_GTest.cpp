@@ -33,6 +33,8 @@
 #include <QDir>
 #include <QFileInfo>
 
+#include <algorithm>
+
 #include <time.h>
 
 using namespace openstudio;
@@ -422,3 +424,50 @@ TEST_F(BCLFixture, RemoteBCLMetaSearchTest)
   }
   EXPECT_TRUE(result->taxonomyTerms().empty());
 }
+
+TEST_F(BCLFixture, LocalBCL_SearchMeasures)
+{
+  openstudio::path srcDir = resourcesPath() / toPath("/utilities/BCL/Measures/SetWindowToWallRatioByFacade/");
+  boost::optional<BCLMeasure> source = BCLMeasure::load(srcDir);
+  ASSERT_TRUE(source);
+
+  LocalBCL& localBCL = LocalBCL::instance();
+  boost::optional<BCLMeasure> existing = localBCL.getMeasure(source->uid(), source->versionId());
+  if (existing){
+    EXPECT_TRUE(localBCL.removeMeasure(*existing));
+  }
+
+  openstudio::path dir = toPath(localBCL.libraryPath()) / toPath(source->uid()) / toPath(source->versionId());
+  if (exists(dir)){
+    boost::filesystem::remove_all(dir);
+  }
+  boost::optional<BCLMeasure> measure = source->clone(dir);
+  ASSERT_TRUE(measure);
+  EXPECT_TRUE(localBCL.addMeasure(*measure));
+
+  // whole words, partial words and words in any order are found
+  std::vector<BCLMeasure> results = localBCL.searchMeasures("Facade", "");
+  EXPECT_FALSE(std::find(results.begin(), results.end(), *measure) == results.end());
+  results = localBCL.searchMeasures("ratio wall", "");
+  EXPECT_FALSE(std::find(results.begin(), results.end(), *measure) == results.end());
+  results = localBCL.searchMeasures("hand-edit", "");
+  EXPECT_FALSE(std::find(results.begin(), results.end(), *measure) == results.end());
+
+  // tags are indexed too
+  results = localBCL.searchMeasures("envelope", "");
+  EXPECT_FALSE(std::find(results.begin(), results.end(), *measure) == results.end());
+  results = localBCL.searchMeasures("Facade NotAWordInThisMeasure", "");
+  EXPECT_TRUE(std::find(results.begin(), results.end(), *measure) == results.end());
+
+  // repeated lookups come from the metadata cache but still reflect the measure on disk
+  std::vector<BCLMeasure> measures = localBCL.measures();
+  EXPECT_FALSE(std::find(measures.begin(), measures.end(), *measure) == measures.end());
+  existing = localBCL.getMeasure(measure->uid(), measure->versionId());
+  ASSERT_TRUE(existing);
+  EXPECT_EQ(measure->name(), existing->name());
+
+  EXPECT_TRUE(localBCL.removeMeasure(*measure));
+  EXPECT_FALSE(localBCL.getMeasure(measure->uid(), measure->versionId()));
+  results = localBCL.searchMeasures("Facade", "");
+  EXPECT_TRUE(std::find(results.begin(), results.end(), *measure) == results.end());
+}
@@ -57,6 +57,8 @@ namespace openstudio{
         m_lastQueuedDataPointUUIDs(),
         m_lastRunningDataPointUUIDs(),
         m_lastCompleteDataPointUUIDs(),
+        m_lastDownloadReadyDataPointUUIDs(),
+        m_lastAnalysisStatusSuccess(false),
         m_lastDataPointJSON(),
         m_lastDownloadDataPointSuccess(false),
         m_errors(),
@@ -356,6 +358,21 @@ namespace openstudio{
       return m_lastDownloadReadyDataPointUUIDs;
     }
 
+    bool OSServer_Impl::analysisStatus(const UUID& analysisUUID, int msec)
+    {
+      if (requestAnalysisStatus(analysisUUID)){
+        if (waitForFinished(msec)){
+          return lastAnalysisStatusSuccess();
+        }
+      }
+      return false;
+    }
+
+    bool OSServer_Impl::lastAnalysisStatusSuccess() const
+    {
+      return m_lastAnalysisStatusSuccess;
+    }
+
     std::string OSServer_Impl::dataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID, int msec)
     {
       if (requestDataPointJSON(analysisUUID, dataPointUUID)){
@@ -918,6 +935,33 @@ namespace openstudio{
       return true;
     }
 
+    bool OSServer_Impl::requestAnalysisStatus(const UUID& analysisUUID)
+    {
+      clearErrorsAndWarnings();
+
+      m_lastAnalysisStatusSuccess = false;
+      m_lastIsAnalysisRunning = false;
+      m_lastDataPointUUIDs.clear();
+      m_lastQueuedDataPointUUIDs.clear();
+      m_lastRunningDataPointUUIDs.clear();
+      m_lastCompleteDataPointUUIDs.clear();
+      m_lastDownloadReadyDataPointUUIDs.clear();
+
+      if (!m_mutex->tryLock()){
+        return false;
+      }
+
+      QString id = toQString(removeBraces(analysisUUID));
+      QUrl url(m_url.toString().append("/analyses/").append(id).append("/status.json"));
+      QNetworkRequest request(url);
+      m_networkReply = m_networkAccessManager->get(request);
+
+      bool test = QObject::connect(m_networkReply, SIGNAL(finished()), this, SLOT(processAnalysisStatus()));
+      OS_ASSERT(test);
+
+      return true;
+    }
+
     bool OSServer_Impl::requestDataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID)
     {
       clearErrorsAndWarnings();
@@ -1574,6 +1618,85 @@ namespace openstudio{
       emit requestProcessed(success);
     }
 
+    void OSServer_Impl::processAnalysisStatus()
+    {
+      bool success = false;
+
+      logNetworkReply("processAnalysisStatus");
+
+      if (m_networkReply->error() == QNetworkReply::NoError){
+
+        bool test;
+        QJson::Parser parser;
+        QVariant variant = parser.parse(m_networkReply, &test);
+
+        if (test){
+
+          QVariantMap map = variant.toMap();
+          if (map.contains("analysis") && map.contains("data_points")){
+
+            success = true;
+
+            // possible status are 'queued', 'started', 'completed'
+            QVariantMap analysisMap = map["analysis"].toMap();
+            m_lastIsAnalysisRunning = (analysisMap["status"].toString() == "started");
+
+            // each data point is reported as {"_id": ..., "status": ..., "download_status": ...}
+            Q_FOREACH(const QVariant& dataPointVariant, map["data_points"].toList()){
+              QVariantMap dataPointMap = dataPointVariant.toMap();
+              if (!dataPointMap.contains("_id")){
+                success = false;
+                break;
+              }
+
+              UUID uuid(dataPointMap["_id"].toString());
+              m_lastDataPointUUIDs.push_back(uuid);
+
+              QString status = dataPointMap["status"].toString();
+              if (status == "queued"){
+                m_lastQueuedDataPointUUIDs.push_back(uuid);
+              }else if (status == "started"){
+                m_lastRunningDataPointUUIDs.push_back(uuid);
+              }else if (status == "completed"){
+                m_lastCompleteDataPointUUIDs.push_back(uuid);
+              }
+
+              if (dataPointMap["download_status"].toString() == "completed"){
+                m_lastDownloadReadyDataPointUUIDs.push_back(uuid);
+              }
+            }
+
+            if (!success){
+              m_lastIsAnalysisRunning = false;
+              m_lastDataPointUUIDs.clear();
+              m_lastQueuedDataPointUUIDs.clear();
+              m_lastRunningDataPointUUIDs.clear();
+              m_lastCompleteDataPointUUIDs.clear();
+              m_lastDownloadReadyDataPointUUIDs.clear();
+              logError("Incorrect JSON response");
+            }
+
+          }else{
+            logError("Incorrect JSON response");
+          }
+
+        }else{
+          logError("Could not parse JSON response");
+        }
+      }else{
+        logNetworkError(m_networkReply->error());
+      }
+
+      m_lastAnalysisStatusSuccess = success;
+
+      m_networkReply->deleteLater();
+      m_networkReply = 0;
+
+      m_mutex->unlock();
+
+      emit requestProcessed(success);
+    }
+
     void OSServer_Impl::processDataPointJSON()
     {
       bool success = false;
@@ -1991,6 +2114,16 @@ namespace openstudio{
     return getImpl<detail::OSServer_Impl>()->lastDownloadReadyDataPointUUIDs();
   }
 
+  bool OSServer::analysisStatus(const UUID& analysisUUID, int msec)
+  {
+    return getImpl<detail::OSServer_Impl>()->analysisStatus(analysisUUID, msec);
+  }
+
+  bool OSServer::lastAnalysisStatusSuccess() const
+  {
+    return getImpl<detail::OSServer_Impl>()->lastAnalysisStatusSuccess();
+  }
+
   std::string OSServer::dataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID, int msec) 
   {
     return getImpl<detail::OSServer_Impl>()->dataPointJSON(analysisUUID, dataPointUUID, msec);
@@ -2116,6 +2249,11 @@ namespace openstudio{
     return getImpl<detail::OSServer_Impl>()->requestDownloadReadyDataPointUUIDs(analysisUUID);
   }
 
+  bool OSServer::requestAnalysisStatus(const UUID& analysisUUID)
+  {
+    return getImpl<detail::OSServer_Impl>()->requestAnalysisStatus(analysisUUID);
+  }
+
   bool OSServer::requestDataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID) 
   {
     return getImpl<detail::OSServer_Impl>()->requestDataPointJSON(analysisUUID, dataPointUUID);
@@ -108,6 +108,15 @@ namespace openstudio{
     std::vector<UUID> downloadReadyDataPointUUIDs(const UUID& analysisUUID, int msec=30000);
     std::vector<UUID> lastDownloadReadyDataPointUUIDs() const;
 
+    /** Retrieves the status of the analysis and all of its data points in one round trip. On
+     *  success, lastIsAnalysisRunning(), lastDataPointUUIDs(), lastQueuedDataPointUUIDs(),
+     *  lastRunningDataPointUUIDs(), lastCompleteDataPointUUIDs() and
+     *  lastDownloadReadyDataPointUUIDs() are all set from the same server reply. Requires a
+     *  server that implements "/analyses/<id>/status.json" with data point and download
+     *  status; the current OpenStudio server does not. */
+    bool analysisStatus(const UUID& analysisUUID, int msec=30000);
+    bool lastAnalysisStatusSuccess() const;
+
     std::string dataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID, int msec=30000);
     std::string lastDataPointJSON() const;
 
@@ -160,6 +169,8 @@ namespace openstudio{
 
     bool requestDownloadReadyDataPointUUIDs(const UUID& analysisUUID);
 
+    bool requestAnalysisStatus(const UUID& analysisUUID);
+
     bool requestDataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID);
 
     bool startDownloadDataPoint(const UUID& analysisUUID, const UUID& dataPointUUID, const openstudio::path& downloadPath);
@@ -115,6 +115,9 @@ namespace detail{
     std::vector<UUID> downloadReadyDataPointUUIDs(const UUID& analysisUUID, int msec);
     std::vector<UUID> lastDownloadReadyDataPointUUIDs() const;
 
+    bool analysisStatus(const UUID& analysisUUID, int msec);
+    bool lastAnalysisStatusSuccess() const;
+
     std::string dataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID, int msec);
     std::string lastDataPointJSON() const;
 
@@ -167,6 +170,8 @@ namespace detail{
 
     bool requestDownloadReadyDataPointUUIDs(const UUID& analysisUUID);
 
+    bool requestAnalysisStatus(const UUID& analysisUUID);
+
     bool requestDataPointJSON(const UUID& analysisUUID, const UUID& dataPointUUID);
 
     bool startDownloadDataPoint(const UUID& analysisUUID, const UUID& dataPointUUID, const openstudio::path& downloadPath);
@@ -229,6 +234,8 @@ namespace detail{
 
     void processDownloadReadyDataPointUUIDs();
 
+    void processAnalysisStatus();
+
     void processDataPointJSON();
 
     void processDownloadDataPointComplete();
@@ -258,6 +265,7 @@ namespace detail{
     std::vector<UUID> m_lastRunningDataPointUUIDs;
     std::vector<UUID> m_lastCompleteDataPointUUIDs;
     std::vector<UUID> m_lastDownloadReadyDataPointUUIDs;
+    bool m_lastAnalysisStatusSuccess;
     std::string m_lastDataPointJSON;
     bool m_lastDownloadDataPointSuccess;
     path m_lastDownloadDataPointPath;
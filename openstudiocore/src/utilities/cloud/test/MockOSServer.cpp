@@ -0,0 +1,355 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/cloud/test/MockOSServer.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QStringList>
+#include <QUrl>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+
+MockOSServer::MockOSServer(const openstudio::UUID& analysisUUID,
+                           unsigned numDataPoints,
+                           int responseDelayMsec)
+  : m_server(new QTcpServer(this)),
+    m_analysisUUID(analysisUUID),
+    m_analysisStatus("queued"),
+    m_responseDelayMsec(responseDelayMsec),
+    m_numStatusRequestsSinceStart(0),
+    m_numRequests(0),
+    m_maxConcurrentRequests(0),
+    m_numPendingDataPointRequests(0),
+    m_maxConcurrentDataPointRequests(0)
+{
+  for (unsigned i = 0; i < numDataPoints; ++i) {
+    openstudio::UUID uuid = openstudio::createUUID();
+    m_dataPointUUIDs.push_back(uuid);
+    DataPointState state;
+    state.posted = true;
+    state.status = "queued";
+    m_dataPointStates[uuid] = state;
+  }
+
+  listen();
+}
+
+MockOSServer::MockOSServer(const openstudio::UUID& projectUUID,
+                           const openstudio::UUID& analysisUUID,
+                           const std::vector<openstudio::UUID>& dataPointUUIDs,
+                           int responseDelayMsec)
+  : m_server(new QTcpServer(this)),
+    m_projectUUID(projectUUID),
+    m_analysisUUID(analysisUUID),
+    m_analysisStatus("queued"),
+    m_dataPointUUIDs(dataPointUUIDs),
+    m_responseDelayMsec(responseDelayMsec),
+    m_numStatusRequestsSinceStart(0),
+    m_numRequests(0),
+    m_maxConcurrentRequests(0),
+    m_numPendingDataPointRequests(0),
+    m_maxConcurrentDataPointRequests(0)
+{
+  BOOST_FOREACH(const openstudio::UUID& uuid,m_dataPointUUIDs) {
+    DataPointState state;
+    state.posted = false;
+    state.status = "queued";
+    m_dataPointStates[uuid] = state;
+  }
+
+  listen();
+}
+
+MockOSServer::~MockOSServer()
+{}
+
+openstudio::Url MockOSServer::url() const {
+  if (!m_server->isListening()) {
+    return openstudio::Url();
+  }
+  return openstudio::Url(QString("http://127.0.0.1:%1").arg(m_server->serverPort()));
+}
+
+openstudio::UUID MockOSServer::analysisUUID() const {
+  return m_analysisUUID;
+}
+
+std::vector<openstudio::UUID> MockOSServer::dataPointUUIDs() const {
+  return m_dataPointUUIDs;
+}
+
+void MockOSServer::setAnalysisStatus(const std::string& status) {
+  m_analysisStatus = status;
+}
+
+void MockOSServer::setDataPointStatus(const openstudio::UUID& dataPointUUID,
+                                      const std::string& status,
+                                      const std::string& downloadStatus)
+{
+  std::map<openstudio::UUID,DataPointState>::iterator it = m_dataPointStates.find(dataPointUUID);
+  OS_ASSERT(it != m_dataPointStates.end());
+  it->second.status = status;
+  it->second.downloadStatus = downloadStatus;
+}
+
+void MockOSServer::completeDataPointsAfter(unsigned numStatusRequests) {
+  m_completeAfterStatusRequests = numStatusRequests;
+}
+
+unsigned MockOSServer::numRequests() const {
+  return m_numRequests;
+}
+
+unsigned MockOSServer::numRequests(const std::string& resource) const {
+  std::map<QString,unsigned>::const_iterator it = m_requestCounts.find(QString::fromStdString(resource));
+  if (it == m_requestCounts.end()) {
+    return 0u;
+  }
+  return it->second;
+}
+
+unsigned MockOSServer::maxConcurrentRequests() const {
+  return m_maxConcurrentRequests;
+}
+
+unsigned MockOSServer::maxConcurrentDataPointRequests() const {
+  return m_maxConcurrentDataPointRequests;
+}
+
+void MockOSServer::acceptConnection() {
+  while (m_server->hasPendingConnections()) {
+    QTcpSocket* socket = m_server->nextPendingConnection();
+    bool test = connect(socket,SIGNAL(readyRead()),this,SLOT(readRequest()));
+    OS_ASSERT(test);
+    test = connect(socket,SIGNAL(disconnected()),socket,SLOT(deleteLater()));
+    OS_ASSERT(test);
+  }
+}
+
+void MockOSServer::readRequest() {
+  QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+  OS_ASSERT(socket);
+
+  QByteArray& buffer = m_partialRequests[socket];
+  buffer.append(socket->readAll());
+
+  int headerEnd = buffer.indexOf("\r\n\r\n");
+  if (headerEnd < 0) {
+    return;
+  }
+
+  // posts carry a body, which is complete once Content-Length bytes follow the headers
+  int contentLength = 0;
+  QList<QByteArray> headers = buffer.left(headerEnd).split('\n');
+  BOOST_FOREACH(const QByteArray& header,headers) {
+    if (header.toLower().startsWith("content-length:")) {
+      contentLength = header.mid(15).trimmed().toInt();
+    }
+  }
+  if (buffer.size() < headerEnd + 4 + contentLength) {
+    return;
+  }
+
+  QList<QByteArray> requestLine = buffer.left(buffer.indexOf("\r\n")).split(' ');
+  QByteArray body = buffer.mid(headerEnd + 4,contentLength);
+  m_partialRequests.erase(socket);
+
+  PendingResponse pending;
+  pending.socket = socket;
+  pending.dataPointRequest = false;
+  if (requestLine.size() < 2) {
+    pending.response = respond(QByteArray(),QString(),body);
+  }
+  else {
+    QString resource = QString::fromUtf8(requestLine[1]);
+    ++m_requestCounts[resource];
+    pending.dataPointRequest = resource.startsWith("/data_points/");
+    pending.response = respond(requestLine[0],resource,body);
+  }
+
+  ++m_numRequests;
+  m_pendingResponses.push_back(pending);
+  m_maxConcurrentRequests = std::max(m_maxConcurrentRequests,unsigned(m_pendingResponses.size()));
+  if (pending.dataPointRequest) {
+    ++m_numPendingDataPointRequests;
+    m_maxConcurrentDataPointRequests = std::max(m_maxConcurrentDataPointRequests,m_numPendingDataPointRequests);
+  }
+
+  // all replies are held for the same delay, so they go out in arrival order
+  QTimer::singleShot(m_responseDelayMsec,this,SLOT(sendNextResponse()));
+}
+
+void MockOSServer::sendNextResponse() {
+  OS_ASSERT(!m_pendingResponses.empty());
+  PendingResponse next = m_pendingResponses.front();
+  m_pendingResponses.pop_front();
+  if (next.dataPointRequest) {
+    --m_numPendingDataPointRequests;
+  }
+
+  next.socket->write(next.response);
+  next.socket->disconnectFromHost();
+}
+
+void MockOSServer::listen() {
+  bool test = connect(m_server,SIGNAL(newConnection()),this,SLOT(acceptConnection()));
+  OS_ASSERT(test);
+  m_server->listen(QHostAddress::LocalHost);
+}
+
+QByteArray MockOSServer::respond(const QByteArray& method, const QString& resource, const QByteArray& body) {
+  QByteArray status("404 Not Found");
+  QByteArray contentType("application/json");
+  QByteArray replyBody;
+
+  QUrl url(QString("http://localhost") + resource);
+  QStringList parts = url.path().split('/',QString::SkipEmptyParts);
+  QString analysisId = QString::fromStdString(openstudio::removeBraces(m_analysisUUID));
+  bool analysisResource = (parts.size() == 3) && (parts[0] == "analyses") && (parts[1] == analysisId);
+
+  if (method == "GET") {
+    if (parts.isEmpty()) {
+      status = "200 OK";
+      replyBody = "{}";
+    }
+    else if ((parts.size() == 1) && (parts[0] == "projects.json")) {
+      status = "200 OK";
+      replyBody = "[]";
+      if (m_projectUUID) {
+        replyBody = QString("[{\"_id\":\"%1\"}]").arg(QString::fromStdString(openstudio::removeBraces(*m_projectUUID))).toUtf8();
+      }
+    }
+    else if ((parts.size() == 2) && (parts[0] == "projects") && m_projectUUID &&
+             (parts[1] == QString::fromStdString(openstudio::removeBraces(*m_projectUUID)) + ".json"))
+    {
+      status = "200 OK";
+      replyBody = QString("{\"analyses\":[{\"_id\":\"%1\"}]}").arg(analysisId).toUtf8();
+    }
+    else if (analysisResource) {
+      if (parts[2] == "status.json") {
+        status = "200 OK";
+        replyBody = statusJSON(url.queryItemValue("jobs"),QString());
+      }
+      else if (parts[2] == "download_status.json") {
+        status = "200 OK";
+        replyBody = statusJSON(QString(),url.queryItemValue("downloads"));
+      }
+    }
+    else if ((parts.size() >= 2) && (parts[0] == "data_points")) {
+      QString id = parts[1];
+      if (id.endsWith(".json")) {
+        id.chop(5);
+      }
+      openstudio::UUID uuid(id);
+      if (m_dataPointStates.find(uuid) != m_dataPointStates.end()) {
+        if ((parts.size() == 2) && parts[1].endsWith(".json")) {
+          status = "200 OK";
+          replyBody = QString("{\"data_point\":{\"_id\":\"%1\",\"analysis_id\":\"%2\"}}").arg(id).arg(analysisId).toUtf8();
+        }
+        else if ((parts.size() == 3) && (parts[2] == "download")) {
+          status = "200 OK";
+          contentType = "application/zip";
+          replyBody = QByteArray("PK\x05\x06",4) + QByteArray(18,'\0');
+        }
+      }
+    }
+  }
+  else if ((method == "POST") && analysisResource) {
+    if (parts[2] == "upload.json") {
+      status = "201 Created";
+      replyBody = "{}";
+    }
+    else if (parts[2] == "data_points.json") {
+      // the posted DataPoint is the one whose id appears in the body
+      BOOST_FOREACH(const openstudio::UUID& uuid,m_dataPointUUIDs) {
+        if (body.contains(openstudio::removeBraces(uuid).c_str())) {
+          m_dataPointStates[uuid].posted = true;
+          status = "201 Created";
+          replyBody = "{}";
+        }
+      }
+    }
+    else if ((parts[2] == "action.json") && body.contains("start")) {
+      m_analysisStatus = "started";
+      m_numStatusRequestsSinceStart = 0;
+      BOOST_FOREACH(const openstudio::UUID& uuid,m_dataPointUUIDs) {
+        DataPointState& state = m_dataPointStates[uuid];
+        if (state.posted && (state.status == "queued")) {
+          state.status = "started";
+        }
+      }
+      status = "200 OK";
+      replyBody = "{}";
+    }
+  }
+
+  QByteArray result("HTTP/1.1 ");
+  result.append(status);
+  result.append("\r\nContent-Type: ");
+  result.append(contentType);
+  result.append("\r\nContent-Length: ");
+  result.append(QByteArray::number(replyBody.size()));
+  result.append("\r\nConnection: close\r\n\r\n");
+  result.append(replyBody);
+  return result;
+}
+
+QByteArray MockOSServer::statusJSON(const QString& jobsFilter, const QString& downloadsFilter) {
+  if (m_analysisStatus == "started") {
+    ++m_numStatusRequestsSinceStart;
+    if (m_completeAfterStatusRequests && (m_numStatusRequestsSinceStart >= *m_completeAfterStatusRequests)) {
+      BOOST_FOREACH(const openstudio::UUID& uuid,m_dataPointUUIDs) {
+        DataPointState& state = m_dataPointStates[uuid];
+        if (state.status == "started") {
+          state.status = "completed";
+          state.downloadStatus = "completed";
+        }
+      }
+    }
+  }
+
+  QStringList dataPoints;
+  BOOST_FOREACH(const openstudio::UUID& uuid,m_dataPointUUIDs) {
+    const DataPointState& state = m_dataPointStates.find(uuid)->second;
+    if (!state.posted) {
+      continue;
+    }
+    if (!jobsFilter.isEmpty() && (jobsFilter != QString::fromStdString(state.status))) {
+      continue;
+    }
+    if (!downloadsFilter.isEmpty() && (downloadsFilter != QString::fromStdString(state.downloadStatus))) {
+      continue;
+    }
+    dataPoints << QString("{\"_id\":\"%1\",\"status\":\"%2\",\"download_status\":\"%3\"}")
+                    .arg(QString::fromStdString(openstudio::removeBraces(uuid)))
+                    .arg(QString::fromStdString(state.status))
+                    .arg(QString::fromStdString(state.downloadStatus));
+  }
+
+  return QString("{\"analysis\":{\"status\":\"%1\"},\"data_points\":[%2]}")
+           .arg(QString::fromStdString(m_analysisStatus))
+           .arg(dataPoints.join(",")).toUtf8();
+}
@@ -0,0 +1,140 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_CLOUD_TEST_MOCKOSSERVER_HPP
+#define UTILITIES_CLOUD_TEST_MOCKOSSERVER_HPP
+
+#include <utilities/core/UUID.hpp>
+#include <utilities/core/Url.hpp>
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+#include <boost/optional.hpp>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+class QTcpServer;
+class QTcpSocket;
+
+/** MockOSServer is a minimal local HTTP stand-in for the OpenStudio Server. It answers the
+ *  status, data point JSON and data point download requests issued by OSServer for one
+ *  analysis, optionally holding each reply for a fixed delay so that tests can observe how
+ *  many requests are in flight at once. With the second constructor it also accepts the
+ *  posts, upload and start action that CloudAnalysisDriver makes to run an analysis. */
+class MockOSServer : public QObject {
+  Q_OBJECT;
+ public:
+
+  MockOSServer(const openstudio::UUID& analysisUUID,
+               unsigned numDataPoints,
+               int responseDelayMsec=0);
+
+  /** Mocks a server that already knows about projectUUID and analysisUUID, but not about any
+   *  of dataPointUUIDs. Each DataPoint is listed once it has been posted, starts running when
+   *  the analysis is started, and completes as set by completeDataPointsAfter. */
+  MockOSServer(const openstudio::UUID& projectUUID,
+               const openstudio::UUID& analysisUUID,
+               const std::vector<openstudio::UUID>& dataPointUUIDs,
+               int responseDelayMsec=0);
+
+  virtual ~MockOSServer();
+
+  /** Returns the url of the listening server, or an empty url if listening failed. */
+  openstudio::Url url() const;
+
+  openstudio::UUID analysisUUID() const;
+
+  std::vector<openstudio::UUID> dataPointUUIDs() const;
+
+  /** Status may be 'queued', 'started' or 'completed'. */
+  void setAnalysisStatus(const std::string& status);
+
+  void setDataPointStatus(const openstudio::UUID& dataPointUUID,
+                          const std::string& status,
+                          const std::string& downloadStatus="");
+
+  /** Once the analysis has been started, all running DataPoints are reported as complete
+   *  (and ready for download) from the numStatusRequests'th status request on. */
+  void completeDataPointsAfter(unsigned numStatusRequests);
+
+  /** Returns the number of requests received so far. */
+  unsigned numRequests() const;
+
+  /** Returns the number of requests received so far for resource, for instance
+   *  "/analyses/<id>/status.json?jobs=started". */
+  unsigned numRequests(const std::string& resource) const;
+
+  /** Returns the largest number of requests that were waiting on a reply at the same time. */
+  unsigned maxConcurrentRequests() const;
+
+  /** Returns the largest number of data point JSON and download requests that were waiting on
+   *  a reply at the same time. */
+  unsigned maxConcurrentDataPointRequests() const;
+
+ private slots:
+
+  void acceptConnection();
+
+  void readRequest();
+
+  void sendNextResponse();
+
+ private:
+
+  struct DataPointState {
+    bool posted;
+    std::string status;
+    std::string downloadStatus;
+  };
+
+  struct PendingResponse {
+    QTcpSocket* socket;
+    QByteArray response;
+    bool dataPointRequest;
+  };
+
+  QTcpServer* m_server;
+  boost::optional<openstudio::UUID> m_projectUUID;
+  openstudio::UUID m_analysisUUID;
+  std::string m_analysisStatus;
+  std::vector<openstudio::UUID> m_dataPointUUIDs;
+  std::map<openstudio::UUID,DataPointState> m_dataPointStates;
+  int m_responseDelayMsec;
+  boost::optional<unsigned> m_completeAfterStatusRequests;
+  unsigned m_numStatusRequestsSinceStart;
+
+  std::map<QTcpSocket*,QByteArray> m_partialRequests;
+  std::deque<PendingResponse> m_pendingResponses;
+  std::map<QString,unsigned> m_requestCounts;
+  unsigned m_numRequests;
+  unsigned m_maxConcurrentRequests;
+  unsigned m_numPendingDataPointRequests;
+  unsigned m_maxConcurrentDataPointRequests;
+
+  void listen();
+  QByteArray respond(const QByteArray& method, const QString& resource, const QByteArray& body);
+  QByteArray statusJSON(const QString& jobsFilter, const QString& downloadsFilter);
+};
+
+#endif // UTILITIES_CLOUD_TEST_MOCKOSSERVER_HPP
@@ -0,0 +1,93 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/cloud/OSServer.hpp>
+#include <utilities/cloud/test/MockOSServer.hpp>
+
+#include <utilities/core/Application.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+
+using namespace openstudio;
+
+TEST(OSServer, AnalysisStatus_SingleRoundTrip)
+{
+  Application::instance().application();
+
+  MockOSServer mock(createUUID(),6);
+  ASSERT_FALSE(mock.url().isEmpty());
+  std::vector<UUID> dataPoints = mock.dataPointUUIDs();
+  mock.setAnalysisStatus("started");
+  mock.setDataPointStatus(dataPoints[1],"started");
+  mock.setDataPointStatus(dataPoints[2],"started");
+  mock.setDataPointStatus(dataPoints[3],"completed");
+  mock.setDataPointStatus(dataPoints[4],"completed","completed");
+  mock.setDataPointStatus(dataPoints[5],"completed","completed");
+
+  OSServer server(mock.url());
+  EXPECT_TRUE(server.analysisStatus(mock.analysisUUID()));
+  EXPECT_TRUE(server.lastAnalysisStatusSuccess());
+  EXPECT_EQ(1u,mock.numRequests());
+
+  EXPECT_TRUE(server.lastIsAnalysisRunning());
+  EXPECT_EQ(6u,server.lastDataPointUUIDs().size());
+  ASSERT_EQ(1u,server.lastQueuedDataPointUUIDs().size());
+  EXPECT_TRUE(server.lastQueuedDataPointUUIDs()[0] == dataPoints[0]);
+  EXPECT_EQ(2u,server.lastRunningDataPointUUIDs().size());
+  EXPECT_EQ(3u,server.lastCompleteDataPointUUIDs().size());
+  ASSERT_EQ(2u,server.lastDownloadReadyDataPointUUIDs().size());
+  EXPECT_TRUE(server.lastDownloadReadyDataPointUUIDs()[0] == dataPoints[4]);
+
+  // the individual queries agree with the coalesced one
+  std::vector<UUID> complete = server.completeDataPointUUIDs(mock.analysisUUID());
+  EXPECT_EQ(3u,complete.size());
+  std::vector<UUID> ready = server.downloadReadyDataPointUUIDs(mock.analysisUUID());
+  EXPECT_EQ(2u,ready.size());
+  EXPECT_EQ(3u,mock.numRequests());
+}
+
+TEST(OSServer, ConcurrentDataPointDownloads)
+{
+  Application::instance().application();
+
+  MockOSServer mock(createUUID(),4,200);
+  ASSERT_FALSE(mock.url().isEmpty());
+  std::vector<UUID> dataPoints = mock.dataPointUUIDs();
+
+  // one OSServer per in-flight request, as in CloudAnalysisDriver's download window
+  std::vector<OSServer> servers;
+  BOOST_FOREACH(const UUID& dataPoint,dataPoints) {
+    servers.push_back(OSServer(mock.url()));
+    EXPECT_TRUE(servers.back().requestDataPointJSON(mock.analysisUUID(),dataPoint));
+  }
+
+  for (unsigned i = 0; i < servers.size(); ++i) {
+    EXPECT_TRUE(servers[i].waitForFinished());
+    std::string json = servers[i].lastDataPointJSON();
+    EXPECT_FALSE(json.empty());
+    EXPECT_NE(std::string::npos,json.find(removeBraces(dataPoints[i])));
+  }
+
+  EXPECT_EQ(4u,mock.numRequests());
+  EXPECT_GT(mock.maxConcurrentRequests(),1u);
+}
@@ -0,0 +1,152 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_CORE_COPYONWRITEVECTOR_HPP
+#define UTILITIES_CORE_COPYONWRITEVECTOR_HPP
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace openstudio {
+
+/** CopyOnWriteVector is a std::vector whose storage is shared between copies until one of them
+ *  is modified. Copying is O(1); the first modification of a shared instance copies the data.
+ *  Element access is read-only, even on a non-const instance, so that reads never copy; use
+ *  set() or detach() to modify elements.
+ *
+ *  Instances are not internally locked. Copies may be read and written from different threads,
+ *  but a single instance must not be written while it is being read elsewhere. */
+template <typename T>
+class CopyOnWriteVector {
+ public:
+  typedef std::vector<T> vector_type;
+  typedef typename vector_type::value_type value_type;
+  typedef typename vector_type::size_type size_type;
+  typedef typename vector_type::const_iterator const_iterator;
+  typedef const_iterator iterator;
+  typedef typename vector_type::const_reference const_reference;
+
+  CopyOnWriteVector() {}
+
+  CopyOnWriteVector(const vector_type& other)
+    : m_data(other.empty() ? boost::shared_ptr<vector_type>() : boost::shared_ptr<vector_type>(new vector_type(other)))
+  {}
+
+  CopyOnWriteVector& operator=(const vector_type& other) {
+    m_data.reset(other.empty() ? NULL : new vector_type(other));
+    return *this;
+  }
+
+  /** @name Read access. Never copies. */
+  //@{
+
+  const vector_type& get() const {
+    return m_data ? *m_data : emptyVector();
+  }
+
+  operator const vector_type&() const {
+    return get();
+  }
+
+  size_type size() const {
+    return m_data ? m_data->size() : 0u;
+  }
+
+  bool empty() const {
+    return !m_data || m_data->empty();
+  }
+
+  const_reference operator[](size_type index) const {
+    return (*m_data)[index];
+  }
+
+  const_reference back() const {
+    return m_data->back();
+  }
+
+  const_iterator begin() const {
+    return get().begin();
+  }
+
+  const_iterator end() const {
+    return get().end();
+  }
+
+  /** Returns true if this instance currently shares its storage with another copy. */
+  bool isShared() const {
+    return m_data && !m_data.unique();
+  }
+
+  //@}
+  /** @name Write access. Copies the data first if it is shared. */
+  //@{
+
+  /** Returns the underlying vector for modification. */
+  vector_type& detach() {
+    if (!m_data) {
+      m_data.reset(new vector_type());
+    }
+    else if (!m_data.unique()) {
+      m_data.reset(new vector_type(*m_data));
+    }
+    return *m_data;
+  }
+
+  void set(size_type index, const value_type& value) {
+    detach()[index] = value;
+  }
+
+  void push_back(const value_type& value) {
+    detach().push_back(value);
+  }
+
+  void pop_back() {
+    detach().pop_back();
+  }
+
+  void resize(size_type n) {
+    if (n != size()) {
+      detach().resize(n);
+    }
+  }
+
+  void resize(size_type n, const value_type& value) {
+    if (n != size()) {
+      detach().resize(n,value);
+    }
+  }
+
+  void clear() {
+    m_data.reset();
+  }
+
+  //@}
+ private:
+  static const vector_type& emptyVector() {
+    static const vector_type result;
+    return result;
+  }
+
+  boost::shared_ptr<vector_type> m_data;
+};
+
+} // openstudio
+
+#endif // UTILITIES_CORE_COPYONWRITEVECTOR_HPP
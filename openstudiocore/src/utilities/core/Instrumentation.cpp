@@ -0,0 +1,235 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/core/Instrumentation.hpp>
+#include <utilities/core/Json.hpp>
+#include <utilities/core/String.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+namespace openstudio{
+
+  namespace {
+
+    // bounds memory use of a long run, further events are dropped
+    const unsigned maxEvents = 1000000;
+
+    struct TimerSummary {
+      TimerSummary() : calls(0), total(0), max(0) {}
+      unsigned calls;
+      long long total;
+      long long max;
+    };
+
+  }
+
+  InstrumentationSingleton::InstrumentationSingleton()
+    : m_enabled(false),
+      m_startTime(boost::posix_time::microsec_clock::universal_time()),
+      m_truncated(false)
+  {
+    const char* env = std::getenv("OPENSTUDIO_INSTRUMENTATION");
+    if (env && (std::string(env) == "1")) {
+      m_enabled = true;
+    }
+  }
+
+  void InstrumentationSingleton::setEnabled(bool enabled)
+  {
+    m_enabled = enabled;
+  }
+
+  void InstrumentationSingleton::clear()
+  {
+    boost::mutex::scoped_lock l(m_mutex);
+    m_events.clear();
+    m_truncated = false;
+  }
+
+  long long InstrumentationSingleton::now() const
+  {
+    return (boost::posix_time::microsec_clock::universal_time() - m_startTime).total_microseconds();
+  }
+
+  unsigned InstrumentationSingleton::currentThread()
+  {
+    boost::mutex::scoped_lock l(m_mutex);
+    std::map<boost::thread::id, unsigned>::const_iterator it = m_threads.find(boost::this_thread::get_id());
+    if (it != m_threads.end()) {
+      return it->second;
+    }
+    unsigned result = m_threads.size();
+    m_threads[boost::this_thread::get_id()] = result;
+    return result;
+  }
+
+  void InstrumentationSingleton::recordTimer(const char* name, long long start, long long end)
+  {
+    InstrumentationEvent event;
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    event.count = 0;
+    event.isCounter = false;
+    record(event);
+  }
+
+  void InstrumentationSingleton::recordCount(const char* name, long long count)
+  {
+    InstrumentationEvent event;
+    event.name = name;
+    event.start = now();
+    event.duration = 0;
+    event.count = count;
+    event.isCounter = true;
+    record(event);
+  }
+
+  void InstrumentationSingleton::record(const InstrumentationEvent& event)
+  {
+    unsigned thread = currentThread();
+
+    boost::mutex::scoped_lock l(m_mutex);
+    if (m_events.size() >= maxEvents) {
+      if (!m_truncated) {
+        LOG(Warn, "More than " << maxEvents << " events recorded, later events are dropped");
+        m_truncated = true;
+      }
+      return;
+    }
+    m_events.push_back(event);
+    m_events.back().thread = thread;
+  }
+
+  std::vector<InstrumentationEvent> InstrumentationSingleton::events() const
+  {
+    boost::mutex::scoped_lock l(m_mutex);
+    return m_events;
+  }
+
+  std::vector<InstrumentationEvent> InstrumentationSingleton::events(unsigned thread, long long since) const
+  {
+    std::vector<InstrumentationEvent> result;
+    boost::mutex::scoped_lock l(m_mutex);
+    BOOST_FOREACH(const InstrumentationEvent& event, m_events) {
+      if ((event.thread == thread) && (event.start + event.duration >= since)) {
+        result.push_back(event);
+      }
+    }
+    return result;
+  }
+
+  void InstrumentationSingleton::printSummary(const std::vector<InstrumentationEvent>& events, std::ostream& os)
+  {
+    std::map<std::string, TimerSummary> timers;
+    std::map<std::string, long long> counters;
+    BOOST_FOREACH(const InstrumentationEvent& event, events) {
+      if (event.isCounter) {
+        counters[event.name] += event.count;
+      } else {
+        TimerSummary& summary = timers[event.name];
+        ++summary.calls;
+        summary.total += event.duration;
+        summary.max = std::max(summary.max, event.duration);
+      }
+    }
+
+    os << std::left << std::setw(48) << "timer" << std::right
+       << std::setw(10) << "calls" << std::setw(14) << "total (s)"
+       << std::setw(14) << "mean (ms)" << std::setw(14) << "max (ms)" << '\n';
+    os << std::fixed;
+    for (std::map<std::string, TimerSummary>::const_iterator it = timers.begin(); it != timers.end(); ++it) {
+      os << std::left << std::setw(48) << it->first << std::right
+         << std::setw(10) << it->second.calls
+         << std::setw(14) << std::setprecision(3) << 1.0e-6 * it->second.total
+         << std::setw(14) << std::setprecision(3) << 1.0e-3 * it->second.total / it->second.calls
+         << std::setw(14) << std::setprecision(3) << 1.0e-3 * it->second.max << '\n';
+    }
+
+    if (!counters.empty()) {
+      os << '\n' << std::left << std::setw(48) << "counter" << std::right << std::setw(10) << "total" << '\n';
+      for (std::map<std::string, long long>::const_iterator it = counters.begin(); it != counters.end(); ++it) {
+        os << std::left << std::setw(48) << it->first << std::right << std::setw(10) << it->second << '\n';
+      }
+    }
+    os.flush();
+  }
+
+  bool InstrumentationSingleton::saveSummary(const std::vector<InstrumentationEvent>& events, const openstudio::path& p)
+  {
+    boost::filesystem::ofstream os(p);
+    if (!os) {
+      LOG(Error, "Unable to write instrumentation summary to " << toString(p));
+      return false;
+    }
+    printSummary(events, os);
+    return os.good();
+  }
+
+  bool InstrumentationSingleton::saveChromeTrace(const openstudio::path& p) const
+  {
+    boost::filesystem::ofstream os(p);
+    if (!os) {
+      LOG(Error, "Unable to write instrumentation trace to " << toString(p));
+      return false;
+    }
+
+    std::vector<InstrumentationEvent> allEvents = events();
+
+    // counters are shown as running totals
+    std::map<std::string, long long> counters;
+
+    JsonWriter writer(os, true);
+    writer.startObject();
+    writer.write("displayTimeUnit", "ms");
+    writer.startArray("traceEvents");
+    BOOST_FOREACH(const InstrumentationEvent& event, allEvents) {
+      QVariantMap map;
+      map["name"] = toQString(event.name);
+      map["cat"] = "openstudio";
+      map["pid"] = 1;
+      map["tid"] = event.thread;
+      map["ts"] = event.start;
+      if (event.isCounter) {
+        long long& total = counters[event.name];
+        total += event.count;
+        QVariantMap args;
+        args["value"] = total;
+        map["ph"] = "C";
+        map["args"] = args;
+      } else {
+        map["ph"] = "X";
+        map["dur"] = event.duration;
+      }
+      writer.write(map);
+    }
+    writer.end();
+    writer.end();
+    os << std::endl;
+
+    return os.good();
+  }
+
+} // openstudio
@@ -0,0 +1,183 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_CORE_INSTRUMENTATION_HPP
+#define UTILITIES_CORE_INSTRUMENTATION_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <utilities/core/Singleton.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef OPENSTUDIO_NO_INSTRUMENTATION
+
+#define OS_TIMER(__name__)
+#define OS_COUNT(__name__, __n__)
+
+#else
+
+/// time the enclosing scope under __name__, a string literal, if instrumentation is enabled
+#define OS_TIMER(__name__) \
+  openstudio::ScopedTimer BOOST_PP_CAT(_osScopedTimer, __LINE__)(__name__);
+
+/// add __n__ to the counter __name__, a string literal, if instrumentation is enabled
+#define OS_COUNT(__name__, __n__) \
+  { \
+    if (openstudio::Instrumentation::instance().enabled()) { \
+      openstudio::Instrumentation::instance().recordCount(__name__, __n__); \
+    } \
+  }
+
+#endif
+
+namespace openstudio{
+
+  /** A timed scope or counter increment recorded by Instrumentation. Times are in microseconds
+   *  since the registry was created. */
+  struct UTILITIES_API InstrumentationEvent {
+    std::string name;
+    /// small integer identifying the recording thread, in order of first use
+    unsigned thread;
+    long long start;
+    /// duration of a timer, 0 for a counter
+    long long duration;
+    /// increment of a counter, 0 for a timer
+    long long count;
+    bool isCounter;
+  };
+
+  /** Singleton registry of scoped timers and counters placed on hot paths (IDF and IDD parsing,
+   *  Workspace add and remove, forward translation, SqlFile queries and RunManager job phases).
+   *  Recording is off by default, and costs a single flag check per OS_TIMER or OS_COUNT while
+   *  off. It is turned on by setEnabled or by setting the OPENSTUDIO_INSTRUMENTATION environment
+   *  variable to 1 before startup. Defining OPENSTUDIO_NO_INSTRUMENTATION compiles the macros
+   *  away entirely. */
+  class UTILITIES_API InstrumentationSingleton {
+
+    friend class Singleton<InstrumentationSingleton>;
+
+   public:
+
+    /// returns true if timers and counters are being recorded
+    bool enabled() const { return m_enabled; }
+
+    void setEnabled(bool enabled);
+
+    /// discards all recorded events, the clock keeps running
+    void clear();
+
+    /// microseconds since the registry was created
+    long long now() const;
+
+    /// identifier of the calling thread as recorded in events
+    unsigned currentThread();
+
+    void recordTimer(const char* name, long long start, long long end);
+
+    void recordCount(const char* name, long long count);
+
+    /// all recorded events, in the order they were completed
+    std::vector<InstrumentationEvent> events() const;
+
+    /// events recorded by thread that completed at or after since
+    std::vector<InstrumentationEvent> events(unsigned thread, long long since) const;
+
+    /** Writes a table of calls, total, mean and maximum time per timer, followed by the total of
+     *  each counter. */
+    static void printSummary(const std::vector<InstrumentationEvent>& events, std::ostream& os);
+
+    /// prints the summary of events to p
+    static bool saveSummary(const std::vector<InstrumentationEvent>& events, const openstudio::path& p);
+
+    /** Writes all recorded events in the Chrome trace event format, which can be opened in
+     *  chrome://tracing. */
+    bool saveChromeTrace(const openstudio::path& p) const;
+
+   private:
+
+    InstrumentationSingleton();
+
+    REGISTER_LOGGER("utilities.Instrumentation");
+
+    void record(const InstrumentationEvent& event);
+
+    volatile bool m_enabled;
+    mutable boost::mutex m_mutex;
+    // set once on construction so now() can read it without locking
+    const boost::posix_time::ptime m_startTime;
+    std::map<boost::thread::id, unsigned> m_threads;
+    std::vector<InstrumentationEvent> m_events;
+    bool m_truncated;
+  };
+
+#if _WIN32 || _MSC_VER
+
+  /// Explicitly instantiate and export InstrumentationSingleton Singleton template instance
+  /// so that the same instance is shared between the DLL's that link to Utilities.dll
+  UTILITIES_TEMPLATE_EXT template class UTILITIES_API openstudio::Singleton<InstrumentationSingleton>;
+
+#endif
+
+  typedef openstudio::Singleton<InstrumentationSingleton> Instrumentation;
+
+  /** Records the lifetime of a scope with Instrumentation. Use through OS_TIMER. */
+  class UTILITIES_API ScopedTimer {
+   public:
+
+    /// name must outlive the timer, normally it is a string literal
+    explicit ScopedTimer(const char* name)
+      : m_name(name), m_active(Instrumentation::instance().enabled()), m_start(0)
+    {
+      if (m_active) {
+        m_start = Instrumentation::instance().now();
+      }
+    }
+
+    ~ScopedTimer()
+    {
+      if (m_active) {
+        Instrumentation::instance().recordTimer(m_name, m_start, Instrumentation::instance().now());
+      }
+    }
+
+   private:
+
+    // no body on purpose, do not want these generated
+    ScopedTimer(const ScopedTimer& other);
+    ScopedTimer& operator=(const ScopedTimer& other);
+
+    const char* m_name;
+    bool m_active;
+    long long m_start;
+  };
+
+} // openstudio
+
+#endif // UTILITIES_CORE_INSTRUMENTATION_HPP
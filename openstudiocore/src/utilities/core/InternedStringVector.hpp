@@ -0,0 +1,166 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_CORE_INTERNEDSTRINGVECTOR_HPP
+#define UTILITIES_CORE_INTERNEDSTRINGVECTOR_HPP
+
+#include <utilities/core/CopyOnWriteVector.hpp>
+#include <utilities/core/StringPool.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+/** A vector of strings held through StringPool. Each element is a pointer to shared, immutable
+ *  text (null for the empty string), and the vector itself is copy-on-write, so copies share
+ *  both the element table and the text. Elements are read as const std::string& and written
+ *  with set, push_back and resize. */
+class InternedStringVector {
+ public:
+  typedef std::vector<std::string>::size_type size_type;
+
+  InternedStringVector() {}
+
+  InternedStringVector(const std::vector<std::string>& values) {
+    assign(values);
+  }
+
+  InternedStringVector& operator=(const std::vector<std::string>& values) {
+    assign(values);
+    return *this;
+  }
+
+  /** @name Read access */
+  //@{
+
+  size_type size() const {
+    return m_data.size();
+  }
+
+  bool empty() const {
+    return m_data.empty();
+  }
+
+  const std::string& operator[](size_type index) const {
+    return deref(m_data[index]);
+  }
+
+  const std::string& back() const {
+    return deref(m_data.back());
+  }
+
+  std::vector<std::string> strings() const {
+    std::vector<std::string> result;
+    result.reserve(size());
+    for (size_type i = 0, n = size(); i < n; ++i) {
+      result.push_back((*this)[i]);
+    }
+    return result;
+  }
+
+  operator std::vector<std::string>() const {
+    return strings();
+  }
+
+  /** Returns true if the element table is shared with another copy. */
+  bool isShared() const {
+    return m_data.isShared();
+  }
+
+  /** Bytes used by the element table. */
+  std::size_t tableBytes() const {
+    return m_data.get().capacity() * sizeof(StringPoolSingleton::StringPtr);
+  }
+
+  /** Characters in elements that are too long to be pooled, and so are not shared with other
+   *  values. */
+  std::size_t unpooledBytes() const {
+    std::size_t result = 0;
+    for (size_type i = 0, n = size(); i < n; ++i) {
+      std::string::size_type length = (*this)[i].size();
+      if (length > StringPoolSingleton::maxInternedLength()) {
+        result += length;
+      }
+    }
+    return result;
+  }
+
+  /** Number of non-empty elements. */
+  size_type numNonEmpty() const {
+    size_type result = 0;
+    for (size_type i = 0, n = size(); i < n; ++i) {
+      if (m_data[i]) {
+        ++result;
+      }
+    }
+    return result;
+  }
+
+  //@}
+  /** @name Write access */
+  //@{
+
+  void set(size_type index, const std::string& value) {
+    m_data.set(index, StringPool::instance().intern(value));
+  }
+
+  void push_back(const std::string& value) {
+    m_data.push_back(StringPool::instance().intern(value));
+  }
+
+  void pop_back() {
+    m_data.pop_back();
+  }
+
+  /** New elements are empty. */
+  void resize(size_type n) {
+    m_data.resize(n);
+  }
+
+  void clear() {
+    m_data.clear();
+  }
+
+  //@}
+ private:
+  static const std::string& deref(const StringPoolSingleton::StringPtr& p) {
+    static const std::string empty;
+    return p ? *p : empty;
+  }
+
+  void assign(const std::vector<std::string>& values) {
+    m_data.clear();
+    if (values.empty()) {
+      return;
+    }
+    std::vector<StringPoolSingleton::StringPtr>& data = m_data.detach();
+    data.reserve(values.size());
+    for (std::vector<std::string>::const_iterator it = values.begin(); it != values.end(); ++it) {
+      data.push_back(StringPool::instance().intern(*it));
+    }
+  }
+
+  CopyOnWriteVector<StringPoolSingleton::StringPtr> m_data;
+};
+
+} // openstudio
+
+#endif // UTILITIES_CORE_INTERNEDSTRINGVECTOR_HPP
@@ -140,4 +140,355 @@ VersionString extractOpenStudioVersion(const QVariant& variant) {
   return version.get();
 }
 
+JsonWriter::JsonWriter(std::ostream& os, bool compact)
+  : m_os(os),
+    m_compact(compact),
+    m_serializer(new QJson::Serializer())
+{
+  if (m_compact) {
+    m_serializer->setIndentMode(QJson::IndentCompact);
+  }
+  else {
+    detail::configureJsonSerializer(*m_serializer);
+  }
+}
+
+void JsonWriter::startObject() {
+  if (!m_closers.empty()) {
+    if (m_closers.back() != ']') {
+      LOG_FREE_AND_THROW("openstudio.Json","An object member must have a key.");
+    }
+    separate();
+  }
+  start('{','}');
+}
+
+void JsonWriter::startObject(const std::string& key) {
+  writeKey(key);
+  start('{','}');
+}
+
+void JsonWriter::startArray() {
+  if (m_closers.empty() || (m_closers.back() != ']')) {
+    LOG_FREE_AND_THROW("openstudio.Json","A keyless array can only be written inside an array.");
+  }
+  separate();
+  start('[',']');
+}
+
+void JsonWriter::startArray(const std::string& key) {
+  writeKey(key);
+  start('[',']');
+}
+
+void JsonWriter::end() {
+  if (m_closers.empty()) {
+    LOG_FREE_AND_THROW("openstudio.Json","There is no open object or array to end.");
+  }
+  if (!m_compact && (m_counts.back() > 0u)) {
+    m_os << std::endl;
+  }
+  m_os << m_closers.back();
+  m_closers.pop_back();
+  m_counts.pop_back();
+  if (m_closers.empty()) {
+    m_os << std::endl;
+  }
+}
+
+void JsonWriter::write(const QVariant& value) {
+  if (m_closers.empty() || (m_closers.back() != ']')) {
+    LOG_FREE_AND_THROW("openstudio.Json","A keyless value can only be written inside an array.");
+  }
+  separate();
+  QByteArray qba = serialize(value);
+  m_os.write(qba.constData(),qba.size());
+}
+
+void JsonWriter::write(const std::string& key, const QVariant& value) {
+  writeKey(key);
+  QByteArray qba = serialize(value);
+  m_os.write(qba.constData(),qba.size());
+}
+
+void JsonWriter::writeMembers(const QVariantMap& map) {
+  for (QVariantMap::const_iterator it = map.begin(), itEnd = map.end(); it != itEnd; ++it) {
+    write(toString(it.key()),it.value());
+  }
+}
+
+bool JsonWriter::isComplete() const {
+  return m_closers.empty();
+}
+
+void JsonWriter::start(char open, char close) {
+  m_os << open;
+  m_closers.push_back(close);
+  m_counts.push_back(0u);
+}
+
+void JsonWriter::separate() {
+  if (m_counts.back() > 0u) {
+    m_os << ',';
+  }
+  if (!m_compact) {
+    m_os << std::endl;
+  }
+  ++m_counts.back();
+}
+
+void JsonWriter::writeKey(const std::string& key) {
+  if (m_closers.empty() || (m_closers.back() != '}')) {
+    LOG_FREE_AND_THROW("openstudio.Json","Member '" << key << "' can only be written inside an object.");
+  }
+  separate();
+  QByteArray qba = serialize(QVariant(toQString(key)));
+  m_os.write(qba.constData(),qba.size());
+  m_os << (m_compact ? ":" : " : ");
+}
+
+QByteArray JsonWriter::serialize(const QVariant& value) {
+  bool ok(false);
+  QByteArray result = m_serializer->serialize(value,&ok);
+  if (!ok) {
+    LOG_FREE_AND_THROW("openstudio.Json","Could not serialize to JSON format, because "
+                       << toString(m_serializer->errorMessage()));
+  }
+  return result;
+}
+
+namespace {
+
+  const char* skipWhitespace(const char* p, const char* end) {
+    while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r'))) {
+      ++p;
+    }
+    return p;
+  }
+
+  const char* skipString(const char* p, const char* end) {
+    OS_ASSERT(*p == '"');
+    for (++p; p < end; ++p) {
+      if (*p == '\\') {
+        ++p;
+      }
+      else if (*p == '"') {
+        return p + 1;
+      }
+    }
+    LOG_FREE_AND_THROW("openstudio.Json","Unterminated string in JSON file.");
+    return end;
+  }
+
+  const char* skipValue(const char* p, const char* end) {
+    if (p >= end) {
+      LOG_FREE_AND_THROW("openstudio.Json","Unexpected end of JSON file.");
+    }
+    if (*p == '"') {
+      return skipString(p,end);
+    }
+    if ((*p == '{') || (*p == '[')) {
+      int depth = 0;
+      while (p < end) {
+        if (*p == '"') {
+          p = skipString(p,end);
+          continue;
+        }
+        if ((*p == '{') || (*p == '[')) {
+          ++depth;
+        }
+        else if ((*p == '}') || (*p == ']')) {
+          --depth;
+        }
+        ++p;
+        if (depth == 0) {
+          return p;
+        }
+      }
+      LOG_FREE_AND_THROW("openstudio.Json","Unterminated object or array in JSON file.");
+    }
+    // number, true, false or null
+    const char* begin = p;
+    while ((p < end) && (*p != ',') && (*p != '}') && (*p != ']') &&
+           (*p != ' ') && (*p != '\t') && (*p != '\n') && (*p != '\r'))
+    {
+      ++p;
+    }
+    if (p == begin) {
+      LOG_FREE_AND_THROW("openstudio.Json","Expected a value in JSON file.");
+    }
+    return p;
+  }
+
+}
+
+JsonFileIndex::JsonFileIndex(const openstudio::path& p, unsigned maxDepth)
+  : m_file(new QFile(toQString(p))),
+    m_begin(NULL),
+    m_end(NULL),
+    m_maxDepth(maxDepth)
+{
+  if (!m_file->open(QFile::ReadOnly)) {
+    LOG_FREE_AND_THROW("openstudio.Json","Could not open file " << toString(p) << " for reading.");
+  }
+
+  qint64 size = m_file->size();
+  if (uchar* mapped = m_file->map(0,size)) {
+    m_begin = reinterpret_cast<const char*>(mapped);
+  }
+  else {
+    m_buffer = m_file->readAll();
+    m_file->close();
+    m_begin = m_buffer.constData();
+    size = m_buffer.size();
+  }
+  m_end = m_begin + size;
+
+  const char* pos = skipWhitespace(m_begin,m_end);
+  if ((pos == m_end) || (*pos != '{')) {
+    LOG_FREE_AND_THROW("openstudio.Json","The file at " << toString(p) << " does not contain a JSON object.");
+  }
+  indexObject(pos,std::string(),0u);
+}
+
+bool JsonFileIndex::contains(const std::string& keyPath) const {
+  return (m_values.find(keyPath) != m_values.end());
+}
+
+std::vector<std::string> JsonFileIndex::keys(const std::string& objectPath) const {
+  std::map<std::string,std::vector<std::string> >::const_iterator it = m_keys.find(objectPath);
+  if (it != m_keys.end()) {
+    return it->second;
+  }
+  return std::vector<std::string>();
+}
+
+QVariant JsonFileIndex::value(const std::string& keyPath) const {
+  std::map<std::string,Span>::const_iterator it = m_values.find(keyPath);
+  if (it != m_values.end()) {
+    return parse(it->second);
+  }
+  return QVariant();
+}
+
+unsigned JsonFileIndex::arraySize(const std::string& keyPath) const {
+  std::map<std::string,std::vector<Span> >::const_iterator it = m_arrays.find(keyPath);
+  if (it != m_arrays.end()) {
+    return it->second.size();
+  }
+  return 0u;
+}
+
+QVariant JsonFileIndex::arrayElement(const std::string& keyPath, unsigned index) const {
+  std::map<std::string,std::vector<Span> >::const_iterator it = m_arrays.find(keyPath);
+  if ((it != m_arrays.end()) && (index < it->second.size())) {
+    return parse(it->second[index]);
+  }
+  return QVariant();
+}
+
+const char* JsonFileIndex::indexObject(const char* p, const std::string& path, unsigned depth) {
+  OS_ASSERT(*p == '{');
+  std::vector<std::string>& keys = m_keys[path];
+  p = skipWhitespace(p + 1,m_end);
+  if ((p < m_end) && (*p == '}')) {
+    return p + 1;
+  }
+  while (p < m_end) {
+    if (*p != '"') {
+      LOG_FREE_AND_THROW("openstudio.Json","Expected an object key in JSON file.");
+    }
+    const char* keyEnd = skipString(p,m_end);
+    QString quotedKey = QString::fromUtf8(p,keyEnd - p);
+    std::string key;
+    if (quotedKey.contains('\\')) {
+      key = toString(loadJSON("[" + toString(quotedKey) + "]").toList()[0].toString());
+    }
+    else {
+      key = toString(quotedKey.mid(1,quotedKey.size() - 2));
+    }
+    std::string keyPath = path.empty() ? key : path + "/" + key;
+
+    p = skipWhitespace(keyEnd,m_end);
+    if ((p == m_end) || (*p != ':')) {
+      LOG_FREE_AND_THROW("openstudio.Json","Expected ':' after key '" << keyPath << "' in JSON file.");
+    }
+    p = skipWhitespace(p + 1,m_end);
+
+    const char* valueBegin = p;
+    if ((p < m_end) && (*p == '{') && (depth + 1 < m_maxDepth)) {
+      p = indexObject(p,keyPath,depth + 1);
+    }
+    else if ((p < m_end) && (*p == '[')) {
+      p = indexArray(p,keyPath);
+    }
+    else {
+      p = skipValue(p,m_end);
+    }
+    m_values[keyPath] = Span(valueBegin - m_begin,p - m_begin);
+    keys.push_back(key);
+
+    p = skipWhitespace(p,m_end);
+    if ((p < m_end) && (*p == ',')) {
+      p = skipWhitespace(p + 1,m_end);
+      continue;
+    }
+    if ((p < m_end) && (*p == '}')) {
+      return p + 1;
+    }
+    break;
+  }
+  LOG_FREE_AND_THROW("openstudio.Json","Expected ',' or '}' in object '" << path << "' in JSON file.");
+  return m_end;
+}
+
+const char* JsonFileIndex::indexArray(const char* p, const std::string& path) {
+  OS_ASSERT(*p == '[');
+  std::vector<Span>& elements = m_arrays[path];
+  p = skipWhitespace(p + 1,m_end);
+  if ((p < m_end) && (*p == ']')) {
+    return p + 1;
+  }
+  while (p < m_end) {
+    const char* elementBegin = p;
+    p = skipValue(p,m_end);
+    elements.push_back(Span(elementBegin - m_begin,p - m_begin));
+    p = skipWhitespace(p,m_end);
+    if ((p < m_end) && (*p == ',')) {
+      p = skipWhitespace(p + 1,m_end);
+      continue;
+    }
+    if ((p < m_end) && (*p == ']')) {
+      return p + 1;
+    }
+    break;
+  }
+  LOG_FREE_AND_THROW("openstudio.Json","Expected ',' or ']' in array '" << path << "' in JSON file.");
+  return m_end;
+}
+
+QVariant JsonFileIndex::parse(const Span& span) const {
+  const char* begin = m_begin + span.first;
+  int size = span.second - span.first;
+  bool isContainer = (size > 0) && ((*begin == '{') || (*begin == '['));
+
+  QJson::Parser parser;
+  bool ok(false);
+  QVariant result;
+  if (isContainer) {
+    result = parser.parse(QByteArray::fromRawData(begin,size),&ok);
+  }
+  else {
+    // the parser only accepts objects and arrays at the top level
+    QByteArray wrapped("[");
+    wrapped.append(begin,size);
+    wrapped.append("]");
+    result = parser.parse(wrapped,&ok).toList().value(0);
+  }
+  if (!ok) {
+    LOG_FREE_AND_THROW("openstudio.Json","Error parsing JSON: " + toString(parser.errorString()));
+  }
+  return result;
+}
+
 } // openstudio
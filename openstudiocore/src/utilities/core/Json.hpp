@@ -26,12 +26,18 @@
 #include <utilities/core/Compare.hpp>
 
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
+#include <QByteArray>
 #include <QVariant>
 
+#include <map>
+#include <ostream>
 #include <string>
 #include <vector>
 
+class QFile;
+
 namespace QJson {
   class Serializer;
 }
@@ -63,6 +69,99 @@ UTILITIES_API QVariant loadJSON(const std::string& json);
 /** Returns the openstudio_version stored in the top-level JSON variant. */
 UTILITIES_API VersionString extractOpenStudioVersion(const QVariant& variant);
 
+/** JsonWriter writes JSON to a std::ostream one member or array element at a time, so that
+ *  large documents never have to exist as a single QVariant. Leaf values are serialized with
+ *  the same settings as saveJSON unless compact is requested. Throws an openstudio::Exception
+ *  if a value cannot be serialized or start/end calls do not match. */
+class UTILITIES_API JsonWriter {
+ public:
+  JsonWriter(std::ostream& os, bool compact=false);
+
+  /** Starts the top-level object or an object element of the current array. */
+  void startObject();
+
+  /** Starts an object member of the current object. */
+  void startObject(const std::string& key);
+
+  /** Starts an array element of the current array. */
+  void startArray();
+
+  /** Starts an array member of the current object. */
+  void startArray(const std::string& key);
+
+  /** Ends the innermost object or array. */
+  void end();
+
+  /** Writes an element of the current array. */
+  void write(const QVariant& value);
+
+  /** Writes a member of the current object. */
+  void write(const std::string& key, const QVariant& value);
+
+  /** Writes each entry of map as a member of the current object. */
+  void writeMembers(const QVariantMap& map);
+
+  /** Returns true if all objects and arrays have been ended. */
+  bool isComplete() const;
+
+ private:
+  void start(char open, char close);
+  void separate();
+  void writeKey(const std::string& key);
+  QByteArray serialize(const QVariant& value);
+
+  std::ostream& m_os;
+  bool m_compact;
+  boost::shared_ptr<QJson::Serializer> m_serializer;
+  std::vector<char> m_closers;
+  std::vector<unsigned> m_counts;
+};
+
+/** JsonFileIndex maps a JSON file into memory and records where the members of its outer
+ *  objects, and the elements of arrays held by those members, start and end, without parsing
+ *  any values. Values are parsed on request, so large arrays (e.g. analysis/data_points) can be
+ *  loaded one element at a time. Key paths join keys with '/', e.g. "analysis/problem"; the
+ *  top-level object is "". Throws an openstudio::Exception if the file cannot be read or is not
+ *  well-formed. */
+class UTILITIES_API JsonFileIndex {
+ public:
+  /** Indexes the members of objects nested fewer than maxDepth levels below the top-level
+   *  object. */
+  explicit JsonFileIndex(const openstudio::path& p, unsigned maxDepth=2);
+
+  /** Returns true if keyPath is an indexed member. */
+  bool contains(const std::string& keyPath) const;
+
+  /** Returns the member keys of the indexed object at objectPath, in file order. */
+  std::vector<std::string> keys(const std::string& objectPath) const;
+
+  /** Parses and returns the member at keyPath. Returns a null QVariant if !contains(keyPath). */
+  QVariant value(const std::string& keyPath) const;
+
+  /** Returns the number of elements in the indexed array at keyPath. */
+  unsigned arraySize(const std::string& keyPath) const;
+
+  /** Parses and returns element index of the indexed array at keyPath. Returns a null QVariant
+   *  if there is no such element. */
+  QVariant arrayElement(const std::string& keyPath, unsigned index) const;
+
+ private:
+  typedef std::pair<qint64,qint64> Span;
+
+  const char* indexObject(const char* p, const std::string& path, unsigned depth);
+  const char* indexArray(const char* p, const std::string& path);
+  QVariant parse(const Span& span) const;
+
+  boost::shared_ptr<QFile> m_file;
+  QByteArray m_buffer;
+  const char* m_begin;
+  const char* m_end;
+  unsigned m_maxDepth;
+  std::map<std::string,Span> m_values;
+  std::map<std::string,std::vector<std::string> > m_keys;
+  std::map<std::string,std::vector<Span> > m_arrays;
+};
+
 template<typename T>
 std::vector<T> deserializeOrderedVector(const QVariantList& list,
                                         const std::string& valueKey,
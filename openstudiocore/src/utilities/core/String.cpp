@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <limits>
 #include <boost/static_assert.hpp>
+#include <boost/thread/tss.hpp>
 
 namespace openstudio {
 
@@ -58,9 +59,21 @@ std::string toString(const QString& q)
 }
 
 std::string toString(double v) {
-  std::stringstream ss;
-  ss << std::setprecision(std::numeric_limits<double>::digits10) << v;
-  return ss.str();
+  // constructing a stream (and its locale) dominates the cost of this call, which is made for
+  // every numeric field written, so each thread keeps one around
+  static boost::thread_specific_ptr<std::ostringstream> t_ss;
+  std::ostringstream* ss = t_ss.get();
+  if (!ss) {
+    ss = new std::ostringstream();
+    ss->precision(std::numeric_limits<double>::digits10);
+    t_ss.reset(ss);
+  }
+  else {
+    ss->str(std::string());
+    ss->clear();
+  }
+  *ss << v;
+  return ss->str();
 }
 
 /** QString to wstring. */
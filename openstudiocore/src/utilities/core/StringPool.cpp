@@ -0,0 +1,152 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/core/StringPool.hpp>
+
+#include <boost/functional/hash.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <algorithm>
+
+namespace openstudio{
+
+  StringPoolSingleton::StringPoolSingleton()
+  {}
+
+  StringPoolSingleton::StringPtr StringPoolSingleton::intern(const std::string& value)
+  {
+    if (value.empty()) {
+      return StringPtr();
+    }
+
+    if (value.size() > maxInternedLength()) {
+      return StringPtr(new std::string(value));
+    }
+
+    CacheType* cache = m_threadCache.get();
+    if (!cache) {
+      return internInStripe(value);
+    }
+
+    CacheType::const_iterator it = cache->find(value);
+    if (it != cache->end()) {
+      return it->second;
+    }
+
+    StringPtr result = internInStripe(value);
+    cache->insert(CacheType::value_type(value, result));
+    return result;
+  }
+
+  StringPoolSingleton::StringPtr StringPoolSingleton::internInStripe(const std::string& value)
+  {
+    Stripe& s = stripe(value);
+    boost::mutex::scoped_lock l(s.mutex);
+
+    PoolType::const_iterator it = s.pool.find(&value);
+    if (it != s.pool.end()) {
+      return it->second;
+    }
+
+    // drop unreferenced strings once the stripe has doubled since the last purge
+    if (s.pool.size() >= s.purgeSize) {
+      s.purge();
+      s.purgeSize = std::max(s.purgeSize, 2 * s.pool.size());
+    }
+
+    StringPtr result(new std::string(value));
+    s.pool.insert(PoolType::value_type(result.get(), result));
+    s.numBytes += value.size();
+    return result;
+  }
+
+  std::string::size_type StringPoolSingleton::maxInternedLength()
+  {
+    return 32u;
+  }
+
+  unsigned StringPoolSingleton::numStrings() const
+  {
+    unsigned result = 0;
+    for (unsigned i = 0; i < numStripes; ++i) {
+      boost::mutex::scoped_lock l(m_stripes[i].mutex);
+      result += m_stripes[i].pool.size();
+    }
+    return result;
+  }
+
+  std::size_t StringPoolSingleton::numBytes() const
+  {
+    std::size_t result = 0;
+    for (unsigned i = 0; i < numStripes; ++i) {
+      boost::mutex::scoped_lock l(m_stripes[i].mutex);
+      result += m_stripes[i].numBytes;
+    }
+    return result;
+  }
+
+  void StringPoolSingleton::purge()
+  {
+    for (unsigned i = 0; i < numStripes; ++i) {
+      boost::mutex::scoped_lock l(m_stripes[i].mutex);
+      m_stripes[i].purge();
+    }
+  }
+
+  StringPoolSingleton::Stripe& StringPoolSingleton::stripe(const std::string& value)
+  {
+    return m_stripes[boost::hash<std::string>()(value) % numStripes];
+  }
+
+  StringPoolSingleton::ThreadCache::ThreadCache()
+    : m_owner(false)
+  {
+    StringPoolSingleton& pool = StringPool::instance();
+    if (!pool.m_threadCache.get()) {
+      pool.m_threadCache.reset(new CacheType());
+      m_owner = true;
+    }
+  }
+
+  StringPoolSingleton::ThreadCache::~ThreadCache()
+  {
+    if (m_owner) {
+      StringPool::instance().m_threadCache.reset();
+    }
+  }
+
+  StringPoolSingleton::Stripe::Stripe()
+    : numBytes(0), purgeSize(256)
+  {}
+
+  void StringPoolSingleton::Stripe::purge()
+  {
+    PoolType::iterator it = pool.begin();
+    while (it != pool.end()) {
+      if (it->second.unique()) {
+        numBytes -= it->second->size();
+        pool.erase(it++);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+} // openstudio
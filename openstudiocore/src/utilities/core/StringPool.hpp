@@ -0,0 +1,131 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_CORE_STRINGPOOL_HPP
+#define UTILITIES_CORE_STRINGPOOL_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <utilities/core/Singleton.hpp>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace openstudio{
+
+  /** Singleton pool of shared, immutable strings. Short values that occur over and over in
+   *  object data ("Autosize", "Yes", "0", schedule and construction names) are stored once and
+   *  referenced from every field that holds them. Longer values, which are rarely repeated
+   *  (handles, descriptions, file paths), get their own shared storage and are not pooled.
+   *
+   *  Pooled strings stay in the pool until they are no longer referenced and the pool has grown
+   *  enough to be purged, or purge is called. intern is thread-safe. The pool is split into
+   *  stripes by hash of the value, each with its own lock, so that threads setting fields at
+   *  the same time rarely wait on each other. */
+  class UTILITIES_API StringPoolSingleton {
+
+    friend class Singleton<StringPoolSingleton>;
+
+   public:
+
+    typedef boost::shared_ptr<const std::string> StringPtr;
+
+    /** While a ThreadCache exists, intern on the thread that created it looks values up in a
+     *  cache owned by that thread before going to the pool, so repeated values take no lock.
+     *  Values added to the pool through the cache are shared with all other threads as usual.
+     *  Meant for worker threads that set many fields, as in IdfFile::loadParallel. Nested
+     *  instances on the same thread use the outermost cache. */
+    class UTILITIES_API ThreadCache : boost::noncopyable {
+     public:
+      ThreadCache();
+      ~ThreadCache();
+     private:
+      bool m_owner;
+    };
+
+    /** Returns shared storage for value. Returns a null pointer for the empty string. */
+    StringPtr intern(const std::string& value);
+
+    /** Values longer than this are not pooled. */
+    static std::string::size_type maxInternedLength();
+
+    /** Number of distinct strings in the pool. */
+    unsigned numStrings() const;
+
+    /** Characters held by the pool. */
+    std::size_t numBytes() const;
+
+    /** Removes strings that are no longer referenced outside of the pool. */
+    void purge();
+
+   private:
+
+    friend class ThreadCache;
+
+    StringPoolSingleton();
+
+    struct DerefLess {
+      bool operator()(const std::string* x, const std::string* y) const {
+        return *x < *y;
+      }
+    };
+
+    typedef std::map<const std::string*, StringPtr, DerefLess> PoolType;
+
+    typedef boost::unordered_map<std::string, StringPtr> CacheType;
+
+    struct Stripe {
+      Stripe();
+
+      void purge();
+
+      mutable boost::mutex mutex;
+      PoolType pool;
+      std::size_t numBytes;
+      std::size_t purgeSize;
+    };
+
+    static const unsigned numStripes = 16;
+
+    Stripe& stripe(const std::string& value);
+
+    StringPtr internInStripe(const std::string& value);
+
+    Stripe m_stripes[numStripes];
+    boost::thread_specific_ptr<CacheType> m_threadCache;
+  };
+
+#if _WIN32 || _MSC_VER
+
+  UTILITIES_TEMPLATE_EXT template class UTILITIES_API openstudio::Singleton<StringPoolSingleton>;
+
+#endif
+
+  typedef openstudio::Singleton<StringPoolSingleton> StringPool;
+
+} // openstudio
+
+#endif // UTILITIES_CORE_STRINGPOOL_HPP
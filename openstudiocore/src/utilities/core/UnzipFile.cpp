@@ -30,20 +30,40 @@ namespace openstudio {
 
   std::vector<openstudio::path> UnzipFile::extractAllFiles(const openstudio::path &outputPath) const
   {
-    std::vector<openstudio::path> files = listFiles();
+    return extractAllFiles(outputPath, boost::function<void (const openstudio::path&)>());
+  }
 
+  std::vector<openstudio::path> UnzipFile::extractAllFiles(const openstudio::path &outputPath,
+                                                           const boost::function<void (const openstudio::path&)>& fileExtracted) const
+  {
     std::vector<openstudio::path> retfiles;
 
-    for (std::vector<openstudio::path>::const_iterator itr = files.begin();
-         itr != files.end();
-         ++itr)
+    // walk the central directory once rather than locating each entry by name
+    bool cont = unzGoToFirstFile(m_unzFile) == UNZ_OK;
+
+    while (cont)
     {
-      if (toString(itr->filename())=="." || toString(itr->filename())=="/")
+      unz_file_info file_info;
+      std::vector<char> filename(300);
+
+      unzGetCurrentFileInfo(m_unzFile, &file_info,
+          &filename.front(), filename.size(),
+          0,0,
+          0,0);
+
+      openstudio::path file = openstudio::toPath(std::string(&filename.front(), file_info.size_filename));
+
+      if (toString(file.filename())=="." || toString(file.filename())=="/")
       {
         // This is a directory - skip it
       } else {
-        retfiles.push_back(extractFile(*itr, outputPath));
+        retfiles.push_back(extractCurrentFile(file, outputPath));
+        if (fileExtracted) {
+          fileExtracted(retfiles.back());
+        }
       }
+
+      cont = unzGoToNextFile(m_unzFile) == UNZ_OK;
     }
 
     return retfiles;
@@ -56,23 +76,28 @@ namespace openstudio {
       throw std::runtime_error("File does not exist in archive: " + openstudio::toString(filename));
     }
 
+    return extractCurrentFile(filename, outputPath);
+  }
+
+  openstudio::path UnzipFile::extractCurrentFile(const openstudio::path &filename, const openstudio::path &outputPath) const
+  {
     if (unzOpenCurrentFile(m_unzFile) != UNZ_OK)
     {
       throw std::runtime_error("Unable to open file in archive: " + openstudio::toString(filename));
     }
 
+    openstudio::path createdFile = outputPath / filename;
+
     try {
       bool cont = true;
 
-      openstudio::path createdFile = outputPath / filename;
-
       QDir().mkpath(toQString(createdFile.parent_path()));
 
       QFile file(toQString(createdFile));
       file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Truncate);
+      std::vector<char> buffer(65536);
       while (cont)
       {
-        std::vector<char> buffer(1024);
         int bytesread = unzReadCurrentFile(m_unzFile, &buffer.front(), buffer.size());
 
         if (bytesread == 0)
@@ -85,15 +110,13 @@ namespace openstudio {
         }
         else
         {
-          if (file.write(QByteArray(&buffer.front(), bytesread)) < 0)
+          if (file.write(&buffer.front(), bytesread) < 0)
           {
             throw std::runtime_error("Error writing to output file: " + toString(createdFile));
           }
         }
       }
       file.close();
-
-      return createdFile;
     } catch (...) {
       unzCloseCurrentFile(m_unzFile);
       throw;
@@ -101,6 +124,7 @@ namespace openstudio {
 
     unzCloseCurrentFile(m_unzFile);
 
+    return createdFile;
   }
 
 
@@ -4,6 +4,8 @@
 #include <utilities/UtilitiesAPI.hpp>
 #include "Path.hpp"
 
+#include <boost/function.hpp>
+
 #include <vector>
 
 namespace openstudio {
@@ -28,9 +30,18 @@ namespace openstudio {
       /// Extracts all files in the archive to the given path, preserving relative paths.
       std::vector<openstudio::path> extractAllFiles(const openstudio::path &outputPath) const;
 
+      /// Extracts all files in the archive to the given path in a single pass, calling
+      /// fileExtracted with each created file as soon as it has been written, so callers
+      /// can start processing results before the whole archive is extracted.
+      std::vector<openstudio::path> extractAllFiles(const openstudio::path &outputPath,
+                                                    const boost::function<void (const openstudio::path&)>& fileExtracted) const;
+
     private:
       void *m_unzFile;
 
+      /// Extracts the entry the archive is currently positioned at.
+      openstudio::path extractCurrentFile(const openstudio::path &filename, const openstudio::path &outputPath) const;
+
   };
 
 }
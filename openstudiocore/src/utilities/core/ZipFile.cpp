@@ -25,12 +25,210 @@
 
 #include <QDir>
 
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
 #include <fstream>
 
 namespace openstudio {
 
+  namespace {
+
+    const std::size_t zipBufferSize = 65536;
+
+    /// Size of localPath in bytes, or 0 if it cannot be determined (opening it will then
+    /// report the error).
+    boost::uintmax_t localFileSize(const openstudio::path& localPath)
+    {
+      boost::system::error_code ec;
+      boost::uintmax_t result = boost::filesystem::file_size(localPath, ec);
+      return ec ? 0 : result;
+    }
+
+    /// Whether an entry of uncompressedSize bytes needs the zip64 extensions.
+    int needsZip64(boost::uintmax_t uncompressedSize)
+    {
+      return (uncompressedSize >= 0xffffffffu) ? 1 : 0;
+    }
+
+    /// An archive entry compressed in memory, ready to be written raw into the zip.
+    struct CompressedEntry {
+      CompressedEntry() : done(false), crc(0), uncompressedSize(0) {}
+
+      bool done;
+      std::string error;
+      std::vector<char> data;
+      uLong crc;
+      ZPOS64_T uncompressedSize;
+    };
+
+    /// Reads localPath and deflates it without a zlib header (or copies it, if storeOnly),
+    /// which is the form zipWriteInFileInZip expects after opening an entry with raw=1.
+    void compressEntry(const openstudio::path& localPath, bool storeOnly, CompressedEntry& entry)
+    {
+      std::ifstream ifs(openstudio::toString(localPath).c_str(), std::ios_base::in | std::ios_base::binary);
+      if (!ifs.is_open() || ifs.fail())
+      {
+        throw std::runtime_error("Unable to open local file: " + openstudio::toString(localPath));
+      }
+
+      z_stream stream;
+      stream.zalloc = Z_NULL;
+      stream.zfree = Z_NULL;
+      stream.opaque = Z_NULL;
+      if (!storeOnly && (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK))
+      {
+        throw std::runtime_error("Unable to initialize compression for: " + openstudio::toString(localPath));
+      }
+
+      std::vector<char> buffer(zipBufferSize);
+      entry.crc = crc32(0L, Z_NULL, 0);
+      entry.uncompressedSize = 0;
+
+      try {
+        int flush = Z_NO_FLUSH;
+        do
+        {
+          ifs.read(&buffer.front(), buffer.size());
+          std::streamsize bytesread = ifs.gcount();
+
+          if (ifs.fail() && !ifs.eof())
+          {
+            throw std::runtime_error("Error reading from local file: " + openstudio::toString(localPath));
+          }
+
+          entry.crc = crc32(entry.crc, reinterpret_cast<const Bytef*>(&buffer.front()), static_cast<uInt>(bytesread));
+          entry.uncompressedSize += static_cast<ZPOS64_T>(bytesread);
+
+          if (storeOnly) {
+            entry.data.insert(entry.data.end(), buffer.begin(), buffer.begin() + bytesread);
+            continue;
+          }
+
+          flush = ifs.eof() ? Z_FINISH : Z_NO_FLUSH;
+          stream.next_in = reinterpret_cast<Bytef*>(&buffer.front());
+          stream.avail_in = static_cast<uInt>(bytesread);
+          do
+          {
+            std::size_t used = entry.data.size();
+            entry.data.resize(used + zipBufferSize);
+            stream.next_out = reinterpret_cast<Bytef*>(&entry.data[used]);
+            stream.avail_out = static_cast<uInt>(zipBufferSize);
+            deflate(&stream, flush);
+            entry.data.resize(used + zipBufferSize - stream.avail_out);
+          } while (stream.avail_out == 0);
+        } while (!ifs.eof());
+      } catch (...) {
+        if (!storeOnly) {
+          deflateEnd(&stream);
+        }
+        throw;
+      }
+
+      if (!storeOnly) {
+        deflateEnd(&stream);
+      }
+    }
+
+    /// State shared between the thread writing the archive and the threads compressing
+    /// entries. At most window entries, and beyond the first of them at most maxBufferedBytes
+    /// of file data, are held in memory ahead of the writer. Files larger than
+    /// maxBufferedEntrySize are skipped here and streamed by the writer.
+    struct CompressionQueue {
+      CompressionQueue(const std::vector<std::pair<openstudio::path,openstudio::path> >& t_files,
+                       const std::vector<boost::uintmax_t>& t_sizes,
+                       bool t_storeOnly,
+                       std::size_t t_window,
+                       boost::uintmax_t t_maxBufferedBytes,
+                       boost::uintmax_t t_maxBufferedEntrySize)
+        : files(t_files), sizes(t_sizes), storeOnly(t_storeOnly), window(t_window),
+          maxBufferedBytes(t_maxBufferedBytes), maxBufferedEntrySize(t_maxBufferedEntrySize),
+          entries(t_files.size()), next(0), written(0), bufferedBytes(0), aborted(false)
+      {}
+
+      const std::vector<std::pair<openstudio::path,openstudio::path> >& files;
+      const std::vector<boost::uintmax_t>& sizes;
+      bool storeOnly;
+      std::size_t window;
+      boost::uintmax_t maxBufferedBytes;
+      boost::uintmax_t maxBufferedEntrySize;
+      std::vector<CompressedEntry> entries;
+      std::size_t next;
+      std::size_t written;
+      boost::uintmax_t bufferedBytes;
+      bool aborted;
+      boost::mutex mutex;
+      boost::condition_variable changed;
+
+      bool streamed(std::size_t index) const
+      {
+        return sizes[index] > maxBufferedEntrySize;
+      }
+
+      void compressEntries()
+      {
+        while (true)
+        {
+          std::size_t index;
+          {
+            boost::unique_lock<boost::mutex> lock(mutex);
+            while (true) {
+              while ((next < files.size()) && streamed(next)) {
+                ++next;
+              }
+              if (aborted || (next >= files.size())) {
+                return;
+              }
+              if ((next < written + window) &&
+                  ((bufferedBytes == 0) || (bufferedBytes + sizes[next] <= maxBufferedBytes)))
+              {
+                break;
+              }
+              changed.wait(lock);
+            }
+            index = next++;
+            bufferedBytes += sizes[index];
+          }
+
+          CompressedEntry entry;
+          try {
+            compressEntry(files[index].first, storeOnly, entry);
+          } catch (const std::exception& e) {
+            entry.error = e.what();
+          }
+          entry.done = true;
+
+          {
+            boost::unique_lock<boost::mutex> lock(mutex);
+            entries[index].data.swap(entry.data);
+            entries[index].error = entry.error;
+            entries[index].crc = entry.crc;
+            entries[index].uncompressedSize = entry.uncompressedSize;
+            entries[index].done = true;
+          }
+          changed.notify_all();
+        }
+      }
+
+      void abort()
+      {
+        {
+          boost::unique_lock<boost::mutex> lock(mutex);
+          aborted = true;
+        }
+        changed.notify_all();
+      }
+    };
+
+  }
+
   ZipFile::ZipFile(const openstudio::path &filename, bool add)
-    : m_zipFile(zipOpen(openstudio::toString(filename).c_str(), add?APPEND_STATUS_ADDINZIP:APPEND_STATUS_CREATE))
+    : m_zipFile(zipOpen(openstudio::toString(filename).c_str(), add?APPEND_STATUS_ADDINZIP:APPEND_STATUS_CREATE)),
+      m_storeOnly(false),
+      m_numThreads(0),
+      m_maxBufferedBytes(256 * 1024 * 1024)
   {
     if (!m_zipFile) {
       throw std::runtime_error("ZipFile " + openstudio::toString(filename) + " could not be opened");
@@ -42,15 +240,46 @@ namespace openstudio {
     zipClose(m_zipFile, 0);
   }
 
+  void ZipFile::setStoreOnly(bool storeOnly)
+  {
+    m_storeOnly = storeOnly;
+  }
+
+  bool ZipFile::storeOnly() const
+  {
+    return m_storeOnly;
+  }
+
+  void ZipFile::setNumThreads(unsigned numThreads)
+  {
+    m_numThreads = numThreads;
+  }
+
+  unsigned ZipFile::numThreads() const
+  {
+    return m_numThreads;
+  }
+
+  void ZipFile::setMaxBufferedBytes(boost::uintmax_t maxBufferedBytes)
+  {
+    m_maxBufferedBytes = maxBufferedBytes;
+  }
+
+  boost::uintmax_t ZipFile::maxBufferedBytes() const
+  {
+    return m_maxBufferedBytes;
+  }
+
   void ZipFile::addFile(const openstudio::path &localPath, const openstudio::path &destinationPath)
   {
-    if (zipOpenNewFileInZip(m_zipFile, openstudio::toString(destinationPath).c_str(),
+    if (zipOpenNewFileInZip64(m_zipFile, openstudio::toString(destinationPath).c_str(),
           0,
           0, 0,
           0, 0,
           0,
-          Z_DEFLATED,
-          Z_DEFAULT_COMPRESSION) != ZIP_OK)
+          m_storeOnly ? 0 : Z_DEFLATED,
+          m_storeOnly ? Z_NO_COMPRESSION : Z_DEFAULT_COMPRESSION,
+          needsZip64(localFileSize(localPath))) != ZIP_OK)
     {
       throw std::runtime_error("Unable to create new file in archive: " + openstudio::toString(destinationPath));
     }
@@ -63,9 +292,9 @@ namespace openstudio {
         throw std::runtime_error("Unable to open local file: " + openstudio::toString(localPath));
       }
 
+      std::vector<char> buffer(zipBufferSize);
       while (!ifs.eof())
       {
-        std::vector<char> buffer(1024);
         ifs.read(&buffer.front(), buffer.size());
         std::streamsize bytesread = ifs.gcount();
 
@@ -84,7 +313,119 @@ namespace openstudio {
     zipCloseFileInZip(m_zipFile);
   }
 
+  void ZipFile::addFiles(const std::vector<std::pair<openstudio::path,openstudio::path> >& files)
+  {
+    unsigned numThreads = m_numThreads;
+    if (numThreads == 0) {
+      numThreads = std::max(1u, boost::thread::hardware_concurrency());
+    }
+    numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, files.size()));
+
+    if (numThreads <= 1) {
+      for (std::vector<std::pair<openstudio::path,openstudio::path> >::const_iterator itr = files.begin();
+           itr != files.end();
+           ++itr)
+      {
+        addFile(itr->first, itr->second);
+      }
+      return;
+    }
+
+    std::vector<boost::uintmax_t> sizes;
+    sizes.reserve(files.size());
+    for (std::vector<std::pair<openstudio::path,openstudio::path> >::const_iterator itr = files.begin();
+         itr != files.end();
+         ++itr)
+    {
+      sizes.push_back(localFileSize(itr->first));
+    }
+
+    CompressionQueue queue(files, sizes, m_storeOnly, 2 * numThreads, m_maxBufferedBytes, m_maxBufferedBytes / 4);
+    boost::thread_group threads;
+    for (unsigned i = 0; i < numThreads; ++i) {
+      threads.create_thread(boost::bind(&CompressionQueue::compressEntries, &queue));
+    }
+
+    try {
+      for (std::size_t i = 0; i < files.size(); ++i)
+      {
+        if (queue.streamed(i)) {
+          // too large to hold in memory, compress it here as it is written
+          addFile(files[i].first, files[i].second);
+
+          {
+            boost::unique_lock<boost::mutex> lock(queue.mutex);
+            ++queue.written;
+          }
+          queue.changed.notify_all();
+          continue;
+        }
+
+        CompressedEntry entry;
+        {
+          boost::unique_lock<boost::mutex> lock(queue.mutex);
+          while (!queue.entries[i].done) {
+            queue.changed.wait(lock);
+          }
+          entry.data.swap(queue.entries[i].data);
+          entry.error = queue.entries[i].error;
+          entry.crc = queue.entries[i].crc;
+          entry.uncompressedSize = queue.entries[i].uncompressedSize;
+        }
+
+        if (!entry.error.empty()) {
+          throw std::runtime_error(entry.error);
+        }
+
+        const openstudio::path& destinationPath = files[i].second;
+        if (zipOpenNewFileInZip2_64(m_zipFile, openstudio::toString(destinationPath).c_str(),
+              0,
+              0, 0,
+              0, 0,
+              0,
+              m_storeOnly ? 0 : Z_DEFLATED,
+              m_storeOnly ? Z_NO_COMPRESSION : Z_DEFAULT_COMPRESSION,
+              1,
+              needsZip64(entry.uncompressedSize)) != ZIP_OK)
+        {
+          throw std::runtime_error("Unable to create new file in archive: " + openstudio::toString(destinationPath));
+        }
+
+        if (!entry.data.empty() &&
+            (zipWriteInFileInZip(m_zipFile, &entry.data.front(), static_cast<unsigned int>(entry.data.size())) != ZIP_OK))
+        {
+          zipCloseFileInZipRaw64(m_zipFile, entry.uncompressedSize, entry.crc);
+          throw std::runtime_error("Unable to write file to archive: " + openstudio::toString(destinationPath));
+        }
+
+        zipCloseFileInZipRaw64(m_zipFile, entry.uncompressedSize, entry.crc);
+
+        {
+          boost::unique_lock<boost::mutex> lock(queue.mutex);
+          ++queue.written;
+          queue.bufferedBytes -= sizes[i];
+        }
+        queue.changed.notify_all();
+      }
+    } catch (...) {
+      queue.abort();
+      threads.join_all();
+      throw;
+    }
+
+    threads.join_all();
+  }
+
   void ZipFile::addDirectory(const openstudio::path& localDir, const openstudio::path& destinationDir) {
+    std::vector<std::pair<openstudio::path,openstudio::path> > files;
+    listDirectory(localDir, destinationDir, files);
+    addFiles(files);
+  }
+
+  void ZipFile::listDirectory(const openstudio::path& localDir,
+                              const openstudio::path& destinationDir,
+                              std::vector<std::pair<openstudio::path,openstudio::path> >& files)
+  {
     // following conventions in openstudio::copyDirectory
     QDir srcDir(toQString(localDir));
 
@@ -92,10 +433,10 @@ namespace openstudio {
       QString srcItemPath = toQString(localDir) + "/" + info.fileName();
       QString dstItemPath = toQString(destinationDir) + "/" + info.fileName();
       if (info.isDir()) {
-        addDirectory(toPath(srcItemPath),toPath(dstItemPath));
+        listDirectory(toPath(srcItemPath),toPath(dstItemPath),files);
       }
       else if (info.isFile()) {
-        addFile(toPath(srcItemPath),toPath(dstItemPath));
+        files.push_back(std::make_pair(toPath(srcItemPath),toPath(dstItemPath)));
       }
     }
   }
@@ -103,4 +444,3 @@ namespace openstudio {
 
 }
 
-
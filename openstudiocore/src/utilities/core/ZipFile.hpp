@@ -4,6 +4,9 @@
 #include <utilities/UtilitiesAPI.hpp>
 #include "Path.hpp"
 
+#include <boost/cstdint.hpp>
+
+#include <utility>
 #include <vector>
 
 namespace openstudio {
@@ -17,16 +20,47 @@ namespace openstudio {
 
       ~ZipFile();
 
+      /// If true, files added from now on are stored without compression. Useful for payloads
+      /// that are already compressed (zip, gz, png, ...), where deflating costs time and saves
+      /// nothing. Defaults to false.
+      void setStoreOnly(bool storeOnly);
+      bool storeOnly() const;
+
+      /// Sets the number of threads used to compress files in addFiles and addDirectory.
+      /// 0, the default, uses one thread per processor; 1 compresses on the calling thread.
+      void setNumThreads(unsigned numThreads);
+      unsigned numThreads() const;
+
+      /// Sets how much file data addFiles may hold in memory while compressing in parallel.
+      /// Files larger than a quarter of this are not buffered; they are compressed on the
+      /// calling thread as they are written. Defaults to 256 MB.
+      void setMaxBufferedBytes(boost::uintmax_t maxBufferedBytes);
+      boost::uintmax_t maxBufferedBytes() const;
+
       /// Adds localPath to the ZipFile, placing it at relative location destinationPath
       /// in the archive.
       void addFile(const openstudio::path &localPath, const openstudio::path &destinationPath);
 
+      /// Adds each (localPath, destinationPath) pair to the ZipFile. Files are compressed in
+      /// parallel, within the maxBufferedBytes() memory bound, but entries are written to the
+      /// archive in the order given. Throws if any file cannot be read, in which case the
+      /// entries before it have been added.
+      void addFiles(const std::vector<std::pair<openstudio::path,openstudio::path> >& files);
+
       /// Recursively adds all files in localDir to the ZipFile, placing them in the archive
-      /// relative to destinationDir.
+      /// relative to destinationDir. Goes through addFiles, so large result files such as
+      /// eplusout.sql are streamed rather than held in memory.
       void addDirectory(const openstudio::path& localDir, const openstudio::path& destinationDir);
 
     private:
       void *m_zipFile;
+      bool m_storeOnly;
+      unsigned m_numThreads;
+      boost::uintmax_t m_maxBufferedBytes;
+
+      static void listDirectory(const openstudio::path& localDir,
+                                const openstudio::path& destinationDir,
+                                std::vector<std::pair<openstudio::path,openstudio::path> >& files);
 
   };
 
@@ -0,0 +1,100 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/core/CopyOnWriteVector.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <string>
+
+using openstudio::CopyOnWriteVector;
+
+TEST(CopyOnWriteVector, SharesUntilWritten)
+{
+  CopyOnWriteVector<std::string> a;
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(0u, a.size());
+  EXPECT_TRUE(a.begin() == a.end());
+
+  a.push_back("Hello");
+  a.push_back("World");
+  EXPECT_FALSE(a.isShared());
+
+  CopyOnWriteVector<std::string> b(a);
+  EXPECT_TRUE(a.isShared());
+  EXPECT_TRUE(b.isShared());
+  EXPECT_EQ(&a.get(), &b.get());
+
+  // reads do not copy, even through a non-const instance
+  EXPECT_EQ("World", b[1]);
+  EXPECT_EQ("World", b.back());
+  unsigned n = 0;
+  BOOST_FOREACH(const std::string& s, b) {
+    EXPECT_FALSE(s.empty());
+    ++n;
+  }
+  EXPECT_EQ(2u, n);
+  EXPECT_TRUE(b.isShared());
+
+  // first write copies
+  b.set(1, "There");
+  EXPECT_FALSE(a.isShared());
+  EXPECT_FALSE(b.isShared());
+  EXPECT_EQ("World", a[1]);
+  EXPECT_EQ("There", b[1]);
+
+  // resizing to the same size does not copy
+  CopyOnWriteVector<std::string> c = a;
+  c.resize(2);
+  EXPECT_TRUE(c.isShared());
+  c.resize(3);
+  EXPECT_FALSE(c.isShared());
+  EXPECT_EQ(2u, a.size());
+  EXPECT_EQ(3u, c.size());
+
+  c.pop_back();
+  c.pop_back();
+  EXPECT_EQ(1u, c.size());
+  EXPECT_EQ(2u, a.size());
+}
+
+TEST(CopyOnWriteVector, ConvertsToAndFromVector)
+{
+  std::vector<std::string> v;
+  v.push_back("a");
+  v.push_back("b");
+
+  CopyOnWriteVector<std::string> a(v);
+  EXPECT_EQ(v, a.get());
+  v[0] = "c";
+  EXPECT_EQ("a", a.get()[0]);
+
+  std::vector<std::string> w = a;
+  EXPECT_EQ(2u, w.size());
+
+  a = std::vector<std::string>();
+  EXPECT_TRUE(a.empty());
+
+  a.detach().push_back("d");
+  EXPECT_EQ(1u, a.size());
+  a.clear();
+  EXPECT_TRUE(a.empty());
+}
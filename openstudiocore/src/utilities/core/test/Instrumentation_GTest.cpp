@@ -0,0 +1,95 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include <utilities/core/test/CoreFixture.hpp>
+
+#include <utilities/core/Instrumentation.hpp>
+#include <utilities/core/Json.hpp>
+
+#include <QVariant>
+
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+
+#include <sstream>
+
+using namespace openstudio;
+
+namespace {
+
+  void timedFunction()
+  {
+    OS_TIMER("timedFunction");
+    OS_COUNT("timedFunction calls", 1);
+  }
+
+}
+
+TEST_F(CoreFixture, Instrumentation)
+{
+  bool wasEnabled = Instrumentation::instance().enabled();
+
+  Instrumentation::instance().setEnabled(false);
+  Instrumentation::instance().clear();
+  timedFunction();
+  EXPECT_TRUE(Instrumentation::instance().events().empty());
+
+  Instrumentation::instance().setEnabled(true);
+  unsigned thread = Instrumentation::instance().currentThread();
+  long long start = Instrumentation::instance().now();
+  for (unsigned i = 0; i < 3; ++i) {
+    timedFunction();
+  }
+
+  std::vector<InstrumentationEvent> events = Instrumentation::instance().events(thread, start);
+  ASSERT_EQ(6u, events.size());
+  unsigned timers = 0;
+  long long calls = 0;
+  BOOST_FOREACH(const InstrumentationEvent& event, events) {
+    EXPECT_EQ(thread, event.thread);
+    EXPECT_GE(event.start, start);
+    if (event.isCounter) {
+      EXPECT_EQ("timedFunction calls", event.name);
+      calls += event.count;
+    } else {
+      EXPECT_EQ("timedFunction", event.name);
+      EXPECT_GE(event.duration, 0);
+      ++timers;
+    }
+  }
+  EXPECT_EQ(3u, timers);
+  EXPECT_EQ(3, calls);
+
+  std::stringstream ss;
+  InstrumentationSingleton::printSummary(events, ss);
+  EXPECT_NE(std::string::npos, ss.str().find("timedFunction calls"));
+
+  openstudio::path p = toPath("./Instrumentation.json");
+  if (boost::filesystem::exists(p)) {
+    boost::filesystem::remove(p);
+  }
+  EXPECT_TRUE(Instrumentation::instance().saveChromeTrace(p));
+  QVariant trace = loadJSON(p);
+  EXPECT_EQ(6, trace.toMap()["traceEvents"].toList().size());
+
+  Instrumentation::instance().clear();
+  EXPECT_TRUE(Instrumentation::instance().events().empty());
+  Instrumentation::instance().setEnabled(wasEnabled);
+}
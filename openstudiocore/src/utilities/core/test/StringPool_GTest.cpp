@@ -0,0 +1,173 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/core/StringPool.hpp>
+#include <utilities/core/InternedStringVector.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <string>
+#include <vector>
+
+using openstudio::StringPool;
+using openstudio::StringPoolSingleton;
+using openstudio::InternedStringVector;
+
+TEST(StringPool, Intern)
+{
+  StringPoolSingleton::StringPtr a = StringPool::instance().intern("Autosize");
+  StringPoolSingleton::StringPtr b = StringPool::instance().intern(std::string("Auto") + "size");
+  ASSERT_TRUE(a);
+  EXPECT_EQ("Autosize", *a);
+  EXPECT_EQ(a.get(), b.get());
+
+  EXPECT_FALSE(StringPool::instance().intern(""));
+
+  // long values are not pooled
+  std::string longValue(StringPoolSingleton::maxInternedLength() + 1, 'x');
+  StringPoolSingleton::StringPtr c = StringPool::instance().intern(longValue);
+  StringPoolSingleton::StringPtr d = StringPool::instance().intern(longValue);
+  EXPECT_EQ(longValue, *c);
+  EXPECT_NE(c.get(), d.get());
+}
+
+TEST(StringPool, Purge)
+{
+  StringPool::instance().purge();
+  unsigned n = StringPool::instance().numStrings();
+
+  {
+    StringPoolSingleton::StringPtr a = StringPool::instance().intern("StringPool_Purge value");
+    EXPECT_EQ(n + 1, StringPool::instance().numStrings());
+    StringPool::instance().purge();
+    EXPECT_EQ(n + 1, StringPool::instance().numStrings());
+  }
+
+  StringPool::instance().purge();
+  EXPECT_EQ(n, StringPool::instance().numStrings());
+}
+
+TEST(StringPool, InternedStringVector)
+{
+  std::vector<std::string> values;
+  values.push_back("Yes");
+  values.push_back("");
+  values.push_back("Yes");
+
+  InternedStringVector v(values);
+  ASSERT_EQ(3u, v.size());
+  EXPECT_EQ("Yes", v[0]);
+  EXPECT_EQ("", v[1]);
+  EXPECT_EQ(&v[0], &v[2]);
+  EXPECT_EQ(2u, v.numNonEmpty());
+  EXPECT_EQ(values, v.strings());
+
+  InternedStringVector w = v;
+  EXPECT_TRUE(w.isShared());
+  w.set(1, "No");
+  w.push_back("Maybe");
+  EXPECT_FALSE(v.isShared());
+  EXPECT_EQ("", v[1]);
+  EXPECT_EQ("No", w[1]);
+  EXPECT_EQ(3u, v.size());
+  EXPECT_EQ(4u, w.size());
+  EXPECT_EQ("Maybe", w.back());
+
+  w.resize(6);
+  EXPECT_EQ("", w[5]);
+  w.pop_back();
+  EXPECT_EQ(5u, w.size());
+}
+
+
+namespace {
+
+  void internValues(const std::vector<std::string>& values,
+                    std::vector<StringPoolSingleton::StringPtr>& result)
+  {
+    for (unsigned i = 0; i < values.size(); ++i) {
+      result.push_back(StringPool::instance().intern(values[i]));
+    }
+  }
+
+}
+
+TEST(StringPool, Threads)
+{
+  std::vector<std::string> values;
+  for (unsigned i = 0; i < 500; ++i) {
+    values.push_back("StringPool_Threads " + boost::lexical_cast<std::string>(i));
+  }
+
+  // values land in different stripes, but each one is still stored once
+  std::vector<std::vector<StringPoolSingleton::StringPtr> > results(4);
+  boost::thread_group threads;
+  for (unsigned i = 0; i < results.size(); ++i) {
+    threads.create_thread(boost::bind(internValues, boost::cref(values), boost::ref(results[i])));
+  }
+  threads.join_all();
+
+  for (unsigned i = 0; i < results.size(); ++i) {
+    ASSERT_EQ(values.size(), results[i].size());
+    for (unsigned j = 0; j < values.size(); ++j) {
+      EXPECT_EQ(values[j], *results[i][j]);
+      EXPECT_EQ(results[0][j].get(), results[i][j].get());
+    }
+  }
+
+  StringPool::instance().purge();
+  unsigned n = StringPool::instance().numStrings();
+  results.clear();
+  StringPool::instance().purge();
+  EXPECT_EQ(n - values.size(), StringPool::instance().numStrings());
+}
+
+TEST(StringPool, ThreadCache)
+{
+  StringPool::instance().purge();
+  unsigned n = StringPool::instance().numStrings();
+
+  StringPoolSingleton::StringPtr a = StringPool::instance().intern("StringPool_ThreadCache a");
+  StringPoolSingleton::StringPtr c;
+  {
+    StringPoolSingleton::ThreadCache cache;
+    StringPoolSingleton::ThreadCache nested;
+    StringPoolSingleton::StringPtr b = StringPool::instance().intern("StringPool_ThreadCache a");
+    c = StringPool::instance().intern("StringPool_ThreadCache c");
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_EQ(c.get(), StringPool::instance().intern("StringPool_ThreadCache c").get());
+    StringPoolSingleton::StringPtr d = StringPool::instance().intern("StringPool_ThreadCache d");
+  }
+
+  // values interned through the cache are in the shared pool
+  std::vector<StringPoolSingleton::StringPtr> result;
+  std::vector<std::string> values(1, "StringPool_ThreadCache c");
+  boost::thread worker(boost::bind(internValues, boost::cref(values), boost::ref(result)));
+  worker.join();
+  ASSERT_EQ(1u, result.size());
+  EXPECT_EQ(c.get(), result[0].get());
+
+  // and the cache no longer holds them once it is gone
+  StringPool::instance().purge();
+  EXPECT_EQ(n + 2, StringPool::instance().numStrings());
+}
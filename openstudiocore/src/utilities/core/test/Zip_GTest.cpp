@@ -22,6 +22,11 @@
 #include <resources.hxx>
 
 #include <boost/filesystem.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <iterator>
 
 #include <utilities/core/test/CoreFixture.hpp>
 #include <utilities/core/UnzipFile.hpp>
@@ -35,6 +40,13 @@ std::ostream& operator<<(std::ostream& t_o, const openstudio::path &t_path)
 }
 #endif
 
+namespace {
+  void recordExtractedFile(std::vector<openstudio::path>* extracted, const openstudio::path& file)
+  {
+    extracted->push_back(file);
+  }
+}
+
 TEST_F(CoreFixture, Unzip_NonExistTest)
 {
   openstudio::path p = resourcesPath()/openstudio::toPath("utilities/Zip/blarg.zip");
@@ -169,4 +181,138 @@ TEST_F(CoreFixture, Zip_AppendFile)
   EXPECT_EQ(outpath / openstudio::toPath("in/some/subdir/added2.zip"), createdFiles[1]);
 }
 
+TEST_F(CoreFixture, Unzip_ExtractAllFilesCallbackTest)
+{
+  openstudio::path p = resourcesPath()/openstudio::toPath("utilities/Zip/test1.zip");
+
+  openstudio::UnzipFile uf(p);
+
+  openstudio::path outpath = openstudio::tempDir() / openstudio::toPath("ExtractAllFilesCallbackTest");
+  boost::filesystem::remove_all(outpath);
+
+  std::vector<openstudio::path> extracted;
+  std::vector<openstudio::path> createdFiles = uf.extractAllFiles(outpath, boost::bind(&recordExtractedFile, &extracted, _1));
+
+  ASSERT_EQ(4u, createdFiles.size());
+  EXPECT_TRUE(createdFiles == extracted);
+}
+
+TEST_F(CoreFixture, Zip_AddDirectoryParallel)
+{
+  openstudio::path p = resourcesPath()/openstudio::toPath("utilities/Zip/test1.zip");
+  openstudio::path outpath = openstudio::tempDir() / openstudio::toPath("AddDirectoryParallelTest");
+  openstudio::path srcpath = outpath / openstudio::toPath("src");
+  openstudio::path outzip = outpath / openstudio::toPath("new.zip");
+
+  boost::filesystem::remove_all(outpath);
+  std::vector<openstudio::path> srcFiles = openstudio::UnzipFile(p).extractAllFiles(srcpath);
+  ASSERT_EQ(4u, srcFiles.size());
+
+  std::vector<std::pair<openstudio::path,openstudio::path> > files;
+  for (unsigned i = 0; i < 10; ++i) {
+    for (std::vector<openstudio::path>::const_iterator itr = srcFiles.begin(); itr != srcFiles.end(); ++itr) {
+      files.push_back(std::make_pair(*itr, openstudio::toPath("copy" + boost::lexical_cast<std::string>(i)) / itr->filename()));
+    }
+  }
+
+  {
+    openstudio::ZipFile zf(outzip, false);
+    zf.setNumThreads(4);
+    zf.addFiles(files);
+    zf.addDirectory(srcpath, openstudio::toPath("dir"));
+  }
+
+  openstudio::UnzipFile uf(outzip);
+  std::vector<openstudio::path> list = uf.listFiles();
+  ASSERT_EQ(files.size() + srcFiles.size(), list.size());
+  for (unsigned i = 0; i < files.size(); ++i) {
+    EXPECT_EQ(files[i].second, list[i]);
+  }
+
+  std::vector<openstudio::path> createdFiles = uf.extractAllFiles(outpath / openstudio::toPath("out"));
+  ASSERT_EQ(list.size(), createdFiles.size());
+  for (unsigned i = 0; i < files.size(); ++i) {
+    ASSERT_TRUE(boost::filesystem::exists(createdFiles[i]));
+    EXPECT_EQ(boost::filesystem::file_size(files[i].first), boost::filesystem::file_size(createdFiles[i]));
+  }
+}
 
+TEST_F(CoreFixture, Zip_StoreOnly)
+{
+  openstudio::path p = resourcesPath()/openstudio::toPath("utilities/Zip/test1.zip");
+  openstudio::path outpath = openstudio::tempDir() / openstudio::toPath("StoreOnlyTest");
+  openstudio::path outzip = outpath / openstudio::toPath("new.zip");
+
+  boost::filesystem::remove_all(outpath);
+
+  {
+    boost::filesystem::create_directories(outzip.parent_path());
+    openstudio::ZipFile zf(outzip, false);
+    zf.setStoreOnly(true);
+    EXPECT_TRUE(zf.storeOnly());
+    zf.addFile(p, openstudio::toPath("added.zip"));
+    zf.setNumThreads(2);
+    std::vector<std::pair<openstudio::path,openstudio::path> > files;
+    files.push_back(std::make_pair(p, openstudio::toPath("added2.zip")));
+    files.push_back(std::make_pair(p, openstudio::toPath("added3.zip")));
+    zf.addFiles(files);
+  }
+
+  // stored entries are not smaller than their contents
+  EXPECT_LT(3 * boost::filesystem::file_size(p), boost::filesystem::file_size(outzip));
+
+  openstudio::UnzipFile uf(outzip);
+  std::vector<openstudio::path> createdFiles = uf.extractAllFiles(outpath);
+
+  ASSERT_EQ(3u, createdFiles.size());
+  for (std::vector<openstudio::path>::const_iterator itr = createdFiles.begin(); itr != createdFiles.end(); ++itr) {
+    ASSERT_TRUE(boost::filesystem::exists(*itr));
+    EXPECT_EQ(boost::filesystem::file_size(p), boost::filesystem::file_size(*itr));
+  }
+}
+
+TEST_F(CoreFixture, Zip_MaxBufferedBytes)
+{
+  openstudio::path outpath = openstudio::tempDir() / openstudio::toPath("MaxBufferedBytesTest");
+  openstudio::path srcpath = outpath / openstudio::toPath("src");
+  openstudio::path outzip = outpath / openstudio::toPath("new.zip");
+
+  boost::filesystem::remove_all(outpath);
+  boost::filesystem::create_directories(srcpath);
+
+  // with an 8 KB bound, entries over 2 KB are streamed on the writing thread and the rest
+  // are compressed ahead of it
+  unsigned sizes[] = {100, 3000, 9000, 0, 500, 2048, 2049, 7000, 10, 4000};
+  std::vector<std::pair<openstudio::path,openstudio::path> > files;
+  for (unsigned i = 0; i < 10; ++i) {
+    openstudio::path file = srcpath / openstudio::toPath("file" + boost::lexical_cast<std::string>(i) + ".txt");
+    std::ofstream ofs(openstudio::toString(file).c_str(), std::ios_base::out | std::ios_base::binary);
+    for (unsigned j = 0; j < sizes[i]; ++j) {
+      ofs.put(static_cast<char>('a' + (i * j) % 7));
+    }
+    files.push_back(std::make_pair(file, openstudio::toPath("files") / file.filename()));
+  }
+
+  {
+    openstudio::ZipFile zf(outzip, false);
+    zf.setNumThreads(4);
+    zf.setMaxBufferedBytes(8192);
+    EXPECT_EQ(8192u, zf.maxBufferedBytes());
+    zf.addFiles(files);
+  }
+
+  openstudio::UnzipFile uf(outzip);
+  std::vector<openstudio::path> list = uf.listFiles();
+  ASSERT_EQ(files.size(), list.size());
+  std::vector<openstudio::path> createdFiles = uf.extractAllFiles(outpath / openstudio::toPath("out"));
+  ASSERT_EQ(files.size(), createdFiles.size());
+  for (unsigned i = 0; i < files.size(); ++i) {
+    EXPECT_EQ(files[i].second, list[i]);
+    std::ifstream expected(openstudio::toString(files[i].first).c_str(), std::ios_base::in | std::ios_base::binary);
+    std::ifstream actual(openstudio::toString(createdFiles[i]).c_str(), std::ios_base::in | std::ios_base::binary);
+    std::string expectedContents((std::istreambuf_iterator<char>(expected)), std::istreambuf_iterator<char>());
+    std::string actualContents((std::istreambuf_iterator<char>(actual)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(sizes[i], actualContents.size());
+    EXPECT_TRUE(expectedContents == actualContents);
+  }
+}
@@ -25,6 +25,7 @@
 
 #include <utilities/core/PathHelpers.hpp>
 #include <utilities/core/Assert.hpp>
+#include <utilities/core/Instrumentation.hpp>
 
 #include <utilities/core/Containers.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -438,6 +439,7 @@ std::vector<IddObject> IddFile::uniqueObjects() const
 
 OptionalIddFile IddFile::load(std::istream& is)
 {
+  OS_TIMER("IddFile::load");
   boost::shared_ptr<detail::IddFile_Impl> p = detail::IddFile_Impl::load(is);
   if (p) { return IddFile(p); }
   return boost::none;
@@ -35,17 +35,24 @@
 #include <utilities/core/String.hpp>
 #include <utilities/core/Assert.hpp>
 #include <utilities/core/Compare.hpp>
+#include <utilities/core/Instrumentation.hpp>
+#include <utilities/core/StringPool.hpp>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/foreach.hpp>
 #include <boost/regex.hpp>
 #include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/filter/newline.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <boost/thread/thread.hpp>
 
+#include <QThread>
+
+#include <algorithm>
 #include <sstream>
 
 namespace openstudio {
@@ -327,12 +334,14 @@ boost::optional<IdfFile> IdfFile::load(std::istream& is,
                                        const IddFileType& iddFileType, 
                                        ProgressBar* progressBar) 
 {
+  OS_TIMER("IdfFile::load");
   IdfFile result(iddFileType);
   // remove initial version object
   if (OptionalIdfObject vo = result.versionObject()) {
     result.removeObject(*vo);
   }
   if (result.m_load(is, progressBar)) {
+    OS_COUNT("IdfFile::load objects", result.numObjects());
     // check for it again here
     result.addVersionObject();
     return result;
@@ -344,12 +353,14 @@ OptionalIdfFile IdfFile::load(std::istream& is,
                               const IddFile& iddFile, 
                               ProgressBar* progressBar) 
 {
+  OS_TIMER("IdfFile::load");
   IdfFile result(iddFile);
   // remove initial version object
   if (OptionalIdfObject vo = result.versionObject()) {
     result.removeObject(*vo);
   }
   if (result.m_load(is, progressBar)) {
+    OS_COUNT("IdfFile::load objects", result.numObjects());
     // check for it again here
     result.addVersionObject();
     return result;
@@ -418,6 +429,55 @@ OptionalIdfFile IdfFile::load(const path& p, const IddFile& iddFile, ProgressBar
   return boost::none;
 }
 
+OptionalIdfFile IdfFile::loadParallel(std::istream& is, 
+                                      const IddFileType& iddFileType, 
+                                      unsigned numThreads)
+{
+  OS_TIMER("IdfFile::loadParallel");
+  if (numThreads == 0) {
+    numThreads = std::max(1u,boost::thread::hardware_concurrency());
+  }
+
+  IdfFile result(iddFileType);
+  // remove initial version object
+  if (OptionalIdfObject vo = result.versionObject()) {
+    result.removeObject(*vo);
+  }
+  if (result.m_load(is,NULL,false,numThreads)) {
+    OS_COUNT("IdfFile::load objects", result.numObjects());
+    // check for it again here
+    result.addVersionObject();
+    return result;
+  }
+  return boost::none;
+}
+
+OptionalIdfFile IdfFile::loadParallel(const path& p, 
+                                      const IddFileType& iddFileType, 
+                                      unsigned numThreads) 
+{
+  // complete path as load does
+  path wp(p);
+
+  if (iddFileType == IddFileType::OpenStudio) { 
+    wp = completePathToFile(wp,path(),modelFileExtension(),false);
+    if (wp.empty()) { wp = completePathToFile(wp,path(),componentFileExtension(),false); }
+  }
+  else { 
+    wp = completePathToFile(wp,path(),"idf",true); 
+  }
+
+  boost::filesystem::ifstream inFile(wp);
+  if (inFile) {
+    try {
+      return loadParallel(inFile, iddFileType, numThreads);
+    }
+    catch (...) { return boost::none; }
+  }
+
+  return boost::none;
+}
+
 boost::optional<VersionString> IdfFile::loadVersionOnly(std::istream& is) {
   boost::optional<VersionString> result;
   IddFile catchallIdd = IddFile::catchallIddFile();
@@ -450,17 +510,23 @@ boost::optional<VersionString> IdfFile::loadVersionOnly(const path& p) {
 }
 
 std::ostream& IdfFile::print(std::ostream& os) const {
-  if (!m_header.empty()) {
-    os << m_header << std::endl;
+  return print(os,true);
+}
+
+std::ostream& IdfFile::print(std::ostream& os, bool includeComments) const {
+  if (includeComments) {
+    if (!m_header.empty()) {
+      os << m_header << '\n';
+    }
+    os << '\n';
   }
-  os << std::endl;
   BOOST_FOREACH(const IdfObject& object, m_objects){
-    object.print(os);
+    object.print(os,includeComments);
   }
   return os;
 }
 
-bool IdfFile::save(const openstudio::path& p, bool overwrite) {
+bool IdfFile::save(const openstudio::path& p, bool overwrite, bool includeComments) {
 
   // default extension
   std::string expectedExtension;
@@ -501,10 +567,14 @@ bool IdfFile::save(const openstudio::path& p, bool overwrite) {
   }
 
   if (makeParentFolder(wp)) {
-    boost::filesystem::ofstream outFile(wp);
+    // large write buffer, must be installed before the file is opened
+    std::vector<char> buffer(1 << 20);
+    boost::filesystem::ofstream outFile;
+    outFile.rdbuf()->pubsetbuf(&buffer[0],buffer.size());
+    outFile.open(wp);
     if (outFile) {
       try {
-        print(outFile);
+        print(outFile,includeComments);
         outFile.close();
         return true;
       }
@@ -524,7 +594,103 @@ bool IdfFile::save(const openstudio::path& p, bool overwrite) {
 
 // SERIALIZATION
 
-bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnly) {
+namespace {
+
+  typedef std::pair<std::string,IddObject> ObjectText;
+
+  /** Constructs the function-local static strings and regular expressions used by
+   *  IdfObject::load, which are not safe to initialize from several threads at once. */
+  void initializeParserStatics()
+  {
+    idfRegex::newLinestring();
+    idfRegex::optionalNewLinestring();
+    idfRegex::commentOnlyLine();
+    idfRegex::contentAndCommentLine();
+    idfRegex::objectEnd();
+    idfRegex::objectTypeAndName();
+    idfRegex::line();
+    idfRegex::autosize();
+    idfRegex::autocalculate();
+    commentRegex::whitespaceOnlyLine();
+    commentRegex::commentWhitespaceOnlyLine();
+    commentRegex::editorCommentWhitespaceOnlyLine();
+    commentRegex::whitespaceOnlyBlock();
+    commentRegex::commentWhitespaceOnlyBlock();
+    commentRegex::editorCommentWhitespaceOnlyBlock();
+    iddRegex::commentOnlyObjectName();
+    iddRegex::commentOnlyObjectText();
+    iddRegex::versionObjectName();
+  }
+
+  /** Parses texts[begin,end). An exception thrown by IdfObject::load is stored in errors and
+   *  ends the range, since load would not have gone on past it either. */
+  void parseObjectTextRange(const std::vector<ObjectText>& texts,
+                            std::vector<OptionalIdfObject>& objects,
+                            std::vector<boost::exception_ptr>& errors,
+                            unsigned begin,
+                            unsigned end,
+                            QThread* owner)
+  {
+    // field values repeat heavily, so look them up without locking the shared pool
+    StringPoolSingleton::ThreadCache stringCache;
+    for (unsigned i = begin; i < end; ++i) {
+      try {
+        objects[i] = IdfObject::load(texts[i].first,texts[i].second);
+      }
+      catch (...) {
+        errors[i] = boost::current_exception();
+        return;
+      }
+      if (objects[i] && owner) {
+        // hand the QObject over to the loading thread before this worker goes away
+        objects[i]->getImpl<detail::IdfObject_Impl>()->moveToThread(owner);
+      }
+    }
+  }
+
+  /** Parses texts on up to numThreads threads. The result is in the same order as texts. If
+   *  parsing texts[i] threw, errors[i] holds the exception. */
+  std::vector<OptionalIdfObject> parseObjectTexts(const std::vector<ObjectText>& texts,
+                                                  std::vector<boost::exception_ptr>& errors,
+                                                  unsigned numThreads)
+  {
+    OS_TIMER("IdfFile::parseObjectTexts");
+    unsigned n = texts.size();
+    std::vector<OptionalIdfObject> result(n);
+    errors.assign(n,boost::exception_ptr());
+
+    // not worth a thread for fewer than 64 objects
+    numThreads = std::min(numThreads,std::max(1u,n / 64u));
+    if (numThreads <= 1) {
+      parseObjectTextRange(texts,result,errors,0,n,NULL);
+      return result;
+    }
+
+    initializeParserStatics();
+
+    QThread* owner = QThread::currentThread();
+    unsigned begin = 0;
+    unsigned chunkSize = (n - begin + numThreads - 1) / numThreads;
+    boost::thread_group workers;
+    while (begin < n) {
+      unsigned end = std::min(begin + chunkSize,n);
+      workers.create_thread(boost::bind(&parseObjectTextRange,
+                                        boost::cref(texts),
+                                        boost::ref(result),
+                                        boost::ref(errors),
+                                        begin,
+                                        end,
+                                        owner));
+      begin = end;
+    }
+    workers.join_all();
+
+    return result;
+  }
+
+}
+
+bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnly, unsigned numThreads) {
 
   int lineNum = 0;        // Idf line number
   int objectNum = 0;      // number of objects, first is #1
@@ -532,6 +698,7 @@ bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnl
   boost::smatch matches;  // matches to regular expressions
   std::string comment;    // keep running comment
   bool firstBlock = true; // to capture first comment block as the header
+  std::vector<ObjectText> pending; // object text waiting to be parsed if numThreads > 1
 
   int streamsize = 0;
   if (progressBar){
@@ -596,13 +763,18 @@ bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnl
               continue;
             }
 
-            OptionalIdfObject commentOnlyObject;
-            commentOnlyObject = IdfObject::load(commentOnlyIddObject->name() + ";" + comment,
-                                                *commentOnlyIddObject);
-            OS_ASSERT(commentOnlyObject);
-            
-            // put it in the object list
-            addObject(*commentOnlyObject);
+            std::string text = commentOnlyIddObject->name() + ";" + comment;
+            if (numThreads > 1) {
+              // parsed with the other objects, keeping file order
+              pending.push_back(ObjectText(text,*commentOnlyIddObject));
+            }
+            else {
+              OptionalIdfObject commentOnlyObject = IdfObject::load(text,*commentOnlyIddObject);
+              OS_ASSERT(commentOnlyObject);
+
+              // put it in the object list
+              addObject(*commentOnlyObject);
+            }
           }
         }
       }
@@ -672,7 +844,11 @@ bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnl
       }
 
       // construct the object
-      if (!versionOnly || isVersion) {
+      if (numThreads > 1) {
+        // parsed in parallel once the whole file has been split into objects
+        pending.push_back(ObjectText(text,*iddObject));
+      }
+      else if (!versionOnly || isVersion) {
         OptionalIdfObject object = IdfObject::load(text,*iddObject);
         if (!object) {
           LOG(Error,"Unable to construct IdfObject from text: " << std::endl << text 
@@ -691,6 +867,25 @@ bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnl
     }
   }
 
+  if (!pending.empty()) {
+    std::vector<boost::exception_ptr> errors;
+    std::vector<OptionalIdfObject> objects = parseObjectTexts(pending,errors,numThreads);
+    for (unsigned i = 0, n = pending.size(); i < n; ++i) {
+      if (errors[i]) {
+        // load lets the exception through at this object, so do the same
+        boost::rethrow_exception(errors[i]);
+      }
+      if (!objects[i]) {
+        LOG(Error,"Unable to construct IdfObject from text: " << std::endl << pending[i].first 
+            << std::endl << "Throwing this object out and parsing the remainder of the file.");
+        continue;
+      }
+
+      // put it in the object list
+      addObject(*objects[i]);
+    }
+  }
+
   return true;
 }
 
@@ -194,6 +194,22 @@ class UTILITIES_API IdfFile {
                                        const IddFile& iddFile,
                                        ProgressBar* progressBar=NULL);
 
+  /** Load an IdfFile from std::istream using iddFileType, parsing objects on numThreads threads
+   *  (0 for one per core). The input is split into object texts serially, the texts are parsed
+   *  concurrently against the shared IddFile, and the objects are added in file order, so the
+   *  result is the same as that of load(is, iddFileType). As with load, objects that cannot be
+   *  constructed are logged and dropped, and an exception thrown while parsing an object is
+   *  rethrown here. */
+  static boost::optional<IdfFile> loadParallel(std::istream& is,
+                                               const IddFileType& iddFileType,
+                                               unsigned numThreads=0);
+
+  /** Load an IdfFile from path using iddFileType, parsing objects on numThreads threads (0 for
+   *  one per core). Completes the path as load(p, iddFileType) does. */
+  static boost::optional<IdfFile> loadParallel(const path& p,
+                                               const IddFileType& iddFileType,
+                                               unsigned numThreads=0);
+
   /** Quick load method that uses the IddFile::catchallIddFile and stops parsing once a version
    *  identifier is found. Used to determine the appropriate IddFile to use for a full load. */
   static boost::optional<VersionString> loadVersionOnly(std::istream& is);
@@ -205,11 +221,17 @@ class UTILITIES_API IdfFile {
   /** Print this file to std::ostream os. */
   std::ostream& print(std::ostream& os) const;
 
+  /** Print this file to std::ostream os. If !includeComments, the header and all object and
+   *  field comments are omitted, which makes for smaller files that are faster to write. */
+  std::ostream& print(std::ostream& os, bool includeComments) const;
+
   /** Save this file to path p. Will construct the parent folder if necessary and if its parent
    *  folder already exists. Will only overwrite an existing file if overwrite==true. If no
    *  extension is provided will use modelFileExtension() for files using IddFileType::OpenStudio,
-   *  and 'idf' otherwise. Returns true if the save operation is successful; false otherwise. */
-  bool save(const openstudio::path& p, bool overwrite=false);
+   *  and 'idf' otherwise. If !includeComments, the file is written in the compact form of
+   *  print(std::ostream&,bool). Returns true if the save operation is successful; false 
+   *  otherwise. */
+  bool save(const openstudio::path& p, bool overwrite=false, bool includeComments=true);
 
   //@}
 
@@ -237,7 +259,8 @@ class UTILITIES_API IdfFile {
   // SERIALIZATION
 
   /// private load function that uses m_iddFile and m_iddFileType initialized elsewhere
-  bool m_load(std::istream& is, ProgressBar* progressBar=NULL, bool versionOnly=false);
+  /// objects are parsed on numThreads threads after the whole stream has been read, if > 1
+  bool m_load(std::istream& is, ProgressBar* progressBar=NULL, bool versionOnly=false, unsigned numThreads=1);
 
   // configure logging
   REGISTER_LOGGER("utilities.idf.IdfFile");
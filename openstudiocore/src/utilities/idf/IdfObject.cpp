@@ -69,8 +69,9 @@ namespace detail {
   IdfObject_Impl::IdfObject_Impl(const IdfObject_Impl& other, bool keepHandle)
     : m_comment(other.comment()), 
       m_iddObject(other.iddObject()),
-      m_fields(other.fields()), 
-      m_fieldComments(other.fieldComments())
+      m_fields(other.m_fields), 
+      m_fieldComments(other.m_fieldComments),
+      m_handleFieldValue(other.m_handleFieldValue)
   {
     if (keepHandle){
       OS_ASSERT(!other.handle().isNull());
@@ -78,8 +79,14 @@ namespace detail {
     }else{
       m_handle = openstudio::createUUID();
       if (iddObject().hasHandleField()) {
-        bool ok = setString(0,toString(m_handle));
-        OS_ASSERT(ok);
+        if (m_fields.empty()) {
+          bool ok = setString(0,toString(m_handle));
+          OS_ASSERT(ok);
+        }
+        else {
+          // leave m_fields shared with other
+          m_handleFieldValue = toString(m_handle);
+        }
       }
     }
   }
@@ -128,6 +135,20 @@ namespace detail {
     resizeToMinFields();
   }
 
+  IdfObject_Impl::IdfObject_Impl(const Handle& handle,
+                                 const std::string& comment, 
+                                 const IddObject& iddObject, 
+                                 const InternedStringVector& fields,
+                                 const InternedStringVector& fieldComments) 
+    : m_handle(handle),    
+      m_comment(comment),
+      m_iddObject(iddObject),
+      m_fields(fields),
+      m_fieldComments(fieldComments) 
+  {
+    resizeToMinFields();
+  }
+
   // GETTERS
 
   Handle IdfObject_Impl::handle() const {
@@ -216,7 +237,7 @@ namespace detail {
   {
     OptionalString result;
     if (index < m_fields.size()) {
-      result = m_fields[index];
+      result = fieldValue(index);
     }
     if (returnDefault && ((result && result->empty()) || (!result))) {
       OptionalIddField iddField = m_iddObject.getField(index);
@@ -348,6 +369,7 @@ namespace detail {
 
   void IdfObject_Impl::setComment(const std::string& comment, bool checkValidity)
   {
+    recordEdit();
     m_comment = makeComment(comment);
     m_diffs.push_back(IdfObjectDiff(boost::none, boost::none, boost::none));
   }
@@ -362,13 +384,14 @@ namespace detail {
 
   bool IdfObject_Impl::setFieldComment(unsigned index, const std::string& cmnt, bool checkValidity) {
     if (index < m_fields.size()) {
+      recordEdit();
       if (index >= m_fieldComments.size()) {
         m_fieldComments.resize(index+1);
       }
       
-      m_fieldComments[index] = makeComment(cmnt);
+      m_fieldComments.set(index, makeComment(cmnt));
 
-      m_diffs.push_back(IdfObjectDiff(index, m_fields[index], m_fields[index]));
+      m_diffs.push_back(IdfObjectDiff(index, fieldValue(index), fieldValue(index)));
       
       return true;
     }
@@ -399,7 +422,7 @@ namespace detail {
       n = numFields();
       if (i < n) {
         std::string oldName = m_fields[i];
-        m_fields[i] = newName;
+        m_fields.set(i, newName);
         m_diffs.push_back(IdfObjectDiff(i, oldName, newName));
       } 
       else { 
@@ -462,7 +485,7 @@ namespace detail {
         }
       }
       else {
-        oldValue = m_fields[index];
+        oldValue = fieldValue(index);
       }
 
       if (!result) {
@@ -480,7 +503,10 @@ namespace detail {
 
       OS_ASSERT(index < m_fields.size());
 
-      m_fields[index] = value;
+      if (index == 0u) {
+        m_handleFieldValue.clear();
+      }
+      m_fields.set(index, value);
       m_diffs.push_back(IdfObjectDiff(index, oldValue, value));
       return result;
     }
@@ -617,6 +643,8 @@ namespace detail {
     IdfExtensibleGroup result(p,n);
     if (!values.empty() && (values.size() != groupSize)) { return result; }
     
+    recordEdit();
+
     StringVector wValues = values; // copy so can resize empty vector
     OptionalUnsigned mf = maxFields();   
     unsigned diffSize = m_diffs.size();
@@ -1069,6 +1097,17 @@ namespace detail {
     return report;
   }
 
+  void IdfObject_Impl::addMemoryUsage(IdfObjectMemoryUsage& usage) const {
+    ++usage.numObjects;
+    usage.numFields += m_fields.size();
+    usage.numFieldComments += m_fieldComments.numNonEmpty();
+    usage.tableBytes += m_fields.tableBytes() + m_fieldComments.tableBytes();
+    usage.unpooledBytes += m_fields.unpooledBytes() + m_fieldComments.unpooledBytes();
+    if (m_fields.isShared()) {
+      ++usage.numSharedFieldTables;
+    }
+  }
+
   bool IdfObject_Impl::dataFieldsEqual(const IdfObject& other) const {
     if (iddObject() != other.iddObject()) { 
       return false; 
@@ -1234,7 +1273,26 @@ namespace detail {
       }
     }
 
-    os << std::endl;
+    os << '\n';
+
+    return os;
+  }
+
+  std::ostream& IdfObject_Impl::print(std::ostream& os, bool includeComments) const {
+    if (includeComments) {
+      return print(os);
+    }
+
+    // compact form: no comments and no padding, one field per line
+    if (boost::iequals(m_iddObject.name(), iddRegex::commentOnlyObjectName()) ){
+      return os;
+    }
+
+    os << m_iddObject.name();
+    for (unsigned index = 0, n = m_fields.size(); index < n; ++index) {
+      os << ",\n  " << fieldValue(index);
+    }
+    os << ";\n\n";
 
     return os;
   }
@@ -1242,7 +1300,7 @@ namespace detail {
   std::ostream& IdfObject_Impl::printName(std::ostream& os, bool hasFields) const {
     // print comment, if any
     if (!m_comment.empty()){
-      os << m_comment << std::endl;
+      os << m_comment << '\n';
     }
 
     // if this is a comment only object, return
@@ -1254,10 +1312,10 @@ namespace detail {
     os << m_iddObject.name();
 
     if (hasFields) {
-      os << "," << std::endl;
+      os << ",\n";
     }
     else {
-      os << ";" << std::endl;
+      os << ";\n";
     }
       
     return os;
@@ -1300,12 +1358,12 @@ namespace detail {
           if (OptionalString units = iddField.properties().units) {
             os << " {" << *units << "}";
           }
-          os << std::endl;
+          os << '\n';
         }
       }
       else {
         // field value
-        os << "  " << m_fields[index];
+        os << "  " << fieldValue(index);
         // delimiter
         if (isLastField) {
           os << ";";
@@ -1314,11 +1372,11 @@ namespace detail {
           os << ",";
         }
         // field comment
-        int numSpaces = IdfObject::printedFieldSpace() - int(m_fields[index].size());
+        int numSpaces = IdfObject::printedFieldSpace() - int(fieldValue(index).size());
         if (numSpaces > 0) {
           os << std::setw(numSpaces) << " ";
         }
-        os << " " << fieldComment(index,true) << std::endl;
+        os << " " << fieldComment(index,true) << '\n';
       }
     } // if index < numFields()
     return os;
@@ -1527,7 +1585,7 @@ namespace detail {
                                   commentRegex::editorCommentWhitespaceOnlyLine()))
           {
             m_fieldComments.resize(m_fields.size());
-            m_fieldComments.back() = commentOrOtherText;
+            m_fieldComments.set(m_fieldComments.size() - 1, commentOrOtherText);
           }
         }
 
@@ -1929,9 +1987,21 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
     return result;
   }
 
+  const std::string& IdfObject_Impl::fieldValue(unsigned index) const
+  {
+    if ((index == 0u) && !m_handleFieldValue.empty()) {
+      return m_handleFieldValue;
+    }
+    return m_fields[index];
+  }
+
   std::vector<std::string> IdfObject_Impl::fields() const
   {
-    return m_fields;
+    std::vector<std::string> result = m_fields;
+    if (!m_handleFieldValue.empty() && !result.empty()) {
+      result[0] = m_handleFieldValue;
+    }
+    return result;
   }
 
   std::vector<std::string> IdfObject_Impl::fieldComments() const
@@ -1939,6 +2009,9 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
     return m_fieldComments;
   }
 
+  void IdfObject_Impl::recordEdit()
+  {}
+
 } // detail
 
 // CONSTRUCTORS
@@ -1973,6 +2046,25 @@ IdfObject IdfObject::clone(bool keepHandle) const
   return copy;
 }
 
+IdfObject IdfObject::cloneWithIddObject(const IddObject& iddObject) const
+{
+  boost::shared_ptr<detail::IdfObject_Impl> p(new detail::IdfObject_Impl(*m_impl, true));
+  if (!p->m_handleFieldValue.empty()) {
+    // field 0 may not be a handle field under iddObject
+    p->m_fields.set(0, p->m_handleFieldValue);
+    p->m_handleFieldValue.clear();
+  }
+  p->setIddObject(iddObject);
+  // keep handle if the handle field holds one, as when parsing
+  if (iddObject.hasHandleField() && (p->numFields() > 0u)) {
+    Handle candidate = toUUID(p->fieldValue(0));
+    if (!candidate.isNull()) {
+      p->m_handle = candidate;
+    }
+  }
+  return IdfObject(p);
+}
+
 // GETTERS
 
 Handle IdfObject::handle() const {
@@ -2219,6 +2311,11 @@ std::ostream& IdfObject::print(std::ostream& os) const
   return m_impl->print(os);
 }
 
+std::ostream& IdfObject::print(std::ostream& os, bool includeComments) const
+{
+  return m_impl->print(os,includeComments);
+}
+
 std::ostream& IdfObject::printName(std::ostream& os, bool hasFields) const {
   return m_impl->printName(os,hasFields);
 }
@@ -2227,6 +2324,20 @@ std::ostream& IdfObject::printField(std::ostream& os, unsigned index, bool isLas
   return m_impl->printField(os,index,isLastField);
 }
 
+IdfObjectMemoryUsage::IdfObjectMemoryUsage()
+  : numObjects(0), numFields(0), numFieldComments(0), tableBytes(0), unpooledBytes(0), numSharedFieldTables(0)
+{}
+
+IdfObjectMemoryUsage& IdfObjectMemoryUsage::operator+=(const IdfObjectMemoryUsage& other) {
+  numObjects += other.numObjects;
+  numFields += other.numFields;
+  numFieldComments += other.numFieldComments;
+  tableBytes += other.tableBytes;
+  unpooledBytes += other.unpooledBytes;
+  numSharedFieldTables += other.numSharedFieldTables;
+  return *this;
+}
+
 /** Function object for sorting by name. */
 bool IdfObjectNameLess::operator()(const IdfObject& left, const IdfObject& right) const {
   boost::optional<std::string> leftName = left.name();
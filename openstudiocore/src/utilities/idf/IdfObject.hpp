@@ -30,6 +30,7 @@
 #include <boost/optional.hpp>
 #include <boost/foreach.hpp>
 
+#include <cstddef>
 #include <string>
 #include <ostream>
 #include <vector>
@@ -99,6 +100,12 @@ class UTILITIES_API IdfObject {
   /** Creates a deep copy of this object. This object and the newly created object do not share
    *  data, and the new object is always unlocked. */
   IdfObject clone(bool keepHandle=false) const;
+
+  /** Creates a deep copy of this object described by iddObject instead of iddObject(). Fields that
+   *  iddObject does not recognize are dropped. As when parsing, the handle is taken from the handle
+   *  field if it holds one, and is otherwise kept. Lets data be carried across IDD versions without
+   *  printing and re-parsing it. */
+  IdfObject cloneWithIddObject(const IddObject& iddObject) const;
  
   //@}
   /** @name Getters */
@@ -349,6 +356,10 @@ class UTILITIES_API IdfObject {
   /** Serialize this object to os as Idf text. */
   std::ostream& print(std::ostream& os) const;
 
+  /** Serialize this object to os as Idf text. If !includeComments, writes the compact form
+   *  with no object or field comments and no alignment padding. */
+  std::ostream& print(std::ostream& os, bool includeComments) const;
+
   /** Serialize just the preceding comments and name of this IdfObject in the formmat used by 
    *  full object print. If hasFields, the name is follwed by a ','. Otherwise, the name is 
    *  followed by a ';'. */
@@ -417,6 +428,22 @@ class UTILITIES_API IdfObject {
   REGISTER_LOGGER("utilities.idf.IdfObject");
 };
 
+/** Approximate memory used by the field data of one or more objects. Field values are held in
+ *  StringPool, which reports the text it holds; only values too long to be pooled are counted
+ *  here. Field tables shared between clones are counted once per object. \relates IdfObject */
+struct UTILITIES_API IdfObjectMemoryUsage {
+  IdfObjectMemoryUsage();
+
+  unsigned numObjects;
+  unsigned numFields;
+  unsigned numFieldComments; // non-empty comments only
+  std::size_t tableBytes;    // field and field comment tables
+  std::size_t unpooledBytes; // text of values that are not pooled
+  unsigned numSharedFieldTables; // field tables currently shared with a clone
+
+  IdfObjectMemoryUsage& operator+=(const IdfObjectMemoryUsage& other);
+};
+
 /** Function object for sorting objects by name. \relates IdfObject */
 struct UTILITIES_API IdfObjectNameLess {
   bool operator()(const IdfObject& left, const IdfObject& right) const;
@@ -27,6 +27,7 @@
 
 #include <utilities/core/Logger.hpp>
 #include <utilities/core/Containers.hpp>
+#include <utilities/core/InternedStringVector.hpp>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/optional.hpp>
@@ -45,6 +46,7 @@ namespace openstudio {
 class IdfObject;
 class IdfExtensibleGroup;
 struct IdfObjectImplLess;
+struct IdfObjectMemoryUsage;
 class StrictnessLevel;
 class ValidityReport;
 class DataError;
@@ -78,6 +80,13 @@ namespace detail {
                    const StringVector& fields,
                    const StringVector& fieldComments);
 
+    /** Constructor from data that is already interned; shares fields and fieldComments. */
+    IdfObject_Impl(const Handle& handle,
+                   const std::string& comment,
+                   const IddObject& iddObject,
+                   const InternedStringVector& fields,
+                   const InternedStringVector& fieldComments);
+
     virtual ~IdfObject_Impl() {}
 
     //@}
@@ -321,6 +330,9 @@ namespace detail {
      *  Prerequisite: iddObject()s must be equal. */
     bool objectListFieldsNonConflicting(const IdfObject& other) const;
 
+    /** Adds this object's field data to usage. */
+    void addMemoryUsage(IdfObjectMemoryUsage& usage) const;
+
     //@}
     /** @name Serialization */
     //@{
@@ -336,6 +348,10 @@ namespace detail {
     /** Serialize this object to os as Idf text. */
     std::ostream& print(std::ostream& os) const;
 
+    /** Serialize this object to os as Idf text. If !includeComments, writes the compact form
+     *  with no object or field comments and no alignment padding. */
+    std::ostream& print(std::ostream& os, bool includeComments) const;
+
     /** Serialize just the preceding comments and name of this IdfObject in the formmat used by 
      *  full object print. If hasFields, the name is follwed by a ','. Otherwise, the name is 
      *  followed by a ';'. */
@@ -391,19 +407,35 @@ namespace detail {
     // idd object definition
     IddObject m_iddObject;
 
-    // idf fields
-    std::vector<std::string> m_fields;
-    std::vector<std::string> m_fieldComments; // only populated if encounter non-empty, non-default comment
+    // idf fields, interned in StringPool and shared with clones of this object until either one
+    // is modified
+    InternedStringVector m_fields;
+    InternedStringVector m_fieldComments; // only populated if encounter non-empty, non-default comment
+
+    // value of the handle field when it is not the one in m_fields, as in clones given a new
+    // handle, which can then keep sharing m_fields with the original. Empty otherwise.
+    std::string m_handleFieldValue;
 
     // idf differences
     std::vector<IdfObjectDiff> m_diffs;
 
     // GETTER HELPERS
 
+    /** Returns the value of field index < numFields(), taking m_handleFieldValue into account.
+     *  Use this rather than m_fields[index] for any field that may be the handle field. */
+    const std::string& fieldValue(unsigned index) const;
+
     std::vector<std::string> fields() const;
 
     std::vector<std::string> fieldComments() const;
 
+    // SETTER HELPERS
+
+    /** Called by setters that change m_fields or comments directly, before the first change is
+     *  made. Does nothing here; WorkspaceObject_Impl uses it to support Workspace edit
+     *  transactions. */
+    virtual void recordEdit();
+
     virtual OSOptionalQuantity getQuantityFromDouble(unsigned index, boost::optional<double> value, bool returnIP) const;
     
     virtual boost::optional<double> getDoubleFromQuantity(unsigned index, Quantity q) const;
@@ -0,0 +1,419 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/idf/LazyWorkspace.hpp>
+#include <utilities/idf/IdfFile.hpp>
+#include <utilities/idf/IdfRegex.hpp>
+#include <utilities/idf/Workspace.hpp>
+
+#include <utilities/idd/IddFileAndFactoryWrapper.hpp>
+#include <utilities/idd/IddObject.hpp>
+#include <utilities/idd/IddRegex.hpp>
+#include <utilities/idd/CommentRegex.hpp>
+
+#include <utilities/core/Assert.hpp>
+#include <utilities/core/Compare.hpp>
+#include <utilities/core/Instrumentation.hpp>
+#include <utilities/core/Optional.hpp>
+#include <utilities/core/PathHelpers.hpp>
+#include <utilities/core/UUID.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/foreach.hpp>
+#include <boost/regex.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/filter/newline.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace openstudio {
+namespace detail {
+
+  class LazyWorkspace_Impl {
+   public:
+    LazyWorkspace_Impl(const IddFileType& iddFileType)
+      : m_iddFileAndFactoryWrapper(iddFileType), m_numObjects(0), m_numParsedObjects(0)
+    {}
+
+    /** Records the type and extent of each object in is, without parsing any fields. */
+    bool scan(std::istream& is);
+
+    IddFileType iddFileType() const {
+      return m_iddFileAndFactoryWrapper.iddFileType();
+    }
+
+    unsigned numObjects() const {
+      return m_numObjects;
+    }
+
+    unsigned numObjectsOfType(IddObjectType type) const {
+      TypeMap::const_iterator it = m_types.find(type);
+      if (it == m_types.end()) {
+        return 0u;
+      }
+      return it->second.chunks.size();
+    }
+
+    unsigned numParsedObjects() const {
+      return m_numParsedObjects;
+    }
+
+    std::vector<IddObjectType> objectTypes() const {
+      std::vector<IddObjectType> result;
+      for (TypeMap::const_iterator it = m_types.begin(); it != m_types.end(); ++it) {
+        result.push_back(it->first);
+      }
+      return result;
+    }
+
+    std::vector<IdfObject> getObjectsByType(IddObjectType type) const {
+      std::vector<IdfObject> result;
+      TypeMap::iterator it = m_types.find(type);
+      if (it == m_types.end()) {
+        return result;
+      }
+      const std::vector<IdfObject>& objects = parse(it->second);
+      result.reserve(objects.size());
+      BOOST_FOREACH(const IdfObject& object, objects) {
+        result.push_back(object.clone(true));
+      }
+      return result;
+    }
+
+    boost::optional<IdfObject> getObjectByTypeAndName(IddObjectType type,
+                                                      const std::string& name) const
+    {
+      TypeMap::iterator it = m_types.find(type);
+      if (it == m_types.end()) {
+        return boost::none;
+      }
+      BOOST_FOREACH(const IdfObject& object, parse(it->second)) {
+        OptionalString candidate = object.name();
+        if (candidate && istringEqual(*candidate, name)) {
+          return object.clone(true);
+        }
+      }
+      return boost::none;
+    }
+
+    boost::optional<IdfObject> getTarget(const IdfObject& object, unsigned index) const {
+      OptionalString value = object.getString(index);
+      if (!value || value->empty()) {
+        return boost::none;
+      }
+      std::set<std::string> objectLists = object.iddObject().objectLists(index);
+      if (objectLists.empty()) {
+        return boost::none;
+      }
+
+      for (TypeMap::iterator it = m_types.begin(); it != m_types.end(); ++it) {
+        std::vector<std::string> references = it->second.iddObject.references();
+        if (!intersects(objectLists, references)) {
+          continue;
+        }
+        BOOST_FOREACH(const IdfObject& candidate, parse(it->second)) {
+          if (pointsTo(*value, candidate)) {
+            return candidate.clone(true);
+          }
+        }
+      }
+
+      return boost::none;
+    }
+
+    std::vector<IdfObject> getSources(const IdfObject& object) const {
+      std::vector<IdfObject> result;
+      std::vector<std::string> references = object.iddObject().references();
+      if (references.empty()) {
+        return result;
+      }
+
+      for (TypeMap::iterator it = m_types.begin(); it != m_types.end(); ++it) {
+        if (!intersects(it->second.iddObject.objectLists(), references)) {
+          continue;
+        }
+        BOOST_FOREACH(const IdfObject& candidate, parse(it->second)) {
+          for (unsigned i = 0, n = candidate.numFields(); i < n; ++i) {
+            if (!intersects(candidate.iddObject().objectLists(i), references)) {
+              continue;
+            }
+            OptionalString value = candidate.getString(i);
+            if (value && !value->empty() && pointsTo(*value, object)) {
+              result.push_back(candidate.clone(true));
+              break;
+            }
+          }
+        }
+      }
+
+      return result;
+    }
+
+    boost::optional<IdfFile> toIdfFile() const {
+      std::istringstream is(m_text);
+      return IdfFile::load(is, iddFileType());
+    }
+
+   private:
+    REGISTER_LOGGER("utilities.idf.LazyWorkspace");
+
+    /** Offset and length of one object's text (including its leading comment) in m_text. */
+    struct Chunk {
+      std::string::size_type begin;
+      std::string::size_type length;
+    };
+
+    struct TypeEntry {
+      TypeEntry() : parsed(false) {}
+
+      IddObject iddObject;
+      std::vector<Chunk> chunks;
+      bool parsed;
+      std::vector<IdfObject> objects;
+    };
+
+    typedef std::map<IddObjectType, TypeEntry> TypeMap;
+
+    IddFileAndFactoryWrapper m_iddFileAndFactoryWrapper;
+    std::string m_text;
+    unsigned m_numObjects;
+
+    // caches filled on demand, only ever handed out as clones
+    mutable TypeMap m_types;
+    mutable unsigned m_numParsedObjects;
+
+    const std::vector<IdfObject>& parse(TypeEntry& entry) const {
+      if (entry.parsed) {
+        return entry.objects;
+      }
+
+      OS_TIMER("LazyWorkspace::parse");
+      BOOST_FOREACH(const Chunk& chunk, entry.chunks) {
+        std::string text = m_text.substr(chunk.begin, chunk.length);
+        OptionalIdfObject object = IdfObject::load(text, entry.iddObject);
+        if (!object) {
+          LOG(Error,"Unable to construct IdfObject from text: " << std::endl << text
+              << std::endl << "Skipping this object.");
+          continue;
+        }
+        entry.objects.push_back(*object);
+      }
+      entry.parsed = true;
+      m_numParsedObjects += entry.objects.size();
+
+      return entry.objects;
+    }
+
+    /** Returns true if the pointer field value refers to target. OpenStudio files point by
+     *  handle, EnergyPlus files by name. */
+    bool pointsTo(const std::string& value, const IdfObject& target) const {
+      if (target.iddObject().hasHandleField()) {
+        return toUUID(value) == target.handle();
+      }
+      OptionalString name = target.name();
+      return name && istringEqual(*name, value);
+    }
+
+    template<class T>
+    static bool intersects(const std::set<std::string>& objectLists, const T& references) {
+      BOOST_FOREACH(const std::string& reference, references) {
+        if (objectLists.find(reference) != objectLists.end()) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void addChunk(const std::string& objectType,
+                  std::string::size_type begin,
+                  std::string::size_type end)
+    {
+      OptionalIddObject iddObject = m_iddFileAndFactoryWrapper.getObject(objectType);
+      if (!iddObject) {
+        LOG(Warn, "Cannot find object type '" + objectType + "' in Idd. Placing data in Catchall object.");
+        iddObject = IddObject();
+      }
+
+      TypeEntry& entry = m_types[iddObject->type()];
+      if (entry.chunks.empty()) {
+        entry.iddObject = *iddObject;
+      }
+      Chunk chunk = { begin, end - begin };
+      entry.chunks.push_back(chunk);
+      ++m_numObjects;
+    }
+  };
+
+  bool LazyWorkspace_Impl::scan(std::istream& is) {
+    // same line ending handling as IdfFile
+    boost::iostreams::filtering_istream filt;
+    filt.push(boost::iostreams::newline_filter(boost::iostreams::newline::posix));
+    filt.push(is);
+
+    std::string line;
+    boost::smatch matches;
+    bool inComment = false;
+    std::string::size_type commentBegin = 0;
+
+    while (std::getline(filt, line)) {
+
+      if (line == "\r") {
+        continue;
+      }
+
+      std::string::size_type lineBegin = m_text.size();
+      m_text += (line + idfRegex::newLinestring());
+
+      if (boost::regex_match(line, idfRegex::commentOnlyLine())) {
+        if (!inComment) {
+          commentBegin = lineBegin;
+          inComment = true;
+        }
+        continue;
+      }
+
+      if (boost::regex_match(line, commentRegex::whitespaceOnlyLine())) {
+        // the header and comment-only objects are not kept
+        inComment = false;
+        continue;
+      }
+
+      std::string::size_type begin = inComment ? commentBegin : lineBegin;
+      inComment = false;
+
+      std::string objectType;
+      if (boost::regex_search(line, matches, idfRegex::line())) {
+        objectType = std::string(matches[1].first, matches[1].second); boost::trim(objectType);
+      }
+      else {
+        LOG(Warn, "Unrecognizable object type '" + line + "'. Defaulting to 'Catchall'.");
+        objectType = "Catchall";
+      }
+
+      // read until the end of the object
+      bool foundEndLine = boost::regex_match(line, idfRegex::objectEnd());
+      while ((!foundEndLine) && (std::getline(filt, line))) {
+        m_text += (line + idfRegex::newLinestring());
+        foundEndLine = boost::regex_match(line, idfRegex::objectEnd());
+      }
+
+      addChunk(objectType, begin, m_text.size());
+    }
+
+    return true;
+  }
+
+} // detail
+
+LazyWorkspace::LazyWorkspace(boost::shared_ptr<detail::LazyWorkspace_Impl> impl)
+  : m_impl(impl)
+{
+  OS_ASSERT(m_impl);
+}
+
+boost::optional<LazyWorkspace> LazyWorkspace::load(const openstudio::path& p,
+                                                   const IddFileType& iddFileType)
+{
+  // complete path as IdfFile::load does
+  path wp(p);
+  if (iddFileType == IddFileType::OpenStudio) {
+    wp = completePathToFile(wp,path(),modelFileExtension(),false);
+    if (wp.empty()) { wp = completePathToFile(p,path(),componentFileExtension(),false); }
+  }
+  else {
+    wp = completePathToFile(wp,path(),"idf",true);
+  }
+
+  boost::filesystem::ifstream inFile(wp);
+  if (inFile) {
+    try {
+      return load(inFile, iddFileType);
+    }
+    catch (...) { return boost::none; }
+  }
+
+  return boost::none;
+}
+
+boost::optional<LazyWorkspace> LazyWorkspace::load(std::istream& is,
+                                                   const IddFileType& iddFileType)
+{
+  OS_TIMER("LazyWorkspace::load");
+  boost::shared_ptr<detail::LazyWorkspace_Impl> impl(new detail::LazyWorkspace_Impl(iddFileType));
+  if (!impl->scan(is)) {
+    return boost::none;
+  }
+  OS_COUNT("LazyWorkspace::load objects", impl->numObjects());
+  return LazyWorkspace(impl);
+}
+
+IddFileType LazyWorkspace::iddFileType() const {
+  return m_impl->iddFileType();
+}
+
+unsigned LazyWorkspace::numObjects() const {
+  return m_impl->numObjects();
+}
+
+unsigned LazyWorkspace::numObjectsOfType(IddObjectType type) const {
+  return m_impl->numObjectsOfType(type);
+}
+
+unsigned LazyWorkspace::numParsedObjects() const {
+  return m_impl->numParsedObjects();
+}
+
+std::vector<IddObjectType> LazyWorkspace::objectTypes() const {
+  return m_impl->objectTypes();
+}
+
+std::vector<IdfObject> LazyWorkspace::getObjectsByType(IddObjectType type) const {
+  return m_impl->getObjectsByType(type);
+}
+
+boost::optional<IdfObject> LazyWorkspace::getObjectByTypeAndName(IddObjectType type,
+                                                                 const std::string& name) const
+{
+  return m_impl->getObjectByTypeAndName(type, name);
+}
+
+boost::optional<IdfObject> LazyWorkspace::getTarget(const IdfObject& object, unsigned index) const {
+  return m_impl->getTarget(object, index);
+}
+
+std::vector<IdfObject> LazyWorkspace::getSources(const IdfObject& object) const {
+  return m_impl->getSources(object);
+}
+
+boost::optional<IdfFile> LazyWorkspace::toIdfFile() const {
+  return m_impl->toIdfFile();
+}
+
+boost::optional<Workspace> LazyWorkspace::toWorkspace(StrictnessLevel level) const {
+  boost::optional<IdfFile> idfFile = toIdfFile();
+  if (!idfFile) {
+    return boost::none;
+  }
+  return Workspace(*idfFile, level);
+}
+
+} // openstudio
@@ -0,0 +1,141 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_IDF_LAZYWORKSPACE_HPP
+#define UTILITIES_IDF_LAZYWORKSPACE_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+#include <utilities/idf/IdfObject.hpp>
+#include <utilities/idf/ValidityEnums.hpp>
+#include <utilities/idd/IddEnums.hxx>
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/optional.hpp>
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+// forward declarations
+class IdfFile;
+class Workspace;
+
+namespace detail {
+  class LazyWorkspace_Impl;
+}
+
+/** LazyWorkspace is a read-only view of an IDF or OSM file for batch tools that only need to
+ *  query a few object types. Loading scans the text once to find each object's type and extent,
+ *  but does not parse any fields. The objects of a given type are parsed into \link IdfObject
+ *  IdfObjects\endlink the first time that type is requested, and pointers are resolved by name
+ *  (IDF) or handle (OSM) only when getTarget or getSources is called.
+ *
+ *  The returned objects are copies of the cached objects that keep their handles. They share
+ *  field data with the cache until written, so editing them does not change the cache or the
+ *  results of later queries. Call toWorkspace to obtain a fully editable Workspace; this
+ *  re-parses the original text, so no state is shared between the two.
+ *
+ *  Comment-only blocks are not represented, and LazyWorkspace does not add a version object
+ *  if the file does not contain one. LazyWorkspace is a shared object.
+ *
+ *  LazyWorkspace is not thread-safe. Queries fill the parse cache without locking, so a
+ *  LazyWorkspace and its copies must only be used from one thread at a time. */
+class UTILITIES_API LazyWorkspace {
+ public:
+  /** @name Constructors and Destructors */
+  //@{
+
+  /** Scan the file at p. Returns boost::none if the file cannot be opened. */
+  static boost::optional<LazyWorkspace> load(const openstudio::path& p,
+                                             const IddFileType& iddFileType);
+
+  /** Scan the text in is. */
+  static boost::optional<LazyWorkspace> load(std::istream& is,
+                                             const IddFileType& iddFileType);
+
+  virtual ~LazyWorkspace() {}
+
+  //@}
+  /** @name Getters */
+  //@{
+
+  IddFileType iddFileType() const;
+
+  /** Returns the number of objects found in the file. Does not parse any objects. */
+  unsigned numObjects() const;
+
+  /** Returns the number of objects of type found in the file. Does not parse any objects. */
+  unsigned numObjectsOfType(IddObjectType type) const;
+
+  /** Returns the number of objects that have been parsed so far. */
+  unsigned numParsedObjects() const;
+
+  /** Returns the types present in the file. Does not parse any objects. */
+  std::vector<IddObjectType> objectTypes() const;
+
+  /** Returns all objects of type, in file order. Parses them on first access. */
+  std::vector<IdfObject> getObjectsByType(IddObjectType type) const;
+
+  /** Returns the object of type named name (case insensitive), if there is one. */
+  boost::optional<IdfObject> getObjectByTypeAndName(IddObjectType type,
+                                                    const std::string& name) const;
+
+  /** Returns the object pointed to by field index of object, if any. Only the types that can be
+   *  referenced by that field are parsed. */
+  boost::optional<IdfObject> getTarget(const IdfObject& object, unsigned index) const;
+
+  /** Returns the objects that point to object. Only the types that have fields which can
+   *  reference object are parsed. */
+  std::vector<IdfObject> getSources(const IdfObject& object) const;
+
+  //@}
+  /** @name Conversion */
+  //@{
+
+  /** Parses the entire original text into an IdfFile. */
+  boost::optional<IdfFile> toIdfFile() const;
+
+  /** Parses the entire original text into an editable Workspace at level. Returns boost::none
+   *  if the text cannot be parsed; otherwise follows the Workspace(const IdfFile&,
+   *  StrictnessLevel) constructor. */
+  boost::optional<Workspace> toWorkspace(StrictnessLevel level = StrictnessLevel::None) const;
+
+  //@}
+ protected:
+  typedef detail::LazyWorkspace_Impl ImplType;
+
+  LazyWorkspace(boost::shared_ptr<detail::LazyWorkspace_Impl> impl);
+
+ private:
+  boost::shared_ptr<detail::LazyWorkspace_Impl> m_impl;
+
+  REGISTER_LOGGER("utilities.idf.LazyWorkspace");
+};
+
+/** \relates LazyWorkspace */
+typedef boost::optional<LazyWorkspace> OptionalLazyWorkspace;
+
+} // openstudio
+
+#endif // UTILITIES_IDF_LAZYWORKSPACE_HPP
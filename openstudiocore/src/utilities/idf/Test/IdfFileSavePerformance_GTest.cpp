@@ -0,0 +1,103 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include <utilities/idf/Test/IdfFixture.hpp>
+
+#include <utilities/idf/IdfFile.hpp>
+#include <utilities/idf/Workspace.hpp>
+
+#include <utilities/core/String.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/timer.hpp>
+
+using namespace openstudio;
+
+double saveIdfFile(IdfFile& idfFile, const openstudio::path& p, bool includeComments, int number)
+{
+  boost::timer t;
+  for (int i = 0; i < number; ++i) {
+    EXPECT_TRUE(idfFile.save(p,true,includeComments));
+  }
+  return t.elapsed();
+}
+
+TEST_F(IdfFixture, IdfFile_SavePerformance) {
+  int number = 20;
+
+  openstudio::path outPath = outDir/toPath("SavePerformance_in.idf");
+  openstudio::path compactPath = outDir/toPath("SavePerformance_compact.idf");
+
+  IdfFile idfFile = epIdfFile;
+  double full = saveIdfFile(idfFile,outPath,true,number);
+  double compact = saveIdfFile(idfFile,compactPath,false,number);
+
+  LOG(Info, "IdfFile with " << idfFile.objects().size() << " objects saved " << number 
+      << " times in " << full << "s with comments and " << compact << "s without comments.");
+
+  EXPECT_LT(boost::filesystem::file_size(compactPath),boost::filesystem::file_size(outPath));
+
+  // the compact file must carry the same data
+  OptionalIdfFile oCompact = IdfFile::load(compactPath,IddFileType::EnergyPlus);
+  ASSERT_TRUE(oCompact);
+  IdfObjectVector originalObjects = idfFile.objects();
+  IdfObjectVector compactObjects = oCompact->objects();
+  ASSERT_EQ(originalObjects.size(),compactObjects.size());
+  for (unsigned i = 0, n = originalObjects.size(); i < n; ++i) {
+    EXPECT_TRUE(originalObjects[i].dataFieldsEqual(compactObjects[i]));
+  }
+}
+
+TEST_F(IdfFixture, Workspace_SavePerformance) {
+  int number = 20;
+
+  openstudio::path outPath = outDir/toPath("SavePerformance_workspace.idf");
+
+  Workspace workspace(epIdfFile,StrictnessLevel::None);
+  boost::timer t;
+  for (int i = 0; i < number; ++i) {
+    EXPECT_TRUE(workspace.save(outPath,true));
+  }
+  double elapsed = t.elapsed();
+
+  LOG(Info, "Workspace with " << workspace.numObjects() << " objects saved " << number 
+      << " times in " << elapsed << "s.");
+
+  OptionalIdfFile oIdfFile = IdfFile::load(outPath,IddFileType::EnergyPlus);
+  ASSERT_TRUE(oIdfFile);
+  EXPECT_EQ(workspace.toIdfFile().objects().size(),oIdfFile->objects().size());
+}
+
+TEST_F(IdfFixture, ToStringDouble_Performance) {
+  EXPECT_EQ("0.1",toString(0.1));
+  EXPECT_EQ("1e+20",toString(1.0E20));
+  EXPECT_EQ("3.14159265358979",toString(3.14159265358979));
+  EXPECT_EQ("-2",toString(-2.0));
+
+  int number = 5000;
+  boost::timer t;
+  std::size_t total = 0;
+  for (int i = 0; i < number; ++i) {
+    total += toString(double(i) / 7.0).size();
+  }
+  double elapsed = t.elapsed();
+  EXPECT_GT(total,0u);
+  LOG(Info, number << " toString(double) calls in " << elapsed << "s.");
+}
@@ -22,6 +22,7 @@
 
 #include <utilities/idf/IdfFile.hpp>
 #include <utilities/idf/ValidityReport.hpp>
+#include <utilities/idf/WorkspaceObject.hpp>
 
 #include <utilities/time/Time.hpp>
 
@@ -116,6 +117,42 @@ TEST_F(IdfFixture, IdfFile_DosLineEndings) {
   EXPECT_EQ(static_cast<unsigned>(5),oFile->objects().size());
   EXPECT_EQ(static_cast<unsigned>(0),oFile->getObjectsByType(IddObjectType::Catchall).size());
 }
+
+TEST_F(IdfFixture, IdfFile_LoadParallel) {
+  std::vector<openstudio::path> paths;
+  paths.push_back(resourcesPath()/toPath("energyplus/5ZoneAirCooled/in.idf"));
+  paths.push_back(resourcesPath()/toPath("utilities/Idf/CommentTest.idf"));
+  paths.push_back(resourcesPath()/toPath("utilities/Idf/DosLineEndingTest.idf"));
+
+  BOOST_FOREACH(const openstudio::path& p, paths) {
+    OptionalIdfFile serial = IdfFile::load(p,IddFileType::EnergyPlus);
+    ASSERT_TRUE(serial);
+    std::stringstream expected;
+    serial->print(expected);
+
+    for (unsigned numThreads = 0; numThreads <= 8; numThreads += 2) {
+      OptionalIdfFile parallel = IdfFile::loadParallel(p,IddFileType::EnergyPlus,numThreads);
+      ASSERT_TRUE(parallel);
+      EXPECT_EQ(serial->header(),parallel->header());
+      ASSERT_EQ(serial->objects().size(),parallel->objects().size());
+      std::stringstream actual;
+      parallel->print(actual);
+      EXPECT_TRUE(expected.str() == actual.str()) << toString(p) << " with " << numThreads << " threads";
+    }
+  }
+
+  // pointers resolve the same way in a Workspace
+  OptionalIdfFile parallel = IdfFile::loadParallel(paths[0],IddFileType::EnergyPlus,4);
+  ASSERT_TRUE(parallel);
+  Workspace workspace(*parallel,StrictnessLevel::Draft);
+  Workspace expected(epIdfFile,StrictnessLevel::Draft);
+  EXPECT_EQ(expected.numObjects(),workspace.numObjects());
+  EXPECT_TRUE(workspace.isValid(StrictnessLevel::Draft));
+  OptionalWorkspaceObject zone = workspace.getObjectByTypeAndName(IddObjectType::Zone,"SPACE1-1");
+  ASSERT_TRUE(zone);
+  EXPECT_EQ(expected.getObjectByTypeAndName(IddObjectType::Zone,"SPACE1-1")->sources().size(),
+            zone->sources().size());
+}
  
 TEST_F(IdfFixture, IdfFile_ObjectComments) {
   OptionalIdfFile oFile = IdfFile::load(resourcesPath()/toPath("utilities/Idf/CommentTest.idf"));
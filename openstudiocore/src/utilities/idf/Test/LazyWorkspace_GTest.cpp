@@ -0,0 +1,133 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/idf/Test/IdfFixture.hpp>
+
+#include <utilities/idf/LazyWorkspace.hpp>
+#include <utilities/idf/IdfFile.hpp>
+#include <utilities/idf/Workspace.hpp>
+#include <utilities/idf/WorkspaceObject.hpp>
+
+#include <utilities/idd/IddEnums.hxx>
+#include <utilities/idd/BuildingSurface_Detailed_FieldEnums.hxx>
+
+#include <utilities/core/Compare.hpp>
+
+#include <resources.hxx>
+
+using namespace openstudio;
+
+TEST_F(IdfFixture, LazyWorkspace_LoadAndQuery) {
+  path p = resourcesPath()/toPath("energyplus/5ZoneAirCooled/in.idf");
+  OptionalLazyWorkspace oLazy = LazyWorkspace::load(p, IddFileType::EnergyPlus);
+  ASSERT_TRUE(oLazy);
+  LazyWorkspace lazy = *oLazy;
+
+  // nothing is parsed up front
+  EXPECT_EQ(0u, lazy.numParsedObjects());
+  EXPECT_GT(lazy.numObjects(), 0u);
+
+  // counts by type match the eagerly loaded file
+  BOOST_FOREACH(IddObjectType type, lazy.objectTypes()) {
+    EXPECT_EQ(epIdfFile.getObjectsByType(type).size(), lazy.numObjectsOfType(type)) << type.valueName();
+  }
+  EXPECT_EQ(0u, lazy.numParsedObjects());
+
+  // only the requested type is parsed
+  IdfObjectVector zones = lazy.getObjectsByType(IddObjectType::Zone);
+  IdfObjectVector eagerZones = epIdfFile.getObjectsByType(IddObjectType::Zone);
+  ASSERT_EQ(eagerZones.size(), zones.size());
+  EXPECT_EQ(zones.size(), lazy.numParsedObjects());
+  for (unsigned i = 0, n = zones.size(); i < n; ++i) {
+    EXPECT_TRUE(zones[i].dataFieldsEqual(eagerZones[i]));
+  }
+
+  // repeated access returns the cached objects
+  IdfObjectVector zonesAgain = lazy.getObjectsByType(IddObjectType::Zone);
+  ASSERT_EQ(zones.size(), zonesAgain.size());
+  EXPECT_TRUE(zones[0].handle() == zonesAgain[0].handle());
+  EXPECT_EQ(zones.size(), lazy.numParsedObjects());
+
+  // returned objects are copies, editing one does not change the cache
+  std::string name = zones[0].name().get();
+  EXPECT_TRUE(zones[0].setName("Edited Zone"));
+  EXPECT_EQ(name, lazy.getObjectsByType(IddObjectType::Zone)[0].name().get());
+  EXPECT_TRUE(lazy.getObjectByTypeAndName(IddObjectType::Zone, name));
+  EXPECT_FALSE(lazy.getObjectByTypeAndName(IddObjectType::Zone, "Edited Zone"));
+
+  OptionalIdfObject zone = lazy.getObjectByTypeAndName(IddObjectType::Zone, "space1-1");
+  ASSERT_TRUE(zone);
+  EXPECT_EQ("SPACE1-1", zone->name().get());
+}
+
+TEST_F(IdfFixture, LazyWorkspace_Pointers) {
+  path p = resourcesPath()/toPath("energyplus/5ZoneAirCooled/in.idf");
+  OptionalLazyWorkspace oLazy = LazyWorkspace::load(p, IddFileType::EnergyPlus);
+  ASSERT_TRUE(oLazy);
+  LazyWorkspace lazy = *oLazy;
+
+  OptionalIdfObject surface = lazy.getObjectByTypeAndName(IddObjectType::BuildingSurface_Detailed, "WALL-1PF");
+  ASSERT_TRUE(surface);
+
+  OptionalIdfObject zone = lazy.getTarget(*surface, BuildingSurface_DetailedFields::ZoneName);
+  ASSERT_TRUE(zone);
+  EXPECT_TRUE(zone->iddObject().type() == IddObjectType::Zone);
+  EXPECT_TRUE(istringEqual("PLENUM-1", zone->name().get()));
+
+  OptionalIdfObject construction = lazy.getTarget(*surface, BuildingSurface_DetailedFields::ConstructionName);
+  ASSERT_TRUE(construction);
+  EXPECT_TRUE(istringEqual("WALL-1", construction->name().get()));
+
+  // fields that are not pointers have no target
+  EXPECT_FALSE(lazy.getTarget(*surface, BuildingSurface_DetailedFields::SurfaceType));
+
+  // reverse lookup finds the surface
+  IdfObjectVector sources = lazy.getSources(*zone);
+  EXPECT_FALSE(sources.empty());
+  bool found = false;
+  BOOST_FOREACH(const IdfObject& source, sources) {
+    if (source.handle() == surface->handle()) {
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+
+  // not everything has been parsed
+  EXPECT_LT(lazy.numParsedObjects(), lazy.numObjects());
+}
+
+TEST_F(IdfFixture, LazyWorkspace_ToWorkspace) {
+  path p = resourcesPath()/toPath("energyplus/5ZoneAirCooled/in.idf");
+  OptionalLazyWorkspace oLazy = LazyWorkspace::load(p, IddFileType::EnergyPlus);
+  ASSERT_TRUE(oLazy);
+
+  boost::optional<Workspace> workspace = oLazy->toWorkspace(StrictnessLevel::Draft);
+  ASSERT_TRUE(workspace);
+  EXPECT_EQ(epIdfFile.getObjectsByType(IddObjectType::Zone).size(),
+            workspace->getObjectsByType(IddObjectType::Zone).size());
+  EXPECT_EQ(epIdfFile.objects().size(), workspace->objects().size());
+
+  // the editable workspace does not share data with the lazy view
+  WorkspaceObjectVector zones = workspace->getObjectsByType(IddObjectType::Zone);
+  ASSERT_FALSE(zones.empty());
+  EXPECT_TRUE(zones[0].setName("A New Name"));
+  EXPECT_FALSE(oLazy->getObjectByTypeAndName(IddObjectType::Zone, "A New Name"));
+}
@@ -45,6 +45,7 @@
 #include <utilities/idd/OS_TimeDependentValuation_FieldEnums.hxx>
 #include <utilities/idd/Sizing_Zone_FieldEnums.hxx>
 #include <utilities/idf/WorkspaceWatcher.hpp>
+#include <utilities/idf/WorkspaceObjectWatcher.hpp>
 #include <utilities/idf/Test/IdfTestQObjects.hpp>
 
 #include <utilities/core/Application.hpp>
@@ -55,6 +56,7 @@
 
 #include <utilities/core/Compare.hpp>
 #include <utilities/core/StringStreamLogSink.hpp>
+#include <utilities/core/Instrumentation.hpp>
 
 #include <resources.hxx>
 
@@ -530,6 +532,87 @@ TEST_F(IdfFixture, Workspace_Clone) {
   EXPECT_FALSE(cloneHandles == wsHandles);
 }
 
+TEST_F(IdfFixture, Workspace_CloneIsolation) {
+  // field data is shared between original and clone until one of them is edited
+  Workspace workspace(epIdfFile,StrictnessLevel::None);
+  Workspace clone = workspace.clone(true);
+
+  WorkspaceObjectVector zones = workspace.getObjectsByType(IddObjectType::Zone);
+  ASSERT_FALSE(zones.empty());
+  OptionalWorkspaceObject cloneZone = clone.getObject(zones[0].handle());
+  ASSERT_TRUE(cloneZone);
+  std::string name = zones[0].name().get();
+  EXPECT_EQ(name,cloneZone->name().get());
+  std::string multiplier = zones[0].getString(ZoneFields::Multiplier,false,true).get_value_or("");
+  std::string fieldComment = zones[0].fieldComment(ZoneFields::Multiplier).get_value_or("");
+  std::string comment = zones[0].comment();
+
+  // edit the clone
+  EXPECT_TRUE(cloneZone->setString(ZoneFields::Multiplier,"3"));
+  EXPECT_TRUE(cloneZone->setFieldComment(ZoneFields::Multiplier,"edited in clone"));
+  cloneZone->setComment("! clone only");
+  EXPECT_EQ("3",cloneZone->getString(ZoneFields::Multiplier).get());
+  EXPECT_EQ(multiplier,zones[0].getString(ZoneFields::Multiplier,false,true).get_value_or(""));
+  EXPECT_EQ(fieldComment,zones[0].fieldComment(ZoneFields::Multiplier).get_value_or(""));
+  EXPECT_EQ(comment,zones[0].comment());
+
+  // edit the original
+  EXPECT_TRUE(zones[0].setName("Original Zone Name"));
+  EXPECT_EQ(name,cloneZone->name().get());
+
+  // extensible groups
+  WorkspaceObjectVector surfaces = workspace.getObjectsByType(IddObjectType::BuildingSurface_Detailed);
+  ASSERT_FALSE(surfaces.empty());
+  OptionalWorkspaceObject cloneSurface = clone.getObject(surfaces[0].handle());
+  ASSERT_TRUE(cloneSurface);
+  unsigned n = surfaces[0].numFields();
+  EXPECT_EQ(n,cloneSurface->numFields());
+  StringVector vertex;
+  vertex.push_back("1.0"); vertex.push_back("2.0"); vertex.push_back("3.0");
+  EXPECT_FALSE(cloneSurface->pushExtensibleGroup(vertex).empty());
+  EXPECT_EQ(n + 3,cloneSurface->numFields());
+  EXPECT_EQ(n,surfaces[0].numFields());
+  EXPECT_FALSE(surfaces[0].popExtensibleGroup().empty());
+  EXPECT_EQ(n - 3,surfaces[0].numFields());
+  EXPECT_EQ(n + 3,cloneSurface->numFields());
+
+  // clone of clone
+  Workspace cloneOfClone = clone.clone(true);
+  OptionalWorkspaceObject zone3 = cloneOfClone.getObject(zones[0].handle());
+  ASSERT_TRUE(zone3);
+  EXPECT_EQ("3",zone3->getString(ZoneFields::Multiplier).get());
+  EXPECT_TRUE(zone3->setString(ZoneFields::Multiplier,"4"));
+  EXPECT_EQ("3",cloneZone->getString(ZoneFields::Multiplier).get());
+
+  // IdfObjects
+  IdfObject idfObject = epIdfFile.getObjectsByType(IddObjectType::Zone)[0];
+  IdfObject idfClone = idfObject.clone();
+  EXPECT_TRUE(idfClone.setName("Cloned IdfObject"));
+  EXPECT_EQ(name,idfObject.name().get());
+}
+
+TEST_F(IdfFixture, Workspace_MemoryUsage) {
+  Workspace workspace(epIdfFile,StrictnessLevel::None);
+  typedef std::map<std::string,IdfObjectMemoryUsage> UsageMap;
+  UsageMap usage = workspace.memoryUsage();
+
+  unsigned numObjects = 0;
+  BOOST_FOREACH(const UsageMap::value_type& p, usage) {
+    numObjects += p.second.numObjects;
+    EXPECT_GT(p.second.tableBytes, 0u) << p.first;
+  }
+  EXPECT_EQ(workspace.objects().size(), numObjects);
+
+  std::string zoneName = workspace.getObjectsByType(IddObjectType::Zone)[0].iddObject().name();
+  ASSERT_TRUE(usage.find(zoneName) != usage.end());
+  EXPECT_EQ(workspace.getObjectsByType(IddObjectType::Zone).size(), usage[zoneName].numObjects);
+  EXPECT_GT(usage[zoneName].numFields, usage[zoneName].numObjects);
+
+  std::stringstream ss;
+  workspace.printMemoryUsage(ss);
+  EXPECT_FALSE(ss.str().empty());
+}
+
 TEST_F(IdfFixture,Workspace_Insert) {
   Workspace workspace(epIdfFile,StrictnessLevel::None);
   unsigned n = workspace.handles().size();
@@ -1883,4 +1966,122 @@ TEST_F(IdfFixture, Workspace_DaylightingControlsZoneName)
   ASSERT_TRUE(daylightingControl->getString(0,false,true));
   EXPECT_EQ("Zone 1", daylightingControl->getString(0,false,true).get());
 
+}
+
+TEST_F(IdfFixture, Workspace_Transaction)
+{
+  Workspace workspace(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  OptionalWorkspaceObject oZone1 = workspace.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(oZone1);
+  OptionalWorkspaceObject oZone2 = workspace.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(oZone2);
+  OptionalWorkspaceObject oLights = workspace.addObject(IdfObject(IddObjectType::Lights));
+  ASSERT_TRUE(oLights);
+  WorkspaceObject lights = *oLights;
+  ASSERT_TRUE(lights.setPointer(1,oZone1->handle()));
+  ASSERT_TRUE(lights.setString(4,"10.0"));
+
+  WorkspaceObjectWatcher watcher(lights);
+  EXPECT_FALSE(watcher.dirty());
+
+  // valid edits are signalled once, on commit
+  {
+    WorkspaceTransaction transaction(workspace);
+    EXPECT_TRUE(workspace.inTransaction());
+    EXPECT_TRUE(lights.setString(4,"22.3"));
+    EXPECT_TRUE(lights.setPointer(1,oZone2->handle()));
+    EXPECT_FALSE(watcher.dirty());
+    EXPECT_TRUE(transaction.commit());
+  }
+  EXPECT_FALSE(workspace.inTransaction());
+  EXPECT_TRUE(watcher.dirty());
+  EXPECT_TRUE(watcher.dataChanged());
+  EXPECT_TRUE(watcher.relationshipChanged());
+  EXPECT_EQ("22.3",lights.getString(4).get());
+  ASSERT_TRUE(lights.getTarget(1));
+  EXPECT_TRUE(lights.getTarget(1)->handle() == oZone2->handle());
+  watcher.clearState();
+
+  // an invalid edit rolls back the whole transaction, signalling the restored fields
+  ASSERT_TRUE(workspace.startTransaction());
+  EXPECT_FALSE(workspace.startTransaction());
+  EXPECT_TRUE(lights.setPointer(1,oZone1->handle()));
+  EXPECT_TRUE(lights.setString(4,"not a number"));
+  EXPECT_FALSE(watcher.dirty());
+  EXPECT_FALSE(workspace.commitTransaction());
+  EXPECT_FALSE(workspace.inTransaction());
+  EXPECT_TRUE(watcher.dirty());
+  EXPECT_TRUE(watcher.dataChanged());
+  EXPECT_TRUE(watcher.relationshipChanged());
+  EXPECT_FALSE(watcher.nameChanged());
+  watcher.clearState();
+  EXPECT_EQ("22.3",lights.getString(4).get());
+  ASSERT_TRUE(lights.getTarget(1));
+  EXPECT_TRUE(lights.getTarget(1)->handle() == oZone2->handle());
+  EXPECT_TRUE(oZone1->getSources(IddObjectType::Lights).empty());
+  EXPECT_EQ(1u,oZone2->getSources(IddObjectType::Lights).size());
+  EXPECT_TRUE(workspace.isValid());
+
+  // a transaction that is not committed is rolled back when it goes out of scope
+  std::string comment = lights.comment();
+  {
+    WorkspaceTransaction transaction(workspace);
+    EXPECT_TRUE(lights.setString(4,"5.0"));
+    lights.setComment("Temporary");
+  }
+  EXPECT_FALSE(workspace.inTransaction());
+  EXPECT_TRUE(watcher.dirty());
+  EXPECT_TRUE(watcher.dataChanged());
+  EXPECT_FALSE(watcher.relationshipChanged());
+  EXPECT_EQ("22.3",lights.getString(4).get());
+  EXPECT_EQ(comment,lights.comment());
+  watcher.clearState();
+
+  // rolling back a transaction that changed nothing does not signal
+  {
+    WorkspaceTransaction transaction(workspace);
+    EXPECT_TRUE(lights.setString(4,"22.3"));
+  }
+  EXPECT_FALSE(watcher.dirty());
+}
+
+TEST_F(IdfFixture, Workspace_RemoveObjectInstrumentation)
+{
+  bool wasEnabled = Instrumentation::instance().enabled();
+  Instrumentation::instance().setEnabled(true);
+  unsigned thread = Instrumentation::instance().currentThread();
+
+  Workspace workspace(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  OptionalWorkspaceObject zone1 = workspace.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(zone1);
+  OptionalWorkspaceObject zone2 = workspace.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(zone2);
+  OptionalWorkspaceObject zone3 = workspace.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(zone3);
+
+  long long start = Instrumentation::instance().now();
+  EXPECT_TRUE(workspace.removeObject(zone1->handle()));
+  EXPECT_TRUE(workspace.removeObjects(std::vector<Handle>(1u, zone2->handle())));
+  EXPECT_TRUE(workspace.removeObject(zone3->handle()));
+
+  // single and batched removal are timed and counted separately
+  unsigned removeObjectTimers = 0, removeObjectsTimers = 0;
+  long long removeObjectCount = 0, removeObjectsCount = 0;
+  BOOST_FOREACH(const InstrumentationEvent& event, Instrumentation::instance().events(thread, start)) {
+    if (event.name == "Workspace::removeObject") {
+      ++removeObjectTimers;
+    } else if (event.name == "Workspace::removeObjects") {
+      ++removeObjectsTimers;
+    } else if (event.name == "Workspace::removeObject objects") {
+      removeObjectCount += event.count;
+    } else if (event.name == "Workspace::removeObjects objects") {
+      removeObjectsCount += event.count;
+    }
+  }
+  EXPECT_EQ(2u, removeObjectTimers);
+  EXPECT_EQ(2, removeObjectCount);
+  EXPECT_EQ(1u, removeObjectsTimers);
+  EXPECT_EQ(1, removeObjectsCount);
+
+  Instrumentation::instance().setEnabled(wasEnabled);
 }
\ No newline at end of file
@@ -33,7 +33,9 @@
 #include <utilities/core/Containers.hpp>
 #include <utilities/core/URLHelpers.hpp>
 #include <utilities/core/Compare.hpp>
+#include <utilities/core/Instrumentation.hpp>
 #include <utilities/core/StringHelpers.hpp>
+#include <utilities/core/StringPool.hpp>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
@@ -43,6 +45,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <iomanip>
 #include <deque>
 #include <map>
 #include <list>
@@ -60,6 +63,7 @@ namespace detail {
       m_strictnessLevel(level),
       m_iddFileAndFactoryWrapper(iddFileType),
       m_fastNaming(false),
+      m_inTransaction(false),
       m_workspaceObjectOrder(boost::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(HandleVector(),boost::bind(&Workspace_Impl::getObject,this,_1))))
   {}
@@ -70,6 +74,7 @@ namespace detail {
       m_header(idfFile.header()),
       m_iddFileAndFactoryWrapper(idfFile.iddFileAndFactoryWrapper()),
       m_fastNaming(false),
+      m_inTransaction(false),
       m_workspaceObjectOrder(boost::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(HandleVector(),boost::bind(&Workspace_Impl::getObject,this,_1))))
   {}
@@ -79,6 +84,7 @@ namespace detail {
     m_header(other.m_header),
     m_iddFileAndFactoryWrapper(other.m_iddFileAndFactoryWrapper),
     m_fastNaming(other.fastNaming()),
+    m_inTransaction(false),
     m_workspaceObjectOrder(boost::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(boost::bind(&Workspace_Impl::getObject,this,_1))))
   {
@@ -101,6 +107,7 @@ namespace detail {
       m_header(), // subset of original data--discard header
       m_iddFileAndFactoryWrapper(other.m_iddFileAndFactoryWrapper),
       m_fastNaming(other.fastNaming()),
+      m_inTransaction(false),
       m_workspaceObjectOrder(boost::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(hs,boost::bind(&Workspace_Impl::getObject,this,_1))))
   {
@@ -457,6 +464,11 @@ namespace detail {
     return m_fastNaming;
   }
 
+  bool Workspace_Impl::inTransaction() const
+  {
+    return m_inTransaction;
+  }
+
   // SETTERS
 
   bool Workspace_Impl::setStrictnessLevel(StrictnessLevel level) {
@@ -492,6 +504,8 @@ namespace detail {
       bool driverMethod,
       bool expectToLosePointers)
   {
+    OS_TIMER("Workspace::addObjects");
+    OS_COUNT("Workspace::addObjects objects", objectImplPtrs.size());
     HandleVector newHandles;
     WorkspaceObjectVector newObjects;
 
@@ -1481,6 +1495,8 @@ namespace detail {
   }
 
   bool Workspace_Impl::removeObject(const Handle& handle) {
+    OS_TIMER("Workspace::removeObject");
+    OS_COUNT("Workspace::removeObject objects", 1);
 
     OptionalSavedWorkspaceObject objectData = savedWorkspaceObject(handle);
     if (!objectData) {
@@ -1512,6 +1528,9 @@ namespace detail {
 
     if (handles.empty()) { return true; }
 
+    OS_TIMER("Workspace::removeObjects");
+    OS_COUNT("Workspace::removeObjects objects", handles.size());
+
     SavedWorkspaceObjectVector objectData;
     BOOST_FOREACH(const Handle& handle,handles) {
       OptionalSavedWorkspaceObject candidate = savedWorkspaceObject(handle);
@@ -1612,6 +1631,65 @@ namespace detail {
     m_fastNaming = fastNaming;
   }
 
+  bool Workspace_Impl::startTransaction()
+  {
+    if (m_inTransaction) {
+      return false;
+    }
+    m_inTransaction = true;
+    return true;
+  }
+
+  bool Workspace_Impl::commitTransaction()
+  {
+    if (!m_inTransaction) {
+      return false;
+    }
+    m_inTransaction = false;
+
+    WorkspaceObject_ImplPtrVector edited;
+    edited.swap(m_transactionObjects);
+
+    // validity checks deferred by the setters, once per object rather than once per field
+    bool result = true;
+    BOOST_FOREACH(const WorkspaceObject_ImplPtr& object, edited) {
+      if (object->initialized() && !object->isValid(m_strictnessLevel,false)) {
+        LOG(Info,"Rolling back edit transaction because " << object->briefDescription() 
+            << " is not valid at strictness level " << m_strictnessLevel.valueName() << ".");
+        result = false;
+        break;
+      }
+    }
+
+    BOOST_FOREACH(const WorkspaceObject_ImplPtr& object, edited) {
+      object->endTransactionEdit(!result);
+    }
+    // signal once every object is in its final state
+    BOOST_FOREACH(const WorkspaceObject_ImplPtr& object, edited) {
+      object->emitChangeSignals();
+    }
+
+    return result;
+  }
+
+  void Workspace_Impl::rollbackTransaction()
+  {
+    if (!m_inTransaction) {
+      return;
+    }
+    m_inTransaction = false;
+
+    WorkspaceObject_ImplPtrVector edited;
+    edited.swap(m_transactionObjects);
+    BOOST_FOREACH(const WorkspaceObject_ImplPtr& object, edited) {
+      object->endTransactionEdit(true);
+    }
+    // signal once every object is in its final state
+    BOOST_FOREACH(const WorkspaceObject_ImplPtr& object, edited) {
+      object->emitChangeSignals();
+    }
+  }
+
   // OBJECT ORDER
 
   WorkspaceObjectOrder Workspace_Impl::order() {
@@ -1715,6 +1793,39 @@ namespace detail {
     return validityReport(strictnessLevel());
   }
 
+  std::map<std::string,IdfObjectMemoryUsage> Workspace_Impl::memoryUsage() const {
+    std::map<std::string,IdfObjectMemoryUsage> result;
+    BOOST_FOREACH(const WorkspaceObjectMap::value_type& p, m_workspaceObjectMap) {
+      p.second->addMemoryUsage(result[p.second->iddObject().name()]);
+    }
+    return result;
+  }
+
+  std::ostream& Workspace_Impl::printMemoryUsage(std::ostream& os) const {
+    typedef std::map<std::string,IdfObjectMemoryUsage> UsageMap;
+    UsageMap usage = memoryUsage();
+    IdfObjectMemoryUsage total;
+
+    os << std::left << std::setw(50) << "Object Type" << std::right
+       << std::setw(10) << "Objects" << std::setw(12) << "Fields" << std::setw(10) << "Comments"
+       << std::setw(14) << "Table Bytes" << std::setw(14) << "Text Bytes" << std::endl;
+    BOOST_FOREACH(const UsageMap::value_type& p, usage) {
+      os << std::left << std::setw(50) << p.first << std::right
+         << std::setw(10) << p.second.numObjects << std::setw(12) << p.second.numFields
+         << std::setw(10) << p.second.numFieldComments << std::setw(14) << p.second.tableBytes
+         << std::setw(14) << p.second.unpooledBytes << std::endl;
+      total += p.second;
+    }
+    os << std::left << std::setw(50) << "Total" << std::right
+       << std::setw(10) << total.numObjects << std::setw(12) << total.numFields
+       << std::setw(10) << total.numFieldComments << std::setw(14) << total.tableBytes
+       << std::setw(14) << total.unpooledBytes << std::endl;
+    os << "StringPool: " << StringPool::instance().numStrings() << " strings, "
+       << StringPool::instance().numBytes() << " bytes (shared by all objects)" << std::endl;
+
+    return os;
+  }
+
   ValidityReport Workspace_Impl::validityReport(StrictnessLevel level) const
   {
     ValidityReport report(level);
@@ -2827,6 +2938,11 @@ bool Workspace::fastNaming() const
   return m_impl->fastNaming();
 }
 
+bool Workspace::inTransaction() const
+{
+  return m_impl->inTransaction();
+}
+
 // SETTERS
 
 bool Workspace::setStrictnessLevel(StrictnessLevel level) {
@@ -2894,6 +3010,21 @@ void Workspace::setFastNaming(bool fastNaming)
   m_impl->setFastNaming(fastNaming);
 }
 
+bool Workspace::startTransaction()
+{
+  return m_impl->startTransaction();
+}
+
+bool Workspace::commitTransaction()
+{
+  return m_impl->commitTransaction();
+}
+
+void Workspace::rollbackTransaction()
+{
+  m_impl->rollbackTransaction();
+}
+
 // ORDER
 
 WorkspaceObjectOrder Workspace::order() {
@@ -2963,6 +3094,14 @@ ValidityReport Workspace::validityReport(StrictnessLevel level) const {
   return m_impl->validityReport(level);
 }
 
+std::map<std::string,IdfObjectMemoryUsage> Workspace::memoryUsage() const {
+  return m_impl->memoryUsage();
+}
+
+std::ostream& Workspace::printMemoryUsage(std::ostream& os) const {
+  return m_impl->printMemoryUsage(os);
+}
+
 bool Workspace::operator==(const Workspace& other) const {
   return (m_impl == other.m_impl);
 }
@@ -3054,6 +3193,27 @@ void Workspace::addVersionObject() {
   }
 }
 
+WorkspaceTransaction::WorkspaceTransaction(const Workspace& workspace)
+  : m_workspace(workspace),
+    m_open(m_workspace.startTransaction())
+{}
+
+WorkspaceTransaction::~WorkspaceTransaction()
+{
+  if (m_open) {
+    m_workspace.rollbackTransaction();
+  }
+}
+
+bool WorkspaceTransaction::commit()
+{
+  if (!m_open) {
+    return false;
+  }
+  m_open = false;
+  return m_workspace.commitTransaction();
+}
+
 std::ostream& operator<<(std::ostream& os, const Workspace& workspace)
 {
   os << workspace.toIdfFile();
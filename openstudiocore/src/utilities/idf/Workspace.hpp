@@ -33,6 +33,7 @@
 #include <ostream>
 #include <vector>
 #include <set>
+#include <map>
 
 namespace openstudio {
 
@@ -43,6 +44,7 @@ class IddObject;
 class IddObjectType;
 class IdfFile;
 class IdfObject;
+struct IdfObjectMemoryUsage;
 class WorkspaceObject;
 class WorkspaceObjectOrder;
 class URLSearchPath;
@@ -225,6 +227,9 @@ class UTILITIES_API Workspace {
    *  objects and does not do any name conflict checking. */
   bool fastNaming() const;
 
+  /** Returns true if an edit transaction is open. */
+  bool inTransaction() const;
+
   //@}
   /** @name Setters */
   //@{
@@ -334,6 +339,25 @@ class UTILITIES_API Workspace {
    *  handle. */
   void setFastNaming(bool fastNaming);
 
+  /** Opens an edit transaction, and returns false if one is already open. While it is open,
+   *  field edits to existing objects skip their per-field validity checks and each edited
+   *  object holds its change signals. Names are still checked as they are set. Adding and
+   *  removing objects is not part of the transaction. Use WorkspaceTransaction to make sure
+   *  the transaction is closed. */
+  bool startTransaction();
+
+  /** Checks each object edited since startTransaction() once, at strictnessLevel(). If all are
+   *  valid, each edited object emits a single round of change signals for all of its edits, and
+   *  true is returned. Otherwise, all of the edits are rolled back as in rollbackTransaction(),
+   *  and false is returned. */
+  bool commitTransaction();
+
+  /** Restores the fields, pointers and comments of every object edited since
+   *  startTransaction(). Each restored object then emits one round of change signals for the
+   *  fields that the rollback changed back, so that anything computed from the edited values
+   *  during the transaction is refreshed. */
+  void rollbackTransaction();
+
   //@}
   /** @name Object Order */
   //@{
@@ -395,6 +419,13 @@ class UTILITIES_API Workspace {
   /** Returns a ValidityReport for this Workspace containing all errors at or below level. */
   ValidityReport validityReport(StrictnessLevel level) const;
 
+  /** Returns the approximate memory used by object field data, keyed by IddObject name. */
+  std::map<std::string,IdfObjectMemoryUsage> memoryUsage() const;
+
+  /** Prints memoryUsage() as a table, followed by the totals and the size of the StringPool
+   *  shared by all objects. */
+  std::ostream& printMemoryUsage(std::ostream& os) const;
+
   bool operator==(const Workspace& other) const;
 
   bool operator!=(const Workspace& other) const;
@@ -503,6 +534,23 @@ class UTILITIES_API Workspace {
   boost::shared_ptr<detail::Workspace_Impl> m_impl;
 };
 
+/** Scoped edit transaction. Opens a transaction on workspace on construction and rolls it back
+ *  on destruction unless commit() has been called. */
+class UTILITIES_API WorkspaceTransaction {
+ public:
+  explicit WorkspaceTransaction(const Workspace& workspace);
+
+  ~WorkspaceTransaction();
+
+  /** Commits the transaction. Returns false if the edits were rolled back, or if this object
+   *  did not open the transaction. */
+  bool commit();
+
+ private:
+  Workspace m_workspace;
+  bool m_open;
+};
+
 /** \relates Workspace */
 typedef boost::optional<Workspace> OptionalWorkspace;
 
@@ -41,6 +41,8 @@
 #include <boost/regex.hpp>
 
 #include <iostream>
+#include <map>
+#include <set>
 using namespace std;
 
 using openstudio::detail::WorkspaceObject_Impl;
@@ -315,6 +317,10 @@ namespace detail {
     }
     StrictnessLevel level = m_workspace->strictnessLevel();
 
+    // names are checked immediately, even in a transaction, so that conflicts are resolved by
+    // renaming as usual
+    recordEdit();
+
     OptionalUnsigned index = iddObject().nameFieldIndex();
     if (!index) {
       return false;
@@ -384,6 +390,7 @@ namespace detail {
   {
     if (m_handle.isNull()) { return false; }
     StrictnessLevel level = m_workspace->strictnessLevel();
+    recordEdit();
 
     if (canBeSource(index)) {
       // pointer field
@@ -399,6 +406,11 @@ namespace detail {
       return setName(value,checkValidity);
     } // name
 
+    // validity is checked on commit
+    if (m_transactionSnapshot) {
+      checkValidity = false;
+    }
+
     // record diffs at start
     unsigned diffSize = m_diffs.size();
 
@@ -475,6 +487,12 @@ namespace detail {
 
       StrictnessLevel level = m_workspace->strictnessLevel();
 
+      // validity is checked on commit
+      recordEdit();
+      if (m_transactionSnapshot) {
+        checkValidity = false;
+      }
+
       // field NullAndRequired
       if (checkValidity &&
           (level > StrictnessLevel::Draft) &&
@@ -570,6 +588,7 @@ namespace detail {
     if (m_handle.isNull()) {
       return false;
     }
+    recordEdit();
 
     unsigned index = numFields();
 
@@ -613,6 +632,7 @@ namespace detail {
     if (m_handle.isNull()) {
       return false;
     }
+    recordEdit();
 
     unsigned index = numFields();
 
@@ -665,6 +685,7 @@ namespace detail {
     }
 
     // erase fields, handling pointers as necessary
+    recordEdit();
     result = IdfObject_Impl::popExtensibleGroup(checkValidity);
     if (m_sourceData && !result.empty()) {
       unsigned n = numFields();
@@ -830,6 +851,9 @@ namespace detail {
                                                 m_iddObject,
                                                 m_fields,
                                                 m_fieldComments));
+    if (!m_handleFieldValue.empty()) {
+      result->setString(0,m_handleFieldValue);
+    }
     // add name references based on WorkspaceObject's pointer data
     if (m_sourceData) {
       bool serializeHandle = m_iddObject.hasHandleField();
@@ -868,6 +892,9 @@ namespace detail {
                                                 m_iddObject,
                                                 m_fields,
                                                 m_fieldComments));
+    if (!m_handleFieldValue.empty()) {
+      result->setString(0,m_handleFieldValue);
+    }
     // add name references based on WorkspaceObject's pointer data
     if (m_sourceData) {
       bool serializeHandle = m_iddObject.hasHandleField();
@@ -905,6 +932,11 @@ namespace detail {
       return;
     }
 
+    // edits made in a transaction are announced together on commit
+    if (m_transactionSnapshot) {
+      return;
+    }
+
     bool nameChange = false;
     bool dataChange = false;
 
@@ -1047,6 +1079,150 @@ namespace detail {
     }
   }
 
+  void WorkspaceObject_Impl::recordEdit() {
+    if (m_transactionSnapshot || !initialized() || !m_workspace->inTransaction()) {
+      return;
+    }
+
+    TransactionSnapshot snapshot;
+    snapshot.comment = m_comment;
+    snapshot.fields = m_fields;
+    snapshot.handleFieldValue = m_handleFieldValue;
+    snapshot.fieldComments = m_fieldComments;
+    if (m_sourceData) {
+      snapshot.pointers = m_sourceData->pointers;
+    }
+    m_transactionSnapshot = snapshot;
+
+    m_workspace->m_transactionObjects.push_back(
+        boost::static_pointer_cast<WorkspaceObject_Impl>(shared_from_this()));
+  }
+
+  void WorkspaceObject_Impl::endTransactionEdit(bool rollback) {
+    if (!m_transactionSnapshot) {
+      return;
+    }
+    TransactionSnapshot snapshot = *m_transactionSnapshot;
+    m_transactionSnapshot.reset();
+
+    if (!rollback) {
+      return;
+    }
+
+    m_diffs.clear();
+
+    // object was removed during the transaction
+    if (m_handle.isNull()) {
+      return;
+    }
+
+    // state as edited, to describe the rollback as diffs
+    std::string editedComment = m_comment;
+    std::vector<std::string> editedFields = fields();
+    InternedStringVector editedFieldComments = m_fieldComments;
+    std::map<unsigned,Handle> editedPointers;
+    if (m_sourceData) {
+      BOOST_FOREACH(const ForwardPointer& ptr,m_sourceData->pointers) {
+        editedPointers[ptr.fieldIndex] = ptr.targetHandle;
+      }
+    }
+
+    // drop pointers that were added or retargeted during the transaction
+    if (m_sourceData) {
+      std::vector<ForwardPointer> current(m_sourceData->pointers.begin(),m_sourceData->pointers.end());
+      BOOST_FOREACH(const ForwardPointer& ptr,current) {
+        ForwardPointerSet::const_iterator it = snapshot.pointers.find(ptr);
+        if ((it == snapshot.pointers.end()) || (it->targetHandle != ptr.targetHandle)) {
+          nullifyPointer(ptr.fieldIndex);
+          SourceData::pointer_set::iterator fpIt =
+              getIteratorAtFieldIndex<SourceData>(m_sourceData->pointers,ptr.fieldIndex);
+          OS_ASSERT(fpIt != m_sourceData->pointers.end());
+          m_sourceData->pointers.erase(fpIt);
+        }
+      }
+    }
+
+    m_comment = snapshot.comment;
+    m_fields = snapshot.fields;
+    m_handleFieldValue = snapshot.handleFieldValue;
+    m_fieldComments = snapshot.fieldComments;
+
+    // put the original pointers back, unless their targets have since been removed
+    BOOST_FOREACH(const ForwardPointer& ptr,snapshot.pointers) {
+      OS_ASSERT(m_sourceData);
+      if (m_sourceData->pointers.find(ptr) == m_sourceData->pointers.end()) {
+        Handle targetHandle = ptr.targetHandle;
+        if (!targetHandle.isNull() && !m_workspace->isMember(targetHandle)) {
+          targetHandle = Handle();
+        }
+        setPointerImpl(ptr.fieldIndex,targetHandle);
+      }
+    }
+
+    // record the rollback as diffs from the edited state, so that anything that saw the edits
+    // (e.g. caches that were rebuilt during the transaction) is told about the restored values
+    std::map<unsigned,Handle> restoredPointers;
+    if (m_sourceData) {
+      BOOST_FOREACH(const ForwardPointer& ptr,m_sourceData->pointers) {
+        restoredPointers[ptr.fieldIndex] = ptr.targetHandle;
+      }
+    }
+    std::set<unsigned> pointerIndices;
+    typedef std::map<unsigned,Handle>::value_type PointerPair;
+    BOOST_FOREACH(const PointerPair& p,editedPointers) {
+      pointerIndices.insert(p.first);
+    }
+    BOOST_FOREACH(const PointerPair& p,restoredPointers) {
+      pointerIndices.insert(p.first);
+    }
+
+    if ((m_comment != editedComment) || (m_fieldComments.strings() != editedFieldComments.strings())) {
+      m_diffs.push_back(IdfObjectDiff(boost::none, boost::none, boost::none));
+    }
+
+    unsigned n = std::max(editedFields.size(),m_fields.size());
+    for (unsigned i = 0; i < n; ++i) {
+      if (pointerIndices.find(i) != pointerIndices.end()) {
+        continue;
+      }
+      OptionalString oldValue, newValue;
+      if (i < editedFields.size()) {
+        oldValue = editedFields[i];
+      }
+      if (i < m_fields.size()) {
+        newValue = fieldValue(i);
+      }
+      if (oldValue != newValue) {
+        m_diffs.push_back(IdfObjectDiff(i, oldValue, newValue));
+      }
+    }
+
+    BOOST_FOREACH(unsigned index,pointerIndices) {
+      Handle oldHandle, newHandle;
+      std::map<unsigned,Handle>::const_iterator it = editedPointers.find(index);
+      if (it != editedPointers.end()) {
+        oldHandle = it->second;
+      }
+      it = restoredPointers.find(index);
+      if (it != restoredPointers.end()) {
+        newHandle = it->second;
+      }
+      if (oldHandle == newHandle) {
+        continue;
+      }
+      OptionalString oldValue, newValue;
+      if (iddObject().hasHandleField()) {
+        oldValue = toString(oldHandle);
+        newValue = toString(newHandle);
+      }
+      else {
+        oldValue = m_workspace->name(oldHandle);
+        newValue = m_workspace->name(newHandle);
+      }
+      m_diffs.push_back(WorkspaceObjectDiff(index, oldValue, newValue, oldHandle, newHandle));
+    }
+  }
+
   // PRIVATE
 
   // SETTERS
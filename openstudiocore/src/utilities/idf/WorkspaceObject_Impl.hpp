@@ -314,6 +314,17 @@ namespace detail {
      *  objects. */
     void restorePointers();
 
+    /** Saves the state of this object the first time it is edited while its Workspace has an
+     *  open edit transaction. Edits made after that point skip field-level validity checks and
+     *  hold their change signals until the transaction ends. */
+    virtual void recordEdit();
+
+    /** Ends this object's part in a Workspace edit transaction. If rollback, restores the state
+     *  saved by recordEdit and replaces the pending diffs with ones describing the restore.
+     *  Otherwise, keeps the diffs of all of the edits made during the transaction. In both cases
+     *  the diffs are announced by the next call to emitChangeSignals. */
+    void endTransactionEdit(bool rollback);
+
     // QUERY HELPERS
 
     virtual void populateValidityReport(ValidityReport& report,bool checkNames) const;
@@ -335,6 +346,16 @@ namespace detail {
     OptionalSourceData  m_sourceData;
     OptionalTargetData  m_targetData;
 
+    // state as of the first edit in the current Workspace edit transaction
+    struct TransactionSnapshot {
+      std::string          comment;
+      InternedStringVector fields;
+      std::string          handleFieldValue;
+      InternedStringVector fieldComments;
+      ForwardPointerSet    pointers;
+    };
+    boost::optional<TransactionSnapshot> m_transactionSnapshot;
+
     // SETTER HELPERS
 
     /** Sets pointer at field index to targetHandle, and returns old target. */
@@ -205,6 +205,9 @@ namespace detail {
     /** Returns true if fast naming is enabled. */
     bool fastNaming() const;
 
+    /** Returns true if an edit transaction is open. */
+    bool inTransaction() const;
+
     //@}
     /** @name Setters */
     //@{
@@ -346,6 +349,17 @@ namespace detail {
      */
     void setFastNaming(bool fastNaming);
 
+    /** Opens an edit transaction. Returns false if one is already open. */
+    bool startTransaction();
+
+    /** Checks every object edited since startTransaction at strictnessLevel(). If all are
+     *  valid, emits one round of change signals per edited object and returns true. Otherwise,
+     *  rolls back the transaction and returns false. */
+    bool commitTransaction();
+
+    /** Restores the field data and comments of every object edited since startTransaction. */
+    void rollbackTransaction();
+
     /** Resolve name conflicts within other, and between this workspace and other by renaming objects
      *  in other. */
     bool resolvePotentialNameConflicts(Workspace& other);
@@ -412,6 +426,10 @@ namespace detail {
     /** Returns a ValidityReport for this Workspace containing all errors at or below level. */
     virtual ValidityReport validityReport(StrictnessLevel level) const;
 
+    std::map<std::string,IdfObjectMemoryUsage> memoryUsage() const;
+
+    std::ostream& printMemoryUsage(std::ostream& os) const;
+
     /** Returns an IdfObject based on the Version IddObject appropriate for this Workspace. No
      *  public interface. Used in constructing Workspaces. */
     IdfObject versionObjectToAdd() const;
@@ -481,12 +499,16 @@ namespace detail {
 
    private:
 
+    friend class WorkspaceObject_Impl;
+
     // DATA
 
     StrictnessLevel m_strictnessLevel; // level of validity to be maintained by collection
     std::string m_header;                                // header for the IdfFile
     IddFileAndFactoryWrapper m_iddFileAndFactoryWrapper; // IDD file to be used for validity checking
     bool m_fastNaming;
+    bool m_inTransaction;
+    WorkspaceObject_ImplPtrVector m_transactionObjects;  // objects edited in the open transaction
 
     typedef std::map<Handle, boost::shared_ptr<WorkspaceObject_Impl> > WorkspaceObjectMap;
     WorkspaceObjectMap m_workspaceObjectMap;
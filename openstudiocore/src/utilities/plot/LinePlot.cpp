@@ -20,7 +20,12 @@
 #include <utilities/plot/LinePlot.hpp>
 #include <cfloat>
 #include <utilities/core/Application.hpp>
+#include <utilities/core/Assert.hpp>
 #include <qwt/qwt_painter.h>
+#include <qwt/qwt_scale_map.h>
+#include <qwt/qwt_symbol.h>
+
+#include <algorithm>
 
 
 using namespace std;
@@ -206,6 +211,177 @@ double VectorLinePlotData::y(size_t pos) const
 }
 
 
+/* --------------------------------------
+ * LinePlotPyramid Class
+ * --------------------------------------
+*/
+
+namespace {
+
+  // keep the minimum and maximum of each group of four points, in their original order
+  void decimate(const QwtData& source, std::vector<double>& x, std::vector<double>& y)
+  {
+    size_t n = source.size();
+    x.clear();
+    y.clear();
+    x.reserve(n/2 + 2);
+    y.reserve(n/2 + 2);
+    for (size_t begin = 0; begin < n; begin += 4){
+      size_t end = std::min(begin + 4, n);
+      size_t iMin = begin;
+      size_t iMax = begin;
+      for (size_t i = begin + 1; i < end; ++i){
+        double value = source.y(i);
+        if (value < source.y(iMin)) iMin = i;
+        if (value > source.y(iMax)) iMax = i;
+      }
+      size_t first = std::min(iMin, iMax);
+      size_t second = std::max(iMin, iMax);
+      x.push_back(source.x(first));
+      y.push_back(source.y(first));
+      if (second != first){
+        x.push_back(source.x(second));
+        y.push_back(source.y(second));
+      }
+    }
+  }
+
+}
+
+LinePlotPyramid::LinePlotPyramid(const QwtData& data, unsigned minPoints)
+  : m_size(data.size())
+{
+  // decimating by index only preserves the envelope when x is sorted
+  for (size_t i = 1; i < m_size; ++i){
+    if (data.x(i) < data.x(i-1)){
+      return;
+    }
+  }
+
+  if (m_size < 2*minPoints){
+    return;
+  }
+
+  std::vector<double> x;
+  std::vector<double> y;
+  decimate(data, x, y);
+  while (true){
+    m_x.push_back(std::vector<double>());
+    m_y.push_back(std::vector<double>());
+    m_x.back().swap(x);
+    m_y.back().swap(y);
+    if (m_x.back().size() < 2*minPoints){
+      break;
+    }
+    QwtCPointerData previous(&m_x.back()[0], &m_y.back()[0], m_x.back().size());
+    decimate(previous, x, y);
+  }
+}
+
+unsigned LinePlotPyramid::numLevels() const
+{
+  return m_x.size() + 1;
+}
+
+size_t LinePlotPyramid::size() const
+{
+  return m_size;
+}
+
+const std::vector<double>& LinePlotPyramid::x(unsigned level) const
+{
+  OS_ASSERT(level > 0 && level < numLevels());
+  return m_x[level-1];
+}
+
+const std::vector<double>& LinePlotPyramid::y(unsigned level) const
+{
+  OS_ASSERT(level > 0 && level < numLevels());
+  return m_y[level-1];
+}
+
+unsigned LinePlotPyramid::level(double minX, double maxX, unsigned pixelWidth, unsigned pointsPerPixel) const
+{
+  size_t required = static_cast<size_t>(pixelWidth) * pointsPerPixel;
+  unsigned result = 0;
+  for (unsigned level = 1; level < numLevels(); ++level){
+    std::pair<size_t, size_t> range = visibleRange(level, minX, maxX);
+    if (range.second - range.first < required){
+      break;
+    }
+    result = level;
+  }
+  return result;
+}
+
+std::pair<size_t, size_t> LinePlotPyramid::visibleRange(unsigned level, double minX, double maxX) const
+{
+  const std::vector<double>& values = x(level);
+  if (maxX < minX){
+    std::swap(minX, maxX);
+  }
+  size_t first = std::lower_bound(values.begin(), values.end(), minX) - values.begin();
+  size_t last = std::upper_bound(values.begin(), values.end(), maxX) - values.begin();
+  // include one point on each side so lines run to the edge of the canvas
+  if (first > 0) --first;
+  if (last < values.size()) ++last;
+  return std::make_pair(first, last);
+}
+
+/* --------------------------------------
+ * DecimatedPlotCurve Class
+ * --------------------------------------
+*/
+
+DecimatedPlotCurve::DecimatedPlotCurve()
+  : QwtPlotCurve(), m_levelCurve(new QwtPlotCurve())
+{
+}
+
+DecimatedPlotCurve::DecimatedPlotCurve(const QString& title)
+  : QwtPlotCurve(title), m_levelCurve(new QwtPlotCurve())
+{
+}
+
+void DecimatedPlotCurve::draw(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap, int from, int to) const
+{
+  // incremental draws address points of the original data, fitted curves need all of them
+  if (from != 0 || to >= 0 || testCurveAttribute(QwtPlotCurve::Fitted)){
+    QwtPlotCurve::draw(painter, xMap, yMap, from, to);
+    return;
+  }
+
+  if (!m_pyramid || m_pyramid->size() != static_cast<size_t>(dataSize())){
+    m_pyramid = LinePlotPyramid::Ptr(new LinePlotPyramid(data()));
+  }
+
+  unsigned level = m_pyramid->level(xMap.s1(), xMap.s2(), static_cast<unsigned>(xMap.pDist()) + 1);
+  if (level == 0){
+    QwtPlotCurve::draw(painter, xMap, yMap, from, to);
+    return;
+  }
+
+  std::pair<size_t, size_t> range = m_pyramid->visibleRange(level, xMap.s1(), xMap.s2());
+  if (range.second <= range.first){
+    return;
+  }
+
+  m_levelCurve->setRawData(&m_pyramid->x(level)[range.first], &m_pyramid->y(level)[range.first], range.second - range.first);
+  m_levelCurve->setPen(pen());
+  m_levelCurve->setBrush(brush());
+  m_levelCurve->setStyle(style());
+  m_levelCurve->setSymbol(symbol());
+  m_levelCurve->setBaseline(baseline());
+  m_levelCurve->setCurveType(curveType());
+  m_levelCurve->draw(painter, xMap, yMap, 0, -1);
+}
+
+void DecimatedPlotCurve::itemChanged()
+{
+  m_pyramid.reset();
+  QwtPlotCurve::itemChanged();
+}
+
 /* --------------------------------------
  * LinePlot Class
  * --------------------------------------
@@ -371,7 +547,7 @@ void LinePlot::linePlotData(LinePlotData::Ptr data,  const std::string& name, QC
 
 
   /// todo - curve collection - shared pointers
-  QwtPlotCurve * curve = new QwtPlotCurve(toQString(name));
+  QwtPlotCurve * curve = new DecimatedPlotCurve(toQString(name));
   if (color == Qt::color0) 
   { // generate new color from color map
     color = curveColor(m_lastColor);
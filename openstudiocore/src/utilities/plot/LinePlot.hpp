@@ -46,6 +46,7 @@
 
 #include <cmath>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 
 namespace openstudio{
 
@@ -290,6 +291,75 @@ private:
 
 
 
+/** LinePlotPyramid is a min/max preserving, multi-resolution copy of curve data whose x values
+ *  are non-decreasing.  Level 0 is the original data, each coarser level keeps the smallest and
+ *  largest value of every group of four points of the level below, roughly halving the number
+ *  of points while preserving the envelope of the curve.
+ */
+class UTILITIES_API LinePlotPyramid
+{
+public:
+
+  COMMON_PTR_TYPEDEFS(LinePlotPyramid)
+
+  /// build coarser levels from data until a level has fewer than 2*minPoints points
+  LinePlotPyramid(const QwtData& data, unsigned minPoints = 1024);
+
+  /// number of levels, including the original data as level 0
+  unsigned numLevels() const;
+
+  /// number of points in the original data
+  size_t size() const;
+
+  /// x values at level, level must be greater than 0
+  const std::vector<double>& x(unsigned level) const;
+
+  /// y values at level, level must be greater than 0
+  const std::vector<double>& y(unsigned level) const;
+
+  /// coarsest level with at least pointsPerPixel points per pixel between minX and maxX
+  unsigned level(double minX, double maxX, unsigned pixelWidth, unsigned pointsPerPixel = 2) const;
+
+  /// index range [first, last) of points at level needed to draw minX to maxX, level must be greater than 0
+  std::pair<size_t, size_t> visibleRange(unsigned level, double minX, double maxX) const;
+
+private:
+  size_t m_size;
+  std::vector<std::vector<double> > m_x;
+  std::vector<std::vector<double> > m_y;
+};
+
+/** DecimatedPlotCurve is a QwtPlotCurve which draws from a LinePlotPyramid level matched to the
+ *  visible x range and canvas width, so redraw cost depends on the plot size rather than the
+ *  number of points.  The pyramid is built on first draw and rebuilt whenever the curve changes.
+ */
+class UTILITIES_API DecimatedPlotCurve : public QwtPlotCurve
+{
+public:
+
+  /// constructor
+  DecimatedPlotCurve();
+
+  /// constructor
+  explicit DecimatedPlotCurve(const QString& title);
+
+  /// virtual destructor
+  virtual ~DecimatedPlotCurve() {}
+
+  using QwtPlotCurve::draw;
+
+  /// reimplement draw to use decimated data when drawing the whole curve
+  virtual void draw(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap, int from, int to) const;
+
+  /// reimplement to discard the pyramid when data or appearance changes
+  virtual void itemChanged();
+
+private:
+
+  mutable LinePlotPyramid::Ptr m_pyramid;
+  mutable boost::scoped_ptr<QwtPlotCurve> m_levelCurve;
+};
+
 /** line plots data in a nice image 
 */
 class UTILITIES_API LinePlot : public Plot2D
@@ -24,6 +24,9 @@
 #include <utilities/data/Matrix.hpp>
 #include <utilities/core/Application.hpp>
 
+#include <algorithm>
+#include <functional>
+
 using namespace std;
 using namespace boost;
 using namespace openstudio;
@@ -240,3 +243,46 @@ TEST(LinePlot, TimeSeriesLinePlot_DetailedEndOfMonth)
   lp->generateImage(toPath("testTimeSeriesLinePlot_DetailedEndOfMonth.png"));
 
 }
+
+TEST(LinePlot, LinePlotPyramid)
+{
+  // one year of one minute data
+  unsigned n = 525600;
+  QwtArray<double> x(n);
+  QwtArray<double> y(n);
+  for (unsigned i = 0; i < n; ++i){
+    x[i] = i / 1440.0;
+    y[i] = i % 60;
+  }
+  y[123457] = 1000.0;
+  y[400001] = -1000.0;
+
+  QwtArrayData data(x, y);
+  LinePlotPyramid pyramid(data);
+  EXPECT_EQ(n, pyramid.size());
+  ASSERT_GT(pyramid.numLevels(), 1u);
+
+  for (unsigned level = 1; level < pyramid.numLevels(); ++level){
+    const std::vector<double>& levelX = pyramid.x(level);
+    const std::vector<double>& levelY = pyramid.y(level);
+    ASSERT_EQ(levelX.size(), levelY.size());
+    EXPECT_LE(levelX.size(), n);
+    EXPECT_TRUE(std::adjacent_find(levelX.begin(), levelX.end(), std::greater<double>()) == levelX.end());
+
+    // extremes survive every level
+    EXPECT_DOUBLE_EQ(1000.0, *std::max_element(levelY.begin(), levelY.end()));
+    EXPECT_DOUBLE_EQ(-1000.0, *std::min_element(levelY.begin(), levelY.end()));
+  }
+
+  // full range on a 1000 pixel canvas uses a coarse level, a one day window needs the raw data
+  unsigned fullLevel = pyramid.level(0.0, 365.0, 1000);
+  EXPECT_GT(fullLevel, 0u);
+  std::pair<size_t, size_t> range = pyramid.visibleRange(fullLevel, 0.0, 365.0);
+  EXPECT_GE(range.second - range.first, 2000u);
+  EXPECT_EQ(0u, pyramid.level(100.0, 101.0, 1000));
+
+  // unsorted x values are never decimated
+  x[10] = 1000.0;
+  QwtArrayData unsorted(x, y);
+  EXPECT_EQ(1u, LinePlotPyramid(unsorted).numLevels());
+}
@@ -30,10 +30,10 @@ namespace openstudio{
 SqlFile::SqlFile()
 {}
 
-SqlFile::SqlFile(const openstudio::path& path)
+SqlFile::SqlFile(const openstudio::path& path, bool readOnly)
 {
   try{
-    m_impl = boost::shared_ptr<detail::SqlFile_Impl>(new detail::SqlFile_Impl(path));
+    m_impl = boost::shared_ptr<detail::SqlFile_Impl>(new detail::SqlFile_Impl(path, readOnly));
   }catch(const std::exception& e){
     LOG(Error, "Could not create SqlFile for path '" << openstudio::toString(path) << "' error:" << e.what());
   }
@@ -84,6 +84,15 @@ openstudio::path SqlFile::path() const {
   return result;
 }
 
+bool SqlFile::readOnly() const
+{
+  bool result = false;
+  if (m_impl){
+    result = m_impl->readOnly();
+  }
+  return result;
+}
+
 bool SqlFile::close()
 {
   bool result = false;
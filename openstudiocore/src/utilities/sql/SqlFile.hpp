@@ -69,8 +69,10 @@ class UTILITIES_API SqlFile {
   /// default constructor
   SqlFile();
 
-  /// constructor from path
-  explicit SqlFile(const openstudio::path& path);
+  /// constructor from path. if readOnly, the file is opened read-only and is never modified;
+  /// indexes needed by time series and illuminance map queries are built in a temporary
+  /// database the first time each kind of query runs.
+  explicit SqlFile(const openstudio::path& path, bool readOnly = false);
 
   /// initializes a new sql file for output
   /// Does not create the indexes, that must be done manually
@@ -96,6 +98,9 @@ class UTILITIES_API SqlFile {
   /// get the path
   openstudio::path path() const;
 
+  /// returns true if the file was opened read-only
+  bool readOnly() const;
+
   /// close the file
   bool close();
 
@@ -0,0 +1,238 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <utilities/sql/SqlFileAggregator.hpp>
+#include <utilities/sql/SqlFile.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace openstudio {
+
+namespace {
+
+  boost::optional<double> firstDouble(const SqlFile& t_sqlFile, const std::string& t_statement)
+  {
+    return t_sqlFile.execAndReturnFirstDouble(t_statement);
+  }
+
+  // escape single quotes for use in an sql string literal
+  std::string quoted(const std::string& t_value)
+  {
+    std::string result = "'";
+    for (std::string::const_iterator itr = t_value.begin(); itr != t_value.end(); ++itr) {
+      if (*itr == '\'') {
+        result += '\'';
+      }
+      result += *itr;
+    }
+    result += "'";
+    return result;
+  }
+
+}
+
+// SQL FILE METRIC
+
+SqlFileMetric::SqlFileMetric(const std::string& name, 
+                             const boost::function<boost::optional<double> (const SqlFile&)>& value,
+                             const std::string& units)
+  : m_name(name), m_units(units), m_value(value)
+{}
+
+SqlFileMetric::SqlFileMetric(const std::string& name, 
+                             const std::string& statement,
+                             const std::string& units)
+  : m_name(name), m_units(units), m_value(boost::bind(&firstDouble, _1, statement))
+{}
+
+SqlFileMetric SqlFileMetric::tabularValue(const std::string& name,
+                                          const std::string& reportName,
+                                          const std::string& reportForString,
+                                          const std::string& tableName,
+                                          const std::string& rowName,
+                                          const std::string& columnName,
+                                          const std::string& units)
+{
+  std::string statement = "SELECT Value FROM tabulardatawithstrings WHERE ReportName=" + quoted(reportName) + 
+                          " AND ReportForString=" + quoted(reportForString) + 
+                          " AND TableName=" + quoted(tableName) + 
+                          " AND RowName=" + quoted(rowName) + 
+                          " AND ColumnName=" + quoted(columnName) + 
+                          " AND Units=" + quoted(units);
+  return SqlFileMetric(name, statement, units);
+}
+
+SqlFileMetric SqlFileMetric::meterTotal(const std::string& name,
+                                        const std::string& meterName,
+                                        const std::string& reportingFrequency)
+{
+  std::string statement = "SELECT SUM(ReportMeterData.VariableValue) FROM ReportMeterData, ReportMeterDataDictionary"
+                          " WHERE ReportMeterData.ReportMeterDataDictionaryIndex = ReportMeterDataDictionary.ReportMeterDataDictionaryIndex"
+                          " AND ReportMeterDataDictionary.VariableName=" + quoted(meterName) + 
+                          " AND ReportMeterDataDictionary.ReportingFrequency=" + quoted(reportingFrequency);
+  return SqlFileMetric(name, statement);
+}
+
+std::string SqlFileMetric::name() const {
+  return m_name;
+}
+
+std::string SqlFileMetric::units() const {
+  return m_units;
+}
+
+boost::optional<double> SqlFileMetric::value(const SqlFile& t_sqlFile) const {
+  return m_value(t_sqlFile);
+}
+
+// SQL FILE AGGREGATION
+
+SqlFileAggregation::SqlFileAggregation(const std::vector<openstudio::path>& sqlFiles,
+                                       const std::vector<SqlFileMetric>& metrics)
+  : m_sqlFiles(sqlFiles),
+    m_values(boost::numeric::ublas::scalar_matrix<double>(sqlFiles.size(), metrics.size(), 
+                                                          std::numeric_limits<double>::quiet_NaN())),
+    m_opened(sqlFiles.size(), 0)
+{
+  for (std::vector<SqlFileMetric>::const_iterator itr = metrics.begin(); itr != metrics.end(); ++itr) {
+    m_metricNames.push_back(itr->name());
+    m_metricUnits.push_back(itr->units());
+  }
+}
+
+std::vector<openstudio::path> SqlFileAggregation::sqlFiles() const {
+  return m_sqlFiles;
+}
+
+std::vector<std::string> SqlFileAggregation::metricNames() const {
+  return m_metricNames;
+}
+
+std::vector<std::string> SqlFileAggregation::metricUnits() const {
+  return m_metricUnits;
+}
+
+const Matrix& SqlFileAggregation::values() const {
+  return m_values;
+}
+
+Vector SqlFileAggregation::column(const std::string& metricName) const {
+  std::vector<std::string>::const_iterator itr = std::find(m_metricNames.begin(), m_metricNames.end(), metricName);
+  if (itr == m_metricNames.end()) {
+    throw std::runtime_error("No metric named '" + metricName + "' in SqlFileAggregation");
+  }
+
+  unsigned j = itr - m_metricNames.begin();
+  Vector result(m_values.size1());
+  for (unsigned i = 0; i < m_values.size1(); ++i) {
+    result(i) = m_values(i, j);
+  }
+  return result;
+}
+
+bool SqlFileAggregation::opened(unsigned i) const {
+  return m_opened.at(i) != 0;
+}
+
+// SQL FILE AGGREGATOR
+
+SqlFileAggregator::SqlFileAggregator(const std::vector<SqlFileMetric>& metrics)
+  : m_metrics(metrics), m_numThreads(0)
+{}
+
+void SqlFileAggregator::setNumThreads(unsigned t_numThreads) {
+  m_numThreads = t_numThreads;
+}
+
+unsigned SqlFileAggregator::numThreads() const {
+  return m_numThreads;
+}
+
+std::vector<SqlFileMetric> SqlFileAggregator::metrics() const {
+  return m_metrics;
+}
+
+SqlFileAggregation SqlFileAggregator::aggregate(const std::vector<openstudio::path>& sqlFiles) const
+{
+  SqlFileAggregation result(sqlFiles, m_metrics);
+
+  unsigned numThreads = m_numThreads;
+  if (numThreads == 0) {
+    numThreads = boost::thread::hardware_concurrency();
+  }
+  numThreads = std::max(1u, std::min(numThreads, static_cast<unsigned>(sqlFiles.size())));
+
+  unsigned next = 0;
+  boost::mutex mutex;
+
+  if (numThreads <= 1) {
+    aggregateWorker(result, next, mutex);
+  } else {
+    boost::thread_group threads;
+    for (unsigned i = 0; i < numThreads; ++i) {
+      threads.create_thread(boost::bind(&SqlFileAggregator::aggregateWorker, this, boost::ref(result), boost::ref(next), boost::ref(mutex)));
+    }
+    threads.join_all();
+  }
+
+  return result;
+}
+
+void SqlFileAggregator::aggregateWorker(SqlFileAggregation& t_result, unsigned& t_next, boost::mutex& t_mutex) const
+{
+  while (true) {
+    unsigned i;
+    {
+      boost::mutex::scoped_lock lock(t_mutex);
+      if (t_next >= t_result.m_sqlFiles.size()) {
+        return;
+      }
+      i = t_next++;
+    }
+
+    // each row is only written by the thread that claimed it
+    try {
+      SqlFile sqlFile(t_result.m_sqlFiles[i], true);
+      if (!sqlFile.connectionOpen()) {
+        LOG(Warn, "Unable to open sql file '" << toString(t_result.m_sqlFiles[i]) << "'");
+        continue;
+      }
+
+      t_result.m_opened[i] = 1;
+
+      for (unsigned j = 0; j < m_metrics.size(); ++j) {
+        boost::optional<double> value = m_metrics[j].value(sqlFile);
+        if (value) {
+          t_result.m_values(i, j) = *value;
+        }
+      }
+    } catch (const std::exception& e) {
+      LOG(Warn, "Error reading sql file '" << toString(t_result.m_sqlFiles[i]) << "': " << e.what());
+    }
+  }
+}
+
+} // openstudio
@@ -0,0 +1,147 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#ifndef UTILITIES_SQL_SQLFILEAGGREGATOR_HPP
+#define UTILITIES_SQL_SQLFILEAGGREGATOR_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <utilities/data/Matrix.hpp>
+#include <utilities/data/Vector.hpp>
+
+#include <utilities/core/Path.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+class SqlFile;
+
+/** SqlFileMetric describes one value read from every SqlFile by a SqlFileAggregator. */
+class UTILITIES_API SqlFileMetric {
+ public:
+
+  /** Construct from a function returning the value for a given SqlFile. Must be safe to call
+   *  from several threads at once, each with its own SqlFile. */
+  SqlFileMetric(const std::string& name, 
+                const boost::function<boost::optional<double> (const SqlFile&)>& value,
+                const std::string& units = std::string());
+
+  /** Construct from an sql statement returning a single double. */
+  SqlFileMetric(const std::string& name, 
+                const std::string& statement,
+                const std::string& units = std::string());
+
+  /** Value from the tabular reports. */
+  static SqlFileMetric tabularValue(const std::string& name,
+                                    const std::string& reportName,
+                                    const std::string& reportForString,
+                                    const std::string& tableName,
+                                    const std::string& rowName,
+                                    const std::string& columnName,
+                                    const std::string& units);
+
+  /** Sum of all values reported for meterName at reportingFrequency, e.g. "Electricity:Facility" and "Hourly". */
+  static SqlFileMetric meterTotal(const std::string& name,
+                                  const std::string& meterName,
+                                  const std::string& reportingFrequency);
+
+  std::string name() const;
+
+  std::string units() const;
+
+  /** Returns the value of this metric for t_sqlFile. */
+  boost::optional<double> value(const SqlFile& t_sqlFile) const;
+
+ private:
+  std::string m_name;
+  std::string m_units;
+  boost::function<boost::optional<double> (const SqlFile&)> m_value;
+};
+
+/** Results of a SqlFileAggregator run. Values are stored as a runs x metrics matrix, in the order 
+ *  the sql files and metrics were given, with NaN where a value is not available. */
+class UTILITIES_API SqlFileAggregation {
+ public:
+
+  SqlFileAggregation(const std::vector<openstudio::path>& sqlFiles,
+                     const std::vector<SqlFileMetric>& metrics);
+
+  std::vector<openstudio::path> sqlFiles() const;
+
+  std::vector<std::string> metricNames() const;
+
+  std::vector<std::string> metricUnits() const;
+
+  /** Runs x metrics matrix of values. */
+  const Matrix& values() const;
+
+  /** Values of one metric across all runs. Throws if there is no metric named metricName. */
+  Vector column(const std::string& metricName) const;
+
+  /** Returns true if sql file i could be opened. */
+  bool opened(unsigned i) const;
+
+ private:
+  friend class SqlFileAggregator;
+
+  std::vector<openstudio::path> m_sqlFiles;
+  std::vector<std::string> m_metricNames;
+  std::vector<std::string> m_metricUnits;
+  Matrix m_values;
+  std::vector<int> m_opened; // not vector<bool>, rows are filled from several threads
+};
+
+/** SqlFileAggregator reads the same set of metrics from many EnergyPlus sql files, for instance
+ *  all the DataPoints of a parametric analysis, opening the files read-only from a bounded number 
+ *  of threads. */
+class UTILITIES_API SqlFileAggregator {
+ public:
+
+  SqlFileAggregator(const std::vector<SqlFileMetric>& metrics);
+
+  /// Sets the number of threads used to read sql files, 0 (the default) uses one per core
+  void setNumThreads(unsigned t_numThreads);
+
+  unsigned numThreads() const;
+
+  std::vector<SqlFileMetric> metrics() const;
+
+  /** Reads all metrics from all sqlFiles. Files that cannot be opened yield a row of NaN. */
+  SqlFileAggregation aggregate(const std::vector<openstudio::path>& sqlFiles) const;
+
+ private:
+  REGISTER_LOGGER("openstudio.SqlFileAggregator");
+
+  void aggregateWorker(SqlFileAggregation& t_result, unsigned& t_next, boost::mutex& t_mutex) const;
+
+  std::vector<SqlFileMetric> m_metrics;
+  unsigned m_numThreads;
+};
+
+} // openstudio
+
+#endif // UTILITIES_SQL_SQLFILEAGGREGATOR_HPP
@@ -21,6 +21,8 @@
 #include <utilities/sql/SqlFileTimeSeriesQuery.hpp>
 
 #include <utilities/core/String.hpp>
+#include <utilities/core/Compare.hpp>
+#include <utilities/core/Instrumentation.hpp>
 #include <utilities/time/Calendar.hpp>
 #include <utilities/filetypes/EpwFile.hpp>
 #include <utilities/core/Containers.hpp>
@@ -50,15 +52,58 @@ namespace openstudio{
       return std::string(reinterpret_cast<const char*>(column));
     }
 
-    SqlFile_Impl::SqlFile_Impl(const openstudio::path& path)
-      : m_path(path), m_connectionOpen(false)
+    // parses the WHERE clause of a "SELECT Value FROM TabularDataWithStrings" statement into
+    // constraints on ReportName, ReportForString, TableName, RowName, ColumnName and Units.
+    // returns false for anything but equality tests on those columns joined by AND.
+    bool parseTabularDataQuery(const std::string& statement, std::vector<boost::optional<std::string> >& constraints)
+    {
+      static const boost::regex select("^\\s*select\\s+value\\s+from\\s+tabulardatawithstrings\\s+where\\s+(.*?)[\\s;]*$",
+                                       boost::regex::icase);
+      static const boost::regex term("\\s*\\(?\\s*(\\w+)\\s*=\\s*'((?:[^']|'')*)'\\s*\\)?\\s*(and\\s+|$)",
+                                     boost::regex::icase);
+      static const char* columns[] = {"ReportName", "ReportForString", "TableName", "RowName", "ColumnName", "Units"};
+
+      boost::smatch selectMatch;
+      if (!boost::regex_match(statement, selectMatch, select)) {
+        return false;
+      }
+
+      constraints.assign(6u, boost::none);
+      std::string::const_iterator begin = selectMatch[1].first;
+      std::string::const_iterator end = selectMatch[1].second;
+      boost::smatch termMatch;
+      while (begin != end) {
+        if (!boost::regex_search(begin, end, termMatch, term, boost::match_continuous)) {
+          return false;
+        }
+
+        unsigned index = 0;
+        while ((index < 6u) && !istringEqual(termMatch[1].str(), columns[index])) {
+          ++index;
+        }
+        if ((index == 6u) || constraints[index]) {
+          return false;
+        }
+        constraints[index] = boost::regex_replace(termMatch[2].str(), boost::regex("''"), "'");
+
+        begin = termMatch[0].second;
+        if ((termMatch[3].length() == 0) && (begin != end)) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    SqlFile_Impl::SqlFile_Impl(const openstudio::path& path, bool readOnly)
+      : m_path(path), m_connectionOpen(false), m_readOnly(readOnly)
     {
       reopen();
     }
 
     SqlFile_Impl::SqlFile_Impl(const openstudio::path &t_path, const openstudio::EpwFile &t_epwFile, const openstudio::DateTime &t_simulationTime,
         const openstudio::Calendar &t_calendar)
-      : m_path(t_path), m_sqliteFilename(toString(m_path))
+      : m_path(t_path), m_readOnly(false), m_sqliteFilename(toString(m_path))
     {
       m_sqliteFilename = toString(m_path);
       std::string fileName = m_sqliteFilename;
@@ -129,6 +174,11 @@ namespace openstudio{
 
     void SqlFile_Impl::removeIndexes()
     {
+      if (m_readOnly) {
+        LOG(Warn, "Not removing indexes from read-only SqlFile '" << m_sqliteFilename << "'");
+        return;
+      }
+
       if (m_connectionOpen)
       {
         try {
@@ -165,6 +215,12 @@ namespace openstudio{
 
     void SqlFile_Impl::createIndexes()
     {
+      if (m_readOnly) {
+        // read-only files get temporary indexes as queries need them, see keyedDataSource
+        LOG(Info, "Not creating indexes in read-only SqlFile '" << m_sqliteFilename << "'");
+        return;
+      }
+
       if (m_connectionOpen)
       {
         try {
@@ -340,6 +396,7 @@ namespace openstudio{
 
     void SqlFile_Impl::execAndThrowOnError(const std::string &t_stmt)
     {
+      m_tabularDataIndex.reset();
       char *err = 0;
       if (sqlite3_exec(m_db, t_stmt.c_str(), 0, 0, &err) != SQLITE_OK)
       {
@@ -384,6 +441,8 @@ namespace openstudio{
         sqlite3_close(m_db);
         m_connectionOpen = false;
       }
+      m_tabularDataIndex.reset();
+      m_temporaryIndexes.clear();
       return true;
     }
 
@@ -404,7 +463,16 @@ namespace openstudio{
       m_sqliteFilename = toString(m_path);
       std::string fileName = m_sqliteFilename;
 
-      int code = sqlite3_open_v2(fileName.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_EXCLUSIVE, NULL);
+      int code;
+      if (m_readOnly) {
+        // never create or modify the file, any indexes go to the temp database
+        if (!boost::filesystem::exists(m_path)) {
+          throw openstudio::Exception("File does not exist.");
+        }
+        code = sqlite3_open_v2(fileName.c_str(), &m_db, SQLITE_OPEN_READONLY, NULL);
+      } else {
+        code = sqlite3_open_v2(fileName.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_EXCLUSIVE, NULL);
+      }
 
       m_connectionOpen = (code == 0);
       if (m_connectionOpen) {// create index on dictionaryIndex for large table reportvariabledata
@@ -426,6 +494,48 @@ namespace openstudio{
       }
     }
 
+    bool SqlFile_Impl::readOnly() const
+    {
+      return m_readOnly;
+    }
+
+    std::string SqlFile_Impl::keyedDataSource(const std::string& table, const std::string& keyColumn, int key) const
+    {
+      if (!m_readOnly || !m_db) {
+        return table;
+      }
+
+      // map each key to the rowids holding it, once per table, in the connection's temp database
+      std::string rowsTable = table + "Rows";
+      if (m_temporaryIndexes.find(rowsTable) == m_temporaryIndexes.end()) {
+        std::string statement =
+          "CREATE TEMP TABLE IF NOT EXISTS " + rowsTable + " AS SELECT " + keyColumn + " AS KeyValue, rowid AS DataRowId FROM main." + table + ";"
+          "CREATE INDEX IF NOT EXISTS temp." + rowsTable + "KV ON " + rowsTable + " (KeyValue ASC);";
+        char *err = 0;
+        if (sqlite3_exec(m_db, statement.c_str(), 0, 0, &err) != SQLITE_OK) {
+          LOG(Warn, "Unable to create temporary index on " << table << ": " << (err ? err : "unknown error"));
+          sqlite3_free(err);
+          return table;
+        }
+        m_temporaryIndexes.insert(rowsTable);
+      }
+
+      std::stringstream s;
+      s << "(SELECT * FROM main." << table << " WHERE rowid IN (SELECT DataRowId FROM temp." << rowsTable
+        << " WHERE KeyValue=" << key << "))";
+      return s.str();
+    }
+
+    std::string SqlFile_Impl::dataDictionarySource(const DataDictionaryItem& dataDictionary) const
+    {
+      if (dataDictionary.table == "ReportMeterData") {
+        return keyedDataSource(dataDictionary.table, "ReportMeterDataDictionaryIndex", dataDictionary.recordIndex);
+      } else if (dataDictionary.table == "ReportVariableData") {
+        return keyedDataSource(dataDictionary.table, "ReportVariableDataDictionaryIndex", dataDictionary.recordIndex);
+      }
+      return dataDictionary.table;
+    }
+
     bool SqlFile_Impl::isValidConnection()
     {
       int code = -1;
@@ -1799,8 +1909,110 @@ namespace openstudio{
       return execAndReturnFirstDouble(s.str());
     }
 
+    const SqlFile_Impl::TabularDataIndex& SqlFile_Impl::tabularDataIndex() const
+    {
+      if (!m_tabularDataIndex) {
+        m_tabularDataIndex = boost::shared_ptr<TabularDataIndex>(new TabularDataIndex());
+        if (m_db)
+        {
+          sqlite3_stmt* sqlStmtPtr;
+
+          sqlite3_prepare_v2(m_db, "SELECT ReportName, ReportForString, TableName, RowName, ColumnName, Units, Value FROM TabularDataWithStrings", -1, &sqlStmtPtr, NULL);
+
+          while (sqlite3_step(sqlStmtPtr) == SQLITE_ROW)
+          {
+            TabularDataRow row;
+            for (int i = 0; i < 7; ++i) {
+              const unsigned char* text = sqlite3_column_text(sqlStmtPtr, i);
+              std::string column = text ? columnText(text) : std::string();
+              if (i < 6) {
+                row.key.push_back(column);
+              } else {
+                row.value = column;
+              }
+            }
+            row.doubleValue = sqlite3_column_double(sqlStmtPtr, 6);
+
+            unsigned index = m_tabularDataIndex->rows.size();
+            m_tabularDataIndex->byKey.insert(std::make_pair(row.key, index));
+            m_tabularDataIndex->byReport[std::make_pair(row.key[0], row.key[1])].push_back(index);
+            m_tabularDataIndex->rows.push_back(row);
+          }
+
+          // must finalize to prevent memory leaks
+          sqlite3_finalize(sqlStmtPtr);
+        }
+      }
+      return *m_tabularDataIndex;
+    }
+
+    bool SqlFile_Impl::findTabularData(const std::string& statement, const TabularDataRow*& row) const
+    {
+      std::vector<boost::optional<std::string> > constraints;
+      if (!parseTabularDataQuery(statement, constraints)) {
+        return false;
+      }
+
+      const TabularDataIndex& index = tabularDataIndex();
+      row = 0;
+
+      bool fullKey = true;
+      std::vector<std::string> key;
+      BOOST_FOREACH(const boost::optional<std::string>& constraint, constraints) {
+        if (!constraint) {
+          fullKey = false;
+          break;
+        }
+        key.push_back(*constraint);
+      }
+      if (fullKey) {
+        std::map<std::vector<std::string>, unsigned>::const_iterator it = index.byKey.find(key);
+        if (it != index.byKey.end()) {
+          row = &index.rows[it->second];
+        }
+        return true;
+      }
+
+      std::vector<unsigned> allRows;
+      const std::vector<unsigned>* candidates = &allRows;
+      if (constraints[0] && constraints[1]) {
+        std::map<std::pair<std::string, std::string>, std::vector<unsigned> >::const_iterator it =
+          index.byReport.find(std::make_pair(*constraints[0], *constraints[1]));
+        if (it == index.byReport.end()) {
+          return true;
+        }
+        candidates = &it->second;
+      } else {
+        for (unsigned i = 0, n = index.rows.size(); i < n; ++i) {
+          allRows.push_back(i);
+        }
+      }
+
+      BOOST_FOREACH(unsigned i, *candidates) {
+        const TabularDataRow& candidate = index.rows[i];
+        bool match = true;
+        for (unsigned j = 0; match && (j < 6u); ++j) {
+          match = (!constraints[j] || (*constraints[j] == candidate.key[j]));
+        }
+        if (match) {
+          row = &candidate;
+          break;
+        }
+      }
+      return true;
+    }
+
     boost::optional<double> SqlFile_Impl::execAndReturnFirstDouble(const std::string& statement) const
     {
+      OS_TIMER("SqlFile::query");
+      const TabularDataRow* row = 0;
+      if (findTabularData(statement, row)) {
+        if (row) {
+          return row->doubleValue;
+        }
+        return boost::none;
+      }
+
       boost::optional<double> value;
       if (m_db)
       {
@@ -1822,6 +2034,7 @@ namespace openstudio{
 
     boost::optional<int> SqlFile_Impl::execAndReturnFirstInt(const std::string& statement) const
     {
+      OS_TIMER("SqlFile::query");
       boost::optional<int> value;
       if (m_db)
       {
@@ -1843,6 +2056,15 @@ namespace openstudio{
 
     boost::optional<std::string> SqlFile_Impl::execAndReturnFirstString(const std::string& statement) const
     {
+      OS_TIMER("SqlFile::query");
+      const TabularDataRow* row = 0;
+      if (findTabularData(statement, row)) {
+        if (row) {
+          return row->value;
+        }
+        return boost::none;
+      }
+
       boost::optional<std::string> value;
       if (m_db)
       {
@@ -1864,6 +2086,7 @@ namespace openstudio{
 
     boost::optional<std::vector<double> > SqlFile_Impl::execAndReturnVectorOfDouble(const std::string& statement) const
     {
+      OS_TIMER("SqlFile::query");
       boost::optional<double> value;
       boost::optional<std::vector<double> > valueVector;
       if (m_db)
@@ -1899,6 +2122,7 @@ namespace openstudio{
 
     boost::optional<std::vector<int> > SqlFile_Impl::execAndReturnVectorOfInt(const std::string& statement) const
     {
+      OS_TIMER("SqlFile::query");
       boost::optional<int> value;
       boost::optional<std::vector<int> > valueVector;
       if (m_db)
@@ -1934,6 +2158,7 @@ namespace openstudio{
 
     boost::optional<std::vector<std::string> > SqlFile_Impl::execAndReturnVectorOfString(const std::string& statement) const
     {
+      OS_TIMER("SqlFile::query");
       boost::optional<std::string> value;
       boost::optional<std::vector<std::string> > valueVector;
       if (m_db)
@@ -1969,6 +2194,7 @@ namespace openstudio{
     // execute a statement and return the error code, used for create/drop tables
     int SqlFile_Impl::execute(const std::string& statement)
     {
+      m_tabularDataIndex.reset();
       int code = SQLITE_ERROR;
       if (m_db)
       {
@@ -1992,7 +2218,7 @@ namespace openstudio{
       {
         std::stringstream s;
         s << "SELECT VariableValue FROM ";
-        s << dataDictionary.table;
+        s << dataDictionarySource(dataDictionary);
         // ensure that there are time indice values for variablevalues (slows from 0.094s to 0.125s)
         s << " rvd INNER JOIN Time ti ON ti.TimeIndex = rvd.TimeIndex";
         //    s << " INNER JOIN EnvironmentPeriods ep ON ti.EnvironmentPeriodIndex = ep.EnvironmentPeriodIndex";
@@ -2046,7 +2272,7 @@ namespace openstudio{
       {
         std::stringstream s;
         s << "SELECT ti.Month, ti.Day, ti.Hour from ";
-        s << dataDictionary.table;
+        s << dataDictionarySource(dataDictionary);
         s << " rvd INNER JOIN Time ti on ti.TimeIndex = rvd.TimeIndex";
         if (dataDictionary.table == "ReportMeterData")
         {
@@ -2126,7 +2352,7 @@ namespace openstudio{
             std::stringstream s;
             s << "SELECT Interval from Time where TimeIndex in (";
             s << "SELECT min(ti.timeIndex) FROM ";
-            s << dataDictionary.table;
+            s << dataDictionarySource(dataDictionary);
             s << " rvd INNER JOIN Time ti on ti.TimeIndex = rvd.TimeIndex";
             if (dataDictionary.table == "ReportMeterData")
             {
@@ -2188,6 +2414,7 @@ namespace openstudio{
 
     openstudio::OptionalTimeSeries SqlFile_Impl::timeSeries(const DataDictionaryItem& dataDictionary)
     {
+      OS_TIMER("SqlFile::timeSeries");
       openstudio::OptionalTimeSeries ts;
       openstudio::DateTime startDate;
       std::vector<double> stdDaysFromFirstReport;
@@ -2201,7 +2428,7 @@ namespace openstudio{
       {
         std::stringstream s;
         s << "SELECT dt.VariableValue, Time.Month, Time.Day, Time.Hour, Time.Minute, Time.Interval FROM ";
-        s << dataDictionary.table;
+        s << dataDictionarySource(dataDictionary);
         s << " dt INNER JOIN Time ON Time.timeIndex = dt.TimeIndex";
         s << " WHERE ";
         if (dataDictionary.table == "ReportMeterData")
@@ -2287,7 +2514,7 @@ namespace openstudio{
       if (m_db) {
         std::stringstream s;
         s << "SELECT Time.month, Time.day, Time.hour, Time.minute, Time.dst FROM ";
-        s << dataDictionary.table;
+        s << dataDictionarySource(dataDictionary);
         s << " dt INNER JOIN Time ON Time.timeIndex = dt.TimeIndex";
         s << " WHERE ";
         if (dataDictionary.table == "ReportMeterData")
@@ -2948,7 +3175,7 @@ namespace openstudio{
     {
       std::vector<double> xv;
       std::stringstream s;
-      s << "select X from daylightmaphourlydata where HourlyReportIndex=" << hourlyReportIndex << " group by X";
+      s << "select X from " << keyedDataSource("DaylightMapHourlyData", "HourlyReportIndex", hourlyReportIndex) << " where HourlyReportIndex=" << hourlyReportIndex << " group by X";
 
       sqlite3_stmt* sqlStmtPtr;
 
@@ -2999,7 +3226,7 @@ namespace openstudio{
     {
       std::vector<double> yv;
       std::stringstream s;
-      s << "select Y from daylightmaphourlydata where HourlyReportIndex=" << hourlyReportIndex << " group by Y";
+      s << "select Y from " << keyedDataSource("DaylightMapHourlyData", "HourlyReportIndex", hourlyReportIndex) << " where HourlyReportIndex=" << hourlyReportIndex << " group by Y";
 
       sqlite3_stmt* sqlStmtPtr;
 
@@ -3230,7 +3457,7 @@ namespace openstudio{
       bool yValChanged=false;
 
       std::stringstream statement;
-      statement << "select X,Y,Illuminance from daylightmaphourlydata where HourlyReportIndex=" << hourlyReportIndex <<
+      statement << "select X,Y,Illuminance from " << keyedDataSource("DaylightMapHourlyData", "HourlyReportIndex", hourlyReportIndex) << " where HourlyReportIndex=" << hourlyReportIndex <<
         " order by Y asc, X asc";
 
       sqlite3_stmt* sqlStmtPtr;
@@ -3311,7 +3538,7 @@ namespace openstudio{
       unsigned j = 0;
 
       std::stringstream statement;
-      statement << "select Illuminance from daylightmaphourlydata where HourlyReportIndex=" << hourlyReportIndex <<
+      statement << "select Illuminance from " << keyedDataSource("DaylightMapHourlyData", "HourlyReportIndex", hourlyReportIndex) << " where HourlyReportIndex=" << hourlyReportIndex <<
         " order by X asc, Y asc";
 
       sqlite3_stmt* sqlStmtPtr;
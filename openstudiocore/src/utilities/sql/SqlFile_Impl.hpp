@@ -32,7 +32,10 @@
 #include <utilities/data/Matrix.hpp>
 
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -56,8 +59,8 @@ namespace openstudio{
     public:
 
       /// constructor from filesystem path, will throw ConstructorException if file does not exist
-      /// or if file is not valid
-      SqlFile_Impl(const openstudio::path& path);
+      /// or if file is not valid. if readOnly, the file is never modified.
+      SqlFile_Impl(const openstudio::path& path, bool readOnly = false);
 
 
       SqlFile_Impl(const openstudio::path &t_path, const openstudio::EpwFile &t_epwFile, const openstudio::DateTime &t_simulationTime,
@@ -78,6 +81,9 @@ namespace openstudio{
       /// get the path
       openstudio::path path() const;
 
+      /// returns true if the file was opened read-only
+      bool readOnly() const;
+
       /// close the file
       bool close();
 
@@ -786,8 +792,35 @@ namespace openstudio{
 
     private:
 
+      /// one row of the TabularDataWithStrings view
+      struct TabularDataRow {
+        /// ReportName, ReportForString, TableName, RowName, ColumnName, Units
+        std::vector<std::string> key;
+        std::string value;
+        /// value as sqlite converts it to a double
+        double doubleValue;
+      };
+
+      /// in-memory copy of the TabularDataWithStrings view, so summary queries do not each
+      /// join TabularData to Strings six times
+      struct TabularDataIndex {
+        std::vector<TabularDataRow> rows;
+        /// first row for each full key
+        std::map<std::vector<std::string>, unsigned> byKey;
+        /// rows in view order for each (ReportName, ReportForString)
+        std::map<std::pair<std::string, std::string>, std::vector<unsigned> > byReport;
+      };
+
       void init(const openstudio::path& path);
 
+      /// builds m_tabularDataIndex on first use
+      const TabularDataIndex& tabularDataIndex() const;
+
+      /// if statement is "SELECT Value FROM TabularDataWithStrings WHERE" followed by equality
+      /// tests on the key columns joined by AND, sets row to the first match (or 0 if there is
+      /// none) from tabularDataIndex() and returns true; otherwise returns false
+      bool findTabularData(const std::string& statement, const TabularDataRow*& row) const;
+
       void retrieveDataDictionary();
 
       void execAndThrowOnError(const std::string &t_stmt);
@@ -808,13 +841,23 @@ namespace openstudio{
 
       bool isValidConnection();
 
+      /// returns the FROM source for rows of table whose keyColumn equals key. this is table itself
+      /// unless the file is read-only, in which case a temporary index is built on first use.
+      std::string keyedDataSource(const std::string& table, const std::string& keyColumn, int key) const;
+
+      /// keyedDataSource for the data table of dataDictionary
+      std::string dataDictionarySource(const DataDictionaryItem& dataDictionary) const;
+
       void mf_makeConsistent(std::vector<SqlFileTimeSeriesQuery>& queries);
 
       openstudio::path m_path;
       bool m_connectionOpen;
       DataDictionaryTable m_dataDictionary;
+      bool m_readOnly;
       sqlite3* m_db;
       std::string m_sqliteFilename;
+      mutable boost::shared_ptr<TabularDataIndex> m_tabularDataIndex;
+      mutable std::set<std::string> m_temporaryIndexes;
 
       REGISTER_LOGGER("openstudio.energyplus.SqlFile");
     };
@@ -0,0 +1,80 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <utilities/sql/Test/SqlFileFixture.hpp>
+#include <utilities/sql/SqlFileAggregator.hpp>
+
+#include <resources.hxx>
+
+#include <boost/bind.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+
+using namespace openstudio;
+
+TEST_F(SqlFileFixture, SqlFileAggregator)
+{
+  std::vector<SqlFileMetric> metrics;
+  metrics.push_back(SqlFileMetric("Net Site Energy", boost::bind(&SqlFile::netSiteEnergy, _1), "GJ"));
+  metrics.push_back(SqlFileMetric::tabularValue("Total Site Energy", "AnnualBuildingUtilityPerformanceSummary", 
+                                                "Entire Facility", "Site and Source Energy", "Total Site Energy", 
+                                                "Total Energy", "GJ"));
+  metrics.push_back(SqlFileMetric("Missing", "SELECT Value FROM tabulardatawithstrings WHERE ReportName='NoSuchReport'"));
+
+  openstudio::path path = sqlFile.path();
+  std::vector<openstudio::path> paths(5, path);
+  paths[2] = toPath("./NoSuchFile/eplusout.sql");
+
+  SqlFileAggregator aggregator(metrics);
+  aggregator.setNumThreads(3);
+  EXPECT_EQ(3u, aggregator.numThreads());
+
+  SqlFileAggregation result = aggregator.aggregate(paths);
+
+  ASSERT_EQ(5u, result.values().size1());
+  ASSERT_EQ(3u, result.values().size2());
+  ASSERT_EQ(3u, result.metricNames().size());
+  EXPECT_EQ("GJ", result.metricUnits()[0]);
+
+  for (unsigned i = 0; i < paths.size(); ++i) {
+    if (i == 2) {
+      EXPECT_FALSE(result.opened(i));
+      EXPECT_TRUE(boost::math::isnan(result.values()(i, 0)));
+      EXPECT_TRUE(boost::math::isnan(result.values()(i, 1)));
+    } else {
+      EXPECT_TRUE(result.opened(i));
+      EXPECT_DOUBLE_EQ(*sqlFile.netSiteEnergy(), result.values()(i, 0));
+      EXPECT_DOUBLE_EQ(*sqlFile.totalSiteEnergy(), result.values()(i, 1));
+    }
+    EXPECT_TRUE(boost::math::isnan(result.values()(i, 2)));
+  }
+
+  Vector netSiteEnergy = result.column("Net Site Energy");
+  ASSERT_EQ(5u, netSiteEnergy.size());
+  EXPECT_DOUBLE_EQ(*sqlFile.netSiteEnergy(), netSiteEnergy(4));
+  EXPECT_THROW(result.column("No Such Metric"), std::exception);
+
+  // serial and threaded reads agree
+  aggregator.setNumThreads(1);
+  SqlFileAggregation serial = aggregator.aggregate(paths);
+  EXPECT_DOUBLE_EQ(result.values()(0, 1), serial.values()(0, 1));
+  EXPECT_DOUBLE_EQ(result.values()(4, 0), serial.values()(4, 0));
+}
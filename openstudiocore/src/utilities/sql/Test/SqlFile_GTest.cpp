@@ -38,6 +38,7 @@
 #include <iostream>
 
 #include <boost/foreach.hpp>
+#include <boost/filesystem.hpp>
 
 using namespace std;
 using namespace boost;
@@ -58,6 +59,76 @@ TEST_F(SqlFileFixture, SummaryValues)
 }
 
 
+TEST_F(SqlFileFixture, TabularDataIndex)
+{
+  // served from the tabular data index
+  std::string query = "SELECT Value FROM tabulardatawithstrings WHERE \
+                       ReportName='AnnualBuildingUtilityPerformanceSummary' AND \
+                       ReportForString='Entire Facility' AND \
+                       TableName='Site and Source Energy' AND \
+                       RowName='Total Site Energy' AND \
+                       ColumnName='Total Energy' AND \
+                       Units='GJ'";
+  // not of the indexed form, so goes to sqlite
+  std::string sqlQuery = query + " LIMIT 1";
+
+  ASSERT_TRUE(sqlFile.execAndReturnFirstDouble(query));
+  ASSERT_TRUE(sqlFile.execAndReturnFirstDouble(sqlQuery));
+  EXPECT_DOUBLE_EQ(*sqlFile.execAndReturnFirstDouble(sqlQuery), *sqlFile.execAndReturnFirstDouble(query));
+  ASSERT_TRUE(sqlFile.execAndReturnFirstString(query));
+  EXPECT_EQ(*sqlFile.execAndReturnFirstString(sqlQuery), *sqlFile.execAndReturnFirstString(query));
+
+  // partial keys, parentheses and case-insensitive column names
+  query = "SELECT Value from tabulardatawithstrings where (reportname = 'InputVerificationandResultsSummary') and (ReportForString = 'Entire Facility') and (TableName = 'General') and (RowName = 'Hours Simulated')";
+  sqlQuery = query + " LIMIT 1";
+  ASSERT_TRUE(sqlFile.execAndReturnFirstDouble(query));
+  EXPECT_DOUBLE_EQ(*sqlFile.execAndReturnFirstDouble(sqlQuery), *sqlFile.execAndReturnFirstDouble(query));
+
+  // no match
+  EXPECT_FALSE(sqlFile.execAndReturnFirstDouble("SELECT Value FROM TabularDataWithStrings WHERE ReportName='NotAReport'"));
+  EXPECT_FALSE(sqlFile.execAndReturnFirstString("SELECT Value FROM TabularDataWithStrings WHERE ReportName='NotAReport' AND ReportForString='Entire Facility'"));
+}
+
+TEST_F(SqlFileFixture, ReadOnly)
+{
+  openstudio::path path = resourcesPath()/toPath("energyplus/5ZoneAirCooled/eplusout.sql");
+  boost::uintmax_t size = boost::filesystem::file_size(path);
+  std::time_t lastWrite = boost::filesystem::last_write_time(path);
+
+  {
+    openstudio::SqlFile readOnlyFile(path, true);
+    ASSERT_TRUE(readOnlyFile.connectionOpen());
+    EXPECT_TRUE(readOnlyFile.readOnly());
+    EXPECT_FALSE(sqlFile.readOnly());
+
+    readOnlyFile.createIndexes();
+
+    std::vector<std::string> availableEnvPeriods = readOnlyFile.availableEnvPeriods();
+    ASSERT_FALSE(availableEnvPeriods.empty());
+    openstudio::OptionalTimeSeries ts = readOnlyFile.timeSeries(availableEnvPeriods[0], "Hourly", "Site Outdoor Air Drybulb Temperature",  "Environment");
+    openstudio::OptionalTimeSeries expected = sqlFile.timeSeries(availableEnvPeriods[0], "Hourly", "Site Outdoor Air Drybulb Temperature",  "Environment");
+    ASSERT_TRUE(ts);
+    ASSERT_TRUE(expected);
+    ASSERT_EQ(expected->values().size(), ts->values().size());
+    for (unsigned i = 0; i < ts->values().size(); ++i) {
+      EXPECT_DOUBLE_EQ(expected->values()[i], ts->values()[i]);
+    }
+
+    ASSERT_TRUE(readOnlyFile.totalSiteEnergy());
+    EXPECT_DOUBLE_EQ(*sqlFile.totalSiteEnergy(), *readOnlyFile.totalSiteEnergy());
+  }
+
+  EXPECT_EQ(size, boost::filesystem::file_size(path));
+  EXPECT_EQ(lastWrite, boost::filesystem::last_write_time(path));
+
+  // missing files are not created
+  openstudio::path missing = toPath("./SqlFile_ReadOnly_missing.sql");
+  boost::filesystem::remove(missing);
+  openstudio::SqlFile missingFile(missing, true);
+  EXPECT_FALSE(missingFile.connectionOpen());
+  EXPECT_FALSE(boost::filesystem::exists(missing));
+}
+
 TEST_F(SqlFileFixture, EnvPeriods)
 {
   std::vector<std::string> availableEnvPeriods = sqlFile.availableEnvPeriods();